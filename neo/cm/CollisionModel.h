@@ -103,6 +103,9 @@ public:
 	
 	virtual void			Preload( const char* mapName ) = 0;
 	
+	// Returns true if the .cm or generated .bcm file of the map was built from map geometry with the given CRC.
+	virtual bool			HasCollisionModelFile( const char* mapName, unsigned int mapFileCRC ) = 0;
+	
 	// Gets the clip handle for a model.
 	virtual cmHandle_t		LoadModel( const char* modelName ) = 0;
 	// Sets up a trace model for collision with other trace models.
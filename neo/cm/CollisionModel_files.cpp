@@ -436,6 +436,8 @@ void idCollisionModelManagerLocal::ParsePolygons( idLexer* src, cm_model_t* mode
 	int i, numEdges;
 	idVec3 normal;
 	idToken token;
+	idTokenView materialToken;
+	idStr materialName;
 	
 	if( src->CheckTokenType( TT_NUMBER, 0, &token ) )
 	{
@@ -462,9 +464,10 @@ void idCollisionModelManagerLocal::ParsePolygons( idLexer* src, cm_model_t* mode
 		p->plane.SetDist( src->ParseFloat() );
 		src->Parse1DMatrix( 3, p->bounds[0].ToFloatPtr() );
 		src->Parse1DMatrix( 3, p->bounds[1].ToFloatPtr() );
-		src->ExpectTokenType( TT_STRING, 0, &token );
+		src->ExpectTokenViewType( TT_STRING, 0, &materialToken );
 		// get material
-		p->material = declManager->FindMaterial( token );
+		materialToken.ToStr( materialName );
+		p->material = declManager->FindMaterial( materialName );
 		p->contents = p->material->GetContentFlags();
 		p->checkcount = 0;
 		// filter polygon into tree
@@ -483,6 +486,8 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer* src, cm_model_t* model
 	int i, numPlanes;
 	idVec3 normal;
 	idToken token;
+	idTokenView contentsToken;
+	idStr contents;
 	
 	if( src->CheckTokenType( TT_NUMBER, 0, &token ) )
 	{
@@ -508,14 +513,15 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer* src, cm_model_t* model
 		src->ExpectTokenString( "}" );
 		src->Parse1DMatrix( 3, b->bounds[0].ToFloatPtr() );
 		src->Parse1DMatrix( 3, b->bounds[1].ToFloatPtr() );
-		src->ReadToken( &token );
-		if( token.type == TT_NUMBER )
+		src->ReadTokenView( &contentsToken );
+		if( contentsToken.type == TT_NUMBER )
 		{
-			b->contents = token.GetIntValue();		// old .cm files use a single integer
+			b->contents = contentsToken.GetIntValue();		// old .cm files use a single integer
 		}
 		else
 		{
-			b->contents = ContentsFromString( token );
+			contentsToken.ToStr( contents );
+			b->contents = ContentsFromString( contents );
 		}
 		b->checkcount = 0;
 		b->primitiveNum = 0;
@@ -534,7 +540,7 @@ cm_model_t* idCollisionModelManagerLocal::ParseCollisionModel( idLexer* src )
 {
 
 	cm_model_t* model;
-	idToken token;
+	idTokenView token;
 	
 	if( numModels >= MAX_SUBMODELS )
 	{
@@ -545,13 +551,13 @@ cm_model_t* idCollisionModelManagerLocal::ParseCollisionModel( idLexer* src )
 	models[numModels ] = model;
 	numModels++;
 	// parse the file
-	src->ExpectTokenType( TT_STRING, 0, &token );
-	model->name = token;
+	src->ExpectTokenViewType( TT_STRING, 0, &token );
+	token.ToStr( model->name );
 	src->ExpectTokenString( "{" );
 	while( !src->CheckTokenString( "}" ) )
 	{
 	
-		src->ReadToken( &token );
+		src->ReadTokenView( &token );
 		
 		if( token == "vertices" )
 		{
@@ -585,7 +591,7 @@ cm_model_t* idCollisionModelManagerLocal::ParseCollisionModel( idLexer* src )
 			continue;
 		}
 		
-		src->Error( "ParseCollisionModel: bad token \"%s\"", token.c_str() );
+		src->Error( "ParseCollisionModel: bad token \"%.*s\"", token.Length(), token.Ptr() );
 	}
 	// calculate edge normals
 	checkCount++;
@@ -753,3 +759,56 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char* name, uns
 	
 	return true;
 }
+
+/*
+================
+idCollisionModelManagerLocal::HasCollisionModelFile
+
+Checks the headers the same way LoadCollisionModelFile does without loading any models
+================
+*/
+bool idCollisionModelManagerLocal::HasCollisionModelFile( const char* mapName, unsigned int mapFileCRC )
+{
+	idStrStatic< MAX_OSPATH > generatedFileName = mapName;
+	generatedFileName.Insert( "generated/", 0 );
+	generatedFileName.SetFileExtension( CM_BINARYFILE_EXT );
+	
+	idFileLocal file( fileSystem->OpenFileRead( generatedFileName ) );
+	if( file != NULL )
+	{
+		int numEntries = 0;
+		idStr fileMapName;
+		unsigned int crc = 0;
+		idStrStatic< 32 > fileID;
+		idStrStatic< 32 > fileVersion;
+		file->ReadBig( numEntries );
+		file->ReadString( fileMapName );
+		file->ReadBig( crc );
+		file->ReadString( fileID );
+		file->ReadString( fileVersion );
+		if( fileID == CM_FILEID && fileVersion == CM_FILEVERSION && crc == mapFileCRC && numEntries > 0 )
+		{
+			return true;
+		}
+	}
+	
+	idStrStatic< MAX_OSPATH > fileName = mapName;
+	fileName.SetFileExtension( CM_FILE_EXT );
+	
+	idLexer src( fileName, LEXFL_NOSTRINGCONCAT | LEXFL_NODOLLARPRECOMPILE | LEXFL_NOERRORS | LEXFL_NOWARNINGS );
+	if( !src.IsLoaded() )
+	{
+		return false;
+	}
+	
+	idToken token;
+	if( !src.ExpectTokenString( CM_FILEID ) || !src.ReadToken( &token ) || token != CM_FILEVERSION )
+	{
+		return false;
+	}
+	if( !src.ExpectTokenType( TT_NUMBER, TT_INTEGER, &token ) )
+	{
+		return false;
+	}
+	return ( token.GetUnsignedLongValue() == mapFileCRC );
+}
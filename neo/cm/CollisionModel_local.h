@@ -333,6 +333,7 @@ public:
 	void			FreeMap();
 	
 	void			Preload( const char* mapName );
+	bool			HasCollisionModelFile( const char* mapName, unsigned int mapFileCRC );
 	// get clip handle for model
 	cmHandle_t		LoadModel( const char* modelName );
 	// sets up a trace model for collision with other trace models
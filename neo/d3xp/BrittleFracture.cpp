@@ -43,6 +43,8 @@ const int SHARD_FADE_START	= 2000;
 
 static const char* brittleFracture_SnapshotName = "_BrittleFracture_Snapshot_";
 
+idCVar g_fractureJobs( "g_fractureJobs", "1", CVAR_GAME | CVAR_BOOL, "generate the brittle fracture shards on the job threads" );
+
 /*
 ================
 idBrittleFracture::idBrittleFracture
@@ -66,10 +68,18 @@ idBrittleFracture::idBrittleFracture()
 	
 	bounds.Clear();
 	disableFracture = false;
+	fractureJob = NULL;
 	
 	lastRenderEntityUpdate = -1;
 	changed = false;
 	
+	staticShardsChanged = true;
+	staticColor = 0;
+	staticOrigin.Zero();
+	staticAxis.Identity();
+	staticShardBounds.Clear();
+	staticDecalBounds.Clear();
+	
 	fl.networkSync = true;
 	
 	isXraySurface = false;
@@ -84,6 +94,9 @@ idBrittleFracture::~idBrittleFracture()
 {
 	int i;
 	
+	// don't leave a job writing into a deleted fracture
+	FinishFractures();
+	
 	for( i = 0; i < shards.Num(); i++ )
 	{
 		shards[i]->decals.DeleteContents( true );
@@ -185,7 +198,7 @@ void idBrittleFracture::Restore( idRestoreGame* savefile )
 	// Reset all brittle Fractures so we can re-break them if necessary
 	fl.takedamage = true;
 	CreateFractures( defaultRenderModel );
-	FindNeighbours();
+	FinishFractures();
 	
 	int numEvents = 0;
 	bool resolveBreaks = false;
@@ -292,8 +305,6 @@ void idBrittleFracture::Spawn()
 	
 	CreateFractures( renderEntity.hModel );
 	
-	FindNeighbours();
-	
 	defaultRenderModel = renderEntity.hModel;
 	renderEntity.hModel = renderModelManager->AllocModel();
 	renderEntity.hModel->InitEmpty( brittleFracture_SnapshotName );
@@ -330,6 +341,11 @@ void idBrittleFracture::RemoveShard( int index )
 {
 	int i;
 	
+	if( shards[index]->droppedTime == -1 )
+	{
+		staticShardsChanged = true;
+	}
+	
 	delete shards[index];
 	shards.RemoveIndex( index );
 	physicsObj.RemoveIndex( index );
@@ -340,6 +356,135 @@ void idBrittleFracture::RemoveShard( int index )
 	}
 }
 
+/*
+================
+EmitShardTriangles
+
+Emits the winding as a triangle fan with three unshared verts per triangle,
+returns the number of verts written
+================
+*/
+static int EmitShardTriangles( idDrawVert* verts, const idWinding& winding, const idVec3& origin, const idMat3& axis, const idMat3& tangents, const dword packedColor )
+{
+	int numVerts = 0;
+	
+	for( int j = 2; j < winding.GetNumPoints(); j++ )
+	{
+		const int fan[3] = { 0, j - 1, j };
+		
+		for( int k = 0; k < 3; k++ )
+		{
+			const idVec5& p = winding[fan[k]];
+			
+			idDrawVert* v = &verts[numVerts++];
+			v->Clear();
+			v->xyz = origin + p.ToVec3() * axis;
+			v->SetTexCoord( p.s, p.t );
+			v->SetNormal( tangents[0] );
+			v->SetTangent( tangents[1] );
+			v->SetBiTangent( tangents[2] );
+			v->SetColor( packedColor );
+		}
+	}
+	return numVerts;
+}
+
+/*
+================
+EmitShardIndexes
+================
+*/
+static void EmitShardIndexes( srfTriangles_t* tris, const bool backSides )
+{
+	for( int i = 0; i < tris->numVerts; i += 3 )
+	{
+		tris->indexes[tris->numIndexes++] = i + 0;
+		tris->indexes[tris->numIndexes++] = i + 1;
+		tris->indexes[tris->numIndexes++] = i + 2;
+		
+		if( backSides )
+		{
+			tris->indexes[tris->numIndexes++] = i + 1;
+			tris->indexes[tris->numIndexes++] = i + 0;
+			tris->indexes[tris->numIndexes++] = i + 2;
+		}
+	}
+}
+
+/*
+================
+NumShardTriangles
+================
+*/
+static int NumShardTriangles( const idWinding& winding )
+{
+	return Max( winding.GetNumPoints() - 2, 0 );
+}
+
+/*
+================
+idBrittleFracture::UpdateStaticGeometry
+
+Re-emits the shards that are still in place, these only change when a shard
+drops or a decal is projected, not every frame
+================
+*/
+void idBrittleFracture::UpdateStaticGeometry( const dword packedColor ) const
+{
+	int i, k, numTris, numDecalTris, numVerts, numDecalVerts;
+	idPlane plane;
+	idMat3 tangents;
+	
+	staticShardsChanged = false;
+	staticColor = packedColor;
+	staticOrigin = physicsObj.GetOrigin();
+	staticAxis = physicsObj.GetAxis();
+	
+	numTris = 0;
+	numDecalTris = 0;
+	for( i = 0; i < shards.Num(); i++ )
+	{
+		if( shards[i]->droppedTime != -1 )
+		{
+			continue;
+		}
+		numTris += NumShardTriangles( shards[i]->winding );
+		for( k = 0; k < shards[i]->decals.Num(); k++ )
+		{
+			numDecalTris += NumShardTriangles( *shards[i]->decals[k] );
+		}
+	}
+	
+	staticShardVerts.SetNum( numTris * 3 );
+	staticDecalVerts.SetNum( numDecalTris * 3 );
+	
+	numVerts = 0;
+	numDecalVerts = 0;
+	for( i = 0; i < shards.Num(); i++ )
+	{
+		if( shards[i]->droppedTime != -1 )
+		{
+			continue;
+		}
+		
+		const idVec3& origin = shards[i]->clipModel->GetOrigin();
+		const idMat3& axis = shards[i]->clipModel->GetAxis();
+		
+		shards[i]->winding.GetPlane( plane );
+		tangents = ( plane.Normal() * axis ).ToMat3();
+		
+		numVerts += EmitShardTriangles( staticShardVerts.Ptr() + numVerts, shards[i]->winding, origin, axis, tangents, packedColor );
+		
+		for( k = 0; k < shards[i]->decals.Num(); k++ )
+		{
+			numDecalVerts += EmitShardTriangles( staticDecalVerts.Ptr() + numDecalVerts, *shards[i]->decals[k], origin, axis, tangents, packedColor );
+		}
+	}
+	
+	SIMDProcessor->MinMax( staticShardBounds[0], staticShardBounds[1], staticShardVerts.Ptr(), staticShardVerts.Num() );
+	SIMDProcessor->MinMax( staticDecalBounds[0], staticDecalBounds[1], staticDecalVerts.Ptr(), staticDecalVerts.Num() );
+}
+
 /*
 ================
 idBrittleFracture::UpdateRenderEntity
@@ -347,12 +492,11 @@ idBrittleFracture::UpdateRenderEntity
 */
 bool idBrittleFracture::UpdateRenderEntity( renderEntity_s* renderEntity, const renderView_t* renderView ) const
 {
-	int i, j, k, n, msec, numTris, numDecalTris;
+	int i, k, msec, numTris, numDecalTris;
 	float fade;
 	dword packedColor;
 	srfTriangles_t* tris, *decalTris;
 	modelSurface_t surface;
-	idDrawVert* v;
 	idPlane plane;
 	idMat3 tangents;
 	
@@ -372,22 +516,29 @@ bool idBrittleFracture::UpdateRenderEntity( renderEntity_s* renderEntity, const
 	lastRenderEntityUpdate = gameLocal.time;
 	changed = false;
 	
-	numTris = 0;
-	numDecalTris = 0;
+	packedColor = PackColor( idVec4( renderEntity->shaderParms[ SHADERPARM_RED ],
+									 renderEntity->shaderParms[ SHADERPARM_GREEN ],
+									 renderEntity->shaderParms[ SHADERPARM_BLUE ],
+									 1.0f ) );
+									 
+	if( staticShardsChanged || packedColor != staticColor || physicsObj.GetOrigin() != staticOrigin || physicsObj.GetAxis() != staticAxis )
+	{
+		UpdateStaticGeometry( packedColor );
+	}
+	
+	// only the dropped shards move or fade every frame
+	numTris = staticShardVerts.Num() / 3;
+	numDecalTris = staticDecalVerts.Num() / 3;
 	for( i = 0; i < shards.Num(); i++ )
 	{
-		n = shards[i]->winding.GetNumPoints();
-		if( n > 2 )
+		if( shards[i]->droppedTime == -1 )
 		{
-			numTris += n - 2;
+			continue;
 		}
+		numTris += NumShardTriangles( shards[i]->winding );
 		for( k = 0; k < shards[i]->decals.Num(); k++ )
 		{
-			n = shards[i]->decals[k]->GetNumPoints();
-			if( n > 2 )
-			{
-				numDecalTris += n - 2;
-			}
+			numDecalTris += NumShardTriangles( *shards[i]->decals[k] );
 		}
 	}
 	
@@ -398,19 +549,32 @@ bool idBrittleFracture::UpdateRenderEntity( renderEntity_s* renderEntity, const
 	tris = renderEntity->hModel->AllocSurfaceTriangles( numTris * 3, material->ShouldCreateBackSides() ? numTris * 6 : numTris * 3 );
 	decalTris = renderEntity->hModel->AllocSurfaceTriangles( numDecalTris * 3, decalMaterial->ShouldCreateBackSides() ? numDecalTris * 6 : numDecalTris * 3 );
 	
+	if( staticShardVerts.Num() > 0 )
+	{
+		memcpy( tris->verts, staticShardVerts.Ptr(), staticShardVerts.Num() * sizeof( idDrawVert ) );
+		tris->numVerts = staticShardVerts.Num();
+	}
+	if( staticDecalVerts.Num() > 0 )
+	{
+		memcpy( decalTris->verts, staticDecalVerts.Ptr(), staticDecalVerts.Num() * sizeof( idDrawVert ) );
+		decalTris->numVerts = staticDecalVerts.Num();
+	}
+	
 	for( i = 0; i < shards.Num(); i++ )
 	{
+		if( shards[i]->droppedTime == -1 )
+		{
+			continue;
+		}
+		
 		const idVec3& origin = shards[i]->clipModel->GetOrigin();
 		const idMat3& axis = shards[i]->clipModel->GetAxis();
 		
 		fade = 1.0f;
-		if( shards[i]->droppedTime >= 0 )
+		msec = gameLocal.time - shards[i]->droppedTime - SHARD_FADE_START;
+		if( msec > 0 )
 		{
-			msec = gameLocal.time - shards[i]->droppedTime - SHARD_FADE_START;
-			if( msec > 0 )
-			{
-				fade = 1.0f - ( float ) msec / ( SHARD_ALIVE_TIME - SHARD_FADE_START );
-			}
+			fade = 1.0f - ( float ) msec / ( SHARD_ALIVE_TIME - SHARD_FADE_START );
 		}
 		
 		packedColor = PackColor( idVec4( renderEntity->shaderParms[ SHADERPARM_RED ] * fade,
@@ -418,108 +582,27 @@ bool idBrittleFracture::UpdateRenderEntity( renderEntity_s* renderEntity, const
 										 renderEntity->shaderParms[ SHADERPARM_BLUE ] * fade,
 										 fade ) );
 										 
-		const idWinding& winding = shards[i]->winding;
-		
-		winding.GetPlane( plane );
+		shards[i]->winding.GetPlane( plane );
 		tangents = ( plane.Normal() * axis ).ToMat3();
 		
-		for( j = 2; j < winding.GetNumPoints(); j++ )
-		{
-		
-			v = &tris->verts[tris->numVerts++];
-			v->Clear();
-			v->xyz = origin + winding[0].ToVec3() * axis;
-			v->SetTexCoord( winding[0].s, winding[0].t );
-			v->SetNormal( tangents[0] );
-			v->SetTangent( tangents[1] );
-			v->SetBiTangent( tangents[2] );
-			v->SetColor( packedColor );
-			
-			v = &tris->verts[tris->numVerts++];
-			v->Clear();
-			v->xyz = origin + winding[j - 1].ToVec3() * axis;
-			v->SetTexCoord( winding[j - 1].s, winding[j - 1].t );
-			v->SetNormal( tangents[0] );
-			v->SetTangent( tangents[1] );
-			v->SetBiTangent( tangents[2] );
-			v->SetColor( packedColor );
-			
-			v = &tris->verts[tris->numVerts++];
-			v->Clear();
-			v->xyz = origin + winding[j].ToVec3() * axis;
-			v->SetTexCoord( winding[j].s, winding[j].t );
-			v->SetNormal( tangents[0] );
-			v->SetTangent( tangents[1] );
-			v->SetBiTangent( tangents[2] );
-			v->SetColor( packedColor );
-			
-			tris->indexes[tris->numIndexes++] = tris->numVerts - 3;
-			tris->indexes[tris->numIndexes++] = tris->numVerts - 2;
-			tris->indexes[tris->numIndexes++] = tris->numVerts - 1;
-			
-			if( material->ShouldCreateBackSides() )
-			{
-			
-				tris->indexes[tris->numIndexes++] = tris->numVerts - 2;
-				tris->indexes[tris->numIndexes++] = tris->numVerts - 3;
-				tris->indexes[tris->numIndexes++] = tris->numVerts - 1;
-			}
-		}
+		tris->numVerts += EmitShardTriangles( tris->verts + tris->numVerts, shards[i]->winding, origin, axis, tangents, packedColor );
 		
 		for( k = 0; k < shards[i]->decals.Num(); k++ )
 		{
-			const idWinding& decalWinding = *shards[i]->decals[k];
-			
-			for( j = 2; j < decalWinding.GetNumPoints(); j++ )
-			{
-			
-				v = &decalTris->verts[decalTris->numVerts++];
-				v->Clear();
-				v->xyz = origin + decalWinding[0].ToVec3() * axis;
-				v->SetTexCoord( decalWinding[0].s, decalWinding[0].t );
-				v->SetNormal( tangents[0] );
-				v->SetTangent( tangents[1] );
-				v->SetBiTangent( tangents[2] );
-				v->SetColor( packedColor );
-				
-				v = &decalTris->verts[decalTris->numVerts++];
-				v->Clear();
-				v->xyz = origin + decalWinding[j - 1].ToVec3() * axis;
-				v->SetTexCoord( decalWinding[j - 1].s, decalWinding[j - 1].t );
-				v->SetNormal( tangents[0] );
-				v->SetTangent( tangents[1] );
-				v->SetBiTangent( tangents[2] );
-				v->SetColor( packedColor );
-				
-				v = &decalTris->verts[decalTris->numVerts++];
-				v->Clear();
-				v->xyz = origin + decalWinding[j].ToVec3() * axis;
-				v->SetTexCoord( decalWinding[j].s, decalWinding[j].t );
-				v->SetNormal( tangents[0] );
-				v->SetTangent( tangents[1] );
-				v->SetBiTangent( tangents[2] );
-				v->SetColor( packedColor );
-				
-				decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 3;
-				decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 2;
-				decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 1;
-				
-				if( decalMaterial->ShouldCreateBackSides() )
-				{
-				
-					decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 2;
-					decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 3;
-					decalTris->indexes[decalTris->numIndexes++] = decalTris->numVerts - 1;
-				}
-			}
+			decalTris->numVerts += EmitShardTriangles( decalTris->verts + decalTris->numVerts, *shards[i]->decals[k], origin, axis, tangents, packedColor );
 		}
 	}
 	
+	EmitShardIndexes( tris, material->ShouldCreateBackSides() );
+	EmitShardIndexes( decalTris, decalMaterial->ShouldCreateBackSides() );
+	
 	tris->tangentsCalculated = true;
 	decalTris->tangentsCalculated = true;
 	
-	SIMDProcessor->MinMax( tris->bounds[0], tris->bounds[1], tris->verts, tris->numVerts );
-	SIMDProcessor->MinMax( decalTris->bounds[0], decalTris->bounds[1], decalTris->verts, decalTris->numVerts );
+	SIMDProcessor->MinMax( tris->bounds[0], tris->bounds[1], tris->verts + staticShardVerts.Num(), tris->numVerts - staticShardVerts.Num() );
+	SIMDProcessor->MinMax( decalTris->bounds[0], decalTris->bounds[1], decalTris->verts + staticDecalVerts.Num(), decalTris->numVerts - staticDecalVerts.Num() );
+	tris->bounds.AddBounds( staticShardBounds );
+	decalTris->bounds.AddBounds( staticDecalBounds );
 	
 	memset( &surface, 0, sizeof( surface ) );
 	surface.shader = material;
@@ -687,6 +770,8 @@ idBrittleFracture::ApplyImpulse
 void idBrittleFracture::ApplyImpulse( idEntity* ent, int id, const idVec3& point, const idVec3& impulse )
 {
 
+	FinishFractures();
+	
 	if( id < 0 || id >= shards.Num() )
 	{
 		return;
@@ -710,6 +795,8 @@ idBrittleFracture::AddForce
 void idBrittleFracture::AddForce( idEntity* ent, int id, const idVec3& point, const idVec3& force )
 {
 
+	FinishFractures();
+	
 	if( id < 0 || id >= shards.Num() )
 	{
 		return;
@@ -739,6 +826,8 @@ void idBrittleFracture::ProjectDecal( const idVec3& point, const idVec3& dir, co
 	idMat3 axis, axistemp;
 	idPlane textureAxis[2];
 	
+	FinishFractures();
+	
 	if( common->IsServer() )
 	{
 		idBitMsg	msg;
@@ -846,6 +935,11 @@ void idBrittleFracture::ProjectDecal( const idVec3& point, const idVec3& dir, co
 			( *decal )[j].s = st[j].x;
 			( *decal )[j].t = st[j].y;
 		}
+		
+		if( shards[i]->droppedTime == -1 )
+		{
+			staticShardsChanged = true;
+		}
 	}
 	
 	BecomeActive( TH_UPDATEVISUALS );
@@ -893,6 +987,7 @@ void idBrittleFracture::DropShard( shard_t* shard, const idVec3& point, const id
 	
 	// set the dropped time for fading
 	shard->droppedTime = time;
+	staticShardsChanged = true;
 	
 	dir2 = origin - point;
 	dist = dir2.Normalize();
@@ -929,6 +1024,8 @@ void idBrittleFracture::Shatter( const idVec3& point, const idVec3& impulse, con
 	shard_t* shard;
 	float m;
 	
+	FinishFractures();
+	
 	if( common->IsServer() )
 	{
 		idBitMsg	msg;
@@ -1084,6 +1181,8 @@ idBrittleFracture::Break
 */
 void idBrittleFracture::Break()
 {
+	FinishFractures();
+	
 	fl.takedamage = false;
 	physicsObj.SetContents( CONTENTS_RENDERMODEL | CONTENTS_TRIGGER );
 }
@@ -1129,10 +1228,10 @@ static float fractureSplitTable[] = { 1365.123f, 5.324f, 1125.34f, 50.34f, 555.2
 
 /*
 ================
-idBrittleFracture::Fracture_r
+Fracture_r
 ================
 */
-void idBrittleFracture::Fracture_r( idFixedWinding& w, idRandom2& random )
+static void Fracture_r( fractureJob_t* job, idFixedWinding& w, idRandom2& random )
 {
 	int i, j, bestPlane;
 	float a, c, s, dist, bestDist;
@@ -1140,23 +1239,21 @@ void idBrittleFracture::Fracture_r( idFixedWinding& w, idRandom2& random )
 	idPlane windingPlane, splitPlanes[2];
 	idMat3 axis, axistemp;
 	idFixedWinding back;
-	idTraceModel trm;
-	idClipModel* clipModel;
-	
+	fractureShard_t* shard;
 	
 	while( 1 )
 	{
 		origin = w.GetCenter();
 		w.GetPlane( windingPlane );
 		
-		if( w.GetArea() < maxShardArea )
+		if( w.GetArea() < job->maxShardArea )
 		{
 			break;
 		}
 		
 		// randomly create a split plane
 		axis[2] = windingPlane.Normal();
-		if( isXraySurface )
+		if( job->isXraySurface )
 		{
 			a = idMath::TWO_PI / 2.f;
 		}
@@ -1195,7 +1292,7 @@ void idBrittleFracture::Fracture_r( idFixedWinding& w, idRandom2& random )
 		}
 		
 		// recursively create shards for the back winding
-		Fracture_r( back, random );
+		Fracture_r( job, back, random );
 	}
 	
 	// translate the winding to it's center
@@ -1206,17 +1303,130 @@ void idBrittleFracture::Fracture_r( idFixedWinding& w, idRandom2& random )
 	}
 	w.RemoveEqualPoints();
 	
-	trm.SetupPolygon( w );
-	trm.Shrink( CM_CLIP_EPSILON );
-	clipModel = new( TAG_PHYSICS ) idClipModel( trm, false );
+	shard = new( TAG_PHYSICS_BRITTLE ) fractureShard_t;
+	shard->winding = w;
+	shard->origin = job->origin + origin;
+	shard->edgeHasNeighbour.AssureSize( w.GetNumPoints(), false );
+	shard->atEdge = false;
+	job->shards.Append( shard );
+}
+
+/*
+================
+FindNeighbours
+================
+*/
+static void FindNeighbours( fractureJob_t* job )
+{
+	int i, j, k, l;
+	idVec3 p1, p2, dir;
+	idMat3 axis;
+	idPlane plane[4];
+	const idMat3& shardAxis = job->axis;
+	
+	for( i = 0; i < job->shards.Num(); i++ )
+	{
 	
-	physicsObj.SetClipModel( clipModel, 1.0f, shards.Num() );
-	physicsObj.SetOrigin( GetPhysics()->GetOrigin() + origin, shards.Num() );
-	physicsObj.SetAxis( GetPhysics()->GetAxis(), shards.Num() );
+		fractureShard_t* shard1 = job->shards[i];
+		const idWinding& w1 = shard1->winding;
+		const idVec3& origin1 = shard1->origin;
+		
+		for( k = 0; k < w1.GetNumPoints(); k++ )
+		{
+		
+			p1 = origin1 + w1[k].ToVec3() * shardAxis;
+			p2 = origin1 + w1[( k + 1 ) % w1.GetNumPoints()].ToVec3() * shardAxis;
+			dir = p2 - p1;
+			dir.Normalize();
+			axis = dir.ToMat3();
+			
+			plane[0].SetNormal( dir );
+			plane[0].FitThroughPoint( p1 );
+			plane[1].SetNormal( -dir );
+			plane[1].FitThroughPoint( p2 );
+			plane[2].SetNormal( axis[1] );
+			plane[2].FitThroughPoint( p1 );
+			plane[3].SetNormal( axis[2] );
+			plane[3].FitThroughPoint( p1 );
+			
+			for( j = 0; j < job->shards.Num(); j++ )
+			{
+			
+				if( i == j )
+				{
+					continue;
+				}
+				
+				if( shard1->neighbours.FindIndex( j ) != -1 )
+				{
+					continue;
+				}
+				
+				fractureShard_t* shard2 = job->shards[j];
+				const idWinding& w2 = shard2->winding;
+				const idVec3& origin2 = shard2->origin;
+				
+				for( l = w2.GetNumPoints() - 1; l >= 0; l-- )
+				{
+					p1 = origin2 + w2[l].ToVec3() * shardAxis;
+					p2 = origin2 + w2[( l - 1 + w2.GetNumPoints() ) % w2.GetNumPoints()].ToVec3() * shardAxis;
+					if( plane[0].Side( p2, 0.1f ) == SIDE_FRONT && plane[1].Side( p1, 0.1f ) == SIDE_FRONT )
+					{
+						if( plane[2].Side( p1, 0.1f ) == SIDE_ON && plane[3].Side( p1, 0.1f ) == SIDE_ON )
+						{
+							if( plane[2].Side( p2, 0.1f ) == SIDE_ON && plane[3].Side( p2, 0.1f ) == SIDE_ON )
+							{
+								shard1->neighbours.Append( j );
+								shard1->edgeHasNeighbour[k] = true;
+								shard2->neighbours.Append( i );
+								shard2->edgeHasNeighbour[( l - 1 + w2.GetNumPoints() ) % w2.GetNumPoints()] = true;
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+		
+		for( k = 0; k < w1.GetNumPoints(); k++ )
+		{
+			if( !shard1->edgeHasNeighbour[k] )
+			{
+				break;
+			}
+		}
+		if( k < w1.GetNumPoints() )
+		{
+			shard1->atEdge = true;
+		}
+		else
+		{
+			shard1->atEdge = false;
+		}
+	}
+}
+
+/*
+================
+BrittleFractureJob
+
+Splits the polygons of the render model into shards and connects the neighbours,
+only touches the job so it can run on any thread
+================
+*/
+static void BrittleFractureJob( fractureJob_t* job )
+{
+	for( int i = 0; i < job->polygons.Num(); i++ )
+	{
+		idRandom2 random( job->seed );
+		Fracture_r( job, *job->polygons[i], random );
+	}
 	
-	AddShard( clipModel, w );
+	FindNeighbours( job );
 }
 
+REGISTER_PARALLEL_JOB( BrittleFractureJob, "BrittleFractureJob" );
+
 /*
 ================
 CompareVec5
@@ -1236,6 +1446,9 @@ bool CompareVec5( const idVec5& v0, const idVec5& v1 )
 /*
 ================
 idBrittleFracture::CreateFractures
+
+Gathers the polygons of the render model and queues the shard generation,
+the shards are created by ApplyFractures once the job has finished
 ================
 */
 void idBrittleFracture::CreateFractures( const idRenderModel* renderModel )
@@ -1252,20 +1465,25 @@ void idBrittleFracture::CreateFractures( const idRenderModel* renderModel )
 	const modelSurface_t* surf = renderModel->Surface( 0 );
 	material = surf->shader;
 	
-	idMat3 physAxis;
-	physAxis = physicsObj.GetAxis();
+	assert( fractureJob == NULL && shards.Num() == 0 );
+	fractureJob = new( TAG_PHYSICS_BRITTLE ) fractureJob_t;
+	fractureJob->origin = GetPhysics()->GetOrigin();
+	fractureJob->axis = GetPhysics()->GetAxis();
+	fractureJob->maxShardArea = maxShardArea;
+	fractureJob->isXraySurface = isXraySurface;
+	fractureJob->seed = entityNumber;
+	
 	if( isXraySurface )
 	{
-		idFixedWinding w;
+		idFixedWinding* w = new( TAG_PHYSICS_BRITTLE ) idFixedWinding;
 		
 		for( int i = 0; i < 4; i++ )
 		{
 			const idDrawVert* v = &surf->geometry->verts[i];
-			w.AddPoint( idVec5( v->xyz, v->GetTexCoord() ) );
+			w->AddPoint( idVec5( v->xyz, v->GetTexCoord() ) );
 		}
 		
-		idRandom2 random( entityNumber );
-		Fracture_r( w , random );
+		fractureJob->polygons.Append( w );
 		
 	}
 	else
@@ -1323,117 +1541,89 @@ void idBrittleFracture::CreateFractures( const idRenderModel* renderModel )
 				}
 			}
 			
-			idRandom2 random( entityNumber );
-			Fracture_r( w, random );
+			fractureJob->polygons.Append( new( TAG_PHYSICS_BRITTLE ) idFixedWinding( w ) );
 		}
 	}
 	
-	
-	physicsObj.SetContents( material->GetContentFlags() );
-	SetPhysics( &physicsObj );
+	if( g_fractureJobs.GetBool() )
+	{
+		gameLocal.AddFractureJob( this, ( jobRun_t )BrittleFractureJob, fractureJob );
+	}
+	else
+	{
+		BrittleFractureJob( fractureJob );
+		ApplyFractures();
+	}
 }
 
 /*
 ================
-idBrittleFracture::FindNeighbours
+idBrittleFracture::ApplyFractures
 ================
 */
-void idBrittleFracture::FindNeighbours()
+void idBrittleFracture::ApplyFractures()
 {
-	int i, j, k, l;
-	idVec3 p1, p2, dir;
-	idMat3 axis;
-	idPlane plane[4];
+	int i, j;
+	idTraceModel trm;
+	idClipModel* clipModel;
 	
-	for( i = 0; i < shards.Num(); i++ )
+	if( fractureJob == NULL )
 	{
+		return;
+	}
 	
-		shard_t* shard1 = shards[i];
-		const idWinding& w1 = shard1->winding;
-		const idVec3& origin1 = shard1->clipModel->GetOrigin();
-		const idMat3& axis1 = shard1->clipModel->GetAxis();
+	for( i = 0; i < fractureJob->shards.Num(); i++ )
+	{
+		fractureShard_t* fs = fractureJob->shards[i];
 		
-		for( k = 0; k < w1.GetNumPoints(); k++ )
-		{
+		trm.SetupPolygon( fs->winding );
+		trm.Shrink( CM_CLIP_EPSILON );
+		clipModel = new( TAG_PHYSICS ) idClipModel( trm, false );
 		
-			p1 = origin1 + w1[k].ToVec3() * axis1;
-			p2 = origin1 + w1[( k + 1 ) % w1.GetNumPoints()].ToVec3() * axis1;
-			dir = p2 - p1;
-			dir.Normalize();
-			axis = dir.ToMat3();
-			
-			plane[0].SetNormal( dir );
-			plane[0].FitThroughPoint( p1 );
-			plane[1].SetNormal( -dir );
-			plane[1].FitThroughPoint( p2 );
-			plane[2].SetNormal( axis[1] );
-			plane[2].FitThroughPoint( p1 );
-			plane[3].SetNormal( axis[2] );
-			plane[3].FitThroughPoint( p1 );
-			
-			for( j = 0; j < shards.Num(); j++ )
-			{
-			
-				if( i == j )
-				{
-					continue;
-				}
-				
-				shard_t* shard2 = shards[j];
-				
-				for( l = 0; l < shard1->neighbours.Num(); l++ )
-				{
-					if( shard1->neighbours[l] == shard2 )
-					{
-						break;
-					}
-				}
-				if( l < shard1->neighbours.Num() )
-				{
-					continue;
-				}
-				
-				const idWinding& w2 = shard2->winding;
-				const idVec3& origin2 = shard2->clipModel->GetOrigin();
-				const idMat3& axis2 = shard2->clipModel->GetAxis();
-				
-				for( l = w2.GetNumPoints() - 1; l >= 0; l-- )
-				{
-					p1 = origin2 + w2[l].ToVec3() * axis2;
-					p2 = origin2 + w2[( l - 1 + w2.GetNumPoints() ) % w2.GetNumPoints()].ToVec3() * axis2;
-					if( plane[0].Side( p2, 0.1f ) == SIDE_FRONT && plane[1].Side( p1, 0.1f ) == SIDE_FRONT )
-					{
-						if( plane[2].Side( p1, 0.1f ) == SIDE_ON && plane[3].Side( p1, 0.1f ) == SIDE_ON )
-						{
-							if( plane[2].Side( p2, 0.1f ) == SIDE_ON && plane[3].Side( p2, 0.1f ) == SIDE_ON )
-							{
-								shard1->neighbours.Append( shard2 );
-								shard1->edgeHasNeighbour[k] = true;
-								shard2->neighbours.Append( shard1 );
-								shard2->edgeHasNeighbour[( l - 1 + w2.GetNumPoints() ) % w2.GetNumPoints()] = true;
-								break;
-							}
-						}
-					}
-				}
-			}
-		}
+		physicsObj.SetClipModel( clipModel, 1.0f, shards.Num() );
+		physicsObj.SetOrigin( fs->origin, shards.Num() );
+		physicsObj.SetAxis( fractureJob->axis, shards.Num() );
 		
-		for( k = 0; k < w1.GetNumPoints(); k++ )
-		{
-			if( !shard1->edgeHasNeighbour[k] )
-			{
-				break;
-			}
-		}
-		if( k < w1.GetNumPoints() )
-		{
-			shard1->atEdge = true;
-		}
-		else
+		AddShard( clipModel, fs->winding );
+	}
+	
+	// the job links the neighbours by index
+	for( i = 0; i < fractureJob->shards.Num(); i++ )
+	{
+		fractureShard_t* fs = fractureJob->shards[i];
+		shard_t* shard = shards[i];
+		
+		for( j = 0; j < fs->neighbours.Num(); j++ )
 		{
-			shard1->atEdge = false;
+			shard->neighbours.Append( shards[fs->neighbours[j]] );
 		}
+		shard->edgeHasNeighbour = fs->edgeHasNeighbour;
+		shard->atEdge = fs->atEdge;
+	}
+	
+	fractureJob->polygons.DeleteContents( true );
+	fractureJob->shards.DeleteContents( true );
+	delete fractureJob;
+	fractureJob = NULL;
+	
+	staticShardsChanged = true;
+	
+	physicsObj.SetContents( material->GetContentFlags() );
+	SetPhysics( &physicsObj );
+}
+
+/*
+================
+idBrittleFracture::FinishFractures
+
+Makes sure the shards exist before anything looks at them
+================
+*/
+void idBrittleFracture::FinishFractures()
+{
+	if( fractureJob != NULL )
+	{
+		gameLocal.FinishFractureJobs();
 	}
 }
 
@@ -53,6 +53,29 @@ typedef struct shard_s
 	int							islandNum;
 } shard_t;
 
+// shard generation is pure geometry, it runs on the job threads and is applied to the entity the next frame
+typedef struct fractureShard_s
+{
+	idFixedWinding				winding;			// translated to the shard origin
+	idVec3						origin;				// world space shard origin
+	idList<int>					neighbours;
+	idList<bool>				edgeHasNeighbour;
+	bool						atEdge;
+} fractureShard_t;
+
+typedef struct fractureJob_s
+{
+	// input
+	idList<idFixedWinding*>		polygons;
+	idVec3						origin;
+	idMat3						axis;
+	float						maxShardArea;
+	bool						isXraySurface;
+	int							seed;
+	// output
+	idList<fractureShard_t*>	shards;
+} fractureJob_t;
+
 
 class idBrittleFracture : public idEntity
 {
@@ -78,6 +101,9 @@ public:
 	void						ProjectDecal( const idVec3& point, const idVec3& dir, const int time, const char* damageDefName );
 	bool						IsBroken() const;
 	
+	// creates the shards from a finished fracture job, called by idGameLocal::FinishFractureJobs
+	void						ApplyFractures();
+	
 	enum
 	{
 		EVENT_PROJECT_DECAL = idEntity::EVENT_MAXEVENTS,
@@ -121,12 +147,24 @@ private:
 	idList<shard_t*, TAG_PHYSICS_BRITTLE>	shards;
 	idBounds					bounds;
 	bool						disableFracture;
+	fractureJob_t* 				fractureJob;		// shards still being generated
 	
 	// for rendering
 	mutable int					lastRenderEntityUpdate;
 	mutable bool				changed;
 	
+	// geometry of the shards that are still in place, only re-emitted when they change
+	mutable bool				staticShardsChanged;
+	mutable dword				staticColor;
+	mutable idVec3				staticOrigin;
+	mutable idMat3				staticAxis;
+	mutable idList<idDrawVert, TAG_PHYSICS_BRITTLE>	staticShardVerts;
+	mutable idList<idDrawVert, TAG_PHYSICS_BRITTLE>	staticDecalVerts;
+	mutable idBounds			staticShardBounds;
+	mutable idBounds			staticDecalBounds;
+	
 	bool						UpdateRenderEntity( renderEntity_s* renderEntity, const renderView_t* renderView ) const;
+	void						UpdateStaticGeometry( const dword packedColor ) const;
 	static bool					ModelCallback( renderEntity_s* renderEntity, const renderView_t* renderView );
 	
 	void						AddShard( idClipModel* clipModel, idFixedWinding& w );
@@ -135,9 +173,8 @@ private:
 	void						Shatter( const idVec3& point, const idVec3& impulse, const int time );
 	void						DropFloatingIslands( const idVec3& point, const idVec3& impulse, const int time );
 	void						Break();
-	void						Fracture_r( idFixedWinding& w, idRandom2& random );
 	void						CreateFractures( const idRenderModel* renderModel );
-	void						FindNeighbours();
+	void						FinishFractures();
 	
 	void						Event_Activate( idEntity* activator );
 	void						Event_Touch( idEntity* other, trace_t* trace );
@@ -247,6 +247,36 @@ void AddRenderGui( const char* name, idUserInterface** gui, const idDict* args )
 	UpdateGuiParms( *gui, args );
 }
 
+// spawnArgs parsed for every entity go through pre-hashed key handles
+static const idDictKey spawnKey_model( "model" );
+static const idDictKey spawnKey_skin( "skin" );
+static const idDictKey spawnKey_shader( "shader" );
+static const idDictKey spawnKey_origin( "origin" );
+static const idDictKey spawnKey_angle( "angle" );
+static const idDictKey spawnKey_color( "_color" );
+static const idDictKey spawnKey_shaderParms[] =
+{
+	idDictKey( "shaderParm3" ), idDictKey( "shaderParm4" ), idDictKey( "shaderParm5" ),
+	idDictKey( "shaderParm6" ), idDictKey( "shaderParm7" ), idDictKey( "shaderParm8" ),
+	idDictKey( "shaderParm9" ), idDictKey( "shaderParm10" ), idDictKey( "shaderParm11" )
+};
+static const idDictKey spawnKey_noDynamicInteractions( "noDynamicInteractions" );
+static const idDictKey spawnKey_noshadows( "noshadows" );
+static const idDictKey spawnKey_noselfshadows( "noselfshadows" );
+static const idDictKey spawnKey_minDistance( "s_mindistance" );
+static const idDictKey spawnKey_maxDistance( "s_maxdistance" );
+static const idDictKey spawnKey_volume( "s_volume" );
+static const idDictKey spawnKey_shakes( "s_shakes" );
+static const idDictKey spawnKey_diversity( "s_diversity" );
+static const idDictKey spawnKey_waitForTrigger( "s_waitfortrigger" );
+static const idDictKey spawnKey_omni( "s_omni" );
+static const idDictKey spawnKey_looping( "s_looping" );
+static const idDictKey spawnKey_occlusion( "s_occlusion" );
+static const idDictKey spawnKey_global( "s_global" );
+static const idDictKey spawnKey_unclamped( "s_unclamped" );
+static const idDictKey spawnKey_soundClass( "s_soundClass" );
+static const idDictKey spawnKey_soundShader( "s_shader" );
+
 /*
 ================
 idGameEdit::ParseSpawnArgsToRenderEntity
@@ -266,7 +296,7 @@ void idGameEdit::ParseSpawnArgsToRenderEntity( const idDict* args, renderEntity_
 	
 	memset( renderEntity, 0, sizeof( *renderEntity ) );
 	
-	temp = args->GetString( "model" );
+	temp = args->GetString( spawnKey_model );
 	
 	modelDef = NULL;
 	if( temp[0] != '\0' )
@@ -290,7 +320,7 @@ void idGameEdit::ParseSpawnArgsToRenderEntity( const idDict* args, renderEntity_
 		renderEntity->bounds.Zero();
 	}
 	
-	temp = args->GetString( "skin" );
+	temp = args->GetString( spawnKey_skin );
 	if( temp[0] != '\0' )
 	{
 		renderEntity->customSkin = declManager->FindSkin( temp );
@@ -300,18 +330,18 @@ void idGameEdit::ParseSpawnArgsToRenderEntity( const idDict* args, renderEntity_
 		renderEntity->customSkin = modelDef->GetDefaultSkin();
 	}
 	
-	temp = args->GetString( "shader" );
+	temp = args->GetString( spawnKey_shader );
 	if( temp[0] != '\0' )
 	{
 		renderEntity->customShader = declManager->FindMaterial( temp );
 	}
 	
-	args->GetVector( "origin", "0 0 0", renderEntity->origin );
+	renderEntity->origin = args->GetVector( spawnKey_origin );
 	
 	// get the rotation matrix in either full form, or single angle form
 	if( !args->GetMatrix( "rotation", "1 0 0 0 1 0 0 0 1", renderEntity->axis ) )
 	{
-		angle = args->GetFloat( "angle" );
+		angle = args->GetFloat( spawnKey_angle );
 		if( angle != 0.0f )
 		{
 			renderEntity->axis = idAngles( 0.0f, angle, 0.0f ).ToMat3();
@@ -325,28 +355,24 @@ void idGameEdit::ParseSpawnArgsToRenderEntity( const idDict* args, renderEntity_
 	renderEntity->referenceSound = NULL;
 	
 	// get shader parms
-	args->GetVector( "_color", "1 1 1", color );
+	color = args->GetVector( spawnKey_color, "1 1 1" );
 	renderEntity->shaderParms[ SHADERPARM_RED ]		= color[0];
 	renderEntity->shaderParms[ SHADERPARM_GREEN ]	= color[1];
 	renderEntity->shaderParms[ SHADERPARM_BLUE ]	= color[2];
-	renderEntity->shaderParms[ 3 ]					= args->GetFloat( "shaderParm3", "1" );
-	renderEntity->shaderParms[ 4 ]					= args->GetFloat( "shaderParm4", "0" );
-	renderEntity->shaderParms[ 5 ]					= args->GetFloat( "shaderParm5", "0" );
-	renderEntity->shaderParms[ 6 ]					= args->GetFloat( "shaderParm6", "0" );
-	renderEntity->shaderParms[ 7 ]					= args->GetFloat( "shaderParm7", "0" );
-	renderEntity->shaderParms[ 8 ]					= args->GetFloat( "shaderParm8", "0" );
-	renderEntity->shaderParms[ 9 ]					= args->GetFloat( "shaderParm9", "0" );
-	renderEntity->shaderParms[ 10 ]					= args->GetFloat( "shaderParm10", "0" );
-	renderEntity->shaderParms[ 11 ]					= args->GetFloat( "shaderParm11", "0" );
+	renderEntity->shaderParms[ 3 ]					= args->GetFloat( spawnKey_shaderParms[0], 1.0f );
+	for( i = 4; i < 12; i++ )
+	{
+		renderEntity->shaderParms[ i ]				= args->GetFloat( spawnKey_shaderParms[i - 3] );
+	}
 	
 	// check noDynamicInteractions flag
-	renderEntity->noDynamicInteractions = args->GetBool( "noDynamicInteractions" );
+	renderEntity->noDynamicInteractions = args->GetBool( spawnKey_noDynamicInteractions );
 	
 	// check noshadows flag
-	renderEntity->noShadow = args->GetBool( "noshadows" );
+	renderEntity->noShadow = args->GetBool( spawnKey_noshadows );
 	
 	// check noselfshadows flag
-	renderEntity->noSelfShadow = args->GetBool( "noselfshadows" );
+	renderEntity->noSelfShadow = args->GetBool( spawnKey_noselfshadows );
 	
 	// init any guis, including entity-specific states
 	for( i = 0; i < MAX_RENDERENTITY_GUI; i++ )
@@ -374,44 +400,44 @@ void idGameEdit::ParseSpawnArgsToRefSound( const idDict* args, refSound_t* refSo
 	
 	memset( refSound, 0, sizeof( *refSound ) );
 	
-	refSound->parms.minDistance = args->GetFloat( "s_mindistance" );
-	refSound->parms.maxDistance = args->GetFloat( "s_maxdistance" );
-	refSound->parms.volume = args->GetFloat( "s_volume" );
-	refSound->parms.shakes = args->GetFloat( "s_shakes" );
+	refSound->parms.minDistance = args->GetFloat( spawnKey_minDistance );
+	refSound->parms.maxDistance = args->GetFloat( spawnKey_maxDistance );
+	refSound->parms.volume = args->GetFloat( spawnKey_volume );
+	refSound->parms.shakes = args->GetFloat( spawnKey_shakes );
 	
-	args->GetVector( "origin", "0 0 0", refSound->origin );
+	refSound->origin = args->GetVector( spawnKey_origin );
 	
 	refSound->referenceSound  = NULL;
 	
 	// if a diversity is not specified, every sound start will make
 	// a random one.  Specifying diversity is usefull to make multiple
 	// lights all share the same buzz sound offset, for instance.
-	refSound->diversity = args->GetFloat( "s_diversity", "-1" );
-	refSound->waitfortrigger = args->GetBool( "s_waitfortrigger" );
+	refSound->diversity = args->GetFloat( spawnKey_diversity, -1.0f );
+	refSound->waitfortrigger = args->GetBool( spawnKey_waitForTrigger );
 	
-	if( args->GetBool( "s_omni" ) )
+	if( args->GetBool( spawnKey_omni ) )
 	{
 		refSound->parms.soundShaderFlags |= SSF_OMNIDIRECTIONAL;
 	}
-	if( args->GetBool( "s_looping" ) )
+	if( args->GetBool( spawnKey_looping ) )
 	{
 		refSound->parms.soundShaderFlags |= SSF_LOOPING;
 	}
-	if( args->GetBool( "s_occlusion" ) )
+	if( args->GetBool( spawnKey_occlusion ) )
 	{
 		refSound->parms.soundShaderFlags |= SSF_NO_OCCLUSION;
 	}
-	if( args->GetBool( "s_global" ) )
+	if( args->GetBool( spawnKey_global ) )
 	{
 		refSound->parms.soundShaderFlags |= SSF_GLOBAL;
 	}
-	if( args->GetBool( "s_unclamped" ) )
+	if( args->GetBool( spawnKey_unclamped ) )
 	{
 		refSound->parms.soundShaderFlags |= SSF_UNCLAMPED;
 	}
-	refSound->parms.soundClass = args->GetInt( "s_soundClass" );
+	refSound->parms.soundClass = args->GetInt( spawnKey_soundClass );
 	
-	temp = args->GetString( "s_shader" );
+	temp = args->GetString( spawnKey_soundShader );
 	if( temp[0] != '\0' )
 	{
 		refSound->shader = declManager->FindSound( temp );
@@ -613,6 +639,7 @@ void idEntity::Spawn()
 	{
 		fl.networkSync = ( atoi( networkSync->GetValue() ) != 0 );
 	}
+	fl.networkAlwaysRelevant = spawnArgs.GetBool( "net_alwaysRelevant", "0" );
 	
 #if 0
 	if( !common->IsClient() )
@@ -238,6 +238,7 @@ public:
 		bool				networkSync			: 1;	// if true the entity is synchronized over the network
 		bool				grabbed				: 1;	// if true object is currently being grabbed
 		bool				skipReplication		: 1;	// don't replicate this entity over the network.
+		bool				networkAlwaysRelevant : 1;	// if true the entity is sent to all clients, even outside of their PVS
 	} fl;
 	
 	int						timeGroup;
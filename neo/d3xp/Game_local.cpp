@@ -75,6 +75,9 @@ const char* idGameLocal::sufaceTypeNames[ MAX_SURFACE_TYPES ] =
 
 idCVar net_usercmd_timing_debug( "net_usercmd_timing_debug", "0", CVAR_BOOL, "Print messages about usercmd timing." );
 
+// more fractures than this in one frame are finished right away
+static const int MAX_FRACTURE_JOBS = 256;
+
 beam_t::beam_t()
 	: modelHandle( -1 )
 {
@@ -228,6 +231,9 @@ void idGameLocal::Clear()
 	sessionCommand.Clear();
 	locationEntities = NULL;
 	smokeParticles = NULL;
+	projectileManager = NULL;
+	fractureJobList = NULL;
+	pendingFractures.Clear();
 	editEntities = NULL;
 	entityHash.Clear( 1024, MAX_GENTITIES );
 	inCinematic = false;
@@ -349,6 +355,9 @@ void idGameLocal::Init()
 	program.Startup( SCRIPT_DEFAULT );
 	
 	smokeParticles = new( TAG_PARTICLE ) idSmokeParticles;
+	projectileManager = new( TAG_PROJECTILE ) idProjectileManager;
+	
+	fractureJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_FRACTURE_JOBS, 0, NULL );
 	
 	// set up the aas
 	dict = FindEntityDefDict( "aas_types" );
@@ -412,6 +421,15 @@ void idGameLocal::Shutdown()
 	delete smokeParticles;
 	smokeParticles = NULL;
 	
+	delete projectileManager;
+	projectileManager = NULL;
+	
+	if( fractureJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( fractureJobList );
+		fractureJobList = NULL;
+	}
+	
 	idClass::Shutdown();
 	
 	// clear list with forces
@@ -477,6 +495,9 @@ void idGameLocal::SaveGame( idFile* f, idFile* strings )
 		}
 	}
 	
+	// pooled projectiles aren't entities, give them one so they are saved
+	projectileManager->MaterializeAll();
+	
 	idSaveGame savegame( f, strings, BUILD_NUMBER );
 	
 	if( g_flushSave.GetBool( ) == true )
@@ -963,11 +984,27 @@ void idGameLocal::LoadMap( const char* mapName, int randseed )
 			delete mapFile;
 		}
 		mapFile = new( TAG_GAME ) idMapFile;
-		if( !mapFile->Parse( idStr( mapName ) + ".map" ) )
+
+		// the entity cache has no primitive data, so it can only be used when the
+		// collision models don't have to be built from the map primitives, which
+		// means the .cm or .bcm file has to match the geometry the cache was made from
+		bool cacheLoaded = mapFile->LoadEntityCache( mapName );
+		if( cacheLoaded && !collisionModelManager->HasCollisionModelFile( mapName, mapFile->GetGeometryCRC() ) )
 		{
 			delete mapFile;
-			mapFile = NULL;
-			Error( "Couldn't load %s", mapName );
+			mapFile = new( TAG_GAME ) idMapFile;
+			cacheLoaded = false;
+		}
+		
+		if( !cacheLoaded )
+		{
+			if( !mapFile->Parse( idStr( mapName ) + ".map" ) )
+			{
+				delete mapFile;
+				mapFile = NULL;
+				Error( "Couldn't load %s", mapName );
+			}
+			mapFile->WriteEntityCache();
 		}
 	}
 	mapFileName = mapFile->GetName();
@@ -1081,6 +1118,7 @@ void idGameLocal::LoadMap( const char* mapName, int randseed )
 	
 	// clear the smoke particle free list
 	smokeParticles->Init();
+	projectileManager->Init();
 	
 	common->UpdateLevelLoadPacifier(true,75);
 	
@@ -1151,6 +1189,7 @@ void idGameLocal::LocalMapRestart( )
 	
 	// clear the smoke particle free list
 	smokeParticles->Init();
+	projectileManager->Init();
 	
 	// clear the sound system
 	if( gameSoundWorld )
@@ -1268,6 +1307,9 @@ void idGameLocal::MapPopulate()
 	Printf( "==== Processing events ====\n" );
 	idEvent::ServiceEvents();
 	
+	// let the fracture jobs run while the level load finishes
+	SubmitFractureJobs();
+	
 	// Must set GAME_FPS for script after populating, because some maps run their own scripts
 	// when spawning the world, and GAME_FPS will not be found before then.
 	SetScriptFPS( com_engineHz_latched );
@@ -1605,6 +1647,11 @@ void idGameLocal::MapClear( bool clearClients )
 {
 	int i;
 	
+	if( projectileManager )
+	{
+		projectileManager->Clear();
+	}
+	
 	for( i = ( clearClients ? 0 : MAX_CLIENTS ); i < MAX_GENTITIES; i++ )
 	{
 		delete entities[ i ];
@@ -1640,6 +1687,8 @@ void idGameLocal::MapClear( bool clearClients )
 	
 	delete[] locationEntities;
 	locationEntities = NULL;
+	
+	serverSnapshotCache.Clear();
 }
 
 /*
@@ -1678,6 +1727,11 @@ void idGameLocal::MapShutdown()
 		smokeParticles->Shutdown();
 	}
 	
+	if( projectileManager )
+	{
+		projectileManager->Shutdown();
+	}
+	
 	pvs.Shutdown();
 	
 	common->UpdateLevelLoadPacifier(true, 50);
@@ -2549,6 +2603,7 @@ void idGameLocal::RunEntityThink( idEntity& ent, idUserCmdMgr& userCmdMgr )
 	else
 	{
 		// Non-player entities always run one think.
+		SCOPED_PROFILE_EVENT( ent.GetType()->classname );
 		ent.Think();
 	}
 }
@@ -2570,6 +2625,8 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 	idPlayer*	player;
 	const renderView_t* view;
 	
+	SCOPED_PROFILE_EVENT( "Game::RunFrame" );
+	
 	if( g_recordTrace.GetBool() )
 	{
 		bool result = BeginTraceRecording( "e:\\gametrace.pix2" );
@@ -2659,6 +2716,9 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 		// free old smoke particles
 		smokeParticles->FreeSmokes();
 		
+		// create the shards of the brittle fractures spawned last frame
+		FinishFractureJobs();
+		
 		UpdateBeams();
 
 		// process events on the server
@@ -2730,6 +2790,9 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 			}
 		}
 		
+		// fly the pooled projectiles
+		projectileManager->Think();
+		
 		RunTimeGroup2( cmdMgr );
 		
 		// Run catch-up for any client projectiles.
@@ -2764,13 +2827,17 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 		timer_events.Clear();
 		timer_events.Start();
 		
-		// service any pending events
-		idEvent::ServiceEvents();
-		
-		// service pending fast events
-		SelectTimeGroup( true );
-		idEvent::ServiceFastEvents();
-		SelectTimeGroup( false );
+		{
+			SCOPED_PROFILE_EVENT( "Game::ServiceEvents" );
+			
+			// service any pending events
+			idEvent::ServiceEvents();
+			
+			// service pending fast events
+			SelectTimeGroup( true );
+			idEvent::ServiceFastEvents();
+			SelectTimeGroup( false );
+		}
 		
 		timer_events.Stop();
 		
@@ -2783,6 +2850,8 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 			mpGame.Run();
 		}
 		
+		SubmitFractureJobs();
+		
 		// display how long it took to calculate the current game frame
 		if( g_frametime.GetBool() )
 		{
@@ -3757,6 +3826,12 @@ idEntity* idGameLocal::SpawnEntityType( const idTypeInfo& classdef, const idDict
 	return static_cast<idEntity*>( obj );
 }
 
+static const idDictKey spawnKey_name( "name" );
+static const idDictKey spawnKey_classname( "classname" );
+static const idDictKey spawnKey_slowmo( "slowmo" );
+static const idDictKey spawnKey_spawnclass( "spawnclass" );
+static const idDictKey spawnKey_spawnfunc( "spawnfunc" );
+
 /*
 ===================
 idGameLocal::SpawnEntityDef
@@ -3779,26 +3854,42 @@ bool idGameLocal::SpawnEntityDef( const idDict& args, idEntity** ent, bool setDe
 		*ent = NULL;
 	}
 	
-	spawnArgs = args;
-	
-	if( spawnArgs.GetString( "name", "", &name ) )
+	if( args.GetString( spawnKey_name, "", &name ) )
 	{
 		sprintf( error, " on '%s'", name );
 	}
 	
-	spawnArgs.GetString( "classname", NULL, &classname );
+	args.GetString( spawnKey_classname, NULL, &classname );
 	
 	const idDeclEntityDef* def = FindEntityDef( classname, false );
 	
 	if( !def )
 	{
+		spawnArgs = args;
 		Warning( "Unknown classname '%s'%s.", classname, error.c_str() );
 		return false;
 	}
 	
-	spawnArgs.SetDefaults( &def->dict );
+	// the entityDef keys are referenced instead of copied, only map and code set keys are stored per entity
+	if( &args == &def->dict )
+	{
+		// spawned straight from the entityDef, like projectiles and debris
+		spawnArgs.Clear();
+	}
+	else
+	{
+		spawnArgs = args;
+	}
+	if( def->GetSharedDict() != NULL )
+	{
+		spawnArgs.SetSharedDefaults( def->GetSharedDict() );
+	}
+	else
+	{
+		spawnArgs.SetDefaults( &def->dict );
+	}
 	
-	if( !spawnArgs.FindKey( "slowmo" ) )
+	if( !spawnArgs.FindKey( spawnKey_slowmo ) )
 	{
 		bool slowmo = true;
 		
@@ -3818,7 +3909,7 @@ bool idGameLocal::SpawnEntityDef( const idDict& args, idEntity** ent, bool setDe
 	}
 	
 	// check if we should spawn a class object
-	spawnArgs.GetString( "spawnclass", NULL, &spawn );
+	spawnArgs.GetString( spawnKey_spawnclass, NULL, &spawn );
 	if( spawn )
 	{	
 		cls = idClass::GetClass( spawn );
@@ -3846,7 +3937,7 @@ bool idGameLocal::SpawnEntityDef( const idDict& args, idEntity** ent, bool setDe
 	}
 	
 	// check if we should call a script function to spawn
-	spawnArgs.GetString( "spawnfunc", NULL, &spawn );
+	spawnArgs.GetString( spawnKey_spawnfunc, NULL, &spawn );
 	if( spawn )
 	{
 		const function_t* func = program.FindFunction( spawn );
@@ -4815,6 +4906,68 @@ void idGameLocal::BloodSplat( const idVec3& origin, const idVec3& dir, float siz
 	ProjectDecal( results.endpos, dir, 2.0f * size, true, size, material );
 }
 
+/*
+=============
+idGameLocal::AddFractureJob
+
+Queues the shard generation of a brittle fracture, the entity gets
+its shards when the jobs are finished at the start of the next frame
+=============
+*/
+void idGameLocal::AddFractureJob( idBrittleFracture* ent, jobRun_t function, void* data )
+{
+	if( fractureJobList == NULL )
+	{
+		function( data );
+		ent->ApplyFractures();
+		return;
+	}
+	
+	// a running list can't take new jobs
+	if( fractureJobList->IsSubmitted() || pendingFractures.Num() >= MAX_FRACTURE_JOBS )
+	{
+		FinishFractureJobs();
+	}
+	
+	fractureJobList->AddJob( function, data );
+	pendingFractures.Append( ent );
+}
+
+/*
+=============
+idGameLocal::SubmitFractureJobs
+=============
+*/
+void idGameLocal::SubmitFractureJobs()
+{
+	if( pendingFractures.Num() > 0 && !fractureJobList->IsSubmitted() )
+	{
+		fractureJobList->Submit();
+	}
+}
+
+/*
+=============
+idGameLocal::FinishFractureJobs
+=============
+*/
+void idGameLocal::FinishFractureJobs()
+{
+	if( pendingFractures.Num() == 0 )
+	{
+		return;
+	}
+	
+	SubmitFractureJobs();
+	fractureJobList->Wait();
+	
+	for( int i = 0; i < pendingFractures.Num(); i++ )
+	{
+		pendingFractures[i]->ApplyFractures();
+	}
+	pendingFractures.Clear();
+}
+
 /*
 =============
 idGameLocal::SetCamera
@@ -60,6 +60,8 @@ class idTestModel;
 class idAAS;
 class idAI;
 class idSmokeParticles;
+class idBrittleFracture;
+class idProjectileManager;
 class idEntityFx;
 class idTypeInfo;
 class idProgram;
@@ -339,6 +341,9 @@ public:
 	idMultiplayerGame		mpGame;					// handles rules for standard dm
 	
 	idSmokeParticles* 		smokeParticles;			// global smoke trails
+	idProjectileManager* 	projectileManager;		// pooled projectiles in flight
+	idParallelJobList* 		fractureJobList;		// brittle fracture shard generation
+	idList<idBrittleFracture*>	pendingFractures;	// waiting on fractureJobList to apply their shards
 	idEditEntities* 		editEntities;			// in game editing
 	
 	bool					inCinematic;			// game is playing cinematic (player controls frozen)
@@ -351,6 +356,7 @@ public:
 	
 	gameType_t				gameType;
 	idLinkList<idEntity>	snapshotEntities;		// entities from the last snapshot
+	idSnapShot				serverSnapshotCache;	// states of the last written snapshot, shared by entities that didn't change
 	int						realClientTime;			// real client time
 	bool					isNewFrame;				// true if this is a new game frame, not a rerun due to prediction
 	float					clientSmoothing;		// smoothing of other clients in the view
@@ -553,6 +559,11 @@ public:
 	idPlayer* 				GetLocalPlayer() const;
 	
 	void					SpreadLocations();
+	
+	// brittle fracture shards are generated on the job threads and applied the next frame
+	void					AddFractureJob( idBrittleFracture* ent, jobRun_t function, void* data );
+	void					SubmitFractureJobs();
+	void					FinishFractureJobs();
 	idLocationEntity* 		LocationForPoint( const idVec3& point );	// May return NULL
 	idEntity* 				SelectInitialSpawnPoint( idPlayer* player );
 	
@@ -563,6 +574,7 @@ public:
 	void					SyncPlayersWithLobbyUsers( bool initial );
 	void					ServerWriteInitialReliableMessages( int clientNum, lobbyUserID_t lobbyUserID );
 	void					ServerSendNetworkSyncCvars();
+	uint32					ServerEntityInterest( idEntity* ent, const pvsHandle_t* pvsHandles, idPlayer* const* spectatedPlayers, const uint32* clientVisBits, uint32 allClientVisBits, uint32& lowPriorityMask );
 	
 	virtual void			SetInterpolation( const float fraction, const int serverGameMS, const int ssStartTime, const int ssEndTime );
 	
@@ -1005,6 +1017,7 @@ ID_INLINE SetTimeState::~SetTimeState()
 #include "Misc.h"
 #include "Actor.h"
 #include "Projectile.h"
+#include "ProjectileManager.h"
 #include "Weapon.h"
 #include "PredictedValue.h"
 #include "Inventory.h"
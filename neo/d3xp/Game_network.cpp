@@ -57,6 +57,11 @@ idCVar net_clientSmoothing( "net_clientSmoothing", "0.8", CVAR_GAME | CVAR_FLOAT
 idCVar net_clientSelfSmoothing( "net_clientSelfSmoothing", "0.6", CVAR_GAME | CVAR_FLOAT, "smooth self position if network causes prediction error.", 0.0f, 0.95f );
 extern idCVar net_clientMaxPrediction;
 
+idCVar net_interestManagement( "net_interestManagement", "1", CVAR_GAME | CVAR_BOOL, "only send entities to the clients that can see them or are close to them" );
+idCVar net_interestRadius( "net_interestRadius", "1024", CVAR_GAME | CVAR_FLOAT, "entities closer than this to a client are sent even when they are outside of the client's PVS", 0.0f, 65536.0f );
+idCVar net_snapshotDirtyTracking( "net_snapshotDirtyTracking", "1", CVAR_GAME | CVAR_BOOL, "entities whose snapshot state didn't change share the state buffer of the last snapshot instead of allocating a new one" );
+idCVar net_interestPriorityRadius( "net_interestPriorityRadius", "2048", CVAR_GAME | CVAR_FLOAT, "entities in the PVS but further away than this are low priority and are sent less often when snapshots grow beyond net_optimalSnapDeltaSize", 0.0f, 65536.0f );
+
 idCVar cg_predictedSpawn_debug( "cg_predictedSpawn_debug", "0", CVAR_BOOL, "Debug predictive spawning of presentables" );
 idCVar g_clientFire_checkLineOfSightDebug( "g_clientFire_checkLineOfSightDebug", "0", CVAR_BOOL, "" );
 
@@ -344,6 +349,75 @@ void idGameLocal::SaveEntityNetworkEvent( const idEntity* ent, int eventId, cons
 	savedEventQueue.Enqueue( event, idEventQueue::OUTOFORDER_IGNORE );
 }
 
+/*
+================
+idGameLocal::ServerEntityInterest
+
+  Returns the snapshot vis mask for an entity. Clients get an entity when any part of its physics
+  team is in their PVS or when it is within net_interestRadius, entities in the PVS beyond
+  net_interestPriorityRadius are flagged low priority for that client.
+================
+*/
+uint32 idGameLocal::ServerEntityInterest( idEntity* ent, const pvsHandle_t* pvsHandles, idPlayer* const* spectatedPlayers, const uint32* clientVisBits, uint32 allClientVisBits, uint32& lowPriorityMask )
+{
+	lowPriorityMask = 0;
+	
+	if( !net_interestManagement.GetBool() || ent->fl.networkAlwaysRelevant || allClientVisBits == 0 )
+	{
+		return ~0U;
+	}
+	
+	const float radiusSqr = Square( net_interestRadius.GetFloat() );
+	const float priorityRadiusSqr = Square( net_interestPriorityRadius.GetFloat() );
+	const idVec3& origin = ent->GetPhysics()->GetOrigin();
+	
+	// bits that don't belong to a client are left set
+	uint32 visMask = ~allClientVisBits;
+	uint32 highPriorityMask = 0;
+	
+	for( int i = 0; i < MAX_PLAYERS; i++ )
+	{
+		const uint32 bit = clientVisBits[i];
+		if( bit == 0 || pvsHandles[i].i < 0 )
+		{
+			continue;
+		}
+		idPlayer* spectated = spectatedPlayers[i];
+		
+		// players, their weapons and anything else bound to them always go out at full rate
+		if( ent->entityNumber < MAX_CLIENTS || ent == spectated || ( ent->GetTeamMaster() != NULL && ent->GetTeamMaster() == spectated->GetTeamMaster() ) )
+		{
+			visMask |= bit;
+			highPriorityMask |= bit;
+			continue;
+		}
+		
+		const float distSqr = ( origin - spectated->GetPhysics()->GetOrigin() ).LengthSqr();
+		if( distSqr < radiusSqr )
+		{
+			visMask |= bit;
+			highPriorityMask |= bit;
+		}
+		else if( ent->PhysicsTeamInPVS( pvsHandles[i] ) )
+		{
+			visMask |= bit;
+			if( distSqr < priorityRadiusSqr )
+			{
+				highPriorityMask |= bit;
+			}
+			else
+			{
+				lowPriorityMask |= bit;
+			}
+		}
+	}
+	
+	// split screen players share a peer, the entity is low priority only if it is for all of them
+	lowPriorityMask &= ~highPriorityMask;
+	
+	return visMask;
+}
+
 /*
 ================
 idGameLocal::ServerWriteSnapshot
@@ -392,9 +466,15 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot& ss )
 	
 	// Build PVS data for each player and write their player state to the snapshot as well
 	pvsHandle_t pvsHandles[ MAX_PLAYERS ];
+	idPlayer* spectatedPlayers[ MAX_PLAYERS ];
+	uint32 clientVisBits[ MAX_PLAYERS ];
+	uint32 allClientVisBits = 0;
+	idLobbyBase& lobby = session->GetActingGameStateLobbyBase();
 	for( int i = 0; i < MAX_PLAYERS; i++ )
 	{
 		idPlayer* player = static_cast<idPlayer*>( entities[ i ] );
+		spectatedPlayers[i] = NULL;
+		clientVisBits[i] = 0;
 		if( player == NULL )
 		{
 			pvsHandles[i].i = -1;
@@ -405,6 +485,15 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot& ss )
 		{
 			spectated = static_cast< idPlayer* >( entities[ player->spectator ] );
 		}
+		spectatedPlayers[i] = spectated;
+		
+		// the snapshot vis mask is indexed by peer + 1, local players on the server don't have a bit
+		const int peer = lobby.PeerIndexFromLobbyUser( lobbyUserIDs[i] );
+		if( peer >= 0 && peer + 1 < 32 )
+		{
+			clientVisBits[i] = BIT( peer + 1 );
+			allClientVisBits |= clientVisBits[i];
+		}
 		
 		msg.InitWrite( buffer, sizeof( buffer ) );
 		spectated->WritePlayerStateToSnapshot( msg );
@@ -433,6 +522,7 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot& ss )
 	}
 	
 	// Add all entities to the snapshot
+	const bool dirtyTracking = net_snapshotDirtyTracking.GetBool();
 	for( idEntity* ent = spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() )
 	{
 		if( ent->GetSkipReplication() )
@@ -440,6 +530,9 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot& ss )
 			continue;
 		}
 		
+		uint32 lowPriorityMask = 0;
+		const uint32 visMask = ServerEntityInterest( ent, pvsHandles, spectatedPlayers, clientVisBits, allClientVisBits, lowPriorityMask );
+		
 		msg.InitWrite( buffer, sizeof( buffer ) );
 		msg.WriteBits( spawnIds[ ent->entityNumber ], 32 - GENTITYNUM_BITS );
 		msg.WriteBits( ent->GetType()->typeNum, idClass::GetTypeNumBits() );
@@ -453,7 +546,29 @@ void idGameLocal::ServerWriteSnapshot( idSnapShot& ss )
 			ent->WriteToSnapshot( msg );
 		}
 		
-		ss.S_AddObject( SNAP_ENTITIES + ent->entityNumber, ~0U, msg, ent->GetName() );
+		// the written state decides if the entity changed, so nothing has to mark it dirty. An
+		// unchanged state shares the buffer of the last snapshot, which saves the allocation
+		// here and lets the delta job match it by pointer.
+		idSnapShot::objectState_t* state = NULL;
+		if( dirtyTracking )
+		{
+			state = ss.S_AddObjectFromSnapshot( SNAP_ENTITIES + ent->entityNumber, visMask, serverSnapshotCache, msg.GetReadData(), msg.GetSize() );
+		}
+		if( state == NULL )
+		{
+			state = ss.S_AddObject( SNAP_ENTITIES + ent->entityNumber, visMask, msg, ent->GetName() );
+		}
+		state->lowPriorityMask = lowPriorityMask;
+	}
+	
+	// keep references to the states for the next snapshot
+	if( dirtyTracking )
+	{
+		serverSnapshotCache = ss;
+	}
+	else
+	{
+		serverSnapshotCache.Clear();
 	}
 	
 	// Free PVS handles for all the players
@@ -965,11 +1080,8 @@ void idGameLocal::ClientReadSnapshot( const idSnapShot& ss )
 		{
 			if( ent->entityNumber >= MAX_CLIENTS && ent->entityNumber < mapSpawnCount && !ent->spawnArgs.GetBool( "net_dynamic", "0" ) ) //_D3XP
 			{
-				// server says it's not in PVS
-				// if that happens on map entities, most likely something is wrong
-				// I can see that moving pieces along several PVS could be a legit situation though
-				// this is a band aid, which means something is not done right elsewhere
-				common->DWarning( "map entity 0x%x (%s) is stale", ent->entityNumber, ent->name.c_str() );
+				// server says it's not in PVS or relevance radius (net_interestManagement)
+				// map entities stay where they are until they become relevant again
 			}
 			else
 			{
@@ -1245,6 +1357,12 @@ void idGameLocal::ClientRunFrame( idUserCmdMgr& cmdMgr, bool lastPredictFrame, g
 	fast.Set( time, previousTime, realClientTime );
 
 	DemoWriteGameInfo();
+	
+	// free old smoke particles
+	smokeParticles->FreeSmokes();
+	
+	// create the shards of the brittle fractures spawned last frame
+	FinishFractureJobs();
 
 	// run prediction on all active entities
 	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
@@ -1264,6 +1382,8 @@ void idGameLocal::ClientRunFrame( idUserCmdMgr& cmdMgr, bool lastPredictFrame, g
 	// service any pending events
 	idEvent::ServiceEvents();
 	
+	SubmitFractureJobs();
+	
 	// show any debug info for this frame
 	if( isNewFrame )
 	{
@@ -530,6 +530,38 @@ void idProjectile::Launch( const idVec3& start, const idVec3& dir, const idVec3&
 	state = LAUNCHED;
 }
 
+/*
+=================
+idProjectile::LaunchFromPool
+
+Launches the entity where the pooled projectile is now and continues with its
+current velocity. The collision is handed over when the sweep hit something.
+=================
+*/
+void idProjectile::LaunchFromPool( const idVec3& start, const idVec3& dir, const idVec3& velocity, const float timeSinceFire, const float launchPower, const float dmgPower, const trace_t* collision )
+{
+	Launch( start, dir, vec3_origin, timeSinceFire, launchPower, dmgPower );
+	
+	if( state != LAUNCHED )
+	{
+		return;
+	}
+	
+	// Launch only takes the flight time off the fuse, the remove time has to keep counting too
+	if( spawnArgs.GetFloat( "fuse" ) <= 0.0f && ( !common->IsClient() || fl.skipReplication ) )
+	{
+		CancelEvents( &EV_Remove );
+		PostEventMS( &EV_Remove, Max( spawnArgs.GetInt( "remove_time", "1500" ) - SEC2MS( timeSinceFire ), 0 ) );
+	}
+	
+	physicsObj.SetLinearVelocity( velocity );
+	
+	if( collision != NULL )
+	{
+		Collide( *collision, velocity );
+	}
+}
+
 /*
 ================
 idProjectile::AppendBeamTarget
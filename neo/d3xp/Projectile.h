@@ -57,6 +57,8 @@ public :
 	
 	void					Create( idEntity* owner, const idVec3& start, const idVec3& dir );
 	virtual void			Launch( const idVec3& start, const idVec3& dir, const idVec3& pushVelocity, const float timeSinceFire = 0.0f, const float launchPower = 1.0f, const float dmgPower = 1.0f, const int projNum = 0 );
+	// takes over a projectile that flew in the projectile manager
+	void					LaunchFromPool( const idVec3& start, const idVec3& dir, const idVec3& velocity, const float timeSinceFire, const float launchPower, const float dmgPower, const trace_t* collision );
 	virtual void			FreeLightDef();
 	
 	idEntity* 				GetOwner() const;
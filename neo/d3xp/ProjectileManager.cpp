@@ -0,0 +1,644 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "Game_local.h"
+
+idCVar g_projectilePool( "g_projectilePool", "1", CVAR_GAME | CVAR_BOOL, "fly simple projectiles without spawning entities until they hit something" );
+idCVar g_projectileStats( "g_projectileStats", "0", CVAR_GAME | CVAR_BOOL, "print pooled projectile counts and timings once a second" );
+
+/*
+================
+CanPoolProjectile
+
+Only plain idProjectiles whose flight can be reproduced with a single sweep
+per frame are pooled, everything else needs the entity to think
+================
+*/
+static bool CanPoolProjectile( const idDeclEntityDef* entityDef )
+{
+	const idDict& dict = entityDef->dict;
+	
+	// the subclasses home, guide or spawn debris
+	if( idStr::Icmp( dict.GetString( "spawnclass" ), "idProjectile" ) != 0 )
+	{
+		return false;
+	}
+	
+	// idProjectile::Launch gives this one special contents
+	if( idStr::Icmp( entityDef->GetName(), "projectile_helltime_killer" ) == 0 )
+	{
+		return false;
+	}
+	
+	if( dict.GetFloat( "thrust" ) != 0.0f || dict.GetInt( "health" ) > 0 || dict.GetFloat( "bounce" ) > 0.0f )
+	{
+		return false;
+	}
+	
+	if( dict.GetBool( "touch_triggers" ) || dict.GetBool( "detonate_on_trigger" ) || dict.GetBool( "detonate_on_fuse" ) )
+	{
+		return false;
+	}
+	
+	if( dict.GetBool( "use_trail_beams" ) || dict.GetBool( "tracers" ) )
+	{
+		return false;
+	}
+	
+	// the pool flies on game time, projectiles that ignore slowmo run on real time
+	if( !dict.GetBool( "slowmo", "1" ) )
+	{
+		return false;
+	}
+	
+	// lights and flight sounds are attached to the entity
+	if( dict.GetString( "mtr_light_shader" )[0] != '\0' || dict.GetString( "snd_fly" )[0] != '\0' )
+	{
+		return false;
+	}
+	
+	idAngles angularVelocity;
+	dict.GetAngles( "angular_velocity", "0 0 0", angularVelocity );
+	if( angularVelocity != ang_zero )
+	{
+		return false;
+	}
+	
+	// animated models need joints
+	const char* model = dict.GetString( "model" );
+	if( model[0] != '\0' && declManager->FindType( DECL_MODELDEF, model, false ) != NULL )
+	{
+		return false;
+	}
+	
+	return true;
+}
+
+/*
+================
+CreateProjectileClipModel
+
+Same rules as idEntity::InitDefaultPhysics
+================
+*/
+static idClipModel* CreateProjectileClipModel( const idDict& dict )
+{
+	const char* temp;
+	
+	if( dict.GetString( "clipmodel", "", &temp ) && idClipModel::CheckModel( temp ) )
+	{
+		return new( TAG_PHYSICS_CLIP_ENTITY ) idClipModel( temp );
+	}
+	
+	if( dict.GetBool( "noclipmodel" ) )
+	{
+		return NULL;
+	}
+	
+	idVec3 size;
+	idBounds bounds;
+	bool setClipModel = false;
+	
+	if( dict.GetVector( "mins", NULL, bounds[0] ) && dict.GetVector( "maxs", NULL, bounds[1] ) )
+	{
+		setClipModel = ( bounds[0][0] <= bounds[1][0] && bounds[0][1] <= bounds[1][1] && bounds[0][2] <= bounds[1][2] );
+	}
+	else if( dict.GetVector( "size", NULL, size ) )
+	{
+		bounds[0].Set( size.x * -0.5f, size.y * -0.5f, 0.0f );
+		bounds[1].Set( size.x * 0.5f, size.y * 0.5f, size.z );
+		setClipModel = ( size.x >= 0.0f && size.y >= 0.0f && size.z >= 0.0f );
+	}
+	
+	if( setClipModel )
+	{
+		int numSides;
+		idTraceModel trm;
+		
+		if( dict.GetInt( "cylinder", "0", numSides ) && numSides > 0 )
+		{
+			trm.SetupCylinder( bounds, numSides < 3 ? 3 : numSides );
+		}
+		else if( dict.GetInt( "cone", "0", numSides ) && numSides > 0 )
+		{
+			trm.SetupCone( bounds, numSides < 3 ? 3 : numSides );
+		}
+		else
+		{
+			trm.SetupBox( bounds );
+		}
+		return new( TAG_PHYSICS_CLIP_ENTITY ) idClipModel( trm );
+	}
+	
+	temp = dict.GetString( "model" );
+	if( temp[0] != '\0' && idClipModel::CheckModel( temp ) )
+	{
+		return new( TAG_PHYSICS_CLIP_ENTITY ) idClipModel( temp );
+	}
+	
+	return NULL;
+}
+
+/*
+================
+idProjectileManager::idProjectileManager
+================
+*/
+idProjectileManager::idProjectileManager()
+{
+	statsStartTime = 0;
+	statsFrames = 0;
+	statsLaunched = 0;
+	statsMaterialized = 0;
+	statsTraces = 0;
+	statsMicroseconds = 0;
+	statsPeakMicroseconds = 0;
+}
+
+/*
+================
+idProjectileManager::~idProjectileManager
+================
+*/
+idProjectileManager::~idProjectileManager()
+{
+	Shutdown();
+}
+
+/*
+================
+idProjectileManager::Init
+================
+*/
+void idProjectileManager::Init()
+{
+	Clear();
+	
+	statsStartTime = gameLocal.time;
+	statsFrames = 0;
+	statsLaunched = 0;
+	statsMaterialized = 0;
+	statsTraces = 0;
+	statsMicroseconds = 0;
+	statsPeakMicroseconds = 0;
+}
+
+/*
+================
+idProjectileManager::Shutdown
+
+The clip models reference the collision models of the map, so the defs
+don't outlive it
+================
+*/
+void idProjectileManager::Shutdown()
+{
+	Clear();
+	
+	for( int i = 0; i < defs.Num(); i++ )
+	{
+		delete defs[i]->clipModel;
+	}
+	defs.DeleteContents( true );
+	defHash.Free();
+}
+
+/*
+================
+idProjectileManager::Clear
+================
+*/
+void idProjectileManager::Clear()
+{
+	for( int i = 0; i < modelDefHandles.Num(); i++ )
+	{
+		if( modelDefHandles[i] != -1 )
+		{
+			gameRenderWorld->FreeEntityDef( modelDefHandles[i] );
+		}
+	}
+	
+	origins.Clear();
+	velocities.Clear();
+	axes.Clear();
+	defNums.Clear();
+	launchTimes.Clear();
+	smokeFlyTimes.Clear();
+	launchPowers.Clear();
+	damagePowers.Clear();
+	diversities.Clear();
+	modelDefHandles.Clear();
+	owners.Clear();
+	finished.Clear();
+}
+
+/*
+================
+idProjectileManager::FindDef
+================
+*/
+int idProjectileManager::FindDef( const idDict& projectileDict )
+{
+	if( !g_projectilePool.GetBool() || common->IsMultiplayer() || origins.Num() >= MAX_PROJECTILES )
+	{
+		return -1;
+	}
+	
+	const char* classname = projectileDict.GetString( "classname" );
+	const int hash = defHash.GenerateKey( classname, false );
+	for( int i = defHash.First( hash ); i != -1; i = defHash.Next( i ) )
+	{
+		if( idStr::Icmp( defs[i]->entityDef->GetName(), classname ) == 0 )
+		{
+			return defs[i]->pooled ? i : -1;
+		}
+	}
+	
+	const idDeclEntityDef* entityDef = gameLocal.FindEntityDef( classname, false );
+	if( entityDef == NULL )
+	{
+		return -1;
+	}
+	
+	projectileDef_t* def = new( TAG_PROJECTILE ) projectileDef_t;
+	memset( def, 0, sizeof( *def ) );
+	def->entityDef = entityDef;
+	def->pooled = CanPoolProjectile( entityDef );
+	
+	if( def->pooled )
+	{
+		def->clipModel = CreateProjectileClipModel( entityDef->dict );
+		def->pooled = ( def->clipModel != NULL );
+	}
+	
+	if( def->pooled )
+	{
+		const idDict& dict = entityDef->dict;
+		idVec3 velocity;
+		
+		dict.GetVector( "velocity", "0 0 0", velocity );
+		def->speed = velocity.Length();
+		def->gravity = dict.GetFloat( "gravity" );
+		def->linearFriction = dict.GetFloat( "linear_friction" );
+		
+		const float fuse = dict.GetFloat( "fuse" );
+		if( fuse <= 0.0f )
+		{
+			def->lifeTime = dict.GetInt( "remove_time", "1500" );
+			def->fizzleOnFuse = false;
+		}
+		else
+		{
+			def->lifeTime = SEC2MS( fuse );
+			def->fizzleOnFuse = ( dict.GetString( "snd_fizzle" )[0] != '\0' );
+		}
+		
+		def->clipMask = MASK_SHOT_RENDERMODEL | CONTENTS_FLUID;
+		if( !dict.GetBool( "no_contents" ) )
+		{
+			def->clipMask |= CONTENTS_PROJECTILE;
+		}
+		
+		const char* smokeName = dict.GetString( "smoke_fly" );
+		if( smokeName[0] != '\0' )
+		{
+			def->smokeFly = static_cast<const idDeclParticle*>( declManager->FindType( DECL_PARTICLE, smokeName ) );
+		}
+		
+		def->randomShaderSpin = dict.GetBool( "random_shader_spin" );
+		def->resetTimeOffset = dict.GetBool( "reset_time_offset" );
+		
+		gameEdit->ParseSpawnArgsToRenderEntity( &dict, &def->renderEntity );
+		def->renderEntity.entityNum = ENTITYNUM_NONE;
+	}
+	
+	const int defNum = defs.Append( def );
+	defHash.Add( hash, defNum );
+	
+	return def->pooled ? defNum : -1;
+}
+
+/*
+================
+idProjectileManager::GetClipModel
+================
+*/
+const idClipModel* idProjectileManager::GetClipModel( int defNum ) const
+{
+	return defs[defNum]->clipModel;
+}
+
+/*
+================
+idProjectileManager::LaunchAxis
+================
+*/
+idMat3 idProjectileManager::LaunchAxis( const idVec3& dir )
+{
+	idMat3 axis = dir.ToMat3();
+	idVec3 tmp = axis[2];
+	axis[2] = axis[0];
+	axis[0] = -tmp;
+	return axis;
+}
+
+/*
+================
+idProjectileManager::Launch
+================
+*/
+void idProjectileManager::Launch( int defNum, idEntity* owner, const idVec3& start, const idVec3& dir, const idVec3& pushVelocity, const float timeSinceFire, const float launchPower, const float dmgPower )
+{
+	const projectileDef_t* def = defs[defNum];
+	const idMat3 axis = LaunchAxis( dir );
+	
+	origins.Append( start );
+	velocities.Append( axis[2] * ( def->speed * launchPower ) + pushVelocity );
+	axes.Append( axis );
+	defNums.Append( defNum );
+	launchTimes.Append( gameLocal.time - SEC2MS( timeSinceFire ) );
+	smokeFlyTimes.Append( def->smokeFly != NULL ? gameLocal.time : 0 );
+	launchPowers.Append( launchPower );
+	damagePowers.Append( dmgPower );
+	diversities.Append( def->randomShaderSpin ? gameLocal.random.RandomFloat() * 0.5f : 0.0f );
+	modelDefHandles.Append( -1 );
+	owners.Alloc() = owner;
+	
+	statsLaunched++;
+	
+	PresentProjectile( origins.Num() - 1 );
+}
+
+/*
+================
+idProjectileManager::Think
+
+Sweeps every projectile once and spawns entities for the ones that hit
+something. idClip isn't thread safe, so the sweeps run in one tight serial
+pass instead of spread over the entity think loop.
+================
+*/
+void idProjectileManager::Think()
+{
+	if( origins.Num() == 0 )
+	{
+		UpdateStats( 0 );
+		return;
+	}
+	
+	SCOPED_PROFILE_EVENT( "idProjectileManager::Think" );
+	
+	const uint64 startTime = Sys_Microseconds();
+	const float dt = MS2SEC( gameLocal.time - gameLocal.previousTime );
+	
+	idVec3 gravityDir = gameLocal.GetGravity();
+	gravityDir.NormalizeFast();
+	
+	trace_t tr;
+	
+	finished.SetNum( 0 );
+	for( int i = 0; i < origins.Num(); i++ )
+	{
+		const projectileDef_t* def = defs[defNums[i]];
+		
+		if( gameLocal.time - launchTimes[i] >= def->lifeTime )
+		{
+			finished_t& f = finished.Alloc();
+			f.index = i;
+			f.hit = false;
+			continue;
+		}
+		
+		idVec3& velocity = velocities[i];
+		velocity += gravityDir * ( def->gravity * dt );
+		
+		gameLocal.clip.Translation( tr, origins[i], origins[i] + velocity * dt, def->clipModel, axes[i], def->clipMask, owners[i].GetEntity() );
+		statsTraces++;
+		
+		origins[i] = tr.endpos;
+		
+		if( tr.fraction < 1.0f )
+		{
+			finished_t& f = finished.Alloc();
+			f.index = i;
+			f.hit = true;
+			f.collision = tr;
+			continue;
+		}
+		
+		velocity *= Max( 0.0f, 1.0f - def->linearFriction * dt );
+	}
+	
+	// walk backwards so removing a projectile never moves one that still has to be handled,
+	// projectiles launched by the impacts are appended behind all of them
+	for( int i = finished.Num() - 1; i >= 0; i-- )
+	{
+		const finished_t& f = finished[i];
+		
+		if( f.hit )
+		{
+			Materialize( f.index, &f.collision );
+		}
+		else if( defs[defNums[f.index]]->fizzleOnFuse )
+		{
+			Materialize( f.index, NULL );
+		}
+		RemoveProjectile( f.index );
+	}
+	
+	for( int i = 0; i < origins.Num(); i++ )
+	{
+		PresentProjectile( i );
+	}
+	
+	UpdateStats( Sys_Microseconds() - startTime );
+}
+
+/*
+================
+idProjectileManager::MaterializeAll
+================
+*/
+void idProjectileManager::MaterializeAll()
+{
+	for( int i = origins.Num() - 1; i >= 0; i-- )
+	{
+		Materialize( i, NULL );
+		RemoveProjectile( i );
+	}
+}
+
+/*
+================
+idProjectileManager::Materialize
+================
+*/
+void idProjectileManager::Materialize( int index, const trace_t* collision )
+{
+	idEntity* ent = NULL;
+	
+	// copy everything first, the entity may launch pooled projectiles while it explodes
+	const projectileDef_t* def = defs[defNums[index]];
+	const idVec3 origin = origins[index];
+	const idVec3 velocity = velocities[index];
+	const idVec3 dir = axes[index][2];
+	const float timeSinceFire = MS2SEC( gameLocal.time - launchTimes[index] );
+	const float launchPower = launchPowers[index];
+	const float dmgPower = damagePowers[index];
+	idEntity* owner = owners[index].GetEntity();
+	
+	// an earlier impact this frame may have removed what this one hit
+	if( collision != NULL && gameLocal.entities[collision->c.entityNum] == NULL )
+	{
+		collision = NULL;
+	}
+	
+	gameLocal.SpawnEntityDef( def->entityDef->dict, &ent, false );
+	if( ent == NULL || !ent->IsType( idProjectile::Type ) )
+	{
+		gameLocal.Warning( "'%s' is not an idProjectile", def->entityDef->GetName() );
+		if( ent != NULL )
+		{
+			ent->PostEventMS( &EV_Remove, 0 );
+		}
+		return;
+	}
+	
+	idProjectile* proj = static_cast<idProjectile*>( ent );
+	proj->Create( owner, origin, dir );
+	proj->LaunchFromPool( origin, dir, velocity, timeSinceFire, launchPower, dmgPower, collision );
+	
+	statsMaterialized++;
+}
+
+/*
+================
+idProjectileManager::RemoveProjectile
+================
+*/
+void idProjectileManager::RemoveProjectile( int index )
+{
+	if( modelDefHandles[index] != -1 )
+	{
+		gameRenderWorld->FreeEntityDef( modelDefHandles[index] );
+	}
+	
+	origins.RemoveIndexFast( index );
+	velocities.RemoveIndexFast( index );
+	axes.RemoveIndexFast( index );
+	defNums.RemoveIndexFast( index );
+	launchTimes.RemoveIndexFast( index );
+	smokeFlyTimes.RemoveIndexFast( index );
+	launchPowers.RemoveIndexFast( index );
+	damagePowers.RemoveIndexFast( index );
+	diversities.RemoveIndexFast( index );
+	modelDefHandles.RemoveIndexFast( index );
+	owners.RemoveIndexFast( index );
+}
+
+/*
+================
+idProjectileManager::PresentProjectile
+================
+*/
+void idProjectileManager::PresentProjectile( int index )
+{
+	const projectileDef_t* def = defs[defNums[index]];
+	
+	if( def->renderEntity.hModel != NULL )
+	{
+		renderEntity_t renderEntity = def->renderEntity;
+		renderEntity.origin = origins[index];
+		renderEntity.axis = axes[index];
+		if( def->randomShaderSpin )
+		{
+			renderEntity.shaderParms[ SHADERPARM_DIVERSITY ] = diversities[index];
+		}
+		if( def->resetTimeOffset )
+		{
+			renderEntity.shaderParms[ SHADERPARM_TIMEOFFSET ] = -MS2SEC( launchTimes[index] );
+		}
+		
+		if( modelDefHandles[index] == -1 )
+		{
+			modelDefHandles[index] = gameRenderWorld->AddEntityDef( &renderEntity );
+		}
+		else
+		{
+			gameRenderWorld->UpdateEntityDef( modelDefHandles[index], &renderEntity );
+		}
+	}
+	
+	if( def->smokeFly != NULL && smokeFlyTimes[index] != 0 )
+	{
+		idVec3 dir = -velocities[index];
+		dir.Normalize();
+		
+		if( !gameLocal.smokeParticles->EmitSmoke( def->smokeFly, smokeFlyTimes[index], gameLocal.random.RandomFloat(), origins[index], dir.ToMat3(), TIME_GROUP1 ) )
+		{
+			smokeFlyTimes[index] = gameLocal.time;
+		}
+	}
+}
+
+/*
+================
+idProjectileManager::UpdateStats
+================
+*/
+void idProjectileManager::UpdateStats( const uint64 microseconds )
+{
+	statsFrames++;
+	statsMicroseconds += microseconds;
+	statsPeakMicroseconds = Max( statsPeakMicroseconds, microseconds );
+	
+	const int elapsed = gameLocal.time - statsStartTime;
+	if( elapsed < 1000 && elapsed >= 0 )
+	{
+		return;
+	}
+	
+	if( g_projectileStats.GetBool() && elapsed > 0 )
+	{
+		const float seconds = MS2SEC( elapsed );
+		gameLocal.Printf( "projectiles: %4d in flight, %6.1f launched/s, %6.1f materialized/s, %5d traces/frame, %.3f ms/frame avg, %.3f ms peak\n",
+						  origins.Num(), statsLaunched / seconds, statsMaterialized / seconds, statsTraces / statsFrames,
+						  statsMicroseconds / ( statsFrames * 1000.0f ), statsPeakMicroseconds / 1000.0f );
+	}
+	
+	statsStartTime = gameLocal.time;
+	statsFrames = 0;
+	statsLaunched = 0;
+	statsMaterialized = 0;
+	statsTraces = 0;
+	statsMicroseconds = 0;
+	statsPeakMicroseconds = 0;
+}
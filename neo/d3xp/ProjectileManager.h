@@ -0,0 +1,143 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __GAME_PROJECTILEMANAGER_H__
+#define __GAME_PROJECTILEMANAGER_H__
+
+/*
+===============================================================================
+
+	Projectile manager
+
+	Simple projectiles that don't thrust, light, make a flight sound or touch
+	triggers don't need to be entities while they are in the air. They are
+	kept in a structure of arrays and swept against the world in one pass
+	each game frame.
+
+	An idProjectile is only spawned when one of them hits something, runs out
+	its fuse or the game is saved. From then on it behaves exactly like a
+	projectile that was spawned at launch.
+
+	Multiplayer games always spawn entities because every projectile has to
+	be replicated.
+
+===============================================================================
+*/
+
+class idProjectileManager
+{
+public:
+	idProjectileManager();
+	~idProjectileManager();
+
+	void					Init();
+	void					Shutdown();
+
+	// removes all projectiles in flight
+	void					Clear();
+
+	// returns the pooled def for the projectile or -1 if it has to be spawned as an entity
+	int						FindDef( const idDict& projectileDict );
+	const idClipModel* 		GetClipModel( int defNum ) const;
+
+	void					Launch( int defNum, idEntity* owner, const idVec3& start, const idVec3& dir, const idVec3& pushVelocity, const float timeSinceFire, const float launchPower, const float dmgPower );
+
+	// moves all projectiles and spawns entities for the ones that hit something
+	void					Think();
+
+	// spawns entities for all projectiles in flight
+	void					MaterializeAll();
+
+	int						NumProjectiles() const
+	{
+		return origins.Num();
+	}
+
+	// projectile models have their z-axis aligned with the direction
+	static idMat3			LaunchAxis( const idVec3& dir );
+
+private:
+	struct projectileDef_t
+	{
+		const idDeclEntityDef* 	entityDef;
+		bool					pooled;
+		idClipModel* 			clipModel;
+		renderEntity_t			renderEntity;		// only origin, axis and time parms change per projectile
+		const idDeclParticle* 	smokeFly;
+		float					speed;
+		float					gravity;			// scale of the world gravity
+		float					linearFriction;
+		int						lifeTime;			// fuse or remove time in msec
+		bool					fizzleOnFuse;		// needs an entity to play the fizzle sound
+		int						clipMask;
+		bool					randomShaderSpin;
+		bool					resetTimeOffset;
+	};
+
+	struct finished_t
+	{
+		int						index;
+		bool					hit;
+		trace_t					collision;
+	};
+
+	static const int		MAX_PROJECTILES = 1024;
+
+	idList<projectileDef_t*, TAG_PROJECTILE>	defs;
+	idHashIndex				defHash;
+
+	// projectiles in flight, all lists have one entry per projectile
+	idList<idVec3, TAG_PROJECTILE>			origins;
+	idList<idVec3, TAG_PROJECTILE>			velocities;
+	idList<idMat3, TAG_PROJECTILE>			axes;
+	idList<int, TAG_PROJECTILE>				defNums;
+	idList<int, TAG_PROJECTILE>				launchTimes;
+	idList<int, TAG_PROJECTILE>				smokeFlyTimes;
+	idList<float, TAG_PROJECTILE>			launchPowers;
+	idList<float, TAG_PROJECTILE>			damagePowers;
+	idList<float, TAG_PROJECTILE>			diversities;
+	idList<qhandle_t, TAG_PROJECTILE>		modelDefHandles;
+	idList<idEntityPtr<idEntity>, TAG_PROJECTILE>	owners;
+
+	idList<finished_t, TAG_PROJECTILE>		finished;
+
+	// counters for g_projectileStats, reset every second
+	int						statsStartTime;
+	int						statsFrames;
+	int						statsLaunched;
+	int						statsMaterialized;
+	int						statsTraces;
+	uint64					statsMicroseconds;
+	uint64					statsPeakMicroseconds;
+
+	void					Materialize( int index, const trace_t* collision );
+	void					RemoveProjectile( int index );
+	void					PresentProjectile( int index );
+	void					UpdateStats( const uint64 microseconds );
+};
+
+#endif /* !__GAME_PROJECTILEMANAGER_H__ */
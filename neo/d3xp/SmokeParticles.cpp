@@ -34,6 +34,9 @@ If you have questions concerning this license or the applicable additional terms
 
 static const char* smokeParticle_SnapshotName = "_SmokeParticle_Snapshot_";
 
+// particles handed to idParticleStage::CreateParticles at once
+static const int SMOKE_BATCH_SIZE = 64;
+
 /*
 ================
 idSmokeParticles::idSmokeParticles
@@ -42,12 +45,23 @@ idSmokeParticles::idSmokeParticles
 idSmokeParticles::idSmokeParticles()
 {
 	initialized = false;
-	memset( &renderEntity, 0, sizeof( renderEntity ) );
-	renderEntityHandle = -1;
-	memset( smokes, 0, sizeof( smokes ) );
-	freeSmokes = NULL;
+	memset( renderEntities, 0, sizeof( renderEntities ) );
+	for( int i = 0; i < NUM_RENDER_ENTITIES; i++ )
+	{
+		renderEntityHandles[i] = -1;
+		currentParticleTimes[i] = -1;
+	}
 	numActiveSmokes = 0;
-	currentParticleTime = -1;
+}
+
+/*
+================
+idSmokeParticles::~idSmokeParticles
+================
+*/
+idSmokeParticles::~idSmokeParticles()
+{
+	activeStages.DeleteContents( true );
 }
 
 /*
@@ -62,41 +76,38 @@ void idSmokeParticles::Init()
 		Shutdown();
 	}
 	
-	// set up the free list
-	for( int i = 0; i < MAX_SMOKE_PARTICLES - 1; i++ )
-	{
-		smokes[i].next = &smokes[i + 1];
-	}
-	smokes[MAX_SMOKE_PARTICLES - 1].next = NULL;
-	freeSmokes = &smokes[0];
+	activeStages.DeleteContents( true );
 	numActiveSmokes = 0;
 	
-	activeStages.Clear();
-	
-	memset( &renderEntity, 0, sizeof( renderEntity ) );
-	
-	renderEntity.bounds.Clear();
-	renderEntity.axis = mat3_identity;
-	renderEntity.shaderParms[ SHADERPARM_RED ]		= 1;
-	renderEntity.shaderParms[ SHADERPARM_GREEN ]	= 1;
-	renderEntity.shaderParms[ SHADERPARM_BLUE ]		= 1;
-	renderEntity.shaderParms[3] = 1;
-	
-	renderEntity.hModel = renderModelManager->AllocModel();
-	renderEntity.hModel->InitEmpty( smokeParticle_SnapshotName );
-	
-	// we certainly don't want particle shadows
-	renderEntity.noShadow = 1;
-	
-	// huge bounds, so it will be present in every world area
-	renderEntity.bounds.AddPoint( idVec3( -100000, -100000, -100000 ) );
-	renderEntity.bounds.AddPoint( idVec3( 100000,  100000,  100000 ) );
-	
-	renderEntity.callback = idSmokeParticles::ModelCallback;
-	// add to renderer list
-	renderEntityHandle = gameRenderWorld->AddEntityDef( &renderEntity );
-	
-	currentParticleTime = -1;
+	for( int i = 0; i < NUM_RENDER_ENTITIES; i++ )
+	{
+		renderEntity_t& renderEntity = renderEntities[i];
+		
+		memset( &renderEntity, 0, sizeof( renderEntity ) );
+		
+		renderEntity.bounds.Clear();
+		renderEntity.axis = mat3_identity;
+		renderEntity.shaderParms[ SHADERPARM_RED ]		= 1;
+		renderEntity.shaderParms[ SHADERPARM_GREEN ]	= 1;
+		renderEntity.shaderParms[ SHADERPARM_BLUE ]		= 1;
+		renderEntity.shaderParms[3] = 1;
+		
+		renderEntity.hModel = renderModelManager->AllocModel();
+		renderEntity.hModel->InitEmpty( smokeParticle_SnapshotName );
+		
+		// we certainly don't want particle shadows
+		renderEntity.noShadow = 1;
+		
+		// huge bounds, so it will be present in every world area
+		renderEntity.bounds.AddPoint( idVec3( -100000, -100000, -100000 ) );
+		renderEntity.bounds.AddPoint( idVec3( 100000,  100000,  100000 ) );
+		
+		renderEntity.callback = idSmokeParticles::ModelCallback;
+		// add to renderer list
+		renderEntityHandles[i] = gameRenderWorld->AddEntityDef( &renderEntity );
+		
+		currentParticleTimes[i] = -1;
+	}
 	
 	initialized = true;
 }
@@ -108,16 +119,19 @@ idSmokeParticles::Shutdown
 */
 void idSmokeParticles::Shutdown()
 {
-	// make sure the render entity is freed before the model is freed
-	if( renderEntityHandle != -1 )
+	for( int i = 0; i < NUM_RENDER_ENTITIES; i++ )
 	{
-		gameRenderWorld->FreeEntityDef( renderEntityHandle );
-		renderEntityHandle = -1;
-	}
-	if( renderEntity.hModel != NULL )
-	{
-		renderModelManager->FreeModel( renderEntity.hModel );
-		renderEntity.hModel = NULL;
+		// make sure the render entity is freed before the model is freed
+		if( renderEntityHandles[i] != -1 )
+		{
+			gameRenderWorld->FreeEntityDef( renderEntityHandles[i] );
+			renderEntityHandles[i] = -1;
+		}
+		if( renderEntities[i].hModel != NULL )
+		{
+			renderModelManager->FreeModel( renderEntities[i].hModel );
+			renderEntities[i].hModel = NULL;
+		}
 	}
 	initialized = false;
 }
@@ -125,58 +139,63 @@ void idSmokeParticles::Shutdown()
 /*
 ================
 idSmokeParticles::FreeSmokes
+
+Compacts the expired particles out of the stages, this is the only place
+particles are removed so the render callbacks can run on the job threads
 ================
 */
 void idSmokeParticles::FreeSmokes()
 {
 	for( int activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ )
 	{
-		singleSmoke_t* smoke, *next, *last;
-		
-		activeSmokeStage_t* active = &activeStages[activeStageNum];
+		activeSmokeStage_t* active = activeStages[activeStageNum];
 		const idParticleStage* stage = active->stage;
+		const int numSmokes = active->startTimes.Num();
+		const float lifeMsec = stage->particleLife * 1000;
 		
-		for( last = NULL, smoke = active->smokes; smoke; smoke = next )
+		int numKept = 0;
+		for( int i = 0; i < numSmokes; i++ )
 		{
-			next = smoke->next;
-			
 			float frac;
 			
-			if( smoke->timeGroup )
+			if( active->timeGroups[i] )
 			{
-				frac = ( float )( gameLocal.fast.time - smoke->privateStartTime ) / ( stage->particleLife * 1000 );
+				frac = ( float )( gameLocal.fast.time - active->startTimes[i] ) / lifeMsec;
 			}
 			else
 			{
-				frac = ( float )( gameLocal.slow.time - smoke->privateStartTime ) / ( stage->particleLife * 1000 );
+				frac = ( float )( gameLocal.slow.time - active->startTimes[i] ) / lifeMsec;
 			}
 			if( frac >= 1.0f )
 			{
-				// remove the particle from the stage list
-				if( last != NULL )
-				{
-					last->next = smoke->next;
-				}
-				else
-				{
-					active->smokes = smoke->next;
-				}
-				// put the particle on the free list
-				smoke->next = freeSmokes;
-				freeSmokes = smoke;
-				numActiveSmokes--;
 				continue;
 			}
 			
-			last = smoke;
+			if( numKept != i )
+			{
+				active->startTimes[numKept] = active->startTimes[i];
+				active->indexes[numKept] = active->indexes[i];
+				active->randoms[numKept] = active->randoms[i];
+				active->origins[numKept] = active->origins[i];
+				active->axes[numKept] = active->axes[i];
+				active->timeGroups[numKept] = active->timeGroups[i];
+			}
+			numKept++;
 		}
 		
-		if( !active->smokes )
+		if( numKept == numSmokes )
 		{
-			// remove this from the activeStages list
-			activeStages.RemoveIndex( activeStageNum );
-			activeStageNum--;
+			continue;
 		}
+		
+		active->startTimes.SetNum( numKept );
+		active->indexes.SetNum( numKept );
+		active->randoms.SetNum( numKept );
+		active->origins.SetNum( numKept );
+		active->axes.SetNum( numKept );
+		active->timeGroups.SetNum( numKept );
+		
+		numActiveSmokes -= numSmokes - numKept;
 	}
 }
 
@@ -286,7 +305,7 @@ bool idSmokeParticles::EmitSmoke( const idDeclParticle* smoke, const int systemS
 		int i;
 		for( i = 0 ; i < activeStages.Num() ; i++ )
 		{
-			active = &activeStages[i];
+			active = activeStages[i];
 			if( active->stage == stage )
 			{
 				break;
@@ -294,35 +313,29 @@ bool idSmokeParticles::EmitSmoke( const idDeclParticle* smoke, const int systemS
 		}
 		if( i == activeStages.Num() )
 		{
-			// add a new one
-			activeSmokeStage_t	newActive;
-			
-			newActive.smokes = NULL;
-			newActive.stage = stage;
-			i = activeStages.Append( newActive );
-			active = &activeStages[i];
+			// add a new one, spread the stages over the render entities
+			active = new( TAG_PARTICLE ) activeSmokeStage_t;
+			active->stage = stage;
+			active->renderEntityNum = activeStages.Num() % NUM_RENDER_ENTITIES;
+			activeStages.Append( active );
 		}
 		
 		// add all the required particles
-		for( prevCount++ ; prevCount <= nowCount && active != NULL ; prevCount++ )
+		for( prevCount++ ; prevCount <= nowCount ; prevCount++ )
 		{
-			if( !freeSmokes )
+			if( numActiveSmokes >= MAX_SMOKE_PARTICLES )
 			{
 				gameLocal.Printf( "idSmokeParticles::EmitSmoke: no free smokes with %d active stages\n", activeStages.Num() );
 				return true;
 			}
-			singleSmoke_t*	newSmoke = freeSmokes;
-			freeSmokes = freeSmokes->next;
 			numActiveSmokes++;
 			
-			newSmoke->timeGroup = timeGroup;
-			newSmoke->index = prevCount;
-			newSmoke->axis = axis;
-			newSmoke->origin = origin;
-			newSmoke->random = steppingRandom;
-			newSmoke->privateStartTime = systemStartTime + prevCount * finalParticleTime / stage->totalParticles;
-			newSmoke->next = active->smokes;
-			active->smokes = newSmoke;
+			active->timeGroups.Append( timeGroup );
+			active->indexes.Append( prevCount );
+			active->axes.Append( axis );
+			active->origins.Append( origin );
+			active->randoms.Append( steppingRandom );
+			active->startTimes.Append( systemStartTime + prevCount * finalParticleTime / stage->totalParticles );
 			
 			steppingRandom.RandomInt();	// advance the random
 		}
@@ -331,14 +344,31 @@ bool idSmokeParticles::EmitSmoke( const idDeclParticle* smoke, const int systemS
 	return continues;
 }
 
+
 /*
 ================
 idSmokeParticles::UpdateRenderEntity
+
+Each render entity only builds the stages assigned to it, so the front end
+can build all of them at the same time. Particles that have run out are
+skipped here and removed by FreeSmokes on the game thread.
 ================
 */
 bool idSmokeParticles::UpdateRenderEntity( renderEntity_s* renderEntity, const renderView_t* renderView )
 {
-
+	int entityNum;
+	for( entityNum = 0; entityNum < NUM_RENDER_ENTITIES; entityNum++ )
+	{
+		if( renderEntities[entityNum].hModel == renderEntity->hModel )
+		{
+			break;
+		}
+	}
+	if( entityNum == NUM_RENDER_ENTITIES )
+	{
+		return false;
+	}
+	
 	// this may be triggered by a model trace or other non-view related source,
 	// to which we should look like an empty model
 	if( !renderView )
@@ -349,7 +379,7 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s* renderEntity, const r
 	}
 	
 	// don't regenerate it if it is current
-	if( renderView->time[renderEntity->timeGroup] == currentParticleTime && !renderView->forceUpdate )
+	if( renderView->time[renderEntity->timeGroup] == currentParticleTimes[entityNum] && !renderView->forceUpdate )
 	{
 		return false;
 	}
@@ -357,31 +387,27 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s* renderEntity, const r
 	// FIXME: re-use model surfaces
 	renderEntity->hModel->InitDynamicEmpty( smokeParticle_SnapshotName );
 	
-	currentParticleTime = renderView->time[renderEntity->timeGroup];
-	
-	particleGen_t g;
+	currentParticleTimes[entityNum] = renderView->time[renderEntity->timeGroup];
 	
-	g.renderEnt = renderEntity;
-	g.renderView = renderView;
+	particleGen_t gens[SMOKE_BATCH_SIZE];
 	
 	for( int activeStageNum = 0; activeStageNum < activeStages.Num(); activeStageNum++ )
 	{
-		singleSmoke_t* smoke, *next, *last;
-		
-		activeSmokeStage_t* active = &activeStages[activeStageNum];
+		const activeSmokeStage_t* active = activeStages[activeStageNum];
 		const idParticleStage* stage = active->stage;
 		
-		if( !stage->material )
+		if( active->renderEntityNum != entityNum || !stage->material )
 		{
 			continue;
 		}
 		
-		// allocate a srfTriangles that can hold all the particles
-		int count = 0;
-		for( smoke = active->smokes; smoke; smoke = smoke->next )
+		const int count = active->startTimes.Num();
+		if( count == 0 )
 		{
-			count++;
+			continue;
 		}
+		
+		// allocate a srfTriangles that can hold all the particles
 		int	quads = count * stage->NumQuadsPerParticle();
 		srfTriangles_t* tri = renderEntity->hModel->AllocSurfaceTriangles( quads * 4, quads * 6 );
 		tri->numIndexes = quads * 6;
@@ -395,50 +421,49 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s* renderEntity, const r
 			tri->bounds[1][1] =
 				tri->bounds[1][2] = 99999;
 				
+		const float lifeMsec = stage->particleLife * 1000;
+		
 		tri->numVerts = 0;
-		for( last = NULL, smoke = active->smokes; smoke; smoke = next )
+		int numGens = 0;
+		for( int i = 0; i < count; i++ )
 		{
-			next = smoke->next;
-			
-			if( smoke->timeGroup )
+			float frac;
+			if( active->timeGroups[i] )
 			{
-				g.frac = ( float )( gameLocal.fast.time - smoke->privateStartTime ) / ( stage->particleLife * 1000 );
+				frac = ( float )( gameLocal.fast.time - active->startTimes[i] ) / lifeMsec;
 			}
 			else
 			{
-				g.frac = ( float )( gameLocal.time - smoke->privateStartTime ) / ( stage->particleLife * 1000 );
+				frac = ( float )( gameLocal.time - active->startTimes[i] ) / lifeMsec;
 			}
-			if( g.frac >= 1.0f )
+			if( frac >= 1.0f )
 			{
-				// remove the particle from the stage list
-				if( last != NULL )
-				{
-					last->next = smoke->next;
-				}
-				else
-				{
-					active->smokes = smoke->next;
-				}
-				// put the particle on the free list
-				smoke->next = freeSmokes;
-				freeSmokes = smoke;
-				numActiveSmokes--;
 				continue;
 			}
 			
-			g.index = smoke->index;
-			g.random = smoke->random;
-			
-			g.origin = smoke->origin;
-			g.axis = smoke->axis;
+			particleGen_t& g = gens[numGens++];
 			
+			g.renderEnt = renderEntity;
+			g.renderView = renderView;
+			g.frac = frac;
+			g.index = active->indexes[i];
+			g.random = active->randoms[i];
+			g.origin = active->origins[i];
+			g.axis = active->axes[i];
 			g.originalRandom = g.random;
 			g.age = g.frac * stage->particleLife;
 			
-			tri->numVerts += stage->CreateParticle( &g, tri->verts + tri->numVerts );
-			
-			last = smoke;
+			if( numGens == SMOKE_BATCH_SIZE )
+			{
+				tri->numVerts += stage->CreateParticles( gens, numGens, tri->verts + tri->numVerts );
+				numGens = 0;
+			}
 		}
+		if( numGens > 0 )
+		{
+			tri->numVerts += stage->CreateParticles( gens, numGens, tri->verts + tri->numVerts );
+		}
+		
 		if( tri->numVerts > quads * 4 )
 		{
 			gameLocal.Error( "idSmokeParticles::UpdateRenderEntity: miscounted verts" );
@@ -446,16 +471,8 @@ bool idSmokeParticles::UpdateRenderEntity( renderEntity_s* renderEntity, const r
 		
 		if( tri->numVerts == 0 )
 		{
-		
-			// they were all removed
+			// they have all run out
 			renderEntity->hModel->FreeSurfaceTriangles( tri );
-			
-			if( !active->smokes )
-			{
-				// remove this from the activeStages list
-				activeStages.RemoveIndex( activeStageNum );
-				activeStageNum--;
-			}
 		}
 		else
 		{
@@ -49,24 +49,25 @@ If you have questions concerning this license or the applicable additional terms
 	Each particle model has its own shaderparms, which can be used by the
 	particle materials.
 
+	The particles are kept per stage in a structure of arrays. Expired ones are
+	compacted out once a game frame, and the stages are spread over a few
+	render entities so their verts are built by separate front end jobs.
+
 ===============================================================================
 */
 
-typedef struct singleSmoke_s
-{
-	struct singleSmoke_s* 		next;
-	int							privateStartTime;	// start time for this particular particle
-	int							index;				// particle index in system, 0 <= index < stage->totalParticles
-	idRandom					random;
-	idVec3						origin;
-	idMat3						axis;
-	int							timeGroup;
-} singleSmoke_t;
-
 typedef struct
 {
-	const idParticleStage* 		stage;
-	singleSmoke_t* 				smokes;
+	const idParticleStage* 			stage;
+	int								renderEntityNum;	// which of the render entities draws this stage
+	
+	// one entry per particle
+	idList<int, TAG_PARTICLE>		startTimes;			// start time for this particular particle
+	idList<int, TAG_PARTICLE>		indexes;			// particle index in system, 0 <= index < stage->totalParticles
+	idList<idRandom, TAG_PARTICLE>	randoms;
+	idList<idVec3, TAG_PARTICLE>	origins;
+	idList<idMat3, TAG_PARTICLE>	axes;
+	idList<int, TAG_PARTICLE>		timeGroups;
 } activeSmokeStage_t;
 
 
@@ -74,8 +75,9 @@ class idSmokeParticles
 {
 public:
 	idSmokeParticles();
+	~idSmokeParticles();
 	
-	// creats an entity covering the entire world that will call back each rendering
+	// creats the entities covering the entire world that will call back each rendering
 	void						Init();
 	void						Shutdown();
 	
@@ -87,18 +89,17 @@ public:
 	void						FreeSmokes();
 	
 private:
-	bool						initialized;
+	static const int			MAX_SMOKE_PARTICLES = 10000;
+	static const int			NUM_RENDER_ENTITIES = 4;
 	
-	renderEntity_t				renderEntity;			// used to present a model to the renderer
-	int							renderEntityHandle;		// handle to static renderer model
+	bool						initialized;
 	
-	static const int			MAX_SMOKE_PARTICLES = 10000;
-	singleSmoke_t				smokes[MAX_SMOKE_PARTICLES];
+	renderEntity_t				renderEntities[NUM_RENDER_ENTITIES];		// used to present a model to the renderer
+	int							renderEntityHandles[NUM_RENDER_ENTITIES];	// handle to static renderer model
+	int							currentParticleTimes[NUM_RENDER_ENTITIES];	// don't need to recalculate if == view time
 	
-	idList<activeSmokeStage_t, TAG_PARTICLE>	activeStages;
-	singleSmoke_t* 				freeSmokes;
+	idList<activeSmokeStage_t*, TAG_PARTICLE>	activeStages;	// stages stay allocated when they run out of particles
 	int							numActiveSmokes;
-	int							currentParticleTime;	// don't need to recalculate if == view time
 	
 	bool						UpdateRenderEntity( renderEntity_s* renderEntity, const renderView_t* renderView );
 	static bool					ModelCallback( renderEntity_s* renderEntity, const renderView_t* renderView );
@@ -4500,6 +4500,8 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 	idVec3			start;
 	idVec3			muzzle_pos;
 	idBounds		ownerBounds, projBounds;
+	const idClipModel* projClip;
+	idMat3			projAxis;
 	
 	idEntity		*hitEnt = NULL;	
 	idVec3			hitPos = vec3_zero;	
@@ -4607,59 +4609,74 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 			dir = muzzleAxis[ 0 ] + muzzleAxis[ 2 ] * ( ang * idMath::Sin( spin ) ) - muzzleAxis[ 1 ] * ( ang * idMath::Cos( spin ) );
 			dir.Normalize();
 			
-			if( projectileEnt )
+			// simple projectiles don't need an entity until they hit something
+			const int pooledDef = ( projectileEnt == NULL ) ? gameLocal.projectileManager->FindDef( projectileDict ) : -1;
+			
+			int predictedKey = idEntity::INVALID_PREDICTION_KEY;
+			
+			if( pooledDef != -1 )
 			{
-				ent = projectileEnt;
-				ent->Show();
-				ent->Unbind();
-				projectileEnt = NULL;
+				proj = NULL;
+				projClip = gameLocal.projectileManager->GetClipModel( pooledDef );
+				projAxis = idProjectileManager::LaunchAxis( dir );
 			}
 			else
 			{
-				if( common->IsClient() )
+				if( projectileEnt )
 				{
-					// This is predicted on a client, don't replicate.
-					// Must be set before spawn, so that the entity can be spawned into the correct area of the entities array.
-					projectileDict.SetBool( "net_skip_replication", true );
+					ent = projectileEnt;
+					ent->Show();
+					ent->Unbind();
+					projectileEnt = NULL;
 				}
 				else
 				{
-					projectileDict.SetBool( "net_skip_replication", false );
+					if( common->IsClient() )
+					{
+						// This is predicted on a client, don't replicate.
+						// Must be set before spawn, so that the entity can be spawned into the correct area of the entities array.
+						projectileDict.SetBool( "net_skip_replication", true );
+					}
+					else
+					{
+						projectileDict.SetBool( "net_skip_replication", false );
+					}
+					gameLocal.SpawnEntityDef( projectileDict, &ent, false );
 				}
-				gameLocal.SpawnEntityDef( projectileDict, &ent, false );
-			}
-			
-			if( ent == NULL || !ent->IsType( idProjectile::Type ) )
-			{
-				const char* projectileName = weaponDef->dict.GetString( "def_projectile" );
-				gameLocal.Error( "'%s' is not an idProjectile", projectileName );
-				return;
-			}
-			
-			int predictedKey = idEntity::INVALID_PREDICTION_KEY;
-			
-			if( projectileDict.GetBool( "net_instanthit" ) )
-			{
-				// don't synchronize this on top of the already predicted effect
-				ent->fl.networkSync = false;
-			}
-			else if( owner != NULL )
-			{
-				// Set the prediction key only for non-instanthit projectiles.
-				if( common->IsClient() )
+				
+				if( ent == NULL || !ent->IsType( idProjectile::Type ) )
+				{
+					const char* projectileName = weaponDef->dict.GetString( "def_projectile" );
+					gameLocal.Error( "'%s' is not an idProjectile", projectileName );
+					return;
+				}
+				
+				if( projectileDict.GetBool( "net_instanthit" ) )
 				{
-					owner->IncrementClientFireCount();
+					// don't synchronize this on top of the already predicted effect
+					ent->fl.networkSync = false;
 				}
+				else if( owner != NULL )
+				{
+					// Set the prediction key only for non-instanthit projectiles.
+					if( common->IsClient() )
+					{
+						owner->IncrementClientFireCount();
+					}
 
-				if ( owner->IsType( idPlayer::Type ) )
-					predictedKey = gameLocal.GeneratePredictionKey( this, static_cast<idPlayer*>(owner.GetEntity()), -1 );
-				ent->SetPredictedKey( predictedKey );
+					if ( owner->IsType( idPlayer::Type ) )
+						predictedKey = gameLocal.GeneratePredictionKey( this, static_cast<idPlayer*>(owner.GetEntity()), -1 );
+					ent->SetPredictedKey( predictedKey );
+				}
+				
+				proj = static_cast<idProjectile*>( ent );
+				proj->Create( owner, muzzleOrigin, dir );
+				
+				projClip = proj->GetPhysics()->GetClipModel();
+				projAxis = proj->GetPhysics()->GetAxis();
 			}
 			
-			proj = static_cast<idProjectile*>( ent );
-			proj->Create( owner, muzzleOrigin, dir );
-			
-			projBounds = proj->GetPhysics()->GetBounds().Rotate( proj->GetPhysics()->GetAxis() );
+			projBounds = projClip->GetBounds().Rotate( projAxis );
 			
 			// make sure the projectile starts inside the bounding box of the owner
 			if( i == 0 )
@@ -4674,7 +4691,7 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 				{
 					start = ownerBounds.GetCenter();
 				}
-				gameLocal.clip.Translation( tr, start, muzzle_pos, proj->GetPhysics()->GetClipModel(), proj->GetPhysics()->GetClipModel()->GetAxis(), MASK_SHOT_RENDERMODEL, owner );
+				gameLocal.clip.Translation( tr, start, muzzle_pos, projClip, projAxis, MASK_SHOT_RENDERMODEL, owner );
 				muzzle_pos = tr.endpos;
 
 				// if projectile is 'on target', give target a chance to react
@@ -4685,10 +4702,14 @@ void idWeapon::Event_LaunchProjectiles( int num_projectiles, float spread, float
 				}
 			}
 			
+			if( pooledDef != -1 )
+			{
+				gameLocal.projectileManager->Launch( pooledDef, owner, muzzle_pos, dir, pushVelocity, fuseOffset, launchPower, dmgPower );
+			}
 			// If this is the server simulating a remote client, the client has spawned the projectile in the past.
 			// The server will catch-up the projectile so that its position will be as if the projectile had spawned
 			// when the client fired it.
-			if( common->IsServer() && owner != NULL && !owner->IsLocallyControlled() && !projectileDict.GetBool( "net_instanthit" ) )
+			else if( common->IsServer() && owner != NULL && !owner->IsLocallyControlled() && !projectileDict.GetBool( "net_instanthit" ) )
 			{
 				int serverTimeOnClient = owner->GetUserCmd()->serverGameMilliseconds;
 				
@@ -4753,6 +4774,8 @@ void idWeapon::Event_LaunchProjectilesEllipse( int num_projectiles, float spread
 	idVec3			start;
 	idVec3			muzzle_pos;
 	idBounds		ownerBounds, projBounds;
+	const idClipModel* projClip;
+	idMat3			projAxis;
 	
 	if( IsHidden() )
 	{
@@ -4846,18 +4869,32 @@ void idWeapon::Event_LaunchProjectilesEllipse( int num_projectiles, float spread
 			dir = playerViewAxis[ 0 ] + playerViewAxis[ 2 ] * ( angb * idMath::Sin( spin ) ) - playerViewAxis[ 1 ] * ( anga * idMath::Cos( spin ) );
 			dir.Normalize();
 			
-			gameLocal.SpawnEntityDef( projectileDict, &ent );
-			if( ent == NULL || !ent->IsType( idProjectile::Type ) )
+			const int pooledDef = gameLocal.projectileManager->FindDef( projectileDict );
+			
+			if( pooledDef != -1 )
 			{
-				const char* projectileName = weaponDef->dict.GetString( "def_projectile" );
-				gameLocal.Error( "'%s' is not an idProjectile", projectileName );
-				return;
+				proj = NULL;
+				projClip = gameLocal.projectileManager->GetClipModel( pooledDef );
+				projAxis = idProjectileManager::LaunchAxis( dir );
+			}
+			else
+			{
+				gameLocal.SpawnEntityDef( projectileDict, &ent );
+				if( ent == NULL || !ent->IsType( idProjectile::Type ) )
+				{
+					const char* projectileName = weaponDef->dict.GetString( "def_projectile" );
+					gameLocal.Error( "'%s' is not an idProjectile", projectileName );
+					return;
+				}
+				
+				proj = static_cast<idProjectile*>( ent );
+				proj->Create( owner, muzzleOrigin, dir );
+				
+				projClip = proj->GetPhysics()->GetClipModel();
+				projAxis = proj->GetPhysics()->GetAxis();
 			}
 			
-			proj = static_cast<idProjectile*>( ent );
-			proj->Create( owner, muzzleOrigin, dir );
-			
-			projBounds = proj->GetPhysics()->GetBounds().Rotate( proj->GetPhysics()->GetAxis() );
+			projBounds = projClip->GetBounds().Rotate( projAxis );
 			
 			// make sure the projectile starts inside the bounding box of the owner
 			if( i == 0 )
@@ -4871,11 +4908,18 @@ void idWeapon::Event_LaunchProjectilesEllipse( int num_projectiles, float spread
 				{
 					start = ownerBounds.GetCenter();
 				}
-				gameLocal.clip.Translation( tr, start, muzzle_pos, proj->GetPhysics()->GetClipModel(), proj->GetPhysics()->GetClipModel()->GetAxis(), MASK_SHOT_RENDERMODEL, owner );
+				gameLocal.clip.Translation( tr, start, muzzle_pos, projClip, projAxis, MASK_SHOT_RENDERMODEL, owner );
 				muzzle_pos = tr.endpos;
 			}
 			
-			proj->Launch( muzzle_pos, dir, pushVelocity, fuseOffset, power );
+			if( pooledDef != -1 )
+			{
+				gameLocal.projectileManager->Launch( pooledDef, owner, muzzle_pos, dir, pushVelocity, fuseOffset, power, 1.0f );
+			}
+			else
+			{
+				proj->Launch( muzzle_pos, dir, pushVelocity, fuseOffset, power );
+			}
 		}
 		
 		// toss the brass
@@ -137,8 +137,6 @@ private:	// routing data
 	idRoutingUpdate* 			areaUpdate;				// memory used to update the area routing cache
 	idRoutingUpdate* 			portalUpdate;			// memory used to update the portal routing cache
 	unsigned short* 			goalAreaTravelTimes;	// travel times to goal areas
-	unsigned short* 			areaTravelTimes;		// travel times through the areas
-	int							numAreaTravelTimes;		// number of area travel times
 	mutable idRoutingCache* 	cacheListStart;			// start of list with cache sorted from oldest to newest
 	mutable idRoutingCache* 	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
@@ -148,8 +146,6 @@ private:	// routing
 	bool						SetupRouting();
 	void						ShutdownRouting();
 	unsigned short				AreaTravelTime( int areaNum, const idVec3& start, const idVec3& end ) const;
-	void						CalculateAreaTravelTimes();
-	void						DeleteAreaTravelTimes();
 	void						SetupRoutingCache();
 	void						DeleteClusterCache( int clusterNum );
 	void						DeletePortalCache();
@@ -90,123 +90,7 @@ idAASLocal::AreaTravelTime
 */
 unsigned short idAASLocal::AreaTravelTime( int areaNum, const idVec3& start, const idVec3& end ) const
 {
-	float dist;
-	
-	dist = ( end - start ).Length();
-	
-	if( file->GetArea( areaNum ).travelFlags & TFL_CROUCH )
-	{
-		dist *= 100.0f / 100.0f;
-	}
-	else if( file->GetArea( areaNum ).travelFlags & TFL_WATER )
-	{
-		dist *= 100.0f / 150.0f;
-	}
-	else
-	{
-		dist *= 100.0f / 300.0f;
-	}
-	if( dist < 1.0f )
-	{
-		return 1;
-	}
-	return ( unsigned short ) idMath::Ftoi( dist );
-}
-
-/*
-============
-idAASLocal::CalculateAreaTravelTimes
-============
-*/
-void idAASLocal::CalculateAreaTravelTimes()
-{
-	int n, i, j, numReach, numRevReach, t, maxt;
-	byte* bytePtr;
-	idReachability* reach, *rev_reach;
-	
-	// get total memory for all area travel times
-	numAreaTravelTimes = 0;
-	for( n = 0; n < file->GetNumAreas(); n++ )
-	{
-	
-		if( !( file->GetArea( n ).flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) )
-		{
-			continue;
-		}
-		
-		numReach = 0;
-		for( reach = file->GetArea( n ).reach; reach; reach = reach->next )
-		{
-			numReach++;
-		}
-		
-		numRevReach = 0;
-		for( rev_reach = file->GetArea( n ).rev_reach; rev_reach; rev_reach = rev_reach->rev_next )
-		{
-			numRevReach++;
-		}
-		numAreaTravelTimes += numReach * numRevReach;
-	}
-	
-	areaTravelTimes = ( unsigned short* ) Mem_Alloc( numAreaTravelTimes * sizeof( unsigned short ), TAG_AAS );
-	bytePtr = ( byte* ) areaTravelTimes;
-	
-	for( n = 0; n < file->GetNumAreas(); n++ )
-	{
-	
-		if( !( file->GetArea( n ).flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) )
-		{
-			continue;
-		}
-		
-		// for each reachability that starts in this area calculate the travel time
-		// towards all the reachabilities that lead towards this area
-		for( maxt = i = 0, reach = file->GetArea( n ).reach; reach; reach = reach->next, i++ )
-		{
-			assert( i < MAX_REACH_PER_AREA );
-			if( i >= MAX_REACH_PER_AREA )
-			{
-				gameLocal.Error( "i >= MAX_REACH_PER_AREA" );
-			}
-			reach->number = i;
-			reach->disableCount = 0;
-			reach->areaTravelTimes = ( unsigned short* ) bytePtr;
-			for( j = 0, rev_reach = file->GetArea( n ).rev_reach; rev_reach; rev_reach = rev_reach->rev_next, j++ )
-			{
-				t = AreaTravelTime( n, reach->start, rev_reach->end );
-				reach->areaTravelTimes[j] = t;
-				if( t > maxt )
-				{
-					maxt = t;
-				}
-			}
-			bytePtr += j * sizeof( unsigned short );
-		}
-		
-		// if this area is a portal
-		if( file->GetArea( n ).cluster < 0 )
-		{
-			// set the maximum travel time through this portal
-			file->SetPortalMaxTravelTime( -file->GetArea( n ).cluster, maxt );
-		}
-	}
-	
-	// RB: 64 bit fixes, changed unsigned int to ptrdiff_t
-	assert( ( ( ptrdiff_t ) bytePtr - ( ptrdiff_t ) areaTravelTimes ) <= numAreaTravelTimes * sizeof( unsigned short ) );
-	// RB end
-	
-}
-
-/*
-============
-idAASLocal::DeleteAreaTravelTimes
-============
-*/
-void idAASLocal::DeleteAreaTravelTimes()
-{
-	Mem_Free( areaTravelTimes );
-	areaTravelTimes = NULL;
-	numAreaTravelTimes = 0;
+	return file->AreaTravelTime( areaNum, start, end );
 }
 
 /*
@@ -327,7 +211,7 @@ idAASLocal::SetupRouting
 */
 bool idAASLocal::SetupRouting()
 {
-	CalculateAreaTravelTimes();
+	// the area travel times are calculated by the AAS file when it is loaded
 	SetupRoutingCache();
 	return true;
 }
@@ -339,7 +223,6 @@ idAASLocal::ShutdownRouting
 */
 void idAASLocal::ShutdownRouting()
 {
-	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
 }
 
@@ -373,7 +256,7 @@ void idAASLocal::RoutingStats() const
 	gameLocal.Printf( "%6d area cache (%d KB)\n", numAreaCache, totalAreaCacheMemory >> 10 );
 	gameLocal.Printf( "%6d portal cache (%d KB)\n", numPortalCache, totalPortalCacheMemory >> 10 );
 	gameLocal.Printf( "%6d total cache (%d KB)\n", numAreaCache + numPortalCache, totalCacheMemory >> 10 );
-	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
+	gameLocal.Printf( "%6d area travel times (%d KB)\n", file->GetNumAreaTravelTimes(), ( file->GetNumAreaTravelTimes() * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache* ) ) >> 10 );
 }
@@ -0,0 +1,356 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "AsyncLog.h"
+
+idCVar com_logFileTimestamps( "logFileTimestamps", "0", CVAR_SYSTEM | CVAR_NOCHEAT | CVAR_BOOL, "start each line in the log file with the time and the id of the printing thread" );
+
+static const int LOG_FLUSH_MSEC = 1000;		// flush interval for logFile 1
+
+// set while the last message of a thread didn't end with a new line
+static ID_TLS logMidLine;
+
+/*
+================================================
+idAsyncLogThread
+================================================
+*/
+class idAsyncLogThread : public idSysThread
+{
+public:
+	idAsyncLogThread( idAsyncLog* log_ ) : log( log_ ) {}
+	
+	virtual int Run()
+	{
+		int lastFlushTime = Sys_Milliseconds();
+		while( !IsTerminating() )
+		{
+			log->writeSignal.Wait( LOG_FLUSH_MSEC );
+			
+			log->drainMutex.Lock();
+			const int numDrained = log->Drain();
+			const int time = Sys_Milliseconds();
+			if( ( numDrained > 0 && log->flushEachPrint ) || time - lastFlushTime >= LOG_FLUSH_MSEC )
+			{
+				log->file->Flush();
+				lastFlushTime = time;
+			}
+			log->drainMutex.Unlock();
+		}
+		return 0;
+	}
+	
+private:
+	idAsyncLog* 	log;
+};
+
+/*
+========================
+idAsyncLog::idAsyncLog
+========================
+*/
+idAsyncLog::idAsyncLog() : writeSignal( false )
+{
+	slots = NULL;
+	readIndex = 0;
+	thread = NULL;
+	file = NULL;
+	flushEachPrint = false;
+}
+
+/*
+========================
+idAsyncLog::~idAsyncLog
+========================
+*/
+idAsyncLog::~idAsyncLog()
+{
+	// only reached without Close() when the process exits early, the file system
+	// may already be gone so just get the text out
+	StopThread();
+	Flush();
+	delete[] slots;
+	slots = NULL;
+}
+
+/*
+========================
+idAsyncLog::StopThread
+========================
+*/
+void idAsyncLog::StopThread()
+{
+	if( thread != NULL )
+	{
+		thread->StopThread( false );
+		writeSignal.Raise();
+		thread->WaitForThread();
+		delete thread;
+		thread = NULL;
+	}
+}
+
+/*
+========================
+idAsyncLog::Open
+========================
+*/
+void idAsyncLog::Open( idFile* file_, bool flushEachPrint_ )
+{
+	Close();
+	
+	// the slots are never freed while the log is in use, a print racing with Close()
+	// may still be copying into one
+	if( slots == NULL )
+	{
+		slots = new( TAG_IDFILE ) logSlot_t[ NUM_SLOTS ];
+	}
+	for( int i = 0; i < NUM_SLOTS; i++ )
+	{
+		slots[i].sequence.SetValue( i );
+		slots[i].length = 0;
+	}
+	writeIndex.SetValue( 0 );
+	readIndex = 0;
+	numStalls.SetValue( 0 );
+	flushEachPrint = flushEachPrint_;
+	
+	// prints are accepted from here on, they drain themselves if the thread can't be started
+	file = file_;
+	
+	thread = new( TAG_IDFILE ) idAsyncLogThread( this );
+	if( !thread->StartThread( "AsyncLog", CORE_ANY, THREAD_BELOW_NORMAL ) )
+	{
+		delete thread;
+		thread = NULL;
+	}
+}
+
+/*
+========================
+idAsyncLog::Close
+========================
+*/
+void idAsyncLog::Close()
+{
+	if( file == NULL )
+	{
+		return;
+	}
+	
+	StopThread();
+	
+	// a print spinning on a full ring drains under the same mutex, so it has
+	// to see either the open file or NULL
+	drainMutex.Lock();
+	idFile* f = file;
+	Drain();
+	f->Flush();
+	file = NULL;
+	drainMutex.Unlock();
+	
+	fileSystem->CloseFile( f );
+}
+
+/*
+========================
+idAsyncLog::Write
+========================
+*/
+void idAsyncLog::Write( const char* msg )
+{
+	if( file == NULL || msg == NULL || msg[0] == '\0' )
+	{
+		return;
+	}
+	
+	char header[64];
+	int headerLength = 0;
+	if( !logMidLine && com_logFileTimestamps.GetBool() )
+	{
+		const uint64 threadID = ( uint64 )Sys_GetCurrentThreadID();
+		headerLength = idStr::snPrintf( header, sizeof( header ), "[%9.3f][%08x] ", Sys_Milliseconds() * 0.001f, ( unsigned int )( threadID ^ ( threadID >> 32 ) ) );
+	}
+	
+	const int msgLength = idStr::Length( msg );
+	logMidLine = ( msg[ msgLength - 1 ] != '\n' );
+	
+	WriteSlots( header, headerLength, msg, msgLength );
+	
+	if( flushEachPrint )
+	{
+		writeSignal.Raise();
+	}
+}
+
+/*
+========================
+idAsyncLog::WriteSlots
+========================
+*/
+void idAsyncLog::WriteSlots( const char* header, int headerLength, const char* msg, int msgLength )
+{
+	// never let a single message take more than a quarter of the ring
+	const int maxLength = ( NUM_SLOTS / 4 ) * SLOT_TEXT_SIZE - headerLength;
+	msgLength = Min( msgLength, maxLength );
+	
+	const int totalLength = headerLength + msgLength;
+	const int numSlots = ( totalLength + SLOT_TEXT_SIZE - 1 ) / SLOT_TEXT_SIZE;
+	
+	// a single add reserves consecutive slots, so the message can't be split by other threads
+	const int start = writeIndex.Add( numSlots ) - numSlots;
+	
+	int copied = 0;
+	bool stalled = false;
+	for( int i = 0; i < numSlots; i++ )
+	{
+		const int index = start + i;
+		logSlot_t& slot = slots[ index & SLOT_MASK ];
+		
+		// the ring is full, wait for the writer or drain it right here if the writer is busy
+		while( slot.sequence.GetValue() != index )
+		{
+			if( !stalled )
+			{
+				numStalls.Increment();
+				stalled = true;
+			}
+			writeSignal.Raise();
+			if( drainMutex.Lock( false ) )
+			{
+				Drain();
+				drainMutex.Unlock();
+			}
+			else
+			{
+				Sys_Yield();
+			}
+		}
+		
+		int length = 0;
+		while( length < SLOT_TEXT_SIZE && copied < totalLength )
+		{
+			const int n = Min( SLOT_TEXT_SIZE - length, ( copied < headerLength ) ? headerLength - copied : totalLength - copied );
+			const char* src = ( copied < headerLength ) ? header + copied : msg + ( copied - headerLength );
+			memcpy( slot.text + length, src, n );
+			length += n;
+			copied += n;
+		}
+		slot.length = length;
+		
+		// publishes the slot to the writer
+		slot.sequence.Increment();
+	}
+}
+
+/*
+========================
+idAsyncLog::Drain
+
+Writes all published slots in order, drainMutex has to be held. Stops at the first slot
+that was reserved but not written yet. Once the log is closed the slots are only handed
+back, so prints that raced with Close() don't wait forever.
+========================
+*/
+int idAsyncLog::Drain()
+{
+	if( slots == NULL )
+	{
+		return 0;
+	}
+	
+	if( file == NULL )
+	{
+		int numDiscarded = 0;
+		while( slots[ readIndex & SLOT_MASK ].sequence.GetValue() == readIndex + 1 )
+		{
+			slots[ readIndex & SLOT_MASK ].sequence.Add( NUM_SLOTS - 1 );
+			readIndex++;
+			numDiscarded++;
+		}
+		return numDiscarded;
+	}
+	
+	char buffer[ 16 * 1024 ];
+	int used = 0;
+	int numDrained = 0;
+	while( 1 )
+	{
+		logSlot_t& slot = slots[ readIndex & SLOT_MASK ];
+		if( slot.sequence.GetValue() != readIndex + 1 )
+		{
+			break;
+		}
+		
+		if( used + slot.length > ( int )sizeof( buffer ) )
+		{
+			file->Write( buffer, used );
+			used = 0;
+		}
+		memcpy( buffer + used, slot.text, slot.length );
+		used += slot.length;
+		
+		// hand the slot back for the message NUM_SLOTS further down the ring
+		slot.sequence.Add( NUM_SLOTS - 1 );
+		readIndex++;
+		numDrained++;
+	}
+	
+	if( used > 0 )
+	{
+		file->Write( buffer, used );
+	}
+	return numDrained;
+}
+
+/*
+========================
+idAsyncLog::Flush
+========================
+*/
+void idAsyncLog::Flush( bool wait )
+{
+	if( file == NULL )
+	{
+		return;
+	}
+	
+	if( !drainMutex.Lock( wait ) )
+	{
+		return;
+	}
+	if( file != NULL )
+	{
+		Drain();
+		file->Flush();
+	}
+	drainMutex.Unlock();
+}
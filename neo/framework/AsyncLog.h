@@ -0,0 +1,108 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __ASYNCLOG_H__
+#define __ASYNCLOG_H__
+
+/*
+================================================================================================
+
+Asynchronous log file
+
+Any thread can print into a fixed size ring of slots without taking a lock, a background
+thread drains the ring into the log file. A message that doesn't fit in one slot takes
+several consecutive slots, they are reserved with a single atomic add so messages from
+different threads never interleave. When the ring is full the printing thread waits for
+the writer, so memory use is bounded.
+
+Flush() drains the ring on the calling thread and must be used before anything that
+terminates the process without going through Close(). The crash handlers reach it through
+idCommon::FlushLogFile().
+
+================================================================================================
+*/
+
+class idAsyncLogThread;
+
+class idAsyncLog
+{
+	friend class idAsyncLogThread;
+public:
+	idAsyncLog();
+	~idAsyncLog();
+	
+	// takes ownership of the file, the file system is only used again by Close()
+	void					Open( idFile* file, bool flushEachPrint );
+	void					Close();
+	bool					IsOpen() const
+	{
+		return file != NULL;
+	}
+	
+	// thread safe, prefixes the time and thread id if the message starts a new line
+	void					Write( const char* msg );
+	
+	// drains the ring and flushes the file on the calling thread, if wait is false it
+	// gives up when another thread is draining, which a crash may have interrupted
+	void					Flush( bool wait = true );
+	
+	// number of prints that had to wait for the writer since Open()
+	int						GetNumStalls() const
+	{
+		return numStalls.GetValue();
+	}
+	
+private:
+	static const int		SLOT_BITS = 12;
+	static const int		NUM_SLOTS = 1 << SLOT_BITS;
+	static const int		SLOT_MASK = NUM_SLOTS - 1;
+	static const int		SLOT_TEXT_SIZE = 248;
+	
+	struct logSlot_t
+	{
+		idSysInterlockedInteger	sequence;	// slot index when free, index + 1 once written
+		int						length;
+		char					text[SLOT_TEXT_SIZE];
+	};
+	
+	logSlot_t* 				slots;
+	idSysInterlockedInteger	writeIndex;		// next slot to reserve
+	int						readIndex;		// next slot to drain, only changed with drainMutex held
+	idSysMutex				drainMutex;
+	idSysSignal				writeSignal;
+	idAsyncLogThread* 		thread;
+	idFile* 				file;
+	bool					flushEachPrint;
+	idSysInterlockedInteger	numStalls;		// prints that had to wait for the writer
+	
+	void					StopThread();
+	void					WriteSlots( const char* header, int headerLength, const char* msg, int msgLength );
+	int						Drain();
+};
+
+#endif // !__ASYNCLOG_H__
@@ -156,8 +156,6 @@ idCommonLocal::idCommonLocal() :
 	com_shuttingDown = false;
 	com_isJapaneseSKU = false;
 	
-	logFile = NULL;
-	
 	strcpy( errorMessage, "" );
 	
 	rd_buffer = NULL;
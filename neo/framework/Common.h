@@ -76,11 +76,20 @@ class idMatchParameters;
 
 struct lobbyConnectInfo_t;
 
+// the color is only used by platform profilers, idProfiler records the name
 ID_INLINE void BeginProfileNamedEventColor( uint32 color, VERIFY_FORMAT_STRING const char* szName )
 {
+	if( idProfiler::IsRecording() )
+	{
+		idProfiler::BeginZone( szName );
+	}
 }
 ID_INLINE void EndProfileNamedEvent()
 {
+	if( idProfiler::IsRecording() )
+	{
+		idProfiler::EndZone();
+	}
 }
 
 ID_INLINE void BeginProfileNamedEvent( VERIFY_FORMAT_STRING const char* szName )
@@ -259,6 +268,9 @@ public:
 	// Prints all queued warnings.
 	virtual void				PrintWarnings() = 0;
 	
+	// Writes everything printed so far to the log file, safe to call from crash handlers.
+	virtual void				FlushLogFile() = 0;
+	
 	// Removes all queued warnings.
 	virtual void				ClearWarnings( const char* reason ) = 0;
 	
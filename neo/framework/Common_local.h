@@ -27,6 +27,8 @@ If you have questions concerning this license or the applicable additional terms
 
 ===========================================================================
 */
+#include "AsyncLog.h"
+
 static const int MAX_USERCMD_BACKUP = 256;
 static const int NUM_USERCMD_RELAY = 10;
 static const int NUM_USERCMD_SEND = 8;
@@ -166,6 +168,7 @@ public:
 	virtual void				Warning( VERIFY_FORMAT_STRING const char* fmt, ... );
 	virtual void				DWarning( VERIFY_FORMAT_STRING const char* fmt, ... );
 	virtual void				PrintWarnings();
+	virtual void				FlushLogFile();
 	virtual void				ClearWarnings( const char* reason );
 	virtual void				Error( VERIFY_FORMAT_STRING const char* fmt, ... );
 	virtual void				FatalError( VERIFY_FORMAT_STRING const char* fmt, ... );
@@ -367,7 +370,7 @@ private:
 	bool						com_shuttingDown;
 	bool						com_isJapaneseSKU;
 	
-	idFile* 					logFile;
+	idAsyncLog					logFile;
 	
 	char						errorMessage[MAX_PRINT_MSG_SIZE];
 	
@@ -32,7 +32,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Common_local.h"
 
-idCVar com_logFile( "logFile", "0", CVAR_SYSTEM | CVAR_NOCHEAT, "1 = buffer log, 2 = flush after each print", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+idCVar com_logFile( "logFile", "0", CVAR_SYSTEM | CVAR_NOCHEAT, "1 = buffer log, flushed every second, 2 = flush after each print", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 idCVar com_logFileName( "logFileName", "qconsole.log", CVAR_SYSTEM | CVAR_NOCHEAT, "name of log file, if empty, qconsole.log will be used" );
 idCVar com_timestampPrints( "com_timestampPrints", "0", CVAR_SYSTEM, "print time with each console print, 1 = msec, 2 = sec", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 
@@ -82,14 +82,29 @@ idCommonLocal::CloseLogFile
 */
 void idCommonLocal::CloseLogFile()
 {
-	if( logFile )
+	if( logFile.IsOpen() )
 	{
+		if( logFile.GetNumStalls() > 0 )
+		{
+			Printf( "log file: %d prints had to wait for the log writer\n", logFile.GetNumStalls() );
+		}
 		com_logFile.SetBool( false ); // make sure no further VPrintf attempts to open the log file again
-		fileSystem->CloseFile( logFile );
-		logFile = NULL;
+		logFile.Close();
 	}
 }
 
+/*
+==================
+idCommonLocal::FlushLogFile
+
+Called from the crash handlers, which may have interrupted a thread that was draining the log
+==================
+*/
+void idCommonLocal::FlushLogFile()
+{
+	logFile.Flush( false );
+}
+
 /*
 ==================
 idCommonLocal::SetRefreshOnPrint
@@ -187,6 +202,13 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 		printf( "%s", msg );
 #endif
 		// RB end
+		
+		// the log is thread safe, but only the main thread opens it
+		if( logFile.IsOpen() )
+		{
+			idStr::RemoveColors( msg );
+			logFile.Write( msg );
+		}
 		return;
 	}
 	
@@ -216,15 +238,15 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 	{
 		static bool recursing;
 		
-		if( !logFile && !recursing )
+		if( !logFile.IsOpen() && !recursing )
 		{
 			const char* fileName = com_logFileName.GetString()[0] ? com_logFileName.GetString() : "qconsole.log";
 			
 			// fileSystem->OpenFileWrite can cause recursive prints into here
 			recursing = true;
 			
-			logFile = fileSystem->OpenFileWrite( fileName );
-			if( !logFile )
+			idFile* f = fileSystem->OpenFileWrite( fileName );
+			if( !f )
 			{
 				logFileFailed = true;
 				FatalError( "failed to open log file '%s'\n", fileName );
@@ -236,19 +258,18 @@ void idCommonLocal::VPrintf( const char* fmt, va_list args )
 			{
 				// force it to not buffer so we get valid
 				// data even if we are crashing
-				logFile->ForceFlush();
+				f->ForceFlush();
 			}
 			
+			// the file is written by the log thread from here on
+			logFile.Open( f, com_logFile.GetInteger() > 1 );
+			
 			time_t aclock;
 			time( &aclock );
 			struct tm* newtime = localtime( &aclock );
 			Printf( "log file '%s' opened on %s\n", fileName, asctime( newtime ) );
 		}
-		if( logFile )
-		{
-			logFile->Write( msg, strlen( msg ) );
-			logFile->Flush();	// ForceFlush doesn't help a whole lot
-		}
+		logFile.Write( msg );
 	}
 	
 	// don't trigger any updates if we are in the process of doing a fatal error
@@ -569,6 +590,9 @@ void idCommonLocal::Error( const char* fmt, ... )
 		cmdSystem->BufferCommandText( CMD_EXEC_NOW, "vid_restart partial windowed\n" );
 	}
 	
+	// Sys_Error doesn't return, get everything buffered into the log file
+	logFile.Flush();
+	
 	Sys_Error( "%s", errorMessage );
 	
 }
@@ -607,6 +631,7 @@ void idCommonLocal::FatalError( const char* fmt, ... )
 		Sys_Printf( "%s\n", errorMessage );
 		
 		// write the console to a log file?
+		logFile.Flush();
 		Sys_Quit();
 	}
 	com_errorEntered = ERP_FATAL;
@@ -623,6 +648,16 @@ void idCommonLocal::FatalError( const char* fmt, ... )
 	
 	Sys_SetFatalError( errorMessage );
 	
+	// the fatal error isn't printed, but it should be the last thing in the log file
+	if( logFile.IsOpen() )
+	{
+		idStr fatalMessage = "FATAL ERROR: ";
+		fatalMessage += errorMessage;
+		fatalMessage += "\n";
+		logFile.Write( fatalMessage );
+		logFile.Flush();
+	}
+	
 	Sys_Error( "%s", errorMessage );
 	
 }
@@ -31,6 +31,26 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 
+/*
+=================
+idDeclEntityDef::idDeclEntityDef
+=================
+*/
+idDeclEntityDef::idDeclEntityDef()
+{
+	sharedDict = NULL;
+}
+
+/*
+=================
+idDeclEntityDef::~idDeclEntityDef
+=================
+*/
+idDeclEntityDef::~idDeclEntityDef()
+{
+	idDict::FreeShared( sharedDict );
+}
+
 /*
 =================
 idDeclEntityDef::Size
@@ -38,7 +58,7 @@ idDeclEntityDef::Size
 */
 size_t idDeclEntityDef::Size() const
 {
-	return sizeof( idDeclEntityDef ) + dict.Allocated();
+	return sizeof( idDeclEntityDef ) + dict.Allocated() + ( ( sharedDict != NULL ) ? sharedDict->Size() : 0 );
 }
 
 /*
@@ -49,14 +69,18 @@ idDeclEntityDef::FreeData
 void idDeclEntityDef::FreeData()
 {
 	dict.Clear();
+	
+	// entities spawned from the old data keep their reference until they are removed
+	idDict::FreeShared( sharedDict );
+	sharedDict = NULL;
 }
 
 /*
 ================
-idDeclEntityDef::Parse
+idDeclEntityDef::ParseKeyValues
 ================
 */
-bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowBinaryVersion )
+bool idDeclEntityDef::ParseKeyValues( const char* text, const int textLength )
 {
 	idLexer src;
 	idToken	token, token2;
@@ -79,14 +103,12 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 		if( token.type != TT_STRING )
 		{
 			src.Warning( "Expected quoted string, but found '%s'", token.c_str() );
-			MakeDefault();
 			return false;
 		}
 		
 		if( !src.ReadToken( &token2 ) )
 		{
 			src.Warning( "Unexpected end of file" );
-			MakeDefault();
 			return false;
 		}
 		
@@ -97,6 +119,45 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 		dict.Set( token, token2 );
 	}
 	
+	return true;
+}
+
+/*
+================
+idDeclEntityDef::Parse
+================
+*/
+bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowBinaryVersion )
+{
+	// the binary version holds the key / value pairs of this decl only, inheritance
+	// is always resolved against the current parent decls
+	bool loadedBinary = false;
+	if( allowBinaryVersion )
+	{
+		idFileLocal file( declManager->ReadBinaryCache( this ) );
+		if( file != NULL )
+		{
+			dict.ReadFromFileHandle( file );
+			loadedBinary = true;
+		}
+	}
+	
+	if( !loadedBinary )
+	{
+		if( !ParseKeyValues( text, textLength ) )
+		{
+			MakeDefault();
+			return false;
+		}
+		
+		if( allowBinaryVersion )
+		{
+			idFile_Memory payload;
+			dict.WriteToFileHandle( &payload );
+			declManager->WriteBinaryCache( this, payload );
+		}
+	}
+	
 	// we always automatically set a "classname" key to our name
 	dict.Set( "classname", GetName() );
 	
@@ -119,7 +180,7 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 		const idDeclEntityDef* copy = static_cast<const idDeclEntityDef*>( declManager->FindType( DECL_ENTITYDEF, kv->GetValue(), false ) );
 		if( !copy )
 		{
-			src.Warning( "Unknown entityDef '%s' inherited by '%s'", kv->GetValue().c_str(), GetName() );
+			common->Warning( "file %s, line %d: Unknown entityDef '%s' inherited by '%s'", GetFileName(), GetLineNum(), kv->GetValue().c_str(), GetName() );
 		}
 		else
 		{
@@ -142,6 +203,12 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 		game->CacheDictionaryMedia( &dict );
 	}
 	
+	// entityDefs are only read from here on
+	dict.Freeze();
+	
+	idDict::FreeShared( sharedDict );
+	sharedDict = idDict::AllocShared( dict );
+	
 	return true;
 }
 
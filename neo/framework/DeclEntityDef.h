@@ -43,11 +43,25 @@ class idDeclEntityDef : public idDecl
 public:
 	idDict					dict;
 	
+	idDeclEntityDef();
+	virtual					~idDeclEntityDef();
+	
+	// shared copy of dict that spawnArgs are layered on, see idDict::SetSharedDefaults
+	const idDict* 			GetSharedDict() const
+	{
+		return sharedDict;
+	}
+	
 	virtual size_t			Size() const;
 	virtual const char* 	DefaultDefinition() const;
 	virtual bool			Parse( const char* text, const int textLength, bool allowBinaryVersion );
 	virtual void			FreeData();
 	virtual void			Print();
+	
+private:
+	const idDict* 			sharedDict;
+	
+	bool					ParseKeyValues( const char* text, const int textLength );
 };
 
 #endif /* !__DECLENTITYDEF_H__ */
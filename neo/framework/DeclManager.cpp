@@ -33,6 +33,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "../d3xp/gamesys/Event.h"
 #include "../d3xp/gamesys/Class.h"
 #include "../d3xp/anim/Anim.h"
+#include "LoadPipeline.h"
 
 /*
 
@@ -161,6 +162,87 @@ private:
 	idDeclLocal* 				nextInFile;				// next decl in the decl file
 };
 
+// one decl found while scanning a decl file
+struct declFileSpan_t
+{
+	declType_t					type;
+	idStr						name;
+	int							offset;					// offset of the decl type / name in the file text
+	int							length;
+	int							line;
+};
+
+// result of idDeclFile::ScanText
+struct declFileScan_t
+{
+	char* 						buffer;					// '\0' terminated file text
+	int							length;
+	ID_TIME_T					timestamp;
+	int							checksum;
+	int							numLines;
+	idList< declFileSpan_t >	spans;
+	idStrList					warnings;				// printed by RegisterDecls so they reach the console
+	bool						failed;					// the text couldn't be lexed, RegisterDecls raises the error
+};
+
+/*
+================================================
+idDeclBinaryCache
+
+Pre-parsed payloads for the decls of one decl file, stored in generated/decls/<file>.bdecl.
+The whole cache is dropped when the MD5 checksum of the decl file changes, every entry
+also keeps the checksum of its decl text so decls changed with SetText are reparsed.
+================================================
+*/
+static const int BDECL_VERSION = 1;
+static const unsigned int BDECL_MAGIC = ( 'B' << 24 ) | ( 'D' << 16 ) | ( 'C' << 8 ) | BDECL_VERSION;
+
+class idDeclBinaryCache
+{
+public:
+	idDeclBinaryCache()
+	{
+		fileChecksum = 0;
+		loaded = false;
+		dirty = false;
+	}
+	
+	void						Clear();
+	void						Load( const char* declFileName, int checksum );
+	void						Write( const char* declFileName );
+	
+	// returns a view of the payload that stays valid until the next Add()
+	idFile* 					Read( declType_t type, const char* name, int declChecksum );
+	void						Add( declType_t type, const char* name, int declChecksum, idFile_Memory& payload );
+	
+	bool						IsLoaded() const
+	{
+		return loaded;
+	}
+	bool						IsDirty() const
+	{
+		return dirty;
+	}
+	
+private:
+	struct entry_t
+	{
+		declType_t				type;
+		idStr					name;
+		int						declChecksum;
+		idList< byte >			payload;
+	};
+	
+	idList< entry_t >			entries;
+	idHashIndex					hash;
+	int							fileChecksum;
+	bool						loaded;
+	bool						dirty;
+	
+	int							FindEntry( declType_t type, const char* name ) const;
+	static void					GetGeneratedFileName( const char* declFileName, idStrStatic< MAX_OSPATH >& generatedFileName );
+};
+
 class idDeclFile
 {
 public:
@@ -170,6 +252,11 @@ public:
 	void						Reload( bool force );
 	int							LoadAndParse();
 	
+	// LoadAndParse is split in a scan that doesn't touch the decl manager and can run
+	// on any thread, and the registration of the found decls on the main thread
+	void						ScanText( declFileScan_t& scan ) const;
+	int							RegisterDecls( const declFileScan_t& scan );
+	
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -180,6 +267,7 @@ public:
 	int							numLines;
 	
 	idDeclLocal* 				decls;
+	idDeclBinaryCache			binaryCache;
 };
 
 class idDeclManagerLocal : public idDeclManager
@@ -237,6 +325,9 @@ public:
 	
 	virtual void					Touch( const idDecl* decl );
 	
+	virtual idFile* 				ReadBinaryCache( const idDecl* decl );
+	virtual void					WriteBinaryCache( const idDecl* decl, idFile_Memory& payload );
+	
 public:
 	static void					MakeNameCanonical( const char* name, char* result, int maxLength );
 	idDeclLocal* 				FindTypeWithoutParsing( declType_t type, const char* name, bool makeDefault = true );
@@ -269,6 +360,7 @@ private:
 	bool						insideLevelLoad;
 	
 	static idCVar				decl_show;
+	static idCVar				decl_binaryCache;
 	
 private:
 	static void					ListDecls_f( const idCmdArgs& args );
@@ -277,6 +369,7 @@ private:
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+idCVar idDeclManagerLocal::decl_binaryCache( "decl_binaryCache", "1", CVAR_SYSTEM | CVAR_BOOL, "load and write pre-parsed decls in generated/decls" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager* 		declManager = &declManagerLocal;
@@ -680,54 +773,81 @@ int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse()
 {
-	int			i, numTypes;
-	idLexer		src;
-	idToken		token;
-	int			startMarker;
-	char* 		buffer;
-	int			length, size;
-	int			sourceLine;
-	idStr		name;
-	idDeclLocal* newDecl;
-	bool		reparse;
+	declFileScan_t scan;
 	
 	// load the text
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, ( void** )&buffer, &timestamp );
-	if( length == -1 )
+	scan.length = fileSystem->ReadFile( fileName, ( void** )&scan.buffer, &scan.timestamp );
+	if( scan.length == -1 )
 	{
 		common->FatalError( "couldn't load %s", fileName.c_str() );
 		return 0;
 	}
 	
-	if( !src.LoadMemory( buffer, length, fileName ) )
-	{
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
-	}
+	ScanText( scan );
+	RegisterDecls( scan );
 	
-	// mark all the defs that were from the last reload of this file
-	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
+	Mem_Free( scan.buffer );
+	
+	return checksum;
+}
+
+/*
+================
+ScanWarning
+
+same output as idLexer::Warning, but kept for the main thread
+================
+*/
+static void ScanWarning( declFileScan_t& scan, idLexer& src, VERIFY_FORMAT_STRING const char* fmt, ... )
+{
+	char text[MAX_STRING_CHARS];
+	va_list ap;
+	
+	va_start( ap, fmt );
+	idStr::vsnPrintf( text, sizeof( text ), fmt, ap );
+	va_end( ap );
+	
+	idStr& warning = scan.warnings.Alloc();
+	sprintf( warning, "file %s, line %d: %s", src.GetFileName(), src.GetLineNum(), text );
+}
+
+/*
+================
+idDeclFile::ScanText
+
+Identifies each individual declaration in the file text. Only reads the registered
+decl types, so it's safe to run in parallel for different files.
+================
+*/
+void idDeclFile::ScanText( declFileScan_t& scan ) const
+{
+	idLexer		src;
+	idTokenView	token;
+	
+	scan.checksum = MD5_BlockChecksum( scan.buffer, scan.length );
+	scan.numLines = 0;
+	scan.spans.Clear();
+	scan.warnings.Clear();
+	scan.failed = false;
+	
+	// this runs on the scan threads, the error is raised on the main thread by RegisterDecls
+	if( !src.LoadMemory( scan.buffer, scan.length, fileName ) )
 	{
-		decl->redefinedInReload = false;
+		scan.failed = true;
+		return;
 	}
 	
 	src.SetFlags( DECL_LEXER_FLAGS );
 	
-	checksum = MD5_BlockChecksum( buffer, length );
-	
-	fileSize = length;
-	
 	// scan through, identifying each individual declaration
 	while( 1 )
 	{
-	
-		startMarker = src.GetFileOffset();
-		sourceLine = src.GetLineNum();
+		const int startMarker = src.GetFileOffset();
+		const int sourceLine = src.GetLineNum();
 		
 		// parse the decl type name
-		if( !src.ReadToken( &token ) )
+		if( !src.ReadTokenView( &token ) )
 		{
 			break;
 		}
@@ -735,11 +855,12 @@ int idDeclFile::LoadAndParse()
 		declType_t identifiedType = DECL_MAX_TYPES;
 		
 		// get the decl type from the type name
-		numTypes = declManagerLocal.GetNumDeclTypes();
+		const int numTypes = declManagerLocal.GetNumDeclTypes();
+		int i;
 		for( i = 0; i < numTypes; i++ )
 		{
 			idDeclType* typeInfo = declManagerLocal.GetDeclType( i );
-			if( typeInfo != NULL && typeInfo->typeName.Icmp( token ) == 0 )
+			if( typeInfo != NULL && token.Icmp( typeInfo->typeName ) == 0 )
 			{
 				identifiedType = ( declType_t ) typeInfo->type;
 				break;
@@ -753,7 +874,7 @@ int idDeclFile::LoadAndParse()
 			{
 			
 				// if we ever see an open brace, we somehow missed the [type] <name> prefix
-				src.Warning( "Missing decl name" );
+				ScanWarning( scan, src, "Missing decl name" );
 				src.SkipBracedSection( false );
 				continue;
 				
@@ -763,26 +884,26 @@ int idDeclFile::LoadAndParse()
 			
 				if( defaultType == DECL_MAX_TYPES )
 				{
-					src.Warning( "No type" );
+					ScanWarning( scan, src, "No type" );
 					continue;
 				}
-				src.UnreadToken( &token );
+				src.UnreadTokenView();
 				// use the default type
 				identifiedType = defaultType;
 			}
 		}
 		
 		// now parse the name
-		if( !src.ReadToken( &token ) )
+		if( !src.ReadTokenView( &token ) )
 		{
-			src.Warning( "Type without definition at end of file" );
+			ScanWarning( scan, src, "Type without definition at end of file" );
 			break;
 		}
 		
 		if( !token.Icmp( "{" ) )
 		{
 			// if we ever see an open brace, we somehow missed the [type] <name> prefix
-			src.Warning( "Missing decl name" );
+			ScanWarning( scan, src, "Missing decl name" );
 			src.SkipBracedSection( false );
 			continue;
 		}
@@ -794,35 +915,86 @@ int idDeclFile::LoadAndParse()
 			continue;
 		}
 		
-		name = token;
+		declFileSpan_t& span = scan.spans.Alloc();
+		token.ToStr( span.name );
 		
 		// make sure there's a '{'
-		if( !src.ReadToken( &token ) )
+		if( !src.ReadTokenView( &token ) )
 		{
-			src.Warning( "Type without definition at end of file" );
+			ScanWarning( scan, src, "Type without definition at end of file" );
+			scan.spans.RemoveIndex( scan.spans.Num() - 1 );
 			break;
 		}
 		if( token != "{" )
 		{
-			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
+			ScanWarning( scan, src, "Expecting '{' but found '%.*s'", token.Length(), token.Ptr() );
+			scan.spans.RemoveIndex( scan.spans.Num() - 1 );
 			continue;
 		}
-		src.UnreadToken( &token );
+		src.UnreadTokenView();
 		
 		// now take everything until a matched closing brace
 		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
+		
+		span.type = identifiedType;
+		span.offset = startMarker;
+		span.length = src.GetFileOffset() - startMarker;
+		span.line = sourceLine;
+	}
+	
+	scan.numLines = src.GetLineNum();
+}
+
+/*
+================
+idDeclFile::RegisterDecls
+
+Creates or updates the decls found by ScanText, scan.buffer has to stay valid until this returns
+================
+*/
+int idDeclFile::RegisterDecls( const declFileScan_t& scan )
+{
+	if( scan.failed )
+	{
+		common->Error( "Couldn't parse %s", fileName.c_str() );
+		return 0;
+	}
+	
+	// mark all the defs that were from the last reload of this file
+	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
+	{
+		decl->redefinedInReload = false;
+	}
+	
+	for( int i = 0; i < scan.warnings.Num(); i++ )
+	{
+		common->Warning( "%s", scan.warnings[ i ].c_str() );
+	}
+	
+	// a changed file invalidates all pre-parsed decls
+	if( scan.checksum != checksum )
+	{
+		binaryCache.Clear();
+	}
+	
+	timestamp = scan.timestamp;
+	checksum = scan.checksum;
+	fileSize = scan.length;
+	
+	for( int i = 0; i < scan.spans.Num(); i++ )
+	{
+		const declFileSpan_t& span = scan.spans[ i ];
 		
 		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
+		bool reparse = false;
+		idDeclLocal* newDecl = declManagerLocal.FindTypeWithoutParsing( span.type, span.name, false );
 		if( newDecl )
 		{
 			// update the existing copy
 			if( newDecl->sourceFile != this || newDecl->redefinedInReload )
 			{
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-							 name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), span.line, declManagerLocal.GetDeclNameFromType( span.type ),
+								 span.name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
 				continue;
 			}
 			if( newDecl->declState != DS_UNPARSED )
@@ -833,7 +1005,7 @@ int idDeclFile::LoadAndParse()
 		else
 		{
 			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
+			newDecl = declManagerLocal.FindTypeWithoutParsing( span.type, span.name, true );
 			newDecl->nextInFile = this->decls;
 			this->decls = newDecl;
 		}
@@ -846,11 +1018,11 @@ int idDeclFile::LoadAndParse()
 			newDecl->textSource = NULL;
 		}
 		
-		newDecl->SetTextLocal( buffer + startMarker, size );
+		newDecl->SetTextLocal( scan.buffer + span.offset, span.length );
 		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
+		newDecl->sourceTextOffset = span.offset;
+		newDecl->sourceTextLength = span.length;
+		newDecl->sourceLine = span.line;
 		newDecl->declState = DS_UNPARSED;
 		
 		// if it is currently in use, reparse it immedaitely
@@ -860,9 +1032,7 @@ int idDeclFile::LoadAndParse()
 		}
 	}
 	
-	numLines = src.GetLineNum();
-	
-	Mem_Free( buffer );
+	numLines = scan.numLines;
 	
 	// any defs that weren't redefinedInReload should now be defaulted
 	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
@@ -879,6 +1049,262 @@ int idDeclFile::LoadAndParse()
 	return checksum;
 }
 
+/*
+====================================================================================
+
+ idDeclBinaryCache
+
+====================================================================================
+*/
+
+/*
+================
+idDeclBinaryCache::Clear
+================
+*/
+void idDeclBinaryCache::Clear()
+{
+	entries.Clear();
+	hash.Clear();
+	fileChecksum = 0;
+	loaded = false;
+	dirty = false;
+}
+
+/*
+================
+idDeclBinaryCache::GetGeneratedFileName
+================
+*/
+void idDeclBinaryCache::GetGeneratedFileName( const char* declFileName, idStrStatic< MAX_OSPATH >& generatedFileName )
+{
+	generatedFileName = "generated/decls/";
+	generatedFileName.AppendPath( declFileName );
+	generatedFileName.Append( ".bdecl" );
+}
+
+/*
+================
+idDeclBinaryCache::FindEntry
+================
+*/
+int idDeclBinaryCache::FindEntry( declType_t type, const char* name ) const
+{
+	const int key = hash.GenerateKey( name, false );
+	for( int i = hash.First( key ); i != -1; i = hash.Next( i ) )
+	{
+		if( entries[ i ].type == type && entries[ i ].name.Icmp( name ) == 0 )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idDeclBinaryCache::Load
+
+The cache is marked loaded even if there was no valid file, so it's only looked for once
+================
+*/
+void idDeclBinaryCache::Load( const char* declFileName, int checksum )
+{
+	Clear();
+	loaded = true;
+	fileChecksum = checksum;
+	
+	idStrStatic< MAX_OSPATH > generatedFileName;
+	GetGeneratedFileName( declFileName, generatedFileName );
+	
+	idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+	if( file == NULL )
+	{
+		return;
+	}
+	
+	unsigned int magic = 0;
+	file->ReadBig( magic );
+	if( magic != BDECL_MAGIC )
+	{
+		return;
+	}
+	
+	int loadedChecksum = 0;
+	file->ReadBig( loadedChecksum );
+	if( loadedChecksum != checksum )
+	{
+		return;
+	}
+	
+	int numEntries = 0;
+	file->ReadBig( numEntries );
+	if( numEntries < 0 )
+	{
+		return;
+	}
+	entries.SetNum( numEntries );
+	
+	for( int i = 0; i < numEntries; i++ )
+	{
+		entry_t& entry = entries[ i ];
+		int type = 0;
+		int length = 0;
+		file->ReadBig( type );
+		file->ReadString( entry.name );
+		file->ReadBig( entry.declChecksum );
+		file->ReadBig( length );
+		if( length < 0 || file->Tell() + length > file->Length() )
+		{
+			Clear();
+			loaded = true;
+			fileChecksum = checksum;
+			return;
+		}
+		entry.type = ( declType_t )type;
+		entry.payload.SetNum( length );
+		file->Read( entry.payload.Ptr(), length );
+		hash.Add( hash.GenerateKey( entry.name, false ), i );
+	}
+}
+
+/*
+================
+idDeclBinaryCache::Write
+================
+*/
+void idDeclBinaryCache::Write( const char* declFileName )
+{
+	dirty = false;
+	
+	idStrStatic< MAX_OSPATH > generatedFileName;
+	GetGeneratedFileName( declFileName, generatedFileName );
+	
+	idFileLocal file( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+	if( file == NULL )
+	{
+		return;
+	}
+	
+	file->WriteBig( BDECL_MAGIC );
+	file->WriteBig( fileChecksum );
+	file->WriteBig( entries.Num() );
+	for( int i = 0; i < entries.Num(); i++ )
+	{
+		const entry_t& entry = entries[ i ];
+		file->WriteBig( ( int )entry.type );
+		file->WriteString( entry.name );
+		file->WriteBig( entry.declChecksum );
+		file->WriteBig( entry.payload.Num() );
+		file->Write( entry.payload.Ptr(), entry.payload.Num() );
+	}
+}
+
+/*
+================
+idDeclBinaryCache::Read
+================
+*/
+idFile* idDeclBinaryCache::Read( declType_t type, const char* name, int declChecksum )
+{
+	const int index = FindEntry( type, name );
+	if( index == -1 || entries[ index ].declChecksum != declChecksum )
+	{
+		return NULL;
+	}
+	const entry_t& entry = entries[ index ];
+	return new( TAG_IDFILE ) idFile_Memory( name, ( const char* )entry.payload.Ptr(), entry.payload.Num() );
+}
+
+/*
+================
+idDeclBinaryCache::Add
+================
+*/
+void idDeclBinaryCache::Add( declType_t type, const char* name, int declChecksum, idFile_Memory& payload )
+{
+	int index = FindEntry( type, name );
+	if( index == -1 )
+	{
+		index = entries.Num();
+		entries.Alloc();
+		hash.Add( hash.GenerateKey( name, false ), index );
+	}
+	
+	entry_t& entry = entries[ index ];
+	entry.type = type;
+	entry.name = name;
+	entry.declChecksum = declChecksum;
+	entry.payload.SetNum( payload.Length() );
+	memcpy( entry.payload.Ptr(), payload.GetDataPtr(), payload.Length() );
+	dirty = true;
+}
+
+/*
+================================================
+idDeclFileLoadItem
+
+Reads a decl file on the load pipeline I/O thread and scans it on a decode thread,
+the decls are registered on the main thread in the order the files were listed so
+the decl indices and idDeclManager::GetChecksum() don't depend on thread timing.
+================================================
+*/
+class idDeclFileLoadItem : public idLoadPipelineItem
+{
+public:
+	idDeclFileLoadItem( idDeclFile* declFile_ ) : declFile( declFile_ )
+	{
+		fileName = declFile->fileName;
+		scan.buffer = NULL;
+		scan.length = 0;
+		scan.timestamp = 0;
+		scan.checksum = 0;
+		scan.numLines = 0;
+		scan.failed = false;
+	}
+	virtual ~idDeclFileLoadItem()
+	{
+		Mem_Free( scan.buffer );
+	}
+	
+	// the lexer needs '\0' terminated text like ReadFile gives it
+	virtual bool Read()
+	{
+		if( !idLoadPipelineItem::Read() )
+		{
+			return false;
+		}
+		scan.length = GetFile()->Length();
+		scan.timestamp = GetFileTime();
+		scan.buffer = ( char* )Mem_Alloc( scan.length + 1, TAG_IDFILE );
+		memcpy( scan.buffer, GetFile()->GetDataPtr(), scan.length );
+		scan.buffer[scan.length] = '\0';
+		FreeData();
+		SetDataLength( scan.length );
+		return true;
+	}
+	virtual void Decode()
+	{
+		declFile->ScanText( scan );
+	}
+	virtual bool Finish()
+	{
+		common->DPrintf( "...loading '%s'\n", fileName.c_str() );
+		declFile->RegisterDecls( scan );
+		Mem_Free( scan.buffer );
+		scan.buffer = NULL;
+		return true;
+	}
+	virtual void Fallback()
+	{
+		declFile->LoadAndParse();
+	}
+	
+private:
+	idDeclFile* 				declFile;
+	declFileScan_t				scan;
+};
+
 /*
 ====================================================================================
 
@@ -1068,10 +1494,71 @@ void idDeclManagerLocal::EndLevelLoad()
 {
 	insideLevelLoad = false;
 	
+	// save the decls that were parsed from text for the next run
+	for( int i = 0; i < loadedFiles.Num(); i++ )
+	{
+		if( loadedFiles[i]->binaryCache.IsDirty() )
+		{
+			loadedFiles[i]->binaryCache.Write( loadedFiles[i]->fileName );
+		}
+	}
+	
 	// we don't need to do anything here, but the image manager, model manager,
 	// and sound sample manager will need to free media that was not referenced
 }
 
+/*
+===================
+idDeclManagerLocal::ReadBinaryCache
+===================
+*/
+idFile* idDeclManagerLocal::ReadBinaryCache( const idDecl* decl )
+{
+	if( !decl_binaryCache.GetBool() || decl == NULL )
+	{
+		return NULL;
+	}
+	
+	idDeclLocal* local = static_cast< idDeclLocal* >( decl->base );
+	idDeclFile* sourceFile = local->sourceFile;
+	if( sourceFile == NULL || sourceFile == &implicitDecls )
+	{
+		return NULL;
+	}
+	
+	if( !sourceFile->binaryCache.IsLoaded() )
+	{
+		sourceFile->binaryCache.Load( sourceFile->fileName, sourceFile->checksum );
+	}
+	return sourceFile->binaryCache.Read( local->type, local->name, local->checksum );
+}
+
+/*
+===================
+idDeclManagerLocal::WriteBinaryCache
+===================
+*/
+void idDeclManagerLocal::WriteBinaryCache( const idDecl* decl, idFile_Memory& payload )
+{
+	if( !decl_binaryCache.GetBool() || decl == NULL )
+	{
+		return;
+	}
+	
+	idDeclLocal* local = static_cast< idDeclLocal* >( decl->base );
+	idDeclFile* sourceFile = local->sourceFile;
+	if( sourceFile == NULL || sourceFile == &implicitDecls )
+	{
+		return;
+	}
+	
+	if( !sourceFile->binaryCache.IsLoaded() )
+	{
+		sourceFile->binaryCache.Load( sourceFile->fileName, sourceFile->checksum );
+	}
+	sourceFile->binaryCache.Add( local->type, local->name, local->checksum, payload );
+}
+
 /*
 ===================
 idDeclManagerLocal::RegisterDeclType
@@ -1136,6 +1623,10 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 	// scan for decl files
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 	
+	// read and scan the decl files in parallel, the decls are registered in file list order
+	idLoadPipeline pipeline( declFolder->folder );
+	pipeline.SetKeepOrder( true );
+	
 	// load and parse decl files
 	for( i = 0; i < fileList->GetNumFiles(); i++ )
 	{
@@ -1158,9 +1649,11 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 			df = new( TAG_DECL ) idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		pipeline.AddItem( new( TAG_DECL ) idDeclFileLoadItem( df ) );
 	}
 	
+	pipeline.Run( false );
+	
 	fileSystem->FreeFileList( fileList );
 }
 
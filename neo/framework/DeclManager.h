@@ -415,6 +415,15 @@ public:
 	virtual const idDeclModelDef*	ModelDefByIndex( int index, bool forceParse = true ) = 0;
 	
 	virtual void					Touch( const idDecl* decl ) = 0;
+	
+	// Binary decl cache for decl types that are expensive to parse from text.
+	// Returns the payload stored with WriteBinaryCache if neither the source file
+	// nor the decl text changed since, NULL otherwise. Only valid inside Parse().
+	// Only entityDefs use it. Particles already have their generated .bprt files, and
+	// materials and modelDefs register images, programs and animations while they
+	// parse, which a stored payload can't replay.
+	virtual idFile* 				ReadBinaryCache( const idDecl* decl ) = 0;
+	virtual void					WriteBinaryCache( const idDecl* decl, idFile_Memory& payload ) = 0;
 };
 
 extern idDeclManager* 		declManager;
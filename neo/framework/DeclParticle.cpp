@@ -1221,6 +1221,35 @@ idParticleStage::ParticleOrigin
 ===============
 */
 void idParticleStage::ParticleOrigin( particleGen_t* g, idVec3& origin ) const
+{
+	ParticleOriginPath( g, origin );
+	
+	// adjust for the per-particle smoke offset
+	origin *= g->axis;
+	origin += g->origin;
+	
+	// add gravity after adjusting for axis
+	if( worldGravity )
+	{
+		idVec3 gra( 0, 0, -gravity );
+		gra *= g->renderEnt->axis.Transpose();
+		origin += gra * g->age * g->age;
+	}
+	else
+	{
+		origin[2] -= gravity * g->age * g->age;
+	}
+}
+
+/*
+===============
+idParticleStage::ParticleOriginPath
+
+Distribution, direction and speed or the custom path of the particle, these
+consume the random numbers
+===============
+*/
+void idParticleStage::ParticleOriginPath( particleGen_t* g, idVec3& origin ) const
 {
 	if( customPathType == PPATH_STANDARD )
 	{
@@ -1417,22 +1446,34 @@ void idParticleStage::ParticleOrigin( particleGen_t* g, idVec3& origin ) const
 		
 		origin += offset;
 	}
+}
+
+/*
+==================
+idParticleStage::ParticleAngle
+==================
+*/
+float idParticleStage::ParticleAngle( particleGen_t* g ) const
+{
+	//
+	// constant rotation
+	//
+	float	angle;
 	
-	// adjust for the per-particle smoke offset
-	origin *= g->axis;
-	origin += g->origin;
+	angle = ( initialAngle ) ? initialAngle : 360 * g->random.RandomFloat();
 	
-	// add gravity after adjusting for axis
-	if( worldGravity )
+	float	angleMove = rotationSpeed.Integrate( g->frac, g->random ) * particleLife;
+	// have hald the particles rotate each way
+	if( g->index & 1 )
 	{
-		idVec3 gra( 0, 0, -gravity );
-		gra *= g->renderEnt->axis.Transpose();
-		origin += gra * g->age * g->age;
+		angle += angleMove;
 	}
 	else
 	{
-		origin[2] -= gravity * g->age * g->age;
+		angle -= angleMove;
 	}
+	
+	return angle / 180 * idMath::PI;
 }
 
 /*
@@ -1531,25 +1572,7 @@ int	idParticleStage::ParticleVerts( particleGen_t* g, idVec3 origin, idDrawVert*
 		return 4 * ( numTrails + 1 );
 	}
 	
-	//
-	// constant rotation
-	//
-	float	angle;
-	
-	angle = ( initialAngle ) ? initialAngle : 360 * g->random.RandomFloat();
-	
-	float	angleMove = rotationSpeed.Integrate( g->frac, g->random ) * particleLife;
-	// have hald the particles rotate each way
-	if( g->index & 1 )
-	{
-		angle += angleMove;
-	}
-	else
-	{
-		angle -= angleMove;
-	}
-	
-	angle = angle / 180 * idMath::PI;
+	float angle = ParticleAngle( g );
 	float c = idMath::Cos16( angle );
 	float s = idMath::Sin16( angle );
 	
@@ -1651,10 +1674,10 @@ void idParticleStage::ParticleTexCoords( particleGen_t* g, idDrawVert* verts ) c
 
 /*
 ==================
-idParticleStage::ParticleColors
+idParticleStage::ParticleFadeFraction
 ==================
 */
-void idParticleStage::ParticleColors( particleGen_t* g, idDrawVert* verts ) const
+float idParticleStage::ParticleFadeFraction( particleGen_t* g ) const
 {
 	float	fadeFraction = 1.0f;
 	
@@ -1679,6 +1702,18 @@ void idParticleStage::ParticleColors( particleGen_t* g, idDrawVert* verts ) cons
 		}
 	}
 	
+	return fadeFraction;
+}
+
+/*
+==================
+idParticleStage::ParticleColors
+==================
+*/
+void idParticleStage::ParticleColors( particleGen_t* g, idDrawVert* verts ) const
+{
+	float	fadeFraction = ParticleFadeFraction( g );
+	
 	for( int i = 0 ; i < 4 ; i++ )
 	{
 		float	fcolor = ( ( entityColor ) ? g->renderEnt->shaderParms[i] : color[i] ) * fadeFraction + fadeColor[i] * ( 1.0f - fadeFraction );
@@ -1698,6 +1733,89 @@ void idParticleStage::ParticleColors( particleGen_t* g, idDrawVert* verts ) cons
 	}
 }
 
+/*
+================
+CrossFadeParticle
+
+If we are doing strip-animation, we need to double the quad and cross fade it
+================
+*/
+static int CrossFadeParticle( const int animationFrames, const particleGen_t* g, idDrawVert* verts, const int numVerts )
+{
+	float	width = 1.0f / animationFrames;
+	float	frac = g->animationFrameFrac;
+	float	iFrac = 1.0f - frac;
+	
+	idVec2 tempST;
+	for( int i = 0 ; i < numVerts ; i++ )
+	{
+		verts[numVerts + i] = verts[i];
+		
+		tempST = verts[numVerts + i].GetTexCoord();
+		verts[numVerts + i].SetTexCoord( tempST.x + width, tempST.y );
+		
+		verts[numVerts + i].color[0] *= frac;
+		verts[numVerts + i].color[1] *= frac;
+		verts[numVerts + i].color[2] *= frac;
+		verts[numVerts + i].color[3] *= frac;
+		
+		verts[i].color[0] *= iFrac;
+		verts[i].color[1] *= iFrac;
+		verts[i].color[2] *= iFrac;
+		verts[i].color[3] *= iFrac;
+	}
+	
+	return numVerts * 2;
+}
+
+/*
+================
+SinCos16_SSE
+
+Four lanes of idMath::SinCos16, the same range reduction and polynomials
+so the results match the scalar version
+================
+*/
+static ID_INLINE void SinCos16_SSE( __m128 a, __m128& s, __m128& c )
+{
+	const __m128 vector_float_one = _mm_set1_ps( 1.0f );
+	const __m128 vector_float_two_pi = _mm_set1_ps( idMath::TWO_PI );
+	const __m128 vector_float_pi = _mm_set1_ps( idMath::PI );
+	
+	// a -= floorf( a * ONEOVER_TWOPI ) * TWO_PI, which doesn't change angles already in range
+	const __m128 f = _mm_mul_ps( a, _mm_set1_ps( idMath::ONEOVER_TWOPI ) );
+	__m128 whole = _mm_cvtepi32_ps( _mm_cvttps_epi32( f ) );
+	whole = _mm_sub_ps( whole, _mm_and_ps( _mm_cmpgt_ps( whole, f ), vector_float_one ) );
+	a = _mm_sub_ps( a, _mm_mul_ps( whole, vector_float_two_pi ) );
+	
+	const __m128 belowPi = _mm_cmplt_ps( a, vector_float_pi );
+	const __m128 aboveHalfPi = _mm_cmpgt_ps( a, _mm_set1_ps( idMath::HALF_PI ) );
+	const __m128 aboveThreeHalfPi = _mm_cmpgt_ps( a, _mm_set1_ps( idMath::PI + idMath::HALF_PI ) );
+	
+	const __m128 wrap = _mm_andnot_ps( belowPi, aboveThreeHalfPi );
+	const __m128 mirror = _mm_or_ps( _mm_and_ps( belowPi, aboveHalfPi ), _mm_andnot_ps( _mm_or_ps( belowPi, aboveThreeHalfPi ), _mm_cmpeq_ps( a, a ) ) );
+	
+	a = _mm_sel_ps( a, _mm_sub_ps( a, vector_float_two_pi ), wrap );
+	a = _mm_sel_ps( a, _mm_sub_ps( vector_float_pi, a ), mirror );
+	const __m128 d = _mm_sel_ps( vector_float_one, _mm_set1_ps( -1.0f ), mirror );
+	
+	const __m128 t = _mm_mul_ps( a, a );
+	
+	__m128 ps = _mm_madd_ps( _mm_set1_ps( -2.39e-08f ), t, _mm_set1_ps( 2.7526e-06f ) );
+	ps = _mm_madd_ps( ps, t, _mm_set1_ps( -1.98409e-04f ) );
+	ps = _mm_madd_ps( ps, t, _mm_set1_ps( 8.3333315e-03f ) );
+	ps = _mm_madd_ps( ps, t, _mm_set1_ps( -1.666666664e-01f ) );
+	ps = _mm_madd_ps( ps, t, vector_float_one );
+	s = _mm_mul_ps( a, ps );
+	
+	__m128 pc = _mm_madd_ps( _mm_set1_ps( -2.605e-07f ), t, _mm_set1_ps( 2.47609e-05f ) );
+	pc = _mm_madd_ps( pc, t, _mm_set1_ps( -1.3888397e-03f ) );
+	pc = _mm_madd_ps( pc, t, _mm_set1_ps( 4.16666418e-02f ) );
+	pc = _mm_madd_ps( pc, t, _mm_set1_ps( -4.999999963e-01f ) );
+	pc = _mm_madd_ps( pc, t, vector_float_one );
+	c = _mm_mul_ps( d, pc );
+}
+
 /*
 ================
 idParticleStage::CreateParticle
@@ -1740,31 +1858,256 @@ int idParticleStage::CreateParticle( particleGen_t* g, idDrawVert* verts ) const
 		return numVerts;
 	}
 	
-	// if we are doing strip-animation, we need to double the quad and cross fade it
-	float	width = 1.0f / animationFrames;
-	float	frac = g->animationFrameFrac;
-	float	iFrac = 1.0f - frac;
+	return CrossFadeParticle( animationFrames, g, verts, numVerts );
+}
+
+/*
+================
+idParticleStage::CreateParticles
+
+Creates a batch of particles four at a time. The path and the random rotation
+are evaluated per particle, after that the smoke transform, the gravity, the
+rotation and the quad corners of all four are done with SSE. The colors are
+packed with SSE as each particle is set up.
+
+All the particles of a batch must share the render entity and view.
+
+Aimed particles back up their origin for every trail quad and are created
+one at a time.
+
+Returns the number of verts created
+================
+*/
+int idParticleStage::CreateParticles( particleGen_t* gens, const int numGens, idDrawVert* verts ) const
+{
+	if( numGens <= 0 )
+	{
+		return 0;
+	}
 	
-	idVec2 tempST;
-	for( int i = 0 ; i < numVerts ; i++ )
+	if( orientation == POR_AIMED )
 	{
-		verts[numVerts + i] = verts[i];
+		int numVerts = 0;
+		for( int i = 0; i < numGens; i++ )
+		{
+			numVerts += CreateParticle( &gens[i], verts + numVerts );
+		}
+		return numVerts;
+	}
+	
+	const renderEntity_t* renderEnt = gens[0].renderEnt;
+	
+	// the gravity direction is the same for the whole batch
+	idVec3 gra( 0, 0, -gravity );
+	if( worldGravity )
+	{
+		gra *= renderEnt->axis.Transpose();
+	}
+	
+	// left = leftC * cos + leftS * sin, up = upC * cos + upS * sin
+	idVec3 leftC, leftS, upC, upS;
+	switch( orientation )
+	{
+		case POR_Z:
+		{
+			leftC.Set( 0, 1, 0 );
+			leftS.Set( 1, 0, 0 );
+			upC.Set( 1, 0, 0 );
+			upS.Set( 0, -1, 0 );
+			break;
+		}
+		case POR_X:
+		{
+			leftC.Set( 0, 1, 0 );
+			leftS.Set( 0, 0, 1 );
+			upC.Set( 0, 0, 1 );
+			upS.Set( 0, -1, 0 );
+			break;
+		}
+		case POR_Y:
+		{
+			leftC.Set( 1, 0, 0 );
+			leftS.Set( 0, 0, 1 );
+			upC.Set( 0, 0, 1 );
+			upS.Set( -1, 0, 0 );
+			break;
+		}
+		default:
+		{
+			// oriented in viewer space
+			idVec3	entityLeft, entityUp;
+			
+			renderEnt->axis.ProjectVector( gens[0].renderView->viewaxis[1], entityLeft );
+			renderEnt->axis.ProjectVector( gens[0].renderView->viewaxis[2], entityUp );
+			
+			leftC = entityLeft;
+			leftS = entityUp;
+			upC = entityUp;
+			upS = -entityLeft;
+			break;
+		}
+	}
+	
+	// the colors only change with the fade fraction of each particle
+	const __m128 baseColor = _mm_loadu_ps( ( entityColor ) ? renderEnt->shaderParms : color.ToFloatPtr() );
+	const __m128 fadeToColor = _mm_loadu_ps( fadeColor.ToFloatPtr() );
+	const __m128 vector_float_one = _mm_set1_ps( 1.0f );
+	const __m128 vector_float_255 = _mm_set1_ps( 255.0f );
+	
+	const int vertsPerParticle = ( animationFrames > 1 ) ? 8 : 4;
+	
+	ALIGN16( float pathOrigin[3][4] );
+	ALIGN16( float axis[3][3][4] );
+	ALIGN16( float origin[3][4] );
+	ALIGN16( float ages[4] );
+	ALIGN16( float angles[4] );
+	ALIGN16( float widths[4] );
+	ALIGN16( float heights[4] );
+	ALIGN16( float corners[4][3][4] );
+	idDrawVert* laneVerts[4];
+	
+	int numVerts = 0;
+	for( int first = 0; first < numGens; first += 4 )
+	{
+		int numLanes = 0;
 		
-		tempST = verts[numVerts + i].GetTexCoord();
-		verts[numVerts + i].SetTexCoord( tempST.x + width, tempST.y );
+		for( int lane = 0; lane < 4; lane++ )
+		{
+			laneVerts[lane] = NULL;
+			
+			if( first + lane < numGens )
+			{
+				particleGen_t* g = &gens[first + lane];
+				idDrawVert* v = verts + numVerts;
+				
+				// same as ParticleColors, truncated and clamped to bytes
+				const __m128 fade = _mm_set1_ps( ParticleFadeFraction( g ) );
+				__m128 fcolor = _mm_add_ps( _mm_mul_ps( baseColor, fade ), _mm_mul_ps( fadeToColor, _mm_sub_ps( vector_float_one, fade ) ) );
+				__m128i icolor = _mm_cvttps_epi32( _mm_mul_ps( fcolor, vector_float_255 ) );
+				icolor = _mm_packs_epi32( icolor, icolor );
+				icolor = _mm_packus_epi16( icolor, icolor );
+				const dword packedColor = _mm_cvtsi128_si32( icolor );
+				
+				// if we are completely faded out, kill the particle
+				if( packedColor != 0 )
+				{
+					v[0].Clear();
+					v[1].Clear();
+					v[2].Clear();
+					v[3].Clear();
+					
+					v[0].SetColor( packedColor );
+					v[1].SetColor( packedColor );
+					v[2].SetColor( packedColor );
+					v[3].SetColor( packedColor );
+					
+					idVec3 path;
+					ParticleOriginPath( g, path );
+					
+					ParticleTexCoords( g, v );
+					
+					float psize = size.Eval( g->frac, g->random );
+					float paspect = aspect.Eval( g->frac, g->random );
+					
+					for( int i = 0; i < 3; i++ )
+					{
+						pathOrigin[i][lane] = path[i];
+						origin[i][lane] = g->origin[i];
+						for( int j = 0; j < 3; j++ )
+						{
+							axis[i][j][lane] = g->axis[i][j];
+						}
+					}
+					ages[lane] = g->age;
+					angles[lane] = ParticleAngle( g );
+					widths[lane] = psize;
+					heights[lane] = psize * paspect;
+					
+					laneVerts[lane] = v;
+					numVerts += vertsPerParticle;
+					numLanes++;
+					continue;
+				}
+			}
+			
+			// keep the unused lanes finite
+			for( int i = 0; i < 3; i++ )
+			{
+				pathOrigin[i][lane] = 0.0f;
+				origin[i][lane] = 0.0f;
+				for( int j = 0; j < 3; j++ )
+				{
+					axis[i][j][lane] = 0.0f;
+				}
+			}
+			ages[lane] = 0.0f;
+			angles[lane] = 0.0f;
+			widths[lane] = 0.0f;
+			heights[lane] = 0.0f;
+		}
 		
-		verts[numVerts + i].color[0] *= frac;
-		verts[numVerts + i].color[1] *= frac;
-		verts[numVerts + i].color[2] *= frac;
-		verts[numVerts + i].color[3] *= frac;
+		if( numLanes == 0 )
+		{
+			continue;
+		}
 		
-		verts[i].color[0] *= iFrac;
-		verts[i].color[1] *= iFrac;
-		verts[i].color[2] *= iFrac;
-		verts[i].color[3] *= iFrac;
+		const __m128 px = _mm_load_ps( pathOrigin[0] );
+		const __m128 py = _mm_load_ps( pathOrigin[1] );
+		const __m128 pz = _mm_load_ps( pathOrigin[2] );
+		const __m128 age = _mm_load_ps( ages );
+		
+		// adjust for the per-particle smoke offset and add gravity after adjusting for axis
+		__m128 o[3];
+		for( int i = 0; i < 3; i++ )
+		{
+			o[i] = _mm_mul_ps( _mm_load_ps( axis[0][i] ), px );
+			o[i] = _mm_add_ps( o[i], _mm_mul_ps( _mm_load_ps( axis[1][i] ), py ) );
+			o[i] = _mm_add_ps( o[i], _mm_mul_ps( _mm_load_ps( axis[2][i] ), pz ) );
+			o[i] = _mm_add_ps( o[i], _mm_load_ps( origin[i] ) );
+			o[i] = _mm_add_ps( o[i], _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( gra[i] ), age ), age ) );
+		}
+		
+		__m128 s, c;
+		SinCos16_SSE( _mm_load_ps( angles ), s, c );
+		
+		const __m128 width = _mm_load_ps( widths );
+		const __m128 height = _mm_load_ps( heights );
+		
+		for( int i = 0; i < 3; i++ )
+		{
+			const __m128 left = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( leftC[i] ), c ), _mm_mul_ps( _mm_set1_ps( leftS[i] ), s ) ), width );
+			const __m128 up = _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps( upC[i] ), c ), _mm_mul_ps( _mm_set1_ps( upS[i] ), s ) ), height );
+			
+			const __m128 minusLeft = _mm_sub_ps( o[i], left );
+			const __m128 plusLeft = _mm_add_ps( o[i], left );
+			
+			_mm_store_ps( corners[0][i], _mm_add_ps( minusLeft, up ) );
+			_mm_store_ps( corners[1][i], _mm_add_ps( plusLeft, up ) );
+			_mm_store_ps( corners[2][i], _mm_sub_ps( minusLeft, up ) );
+			_mm_store_ps( corners[3][i], _mm_sub_ps( plusLeft, up ) );
+		}
+		
+		for( int lane = 0; lane < 4; lane++ )
+		{
+			idDrawVert* v = laneVerts[lane];
+			if( v == NULL )
+			{
+				continue;
+			}
+			
+			for( int k = 0; k < 4; k++ )
+			{
+				v[k].xyz.Set( corners[k][0][lane], corners[k][1][lane], corners[k][2][lane] );
+			}
+			
+			if( animationFrames > 1 )
+			{
+				CrossFadeParticle( animationFrames, &gens[first + lane], v, 4 );
+			}
+		}
 	}
 	
-	return numVerts * 2;
+	return numVerts;
 }
 
 /*
@@ -124,11 +124,16 @@ public:
 	int						NumQuadsPerParticle() const;	// includes trails and cross faded animations
 	// returns the number of verts created, which will range from 0 to 4*NumQuadsPerParticle()
 	int						CreateParticle( particleGen_t* g, idDrawVert* verts ) const;
+	// same verts as CreateParticle on each particle in turn, the particles must share renderEnt and renderView
+	int						CreateParticles( particleGen_t* gens, const int numGens, idDrawVert* verts ) const;
 	
 	void					ParticleOrigin( particleGen_t* g, idVec3& origin ) const;
+	void					ParticleOriginPath( particleGen_t* g, idVec3& origin ) const;	// before the smoke axis and gravity
+	float					ParticleAngle( particleGen_t* g ) const;						// quad rotation in radians
 	int						ParticleVerts( particleGen_t* g, const idVec3 origin, idDrawVert* verts ) const;
 	void					ParticleTexCoords( particleGen_t* g, idDrawVert* verts ) const;
 	void					ParticleColors( particleGen_t* g, idDrawVert* verts ) const;
+	float					ParticleFadeFraction( particleGen_t* g ) const;
 	
 	const char* 			GetCustomPathName();
 	const char* 			GetCustomPathDesc();
@@ -341,10 +341,39 @@ int idFileSystemLocal::ReadFromBGL( idFile* _resourceFile, void* _buffer, int _o
 /*
 ================
 idFileSystemLocal::StartPreload
+
+Asks the OS to start paging in the given files if they live in a mapped resource container
 ================
 */
 void idFileSystemLocal::StartPreload( const idStrList& _preload )
 {
+	if( resourceFiles.Num() == 0 )
+	{
+		return;
+	}
+	
+	int numPrefetched = 0;
+	int bytesPrefetched = 0;
+	idResourceCacheEntry rc;
+	for( int i = 0; i < _preload.Num(); i++ )
+	{
+		if( !GetResourceCacheEntry( _preload[ i ], rc ) )
+		{
+			continue;
+		}
+		const byte* data = resourceFiles[ rc.containerIndex ]->GetMappedData( rc.offset, rc.length );
+		if( data != NULL )
+		{
+			Sys_PrefetchMappedRange( data, rc.length );
+			numPrefetched++;
+			bytesPrefetched += rc.length;
+		}
+	}
+	
+	if( fs_debugResources.GetBool() )
+	{
+		idLib::Printf( "RES: prefetching %d of %d files, %d kB\n", numPrefetched, _preload.Num(), bytesPrefetched >> 10 );
+	}
 }
 
 /*
@@ -3828,6 +3857,13 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 		{
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
+		// mapped containers hand out a read only view of the data without copying it
+		idFile* mapped = resourceFiles[ rc.containerIndex ]->OpenMappedFile( rc.filename, rc.offset, rc.length );
+		if( mapped != NULL )
+		{
+			return mapped;
+		}
+		
 		idFile_InnerResource* file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
 		// DG: add parenthesis to make sure this block is only entered when file != NULL - bug found by clang.
 		if( file != NULL && ( ( memFile || rc.length <= resourceBufferAvailable ) || rc.length < 8 * 1024 * 1024 ) )
@@ -33,11 +33,123 @@ If you have questions concerning this license or the applicable additional terms
 /*
 ================================================================================================
 
+idResourceMapping
+
+================================================================================================
+*/
+
+/*
+========================
+idResourceMapping::~idResourceMapping
+========================
+*/
+idResourceMapping::~idResourceMapping()
+{
+	Sys_UnmapFile( data, length );
+}
+
+/*
+========================
+idResourceMapping::Release
+========================
+*/
+void idResourceMapping::Release()
+{
+	if( refCount.Decrement() == 0 )
+	{
+		delete this;
+	}
+}
+
+/*
+================================================
+idFile_ResourceView
+
+A memory file over a slice of a mapped container that holds a reference to the mapping.
+================================================
+*/
+class idFile_ResourceView : public idFile_Memory
+{
+public:
+	idFile_ResourceView( const char* name, idResourceMapping* _mapping, int offset, int length ) :
+		idFile_Memory( name, ( const char* )_mapping->GetData() + offset, length ), mapping( _mapping )
+	{
+		mapping->AddRef();
+	}
+	virtual ~idFile_ResourceView()
+	{
+		mapping->Release();
+	}
+	
+private:
+	idResourceMapping* 	mapping;
+};
+
+/*
+================================================================================================
+
 idResourceContainer
 
 ================================================================================================
 */
 
+idCVar fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_BOOL, "map resource containers read only and read resource files straight from the mapping" );
+
+/*
+========================
+idResourceContainer::Map
+========================
+*/
+void idResourceContainer::Map()
+{
+	Unmap();
+	
+	// only containers that live in a plain OS file can be mapped
+	idFile_Permanent* osFile = dynamic_cast< idFile_Permanent* >( resourceFile );
+	if( !fs_mapResources.GetBool() || osFile == NULL )
+	{
+		return;
+	}
+	
+	int length = 0;
+	const byte* data = Sys_MapFileReadOnly( osFile->GetFullPath(), length );
+	if( data == NULL )
+	{
+		idLib::Warning( "Unable to map resource file %s, falling back to reads", fileName.c_str() );
+		return;
+	}
+	mapping = new( TAG_RESOURCE ) idResourceMapping( data, length );
+}
+
+/*
+========================
+idResourceContainer::Unmap
+========================
+*/
+void idResourceContainer::Unmap()
+{
+	// open views keep the mapping alive, it goes away when the last one is closed
+	if( mapping != NULL )
+	{
+		mapping->Release();
+		mapping = NULL;
+	}
+}
+
+/*
+========================
+idResourceContainer::OpenMappedFile
+========================
+*/
+idFile* idResourceContainer::OpenMappedFile( const char* name, int offset, int length )
+{
+	if( GetMappedData( offset, length ) == NULL )
+	{
+		return NULL;
+	}
+	return new( TAG_IDFILE ) idFile_ResourceView( name, mapping, offset, length );
+}
+
 /*
 ========================
 idResourceContainer::ReOpen
@@ -47,6 +159,7 @@ void idResourceContainer::ReOpen()
 {
 	delete resourceFile;
 	resourceFile = fileSystem->OpenFileRead( fileName );
+	Map();
 }
 
 /*
@@ -119,6 +232,8 @@ bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 	}
 	Mem_Free( buf );
 	
+	Map();
+	
 	return true;
 }
 
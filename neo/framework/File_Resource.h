@@ -73,6 +73,46 @@ public:
 	uint8				containerIndex;
 };
 
+/*
+================================================
+idResourceMapping
+
+A read only mapping of a whole resource container. The container holds one reference and
+every file view handed out by GetResourceFile holds another, so the mapping stays valid
+until the last view is closed even if the container is reopened or removed in between.
+================================================
+*/
+class idResourceMapping
+{
+public:
+	idResourceMapping( const byte* _data, int _length ) : data( _data ), length( _length )
+	{
+		refCount.Increment();
+	}
+	
+	void			AddRef()
+	{
+		refCount.Increment();
+	}
+	void			Release();
+	
+	const byte* 	GetData() const
+	{
+		return data;
+	}
+	int				GetLength() const
+	{
+		return length;
+	}
+	
+private:
+	~idResourceMapping();
+	
+	const byte* 	data;
+	int				length;
+	idSysInterlockedInteger refCount;
+};
+
 static const uint32 RESOURCE_FILE_MAGIC = 0xD000000D;
 class idResourceContainer
 {
@@ -86,9 +126,11 @@ public:
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
+		mapping = NULL;
 	}
 	~idResourceContainer()
 	{
+		Unmap();
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -106,7 +148,21 @@ public:
 	}
 	void SetContainerIndex( const int& _idx );
 	void ReOpen();
+	// returns a read only pointer into the mapped container, NULL if it isn't mapped
+	const byte* GetMappedData( int offset, int length ) const
+	{
+		if( mapping == NULL || offset < 0 || length < 0 || offset > mapping->GetLength() - length )
+		{
+			return NULL;
+		}
+		return mapping->GetData() + offset;
+	}
+	// returns a file that reads straight from the mapping and keeps it alive until it is closed, NULL if it isn't mapped
+	idFile* OpenMappedFile( const char* name, int offset, int length );
 private:
+	void		Map();
+	void		Unmap();
+	
 	idStrStatic< 256 > fileName;
 	idFile* 	resourceFile;			// open file handle
 	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
@@ -117,6 +173,7 @@ private:
 	int		numFileResources;		// number of file resources in this container
 	idList< idResourceCacheEntry, TAG_RESOURCE>	cacheTable;
 	idHashIndex	cacheHash;
+	idResourceMapping* mapping;			// read only view of the whole container
 };
 
 
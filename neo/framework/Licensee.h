@@ -42,6 +42,11 @@ If you have questions concerning this license or the applicable additional terms
 // see ASYNC_PROTOCOL_VERSION
 // use a different major for each game
 #define ASYNC_PROTOCOL_MAJOR			1
+// bump the minor whenever the format of network messages changes
+// 2: snapshot deltas start with a codec byte
+#define ASYNC_PROTOCOL_MINOR			2
+// part of the version checksum that the lobby compares on connect
+#define ASYNC_PROTOCOL_VERSION			( ( ASYNC_PROTOCOL_MAJOR << 16 ) + ASYNC_PROTOCOL_MINOR )
 
 // <= Doom v1.1: 1. no DS_VERSION token ( default )
 // Doom v1.2:  2
@@ -0,0 +1,600 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+
+#include "LoadPipeline.h"
+
+idCVar fs_loadPipeline( "fs_loadPipeline", "1", CVAR_SYSTEM | CVAR_BOOL, "read, decode and upload level load resources on separate threads" );
+idCVar fs_loadPipelineThreads( "fs_loadPipelineThreads", "2", CVAR_SYSTEM | CVAR_INTEGER, "number of decode threads used by the level load pipeline", 1, 8 );
+idCVar fs_loadPipelineMemory( "fs_loadPipelineMemory", "64", CVAR_SYSTEM | CVAR_INTEGER, "megabytes of file data the level load pipeline may read ahead of the main thread", 1, 1024 );
+idCVar fs_loadPipelineStats( "fs_loadPipelineStats", "0", CVAR_SYSTEM | CVAR_BOOL, "print the per stage timing of each level load pipeline run" );
+
+// how many items the main thread opens ahead of the one it is finishing, bounds the open file handles
+static const int LOAD_PIPELINE_OPEN_AHEAD = 64;
+
+/*
+================================================================================================
+
+idLoadPipelineItem
+
+================================================================================================
+*/
+
+/*
+========================
+idLoadPipelineItem::idLoadPipelineItem
+========================
+*/
+idLoadPipelineItem::idLoadPipelineItem()
+{
+	openFile = NULL;
+	file = NULL;
+	fileTime = FILE_NOT_FOUND_TIMESTAMP;
+	dataLength = 0;
+	containerIndex = 0;
+	offset = 0;
+	order = 0;
+	opened = false;
+	readOk = false;
+}
+
+/*
+========================
+idLoadPipelineItem::~idLoadPipelineItem
+========================
+*/
+idLoadPipelineItem::~idLoadPipelineItem()
+{
+	delete openFile;
+	FreeData();
+}
+
+/*
+========================
+idLoadPipelineItem::Open
+
+Inner resource files read through the container handle and the resource buffer the
+file system shares between all of them, so they are copied right away and closed
+before the next file is opened. Everything else gets read on the I/O thread.
+========================
+*/
+bool idLoadPipelineItem::Open()
+{
+	idFile* f = fileSystem->OpenFileRead( fileName );
+	if( f == NULL )
+	{
+		return false;
+	}
+	
+	if( dynamic_cast< idFile_InnerResource* >( f ) != NULL )
+	{
+		idFileLocal fileLocal( f );
+		return CopyToMemory( f );
+	}
+	
+	openFile = f;
+	return true;
+}
+
+/*
+========================
+idLoadPipelineItem::Read
+
+Files that are already private memory, e.g. views of a mapped resource container,
+are used as is, anything else is copied into a private buffer.
+========================
+*/
+bool idLoadPipelineItem::Read()
+{
+	// Open() already copied it
+	if( file != NULL )
+	{
+		return true;
+	}
+	
+	idFile* f = openFile;
+	openFile = NULL;
+	if( f == NULL )
+	{
+		return false;
+	}
+	
+	idFile_Memory* memFile = dynamic_cast< idFile_Memory* >( f );
+	if( memFile != NULL )
+	{
+		file = memFile;
+		fileTime = memFile->Timestamp();
+		dataLength = memFile->Length();
+		return true;
+	}
+	
+	idFileLocal fileLocal( f );
+	return CopyToMemory( f );
+}
+
+/*
+========================
+idLoadPipelineItem::CopyToMemory
+========================
+*/
+bool idLoadPipelineItem::CopyToMemory( idFile* f )
+{
+	const int length = f->Length();
+	char* buffer = ( char* )Mem_Alloc( Max( length, 1 ), TAG_IDFILE );
+	if( f->Read( buffer, length ) != length )
+	{
+		Mem_Free( buffer );
+		return false;
+	}
+	
+	file = new( TAG_IDFILE ) idFile_Memory( fileName, buffer, length );
+	file->TakeDataOwnership();
+	fileTime = f->Timestamp();
+	dataLength = length;
+	return true;
+}
+
+/*
+========================
+idLoadPipelineItem::FreeData
+========================
+*/
+void idLoadPipelineItem::FreeData()
+{
+	delete file;
+	file = NULL;
+}
+
+/*
+================================================================================================
+
+idLoadPipeline threads
+
+================================================================================================
+*/
+
+/*
+================================================
+idLoadPipelineIOThread
+================================================
+*/
+class idLoadPipelineIOThread : public idSysThread
+{
+public:
+	idLoadPipelineIOThread( idLoadPipeline* pipeline_ ) : pipeline( pipeline_ ), busyMicroSec( 0 ), bytesRead( 0 ) {}
+	
+	virtual int Run()
+	{
+		idList< idLoadPipelineItem* >& items = pipeline->items;
+		for( int i = 0; i < items.Num(); i++ )
+		{
+			// don't run further ahead of the main thread than the memory budget allows
+			while( pipeline->bytesInFlight.GetValue() > pipeline->maxBytesInFlight && pipeline->numFinished.GetValue() < i )
+			{
+				pipeline->finishSignal.Wait( 1 );
+			}
+			
+			// the main thread opens the files, the file system isn't thread safe
+			while( pipeline->numOpened.GetValue() <= i )
+			{
+				pipeline->openSignal.Wait( 1 );
+			}
+			
+			idLoadPipelineItem* item = items[i];
+			const uint64 start = Sys_Microseconds();
+			item->readOk = item->opened && item->Read();
+			busyMicroSec += Sys_Microseconds() - start;
+			
+			if( item->readOk )
+			{
+				bytesRead += item->dataLength;
+				pipeline->bytesInFlight.Add( item->dataLength );
+			}
+			pipeline->numRead.Increment();
+			pipeline->readSignal.Raise();
+		}
+		return 0;
+	}
+	
+	idLoadPipeline* 	pipeline;
+	uint64				busyMicroSec;
+	int64				bytesRead;
+};
+
+/*
+================================================
+idLoadPipelineDecodeThread
+================================================
+*/
+class idLoadPipelineDecodeThread : public idSysThread
+{
+public:
+	idLoadPipelineDecodeThread() : pipeline( NULL ), busyMicroSec( 0 ) {}
+	
+	virtual int Run()
+	{
+		idList< idLoadPipelineItem* >& items = pipeline->items;
+		for( ;; )
+		{
+			const int index = pipeline->nextDecode.Increment() - 1;
+			if( index >= items.Num() )
+			{
+				break;
+			}
+			while( pipeline->numRead.GetValue() <= index )
+			{
+				pipeline->readSignal.Wait( 1 );
+			}
+			
+			idLoadPipelineItem* item = items[index];
+			if( item->readOk )
+			{
+				const uint64 start = Sys_Microseconds();
+				item->Decode();
+				busyMicroSec += Sys_Microseconds() - start;
+			}
+			item->decoded.Increment();
+			pipeline->decodeSignal.Raise();
+		}
+		return 0;
+	}
+	
+	idLoadPipeline* 	pipeline;
+	uint64				busyMicroSec;
+};
+
+/*
+================================================================================================
+
+idLoadPipeline
+
+================================================================================================
+*/
+
+/*
+========================
+idSort_LoadPipeline
+
+Items are read in container / file offset order, loose files go last in the order
+they were added.
+========================
+*/
+class idSort_LoadPipeline : public idSort_Quick< idLoadPipelineItem*, idSort_LoadPipeline >
+{
+public:
+	int Compare( idLoadPipelineItem* const& a, idLoadPipelineItem* const& b ) const
+	{
+		if( a->containerIndex != b->containerIndex )
+		{
+			return a->containerIndex - b->containerIndex;
+		}
+		if( a->offset != b->offset )
+		{
+			return a->offset < b->offset ? -1 : 1;
+		}
+		return a->order - b->order;
+	}
+};
+
+/*
+========================
+idLoadPipeline::idLoadPipeline
+========================
+*/
+idLoadPipeline::idLoadPipeline( const char* name_ ) : name( name_ ), openSignal( false ), readSignal( false ), decodeSignal( false ), finishSignal( false )
+{
+	memset( &stats, 0, sizeof( stats ) );
+	keepOrder = false;
+	numOpenedMain = 0;
+	maxBytesInFlight = 0;
+}
+
+/*
+========================
+idLoadPipeline::~idLoadPipeline
+========================
+*/
+idLoadPipeline::~idLoadPipeline()
+{
+	items.DeleteContents( true );
+}
+
+/*
+========================
+idLoadPipeline::AddItem
+========================
+*/
+void idLoadPipeline::AddItem( idLoadPipelineItem* item )
+{
+	item->order = items.Num();
+	items.Append( item );
+}
+
+/*
+========================
+idLoadPipeline::SortItems
+========================
+*/
+void idLoadPipeline::SortItems()
+{
+	if( keepOrder )
+	{
+		return;
+	}
+	
+	for( int i = 0; i < items.Num(); i++ )
+	{
+		idLoadPipelineItem* item = items[i];
+		idResourceCacheEntry rc;
+		if( fileSystem->GetResourceCacheEntry( item->fileName, rc ) )
+		{
+			// later containers override earlier ones, read them in the order they are stored on disk
+			item->containerIndex = rc.containerIndex;
+			item->offset = rc.offset;
+		}
+		else
+		{
+			item->containerIndex = INT_MAX;
+			item->offset = 0;
+		}
+	}
+	items.SortWithTemplate( idSort_LoadPipeline() );
+}
+
+/*
+========================
+idLoadPipeline::OpenItems
+
+Opens the files of the items up to upTo on the main thread and hands them to the I/O thread
+========================
+*/
+void idLoadPipeline::OpenItems( int upTo )
+{
+	upTo = Min( upTo, items.Num() );
+	if( numOpenedMain >= upTo )
+	{
+		return;
+	}
+	
+	const uint64 start = Sys_Microseconds();
+	for( ; numOpenedMain < upTo; numOpenedMain++ )
+	{
+		idLoadPipelineItem* item = items[numOpenedMain];
+		item->opened = item->Open();
+		numOpened.Increment();
+	}
+	openSignal.Raise();
+	stats.openMicroSec += Sys_Microseconds() - start;
+}
+
+/*
+========================
+idLoadPipeline::FinishItem
+========================
+*/
+void idLoadPipeline::FinishItem( idLoadPipelineItem* item, idList< idLoadPipelineItem* >& fallbacks )
+{
+	const uint64 start = Sys_Microseconds();
+	if( !item->readOk || !item->Finish() )
+	{
+		fallbacks.Append( item );
+	}
+	if( item->readOk )
+	{
+		bytesInFlight.Sub( item->dataLength );
+	}
+	item->FreeData();
+	stats.finishMicroSec += Sys_Microseconds() - start;
+}
+
+/*
+========================
+idLoadPipeline::RunFallbacks
+========================
+*/
+void idLoadPipeline::RunFallbacks( idList< idLoadPipelineItem* >& fallbacks )
+{
+	const uint64 start = Sys_Microseconds();
+	for( int i = 0; i < fallbacks.Num(); i++ )
+	{
+		fallbacks[i]->Fallback();
+	}
+	stats.numFallbacks = fallbacks.Num();
+	stats.fallbackMicroSec = Sys_Microseconds() - start;
+}
+
+/*
+========================
+idLoadPipeline::RunSerial
+
+Same stages on the calling thread, used when the pipeline is disabled or not worth it.
+========================
+*/
+void idLoadPipeline::RunSerial( bool pacifier )
+{
+	idList< idLoadPipelineItem* > fallbacks;
+	for( int i = 0; i < items.Num(); i++ )
+	{
+		if( pacifier )
+		{
+			common->UpdateLevelLoadPacifier( true, ( 100 * i ) / items.Num() );
+		}
+		
+		idLoadPipelineItem* item = items[i];
+		uint64 start = Sys_Microseconds();
+		item->opened = item->Open();
+		stats.openMicroSec += Sys_Microseconds() - start;
+		
+		start = Sys_Microseconds();
+		item->readOk = item->opened && item->Read();
+		stats.readMicroSec += Sys_Microseconds() - start;
+		
+		if( item->readOk )
+		{
+			stats.bytesRead += item->dataLength;
+			start = Sys_Microseconds();
+			item->Decode();
+			stats.decodeMicroSec += Sys_Microseconds() - start;
+		}
+		FinishItem( item, fallbacks );
+	}
+	RunFallbacks( fallbacks );
+}
+
+/*
+========================
+idLoadPipeline::RunThreaded
+========================
+*/
+void idLoadPipeline::RunThreaded( bool pacifier )
+{
+	const int numDecodeThreads = idMath::ClampInt( 1, 8, fs_loadPipelineThreads.GetInteger() );
+	
+	numOpenedMain = 0;
+	numOpened.SetValue( 0 );
+	numRead.SetValue( 0 );
+	nextDecode.SetValue( 0 );
+	numFinished.SetValue( 0 );
+	bytesInFlight.SetValue( 0 );
+	maxBytesInFlight = fs_loadPipelineMemory.GetInteger() * 1024 * 1024;
+	
+	idLoadPipelineIOThread ioThread( this );
+	idLoadPipelineDecodeThread decodeThreads[8];
+	
+	OpenItems( LOAD_PIPELINE_OPEN_AHEAD );
+	
+	ioThread.StartThread( va( "%s_io", name.c_str() ), CORE_ANY );
+	for( int i = 0; i < numDecodeThreads; i++ )
+	{
+		decodeThreads[i].pipeline = this;
+		decodeThreads[i].StartThread( va( "%s_decode%d", name.c_str(), i ), CORE_ANY );
+	}
+	
+	// the main thread retires the items in read order
+	idList< idLoadPipelineItem* > fallbacks;
+	for( int i = 0; i < items.Num(); i++ )
+	{
+		idLoadPipelineItem* item = items[i];
+		
+		OpenItems( i + LOAD_PIPELINE_OPEN_AHEAD );
+		
+		const uint64 waitStart = Sys_Microseconds();
+		while( item->decoded.GetValue() == 0 )
+		{
+			decodeSignal.Wait( 1 );
+			if( pacifier )
+			{
+				common->UpdateLevelLoadPacifier( true, ( 100 * i ) / items.Num() );
+			}
+		}
+		stats.waitMicroSec += Sys_Microseconds() - waitStart;
+		
+		FinishItem( item, fallbacks );
+		numFinished.Increment();
+		finishSignal.Raise();
+		
+		if( pacifier && ( i & 15 ) == 0 )
+		{
+			common->UpdateLevelLoadPacifier( true, ( 100 * i ) / items.Num() );
+		}
+	}
+	
+	ioThread.StopThread();
+	stats.readMicroSec = ioThread.busyMicroSec;
+	stats.bytesRead = ioThread.bytesRead;
+	for( int i = 0; i < numDecodeThreads; i++ )
+	{
+		decodeThreads[i].StopThread();
+		stats.decodeMicroSec += decodeThreads[i].busyMicroSec;
+	}
+	stats.numDecodeThreads = numDecodeThreads;
+	
+	RunFallbacks( fallbacks );
+}
+
+/*
+========================
+idLoadPipeline::Run
+========================
+*/
+void idLoadPipeline::Run( bool pacifier )
+{
+	memset( &stats, 0, sizeof( stats ) );
+	stats.numItems = items.Num();
+	
+	const uint64 start = Sys_Microseconds();
+	
+	SortItems();
+	
+	// let mapped resource containers page in ahead of the reads
+	idStrList prefetch;
+	prefetch.Resize( items.Num() );
+	for( int i = 0; i < items.Num(); i++ )
+	{
+		prefetch.Append( items[ i ]->fileName.c_str() );
+	}
+	fileSystem->StartPreload( prefetch );
+	
+	if( fs_loadPipeline.GetBool() && items.Num() > 1 )
+	{
+		RunThreaded( pacifier );
+	}
+	else
+	{
+		RunSerial( pacifier );
+	}
+	
+	fileSystem->StopPreload();
+	stats.totalMicroSec = Sys_Microseconds() - start;
+	
+	items.DeleteContents( true );
+	
+	if( fs_loadPipelineStats.GetBool() && stats.numItems > 0 )
+	{
+		PrintStats();
+	}
+}
+
+/*
+========================
+idLoadPipeline::PrintStats
+========================
+*/
+void idLoadPipeline::PrintStats() const
+{
+	common->Printf( "%s pipeline: %d items, %.1f MB, %d fallbacks, %d decode threads\n", name.c_str(), stats.numItems, stats.bytesRead / ( 1024.0f * 1024.0f ), stats.numFallbacks, stats.numDecodeThreads );
+	common->Printf( "  open     %6.1f ms\n", stats.openMicroSec * 0.001f );
+	common->Printf( "  read     %6.1f ms\n", stats.readMicroSec * 0.001f );
+	common->Printf( "  decode   %6.1f ms\n", stats.decodeMicroSec * 0.001f );
+	common->Printf( "  finish   %6.1f ms\n", stats.finishMicroSec * 0.001f );
+	common->Printf( "  wait     %6.1f ms\n", stats.waitMicroSec * 0.001f );
+	common->Printf( "  fallback %6.1f ms\n", stats.fallbackMicroSec * 0.001f );
+	common->Printf( "  total    %6.1f ms\n", stats.totalMicroSec * 0.001f );
+}
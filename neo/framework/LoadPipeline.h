@@ -0,0 +1,181 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __LOADPIPELINE_H__
+#define __LOADPIPELINE_H__
+
+/*
+================================================================================================
+
+Staged level load pipeline
+
+The main thread opens the file of every item in resource container / file offset order,
+one I/O thread reads them, decode threads turn the raw bytes into CPU side data and the
+main thread performs the last step (texture uploads, sound buffer creation, model
+registration).
+
+Rules for items:
+	Open()		main thread, a few items ahead of Finish(). idFileSystemLocal is not
+				thread safe, so this is the only stage that may call into the file system.
+	Read()		I/O thread. Reads the file Open() returned, must not touch the file system.
+	Decode()	decode threads. Must not touch the file system, GL or the decl manager.
+	Finish()	main thread. Returning false queues the item for Fallback(), which runs
+				on the main thread after the pipeline has drained and is free to do
+				anything the old serial path did.
+
+================================================================================================
+*/
+
+class idLoadPipelineItem
+{
+	friend class idLoadPipeline;
+	friend class idLoadPipelineIOThread;
+	friend class idLoadPipelineDecodeThread;
+	friend class idSort_LoadPipeline;
+public:
+	idLoadPipelineItem();
+	virtual					~idLoadPipelineItem();
+	
+	// opens fileName, returns false if the file could not be opened
+	virtual bool			Open();
+	// reads the file Open() returned into memory
+	virtual bool			Read();
+	// builds the CPU side data from GetFile()
+	virtual void			Decode() {}
+	// main thread work, returns false if Fallback() should be run
+	virtual bool			Finish() = 0;
+	// slow path once the pipeline has drained
+	virtual void			Fallback() = 0;
+	
+	// NULL if the read failed or the data was already released
+	idFile_Memory* 			GetFile()
+	{
+		return file;
+	}
+	ID_TIME_T				GetFileTime() const
+	{
+		return fileTime;
+	}
+	void					FreeData();
+	
+	idStrStatic< MAX_OSPATH >	fileName;
+	
+protected:
+	// copies f into a private buffer that GetFile() returns
+	bool					CopyToMemory( idFile* f );
+	
+	// for Read() overrides that keep the data somewhere else, counts against fs_loadPipelineMemory
+	void					SetDataLength( int length )
+	{
+		dataLength = length;
+	}
+	
+private:
+	idFile* 				openFile;
+	idFile_Memory* 			file;
+	ID_TIME_T				fileTime;
+	int						dataLength;
+	int						containerIndex;
+	int						offset;
+	int						order;
+	bool					opened;
+	bool					readOk;
+	idSysInterlockedInteger	decoded;
+};
+
+struct loadPipelineStats_t
+{
+	int						numItems;
+	int						numFallbacks;
+	int						numDecodeThreads;
+	int64					bytesRead;
+	uint64					openMicroSec;		// main thread opening files
+	uint64					readMicroSec;		// I/O thread busy time
+	uint64					decodeMicroSec;		// summed over all decode threads
+	uint64					finishMicroSec;		// main thread upload / registration
+	uint64					waitMicroSec;		// main thread stalled on earlier stages
+	uint64					fallbackMicroSec;
+	uint64					totalMicroSec;
+};
+
+class idLoadPipeline
+{
+	friend class idLoadPipelineIOThread;
+	friend class idLoadPipelineDecodeThread;
+public:
+	idLoadPipeline( const char* name );
+	~idLoadPipeline();
+	
+	// the pipeline takes ownership of the item
+	void					AddItem( idLoadPipelineItem* item );
+	// finish items in the order they were added instead of reading them in resource file order
+	void					SetKeepOrder( bool keep )
+	{
+		keepOrder = keep;
+	}
+	int						NumItems() const
+	{
+		return items.Num();
+	}
+	
+	// runs all stages and frees the items, the pipeline can be reused afterwards
+	void					Run( bool pacifier );
+	
+	const loadPipelineStats_t& GetStats() const
+	{
+		return stats;
+	}
+	void					PrintStats() const;
+	
+private:
+	idStr					name;
+	idList< idLoadPipelineItem* >	items;
+	loadPipelineStats_t		stats;
+	bool					keepOrder;
+	
+	int						numOpenedMain;		// only touched by the main thread
+	idSysInterlockedInteger	numOpened;
+	idSysInterlockedInteger	numRead;
+	idSysInterlockedInteger	nextDecode;
+	idSysInterlockedInteger	numFinished;
+	idSysInterlockedInteger	bytesInFlight;
+	int						maxBytesInFlight;
+	idSysSignal				openSignal;
+	idSysSignal				readSignal;
+	idSysSignal				decodeSignal;
+	idSysSignal				finishSignal;
+	
+	void					SortItems();
+	void					OpenItems( int upTo );
+	void					RunSerial( bool pacifier );
+	void					RunThreaded( bool pacifier );
+	void					FinishItem( idLoadPipelineItem* item, idList< idLoadPipelineItem* >& fallbacks );
+	void					RunFallbacks( idList< idLoadPipelineItem* >& fallbacks );
+};
+
+#endif // !__LOADPIPELINE_H__
@@ -838,4 +838,6 @@ void idCommonLocal::Frame()
 	{
 		return;			// an ERP_DROP was thrown
 	}
+	
+	idProfiler::EndFrame();
 }
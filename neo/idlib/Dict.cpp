@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 
 idStrPool		idDict::globalKeys;
 idStrPool		idDict::globalValues;
+int				idDict::keyPoolGeneration = 1;
 
 /*
 ================
@@ -52,7 +53,6 @@ idDict& idDict::operator=( const idDict& other )
 	Clear();
 	
 	args = other.args;
-	argHash = other.argHash;
 	
 	for( i = 0; i < args.Num(); i++ )
 	{
@@ -60,6 +60,35 @@ idDict& idDict::operator=( const idDict& other )
 		args[i].value = globalValues.CopyString( args[i].value );
 	}
 	
+	// copies of frozen dictionaries are usually modified, like spawnArgs copied from an entityDef
+	if( other.frozen )
+	{
+		RebuildHash();
+	}
+	else if( other.base != NULL )
+	{
+		// dictionaries layered on shared defaults only hold a handful of keys themselves
+		argHash.Clear( 16, 16 );
+		RebuildHash();
+	}
+	else
+	{
+		argHash = other.argHash;
+	}
+	
+	if( other.base != NULL )
+	{
+		base = other.base;
+		Sys_InterlockedIncrement( base->sharedRefs );
+		baseHidden = other.baseHidden;
+		baseOverrides = other.baseOverrides;
+		for( i = 0; i < baseOverrides.Num(); i++ )
+		{
+			baseOverrides[i].kv.key = globalKeys.CopyString( baseOverrides[i].kv.key );
+			baseOverrides[i].kv.value = globalValues.CopyString( baseOverrides[i].kv.value );
+		}
+	}
+	
 	return *this;
 }
 
@@ -72,7 +101,7 @@ idDict::Copy
 */
 void idDict::Copy( const idDict& other )
 {
-	int i, n, *found;
+	int i, n, found;
 	idKeyValue kv;
 	
 	// check for assignment to self
@@ -81,34 +110,34 @@ void idDict::Copy( const idDict& other )
 		return;
 	}
 	
-	n = other.args.Num();
+	Thaw();
 	
-	if( args.Num() )
-	{
-		found = ( int* ) _alloca16( other.args.Num() * sizeof( int ) );
-		for( i = 0; i < n; i++ )
-		{
-			found[i] = FindKeyIndex( other.args[i].GetKey() );
-		}
-	}
-	else
-	{
-		found = NULL;
-	}
+	n = other.GetNumKeyVals();
 	
 	for( i = 0; i < n; i++ )
 	{
-		if( found && found[i] != -1 )
+		const idKeyValue* otherKv = other.GetKeyVal( i );
+		found = args.Num() ? FindOwnKeyIndex( otherKv->GetKey() ) : -1;
+		if( found != -1 )
 		{
 			// first set the new value and then free the old value to allow proper self copying
-			const idPoolStr* oldValue = args[found[i]].value;
-			args[found[i]].value = globalValues.CopyString( other.args[i].value );
+			const idPoolStr* oldValue = args[found].value;
+			args[found].value = globalValues.CopyString( otherKv->value );
 			globalValues.FreeString( oldValue );
 		}
 		else
 		{
-			kv.key = globalKeys.CopyString( other.args[i].key );
-			kv.value = globalValues.CopyString( other.args[i].value );
+			if( base != NULL )
+			{
+				const int baseIndex = base->FindOwnKeyIndex( otherKv->GetKey() );
+				if( FindBaseKey( baseIndex ) != NULL )
+				{
+					SetBaseValue( baseIndex, otherKv->GetValue() );
+					continue;
+				}
+			}
+			kv.key = globalKeys.CopyString( otherKv->key );
+			kv.value = globalValues.CopyString( otherKv->value );
 			argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
 		}
 	}
@@ -146,9 +175,19 @@ void idDict::TransferKeyValues( idDict& other )
 		args[i].value = other.args[i].value;
 	}
 	argHash = other.argHash;
+	frozen = other.frozen;
+	frozenKeys = other.frozenKeys;
+	base = other.base;
+	baseHidden = other.baseHidden;
+	baseOverrides = other.baseOverrides;
 	
 	other.args.Clear();
 	other.argHash.Free();
+	other.frozen = false;
+	other.frozenKeys.Clear();
+	other.base = NULL;
+	other.baseHidden.Clear();
+	other.baseOverrides.Clear();
 }
 
 /*
@@ -205,10 +244,12 @@ void idDict::SetDefaults( const idDict* dict )
 	const idKeyValue* kv, *def;
 	idKeyValue newkv;
 	
-	n = dict->args.Num();
+	Thaw();
+	
+	n = dict->GetNumKeyVals();
 	for( i = 0; i < n; i++ )
 	{
-		def = &dict->args[i];
+		def = dict->GetKeyVal( i );
 		kv = FindKey( def->GetKey() );
 		if( !kv )
 		{
@@ -219,6 +260,242 @@ void idDict::SetDefaults( const idDict* dict )
 	}
 }
 
+/*
+================
+idDict::SetSharedDefaults
+
+Entities spawned from the same entityDef all reference its shared dictionary
+this way, so each of them only stores the keys set by the map or the code.
+================
+*/
+void idDict::SetSharedDefaults( const idDict* shared )
+{
+	int i;
+	
+	if( shared == NULL )
+	{
+		return;
+	}
+	
+	// there is only one shared layer, and the shared dictionary has to be released in the
+	// module that allocated it, so keys from another string pool mean a DLL boundary
+	if( base != NULL || ( shared->args.Num() && shared->args[0].key->GetPool() != &globalKeys ) )
+	{
+		SetDefaults( shared );
+		return;
+	}
+	
+	assert( shared->sharedRefs > 0 );
+	Sys_InterlockedIncrement( shared->sharedRefs );
+	base = shared;
+	
+	baseHidden.Clear();
+	for( i = 0; i < args.Num(); i++ )
+	{
+		HideBaseKey( base->FindOwnKeyIndex( args[i].GetKey() ) );
+	}
+}
+
+/*
+================
+idDict::AllocShared
+================
+*/
+const idDict* idDict::AllocShared( const idDict& source )
+{
+	idDict* shared = new( TAG_IDLIB ) idDict;
+	shared->Copy( source );
+	shared->Freeze();
+	shared->sharedRefs = 1;
+	return shared;
+}
+
+/*
+================
+idDict::FreeShared
+================
+*/
+void idDict::FreeShared( const idDict* shared )
+{
+	if( shared != NULL && Sys_InterlockedDecrement( shared->sharedRefs ) == 0 )
+	{
+		delete shared;
+	}
+}
+
+/*
+================
+idDict::ReleaseBase
+================
+*/
+void idDict::ReleaseBase()
+{
+	FreeBaseOverrides();
+	FreeShared( base );
+	base = NULL;
+	baseHidden.Clear();
+}
+
+/*
+================
+idDict::FindBaseKey
+
+Returns the base pair, or the value set for it here, unless this dictionary deleted or shadowed it
+================
+*/
+const idKeyValue* idDict::FindBaseKey( int baseIndex ) const
+{
+	if( baseIndex == -1 )
+	{
+		return NULL;
+	}
+	const int i = idBinSearch_GreaterEqual( baseHidden.Ptr(), baseHidden.Num(), baseIndex );
+	if( i < baseHidden.Num() && baseHidden[i] == baseIndex )
+	{
+		return NULL;
+	}
+	return GetBaseKeyVal( baseIndex );
+}
+
+/*
+================
+idDict::FindBaseOverride
+
+Returns the index into baseOverrides for the base pair, -1 if it isn't set here
+================
+*/
+int idDict::FindBaseOverride( int baseIndex ) const
+{
+	int lo = 0;
+	int hi = baseOverrides.Num();
+	while( lo < hi )
+	{
+		const int mid = ( lo + hi ) >> 1;
+		if( baseOverrides[mid].baseIndex < baseIndex )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	return ( lo < baseOverrides.Num() && baseOverrides[lo].baseIndex == baseIndex ) ? lo : -1;
+}
+
+/*
+================
+idDict::SetBaseValue
+
+Sets the value of a visible base pair in place, so the pair keeps its index
+================
+*/
+void idDict::SetBaseValue( int baseIndex, const char* value )
+{
+	int i = FindBaseOverride( baseIndex );
+	if( base->args[baseIndex].GetValue().Cmp( value ) == 0 )
+	{
+		// the shared value already matches
+		if( i != -1 )
+		{
+			RemoveBaseOverride( baseIndex );
+		}
+		return;
+	}
+	
+	if( i != -1 )
+	{
+		// first set the new value and then free the old value to allow proper self copying
+		const idPoolStr* oldValue = baseOverrides[i].kv.value;
+		baseOverrides[i].kv.value = globalValues.AllocString( value );
+		globalValues.FreeString( oldValue );
+		return;
+	}
+	
+	baseOverride_t newOverride;
+	newOverride.baseIndex = baseIndex;
+	newOverride.kv.key = globalKeys.CopyString( base->args[baseIndex].key );
+	newOverride.kv.value = globalValues.AllocString( value );
+	
+	i = 0;
+	while( i < baseOverrides.Num() && baseOverrides[i].baseIndex < baseIndex )
+	{
+		i++;
+	}
+	baseOverrides.Insert( newOverride, i );
+}
+
+/*
+================
+idDict::RemoveBaseOverride
+================
+*/
+void idDict::RemoveBaseOverride( int baseIndex )
+{
+	const int i = FindBaseOverride( baseIndex );
+	if( i != -1 )
+	{
+		globalKeys.FreeString( baseOverrides[i].kv.key );
+		globalValues.FreeString( baseOverrides[i].kv.value );
+		baseOverrides.RemoveIndex( i );
+	}
+}
+
+/*
+================
+idDict::FreeBaseOverrides
+================
+*/
+void idDict::FreeBaseOverrides()
+{
+	for( int i = 0; i < baseOverrides.Num(); i++ )
+	{
+		globalKeys.FreeString( baseOverrides[i].kv.key );
+		globalValues.FreeString( baseOverrides[i].kv.value );
+	}
+	baseOverrides.Clear();
+}
+
+/*
+================
+idDict::BaseToIndex
+
+Maps a base pair onto the index GetKeyVal uses for it, -1 if it is hidden
+================
+*/
+int idDict::BaseToIndex( int baseIndex ) const
+{
+	if( baseIndex == -1 )
+	{
+		return -1;
+	}
+	const int i = idBinSearch_GreaterEqual( baseHidden.Ptr(), baseHidden.Num(), baseIndex );
+	if( i < baseHidden.Num() && baseHidden[i] == baseIndex )
+	{
+		return -1;
+	}
+	return args.Num() + baseIndex - i;
+}
+
+/*
+================
+idDict::HideBaseKey
+================
+*/
+void idDict::HideBaseKey( int baseIndex )
+{
+	if( baseIndex == -1 )
+	{
+		return;
+	}
+	const int i = idBinSearch_GreaterEqual( baseHidden.Ptr(), baseHidden.Num(), baseIndex );
+	if( i < baseHidden.Num() && baseHidden[i] == baseIndex )
+	{
+		return;
+	}
+	baseHidden.Insert( baseIndex, i );
+}
+
 /*
 ================
 idDict::Clear
@@ -236,6 +513,9 @@ void idDict::Clear()
 	
 	args.Clear();
 	argHash.Free();
+	frozen = false;
+	frozenKeys.Clear();
+	ReleaseBase();
 }
 
 /*
@@ -248,10 +528,11 @@ void idDict::Print() const
 	int i;
 	int n;
 	
-	n = args.Num();
+	n = GetNumKeyVals();
 	for( i = 0; i < n; i++ )
 	{
-		idLib::common->Printf( "%s = %s\n", args[i].GetKey().c_str(), args[i].GetValue().c_str() );
+		const idKeyValue* kv = GetKeyVal( i );
+		idLib::common->Printf( "%s = %s\n", kv->GetKey().c_str(), kv->GetValue().c_str() );
 	}
 }
 
@@ -272,7 +553,12 @@ int	idDict::Checksum() const
 	// RB end
 	int i, n;
 	
-	idList<idKeyValue> sorted = args;
+	idList<idKeyValue> sorted;
+	sorted.SetNum( GetNumKeyVals() );
+	for( i = 0; i < sorted.Num(); i++ )
+	{
+		sorted[i] = *GetKeyVal( i );
+	}
 	sorted.SortWithTemplate( idSort_KeyValue() );
 	n = sorted.Num();
 	CRC32_InitChecksum( ret );
@@ -295,11 +581,15 @@ size_t idDict::Allocated() const
 	int		i;
 	size_t	size;
 	
-	size = args.Allocated() + argHash.Allocated();
+	size = args.Allocated() + argHash.Allocated() + frozenKeys.Allocated() + baseHidden.Allocated() + baseOverrides.Allocated();
 	for( i = 0; i < args.Num(); i++ )
 	{
 		size += args[i].Size();
 	}
+	for( i = 0; i < baseOverrides.Num(); i++ )
+	{
+		size += baseOverrides[i].kv.Size();
+	}
 	
 	return size;
 }
@@ -319,7 +609,9 @@ void idDict::Set( const char* key, const char* value )
 		return;
 	}
 	
-	i = FindKeyIndex( key );
+	Thaw();
+	
+	i = FindOwnKeyIndex( key );
 	if( i != -1 )
 	{
 		// first set the new value and then free the old value to allow proper self copying
@@ -329,6 +621,16 @@ void idDict::Set( const char* key, const char* value )
 	}
 	else
 	{
+		// an inherited pair is set where it is, so the key order doesn't change
+		if( base != NULL )
+		{
+			const int baseIndex = base->FindOwnKeyIndex( key );
+			if( FindBaseKey( baseIndex ) != NULL )
+			{
+				SetBaseValue( baseIndex, value );
+				return;
+			}
+		}
 		kv.key = globalKeys.AllocString( key );
 		kv.value = globalValues.AllocString( value );
 		argHash.Add( argHash.GenerateKey( kv.GetKey(), false ), args.Append( kv ) );
@@ -573,15 +875,15 @@ const idKeyValue* idDict::FindKey( const char* key ) const
 		return NULL;
 	}
 	
-	int hash = argHash.GenerateKey( key, false );
-	for ( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
+	const int i = FindOwnKeyIndex( key );
+	if( i != -1 )
 	{
-		if( args[i].GetKey().Icmp( key ) == 0 )
-		{
-			return &args[i];
-		}
+		return &args[i];
+	}
+	if( base != NULL )
+	{
+		return FindBaseKey( base->FindOwnKeyIndex( key ) );
 	}
-	
 	return NULL;
 }
 
@@ -598,6 +900,36 @@ int idDict::FindKeyIndex( const char* key ) const
 		return 0;
 	}
 	
+	const int i = FindOwnKeyIndex( key );
+	if( i != -1 || base == NULL )
+	{
+		return i;
+	}
+	return BaseToIndex( base->FindOwnKeyIndex( key ) );
+}
+
+/*
+================
+idDict::FindOwnKeyIndex
+
+Only searches the pairs stored in this dictionary, not the shared defaults
+================
+*/
+int idDict::FindOwnKeyIndex( const char* key ) const
+{
+	if( frozen )
+	{
+		const int hash = idStr::IHash( key );
+		for( int i = FirstFrozenKey( hash ); i < frozenKeys.Num() && frozenKeys[i].hash == hash; i++ )
+		{
+			if( args[frozenKeys[i].index].GetKey().Icmp( key ) == 0 )
+			{
+				return frozenKeys[i].index;
+			}
+		}
+		return -1;
+	}
+	
 	int hash = argHash.GenerateKey( key, false );
 	for( int i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
 	{
@@ -610,6 +942,217 @@ int idDict::FindKeyIndex( const char* key ) const
 	return -1;
 }
 
+/*
+================
+idDict::FindKey
+================
+*/
+const idKeyValue* idDict::FindKey( const idDictKey& key ) const
+{
+	const int i = FindOwnKeyIndex( key );
+	if( i != -1 )
+	{
+		return &args[i];
+	}
+	if( base != NULL )
+	{
+		return FindBaseKey( base->FindOwnKeyIndex( key ) );
+	}
+	return NULL;
+}
+
+/*
+================
+idDict::FindKeyIndex
+================
+*/
+int idDict::FindKeyIndex( const idDictKey& key ) const
+{
+	const int i = FindOwnKeyIndex( key );
+	if( i != -1 || base == NULL )
+	{
+		return i;
+	}
+	return BaseToIndex( base->FindOwnKeyIndex( key ) );
+}
+
+/*
+================
+idDict::FindOwnKeyIndex
+
+Keys are pooled case-insensitively, so a pointer compare is all it takes to match a key from the
+same pool. Only dictionaries filled on the other side of a DLL boundary fall back to Icmp.
+================
+*/
+int idDict::FindOwnKeyIndex( const idDictKey& key ) const
+{
+	const idPoolStr* poolStr = key.GetPoolStr();
+	
+	if( frozen )
+	{
+		for( int i = FirstFrozenKey( key.hash ); i < frozenKeys.Num() && frozenKeys[i].hash == key.hash; i++ )
+		{
+			const idPoolStr* argKey = args[frozenKeys[i].index].key;
+			if( argKey == poolStr || ( argKey->GetPool() != poolStr->GetPool() && argKey->Icmp( key.name ) == 0 ) )
+			{
+				return frozenKeys[i].index;
+			}
+		}
+		return -1;
+	}
+	
+	for( int i = argHash.First( argHash.GenerateKey( key.hash ) ); i != -1; i = argHash.Next( i ) )
+	{
+		const idPoolStr* argKey = args[i].key;
+		if( argKey == poolStr || ( argKey->GetPool() != poolStr->GetPool() && argKey->Icmp( key.name ) == 0 ) )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idDict::GetVector
+================
+*/
+idVec3 idDict::GetVector( const idDictKey& key, const char* defaultString ) const
+{
+	const char* s;
+	GetString( key, ( defaultString != NULL ) ? defaultString : "0 0 0", &s );
+	
+	idVec3 out;
+	out.Zero();
+	sscanf( s, "%f %f %f", &out.x, &out.y, &out.z );
+	return out;
+}
+
+/*
+================
+idDict::GetAngles
+================
+*/
+idAngles idDict::GetAngles( const idDictKey& key, const char* defaultString ) const
+{
+	const char* s;
+	GetString( key, ( defaultString != NULL ) ? defaultString : "0 0 0", &s );
+	
+	idAngles out;
+	out.Zero();
+	sscanf( s, "%f %f %f", &out.pitch, &out.yaw, &out.roll );
+	return out;
+}
+
+/*
+================
+idDict::GetMatrix
+================
+*/
+idMat3 idDict::GetMatrix( const idDictKey& key, const char* defaultString ) const
+{
+	const char* s;
+	GetString( key, ( defaultString != NULL ) ? defaultString : "1 0 0 0 1 0 0 0 1", &s );
+	
+	idMat3 out;
+	out.Identity();
+	sscanf( s, "%f %f %f %f %f %f %f %f %f", &out[0].x, &out[0].y, &out[0].z, &out[1].x, &out[1].y, &out[1].z, &out[2].x, &out[2].y, &out[2].z );
+	return out;
+}
+
+/*
+================
+idDict::Freeze
+================
+*/
+void idDict::Freeze()
+{
+	if( frozen )
+	{
+		return;
+	}
+	
+	frozenKeys.SetNum( args.Num() );
+	for( int i = 0; i < args.Num(); i++ )
+	{
+		frozenKeys[i].hash = idStr::IHash( args[i].GetKey() );
+		frozenKeys[i].index = i;
+	}
+	
+	// insertion sort, the dictionaries this is used for hold a few dozen keys
+	for( int i = 1; i < frozenKeys.Num(); i++ )
+	{
+		const frozenKey_t key = frozenKeys[i];
+		int j = i - 1;
+		for( ; j >= 0 && frozenKeys[j].hash > key.hash; j-- )
+		{
+			frozenKeys[j + 1] = frozenKeys[j];
+		}
+		frozenKeys[j + 1] = key;
+	}
+	
+	argHash.Free();
+	frozen = true;
+}
+
+/*
+================
+idDict::Thaw
+
+Turns the hash index back on before a frozen dictionary is modified
+================
+*/
+void idDict::Thaw()
+{
+	if( !frozen )
+	{
+		return;
+	}
+	frozen = false;
+	frozenKeys.Clear();
+	RebuildHash();
+}
+
+/*
+================
+idDict::RebuildHash
+================
+*/
+void idDict::RebuildHash()
+{
+	argHash.Free();
+	for( int i = 0; i < args.Num(); i++ )
+	{
+		argHash.Add( argHash.GenerateKey( args[i].GetKey(), false ), i );
+	}
+}
+
+/*
+================
+idDict::FirstFrozenKey
+
+Returns the index of the first frozen key with the given hash, or the insertion point if there is none
+================
+*/
+int idDict::FirstFrozenKey( int hash ) const
+{
+	int lo = 0;
+	int hi = frozenKeys.Num();
+	while( lo < hi )
+	{
+		const int mid = ( lo + hi ) >> 1;
+		if( frozenKeys[mid].hash < hash )
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
 /*
 ================
 idDict::Delete
@@ -619,6 +1162,8 @@ void idDict::Delete( const char* key )
 {
 	int hash, i;
 	
+	Thaw();
+	
 	hash = argHash.GenerateKey( key, false );
 	for( i = argHash.First( hash ); i != -1; i = argHash.Next( i ) )
 	{
@@ -632,6 +1177,14 @@ void idDict::Delete( const char* key )
 		}
 	}
 	
+	// keep the shared value from showing through
+	if( base != NULL )
+	{
+		const int baseIndex = base->FindOwnKeyIndex( key );
+		RemoveBaseOverride( baseIndex );
+		HideBaseKey( baseIndex );
+	}
+	
 #if 0
 	// make sure all keys can still be found in the hash index
 	for( i = 0; i < args.Num(); i++ )
@@ -651,6 +1204,7 @@ const idKeyValue* idDict::MatchPrefix( const char* prefix, const idKeyValue* las
 	int	i;
 	int len;
 	int start;
+	int n;
 	
 	assert( prefix );
 	len = strlen( prefix );
@@ -658,7 +1212,21 @@ const idKeyValue* idDict::MatchPrefix( const char* prefix, const idKeyValue* las
 	start = -1;
 	if( lastMatch )
 	{
-		start = args.FindIndex( *lastMatch );
+		if( base != NULL && lastMatch >= base->args.Ptr() && lastMatch < base->args.Ptr() + base->args.Num() )
+		{
+			start = BaseToIndex( lastMatch - base->args.Ptr() );
+		}
+		else
+		{
+			start = args.FindIndex( *lastMatch );
+			for( i = 0; start == -1 && i < baseOverrides.Num(); i++ )
+			{
+				if( lastMatch == &baseOverrides[i].kv )
+				{
+					start = BaseToIndex( baseOverrides[i].baseIndex );
+				}
+			}
+		}
 		assert( start >= 0 );
 		if( start < 1 )
 		{
@@ -673,6 +1241,16 @@ const idKeyValue* idDict::MatchPrefix( const char* prefix, const idKeyValue* las
 			return &args[i];
 		}
 	}
+	
+	n = GetNumKeyVals();
+	for( ; i < n; i++ )
+	{
+		const idKeyValue* kv = GetKeyVal( i );
+		if( !kv->GetKey().Icmpn( prefix, len ) )
+		{
+			return kv;
+		}
+	}
 	return NULL;
 }
 
@@ -703,12 +1281,14 @@ idDict::WriteToFileHandle
 */
 void idDict::WriteToFileHandle( idFile* f ) const
 {
-	int c = LittleLong( args.Num() );
+	const int n = GetNumKeyVals();
+	int c = LittleLong( n );
 	f->Write( &c, sizeof( c ) );
-	for( int i = 0; i < args.Num(); i++ )  	// don't loop on the swapped count use the original
+	for( int i = 0; i < n; i++ )  	// don't loop on the swapped count use the original
 	{
-		WriteString( args[i].GetKey().c_str(), f );
-		WriteString( args[i].GetValue().c_str(), f );
+		const idKeyValue* kv = GetKeyVal( i );
+		WriteString( kv->GetKey().c_str(), f );
+		WriteString( kv->GetValue().c_str(), f );
 	}
 }
 
@@ -772,7 +1352,7 @@ void idDict::Serialize( idSerializer& ser )
 		Clear();
 	}
 	
-	int num = args.Num();
+	int num = GetNumKeyVals();
 	ser.SerializePacked( num );
 	for( int i = 0; i < num; i++ )
 	{
@@ -781,8 +1361,8 @@ void idDict::Serialize( idSerializer& ser )
 		
 		if( ser.IsWriting() )
 		{
-			key = args[i].GetKey();
-			val = args[i].GetValue();
+			key = GetKeyVal( i )->GetKey();
+			val = GetKeyVal( i )->GetValue();
 		}
 		
 		ser.SerializeString( key );
@@ -803,7 +1383,12 @@ idDict::WriteToIniFile
 void idDict::WriteToIniFile( idFile* f ) const
 {
 	// make a copy so we don't affect the checksum of the original dict
-	idList< idKeyValue > sortedArgs( args );
+	idList< idKeyValue > sortedArgs;
+	sortedArgs.SetNum( GetNumKeyVals() );
+	for( int i = 0; i < sortedArgs.Num(); i++ )
+	{
+		sortedArgs[i] = *GetKeyVal( i );
+	}
 	sortedArgs.SortWithTemplate( idSort_KeyValue() );
 	
 	idList< idStr > prefixList;
@@ -994,6 +1579,132 @@ CONSOLE_COMMAND( TestDictIniFile, "Tests the writing/reading of various items in
 	}
 }
 
+/*
+================================================
+idDictStressThread
+
+Copies, sets and deletes spawnArg style key/value pairs on private dictionaries.
+All threads draw from the same key and value names, so they contend on the
+same string pool shards.
+================================================
+*/
+class idDictStressThread : public idSysThread
+{
+public:
+	const idStrList* 	keys;
+	const idStrList* 	values;
+	int					iterations;
+	int					seed;
+	
+protected:
+	virtual int			Run()
+	{
+		idRandom random( seed );
+		idDict source;
+		idDict copy;
+		
+		for( int i = 0; i < iterations; i++ )
+		{
+			for( int j = 0; j < 8; j++ )
+			{
+				source.Set( ( *keys )[random.RandomInt( keys->Num() )], ( *values )[random.RandomInt( values->Num() )] );
+			}
+			copy.Copy( source );
+			for( int j = 0; j < 4; j++ )
+			{
+				source.Delete( ( *keys )[random.RandomInt( keys->Num() )] );
+			}
+			if( ( i & 15 ) == 15 )
+			{
+				source.Clear();
+				copy.Clear();
+			}
+		}
+		return 0;
+	}
+};
+
+/*
+================
+RunDictStressThreads
+
+Returns the time in microseconds it took numThreads threads to finish
+================
+*/
+static uint64 RunDictStressThreads( idDictStressThread* threads, int numThreads )
+{
+	const uint64 start = Sys_Microseconds();
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].SignalWork();
+	}
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].WaitForThread();
+	}
+	return Sys_Microseconds() - start;
+}
+
+/*
+================
+idDict::TestThreads_f
+================
+*/
+void idDict::TestThreads_f( const idCmdArgs& args )
+{
+	const int maxThreads = 32;
+	const int numThreads = idMath::ClampInt( 1, maxThreads, ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 4 );
+	const int iterations = idMath::ClampInt( 1, 10000000, ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 100000 );
+	
+	idStrList keys;
+	idStrList values;
+	for( int i = 0; i < 256; i++ )
+	{
+		keys.Append( va( "stressKey%d", i ) );
+		values.Append( va( "%d %d %d", i, i * 3, i * 7 ) );
+	}
+	
+	const int numKeys = globalKeys.Num();
+	const int numValues = globalValues.Num();
+	
+	idDictStressThread threads[maxThreads];
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].keys = &keys;
+		threads[i].values = &values;
+		threads[i].iterations = iterations;
+		threads[i].seed = i;
+		threads[i].StartWorkerThread( va( "DictStress%d", i ), CORE_ANY );
+	}
+	
+	const uint64 singleTime = Max( RunDictStressThreads( threads, 1 ), ( uint64 )1 );
+	const uint64 multiTime = Max( RunDictStressThreads( threads, numThreads ), ( uint64 )1 );
+	
+	for( int i = 0; i < numThreads; i++ )
+	{
+		threads[i].StopThread();
+	}
+	
+	const double singleRate = ( double )iterations / ( singleTime * 0.001 );
+	const double multiRate = ( double )iterations * numThreads / ( multiTime * 0.001 );
+	idLib::Printf( "1 thread:   %8.0f iterations/ms\n", singleRate );
+	idLib::Printf( "%d threads: %8.0f iterations/ms (%.2fx)\n", numThreads, multiRate, multiRate / singleRate );
+	
+	if( globalKeys.Num() != numKeys || globalValues.Num() != numValues )
+	{
+		idLib::Printf( "[^1FAILED^0] string pools went from %d/%d to %d/%d keys/values.\n", numKeys, numValues, globalKeys.Num(), globalValues.Num() );
+	}
+	else
+	{
+		idLib::Printf( "[^2PASSED^0] string pools are balanced.\n" );
+	}
+}
+
+CONSOLE_COMMAND( testDictThreads, "measures idDict Copy/Set/Delete throughput with contending threads, usage: testDictThreads [threads] [iterations]", 0 )
+{
+	idDict::TestThreads_f( args );
+}
+
 /*
 ================
 idDict::Init
@@ -1012,6 +1723,7 @@ idDict::Shutdown
 */
 void idDict::Shutdown()
 {
+	keyPoolGeneration++;
 	globalKeys.Clear();
 	globalValues.Clear();
 }
@@ -44,6 +44,19 @@ Keys are compared case-insensitive.
 
 Does not allocate memory until the first key/value pair is added.
 
+The key and value string pools are shared and thread safe, so different
+dictionaries can be copied and modified from different threads. A single
+dictionary still needs outside synchronization.
+
+A dictionary can be layered on top of shared defaults (see SetSharedDefaults),
+in which case it only stores the pairs it adds or overrides and lookups fall
+through to the shared dictionary. Indexing covers both layers, the own pairs
+come first followed by the shared pairs that are not deleted, which is the
+same order SetDefaults produces. Setting a shared key replaces the value at
+the position of the shared pair, like it would for a copied default. New keys
+are added to the own pairs, so unlike after SetDefaults they come before the
+shared pairs.
+
 ===============================================================================
 */
 
@@ -94,8 +107,50 @@ public:
 	}
 };
 
+/*
+================================================
+idDictKey
+
+A key with its hash computed once and its pooled string resolved on first use. Looking a key
+up through a handle compares pool pointers along the hash chain instead of running Icmp, so
+handles are meant for keys that are looked up over and over, typically as static objects next
+to the code reading the spawnArgs. The key string has to outlive the handle.
+
+The pooled string is resolved lazily because static handles are constructed before idDict::Init,
+it has to happen on the thread that owns the dictionaries just like idDict::Set.
+================================================
+*/
+class idDictKey
+{
+	friend class idDict;
+	
+public:
+	explicit			idDictKey( const char* key ) :
+		name( key ),
+		hash( idStr::IHash( key ) ),
+		poolStr( NULL ),
+		poolGeneration( 0 )
+	{
+	}
+	
+	const char* 		c_str() const
+	{
+		return name;
+	}
+	
+private:
+	const idPoolStr* 	GetPoolStr() const;
+	
+	const char* 		name;
+	int					hash;				// idStr::IHash of the whole key, the dict masks it
+	mutable const idPoolStr* poolStr;
+	mutable int			poolGeneration;		// idDict::keyPoolGeneration poolStr was resolved for
+};
+
 class idDict
 {
+	friend class idDictKey;
+	
 public:
 	idDict();
 	idDict( const idDict& other );	// allow declaration with assignment
@@ -115,6 +170,13 @@ public:
 	bool				Parse( idParser& parser );
 	// copy key/value pairs from other dict not present in this dict
 	void				SetDefaults( const idDict* dict );
+	// same as SetDefaults but references the shared dictionary instead of copying from it,
+	// the shared dictionary has to come from AllocShared
+	void				SetSharedDefaults( const idDict* shared );
+	const idDict* 		GetSharedDefaults() const
+	{
+		return base;
+	}
 	// clear dict freeing up memory
 	void				Clear();
 	// print the dict
@@ -191,24 +253,89 @@ public:
 	// returns a unique checksum for this dictionary's content
 	int					Checksum() const;
 	
+	// lookups through pre-hashed key handles
+	const idKeyValue* 	FindKey( const idDictKey& key ) const;
+	int					FindKeyIndex( const idDictKey& key ) const;
+	const char* 		GetString( const idDictKey& key, const char* defaultString = "" ) const;
+	bool				GetString( const idDictKey& key, const char* defaultString, const char** out ) const;
+	float				GetFloat( const idDictKey& key, const float defaultFloat = 0.0f ) const;
+	int					GetInt( const idDictKey& key, const int defaultInt = 0 ) const;
+	bool				GetBool( const idDictKey& key, const bool defaultBool = false ) const;
+	idVec3				GetVector( const idDictKey& key, const char* defaultString = NULL ) const;
+	idAngles			GetAngles( const idDictKey& key, const char* defaultString = NULL ) const;
+	idMat3				GetMatrix( const idDictKey& key, const char* defaultString = NULL ) const;
+	
+	// Replaces the hash index with a flat array of key hashes sorted for binary search. Meant for
+	// dictionaries that are built once and only read afterwards, like entityDef decls. The key /
+	// value order is unchanged, and any call that modifies the dictionary turns the hash index
+	// back on first.
+	void				Freeze();
+	bool				IsFrozen() const
+	{
+		return frozen;
+	}
+	
+	// returns an immutable, reference counted copy of source for use with SetSharedDefaults
+	static const idDict* AllocShared( const idDict& source );
+	static void			FreeShared( const idDict* shared );
+	
 	static void			Init();
 	static void			Shutdown();
 	
 	static void			ShowMemoryUsage_f( const idCmdArgs& args );
 	static void			ListKeys_f( const idCmdArgs& args );
 	static void			ListValues_f( const idCmdArgs& args );
+	static void			TestThreads_f( const idCmdArgs& args );
 	
 private:
+	struct frozenKey_t
+	{
+		int				hash;				// idStr::IHash of the key
+		int				index;				// into args
+	};
+	
+	struct baseOverride_t
+	{
+		int				baseIndex;			// into base->args
+		idKeyValue		kv;
+	};
+	
+	void				Thaw();
+	void				RebuildHash();
+	int					FirstFrozenKey( int hash ) const;
+	int					FindOwnKeyIndex( const char* key ) const;
+	int					FindOwnKeyIndex( const idDictKey& key ) const;
+	const idKeyValue* 	FindBaseKey( int baseIndex ) const;
+	const idKeyValue* 	GetBaseKeyVal( int baseIndex ) const;
+	int					FindBaseOverride( int baseIndex ) const;
+	void				SetBaseValue( int baseIndex, const char* value );
+	void				RemoveBaseOverride( int baseIndex );
+	void				FreeBaseOverrides();
+	int					BaseToIndex( int baseIndex ) const;
+	void				HideBaseKey( int baseIndex );
+	void				ReleaseBase();
+	
 	idList<idKeyValue>	args;
 	idHashIndex			argHash;
+	bool				frozen;
+	idList<frozenKey_t>	frozenKeys;			// sorted by hash when frozen
+	
+	const idDict* 		base;				// shared defaults below this dictionary
+	idList<int>			baseHidden;			// sorted indices of base pairs deleted here or shadowed by own pairs
+	idList<baseOverride_t>	baseOverrides;	// base pairs set here, sorted by baseIndex
+	mutable interlockedInt_t sharedRefs;	// references to a dictionary from AllocShared
 	
 	static idStrPool	globalKeys;
 	static idStrPool	globalValues;
+	static int			keyPoolGeneration;	// bumped when globalKeys is cleared, invalidates resolved idDictKeys
 };
 
 
 ID_INLINE idDict::idDict()
 {
+	frozen = false;
+	base = NULL;
+	sharedRefs = 0;
 	args.SetGranularity( 16 );
 	argHash.SetGranularity( 16 );
 	argHash.Clear( 128, 16 );
@@ -216,6 +343,9 @@ ID_INLINE idDict::idDict()
 
 ID_INLINE idDict::idDict( const idDict& other )
 {
+	frozen = false;
+	base = NULL;
+	sharedRefs = 0;
 	*this = other;
 }
 
@@ -232,7 +362,7 @@ ID_INLINE void idDict::SetGranularity( int granularity )
 
 ID_INLINE void idDict::SetHashSize( int hashSize )
 {
-	if( args.Num() == 0 )
+	if( args.Num() == 0 && !frozen )
 	{
 		argHash.Clear( hashSize, 16 );
 	}
@@ -392,17 +522,112 @@ ID_INLINE idMat3 idDict::GetMatrix( const char* key, const char* defaultString )
 	return out;
 }
 
+ID_INLINE const idPoolStr* idDictKey::GetPoolStr() const
+{
+	if( poolGeneration != idDict::keyPoolGeneration )
+	{
+		// the pool reference is never released, so the pointer stays valid until the pool is cleared.
+		// Threads racing here all get the same interned string and at worst leak a reference
+		poolStr = idDict::globalKeys.AllocString( name );
+		SYS_MEMORYBARRIER;
+		poolGeneration = idDict::keyPoolGeneration;
+	}
+	return poolStr;
+}
+
+ID_INLINE bool idDict::GetString( const idDictKey& key, const char* defaultString, const char** out ) const
+{
+	const idKeyValue* kv = FindKey( key );
+	if( kv )
+	{
+		*out = kv->GetValue();
+		return true;
+	}
+	*out = defaultString;
+	return false;
+}
+
+ID_INLINE const char* idDict::GetString( const idDictKey& key, const char* defaultString ) const
+{
+	const idKeyValue* kv = FindKey( key );
+	if( kv )
+	{
+		return kv->GetValue();
+	}
+	return defaultString;
+}
+
+ID_INLINE float idDict::GetFloat( const idDictKey& key, const float defaultFloat ) const
+{
+	const idKeyValue* kv = FindKey( key );
+	if( kv )
+	{
+		return atof( kv->GetValue() );
+	}
+	return defaultFloat;
+}
+
+ID_INLINE int idDict::GetInt( const idDictKey& key, const int defaultInt ) const
+{
+	const idKeyValue* kv = FindKey( key );
+	if( kv )
+	{
+		return atoi( kv->GetValue() );
+	}
+	return defaultInt;
+}
+
+ID_INLINE bool idDict::GetBool( const idDictKey& key, const bool defaultBool ) const
+{
+	const idKeyValue* kv = FindKey( key );
+	if( kv )
+	{
+		return atoi( kv->GetValue() ) != 0;
+	}
+	return defaultBool;
+}
+
 ID_INLINE int idDict::GetNumKeyVals() const
 {
+	if( base != NULL )
+	{
+		return args.Num() + base->args.Num() - baseHidden.Num();
+	}
 	return args.Num();
 }
 
+ID_INLINE const idKeyValue* idDict::GetBaseKeyVal( int baseIndex ) const
+{
+	if( baseOverrides.Num() != 0 )
+	{
+		const int i = FindBaseOverride( baseIndex );
+		if( i != -1 )
+		{
+			return &baseOverrides[ i ].kv;
+		}
+	}
+	return &base->args[ baseIndex ];
+}
+
 ID_INLINE const idKeyValue* idDict::GetKeyVal( int index ) const
 {
 	if( index >= 0 && index < args.Num() )
 	{
 		return &args[ index ];
 	}
+	if( base != NULL && index >= args.Num() )
+	{
+		// skip over the hidden base pairs in front of the one we want
+		int baseIndex = index - args.Num();
+		for( int i = 0; i < baseHidden.Num() && baseHidden[i] <= baseIndex; i++ )
+		{
+			baseIndex++;
+		}
+		if( baseIndex < base->args.Num() )
+		{
+			return GetBaseKeyVal( baseIndex );
+		}
+	}
 	return NULL;
 }
 
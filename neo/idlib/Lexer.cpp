@@ -308,12 +308,105 @@ void idLexer::SetPunctuations( const punctuation_t* p )
 	}
 }
 
+/*
+================
+Lexer_SkipSpaces
+
+  returns a pointer to the first character after p that is not a space or control character,
+  or to the trailing zero, the newlines stepped over are added to numLines
+================
+*/
+static ID_INLINE const char* Lexer_SkipSpaces( const char* p, const char* end, int& numLines )
+{
+	// most tokens are only separated by a few characters
+	for( int i = 0; i < 4; i++, p++ )
+	{
+		if( *p > ' ' || *p == '\0' )
+		{
+			return p;
+		}
+		if( *p == '\n' )
+		{
+			numLines++;
+		}
+	}
+	
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i space = _mm_set1_epi8( ' ' );
+	const __m128i newline = _mm_set1_epi8( '\n' );
+	
+	// the characters are signed just like the scalar loop so bytes above 127 count as white space
+	while( p + 16 <= end )
+	{
+		const __m128i chars = _mm_loadu_si128( ( const __m128i* ) p );
+		int stopMask = _mm_movemask_epi8( _mm_or_si128( _mm_cmpgt_epi8( chars, space ), _mm_cmpeq_epi8( chars, zero ) ) );
+		int newlineMask = _mm_movemask_epi8( _mm_cmpeq_epi8( chars, newline ) );
+		if( stopMask != 0 )
+		{
+			int lowBit = stopMask & -stopMask;
+			numLines += idMath::BitCount( newlineMask & ( lowBit - 1 ) );
+			return p + idMath::BitCount( lowBit - 1 );
+		}
+		numLines += idMath::BitCount( newlineMask );
+		p += 16;
+	}
+	while( *p <= ' ' && *p != '\0' )
+	{
+		if( *p == '\n' )
+		{
+			numLines++;
+		}
+		p++;
+	}
+	return p;
+}
+
+/*
+================
+Lexer_SkipComment
+
+  returns a pointer to the first stop character at or after p, or to the trailing zero,
+  the newlines stepped over are added to numLines
+================
+*/
+static ID_INLINE const char* Lexer_SkipComment( const char* p, const char* end, char stop, int& numLines )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i stopChar = _mm_set1_epi8( stop );
+	const __m128i newline = _mm_set1_epi8( '\n' );
+	
+	while( p + 16 <= end )
+	{
+		const __m128i chars = _mm_loadu_si128( ( const __m128i* ) p );
+		int stopMask = _mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( chars, stopChar ), _mm_cmpeq_epi8( chars, zero ) ) );
+		int newlineMask = _mm_movemask_epi8( _mm_cmpeq_epi8( chars, newline ) );
+		if( stopMask != 0 )
+		{
+			int lowBit = stopMask & -stopMask;
+			numLines += idMath::BitCount( newlineMask & ( lowBit - 1 ) );
+			return p + idMath::BitCount( lowBit - 1 );
+		}
+		numLines += idMath::BitCount( newlineMask );
+		p += 16;
+	}
+	while( *p != stop && *p != '\0' )
+	{
+		if( *p == '\n' )
+		{
+			numLines++;
+		}
+		p++;
+	}
+	return p;
+}
+
 /*
 ================
 idLexer::ReadWhiteSpace
 
 Reads spaces, tabs, C-like comments etc.
 When a newline character is found the scripts line counter is increased.
+Long runs of white space and comment text are skipped 16 characters at a time.
 ================
 */
 int idLexer::ReadWhiteSpace()
@@ -321,17 +414,10 @@ int idLexer::ReadWhiteSpace()
 	while( 1 )
 	{
 		// skip white space
-		while( *idLexer::script_p <= ' ' )
+		idLexer::script_p = Lexer_SkipSpaces( idLexer::script_p, idLexer::end_p, idLexer::line );
+		if( !*idLexer::script_p )
 		{
-			if( !*idLexer::script_p )
-			{
-				return 0;
-			}
-			if( *idLexer::script_p == '\n' )
-			{
-				idLexer::line++;
-			}
-			idLexer::script_p++;
+			return 0;
 		}
 		// skip comments
 		if( *idLexer::script_p == '/' )
@@ -339,16 +425,11 @@ int idLexer::ReadWhiteSpace()
 			// comments //
 			if( *( idLexer::script_p + 1 ) == '/' )
 			{
-				idLexer::script_p++;
-				do
+				idLexer::script_p = Lexer_SkipComment( idLexer::script_p + 2, idLexer::end_p, '\n', idLexer::line );
+				if( !*idLexer::script_p )
 				{
-					idLexer::script_p++;
-					if( !*idLexer::script_p )
-					{
-						return 0;
-					}
+					return 0;
 				}
-				while( *idLexer::script_p != '\n' );
 				idLexer::line++;
 				idLexer::script_p++;
 				if( !*idLexer::script_p )
@@ -360,29 +441,23 @@ int idLexer::ReadWhiteSpace()
 			// comments /* */
 			else if( *( idLexer::script_p + 1 ) == '*' )
 			{
-				idLexer::script_p++;
+				idLexer::script_p += 2;
 				while( 1 )
 				{
-					idLexer::script_p++;
+					idLexer::script_p = Lexer_SkipComment( idLexer::script_p, idLexer::end_p, '/', idLexer::line );
 					if( !*idLexer::script_p )
 					{
 						return 0;
 					}
-					if( *idLexer::script_p == '\n' )
+					if( *( idLexer::script_p - 1 ) == '*' )
 					{
-						idLexer::line++;
+						break;
 					}
-					else if( *idLexer::script_p == '/' )
+					if( *( idLexer::script_p + 1 ) == '*' )
 					{
-						if( *( idLexer::script_p - 1 ) == '*' )
-						{
-							break;
-						}
-						if( *( idLexer::script_p + 1 ) == '*' )
-						{
-							idLexer::Warning( "nested comment" );
-						}
+						idLexer::Warning( "nested comment" );
 					}
+					idLexer::script_p++;
 				}
 				idLexer::script_p++;
 				if( !*idLexer::script_p )
@@ -738,18 +813,18 @@ int idLexer::ReadString( idToken* token, int quote )
 
 /*
 ================
-idLexer::ReadName
+idLexer::ScanName
+
+  returns a pointer to the first character after the name that starts at p
 ================
 */
-int idLexer::ReadName( idToken* token )
+ID_INLINE const char* idLexer::ScanName( const char* p ) const
 {
 	char c;
 	
-	token->type = TT_NAME;
 	do
 	{
-		token->AppendDirty( *idLexer::script_p++ );
-		c = *idLexer::script_p;
+		c = *( ++p );
 	}
 	while( ( c >= 'a' && c <= 'z' ) ||
 			( c >= 'A' && c <= 'Z' ) ||
@@ -759,7 +834,39 @@ int idLexer::ReadName( idToken* token )
 			( ( idLexer::flags & LEXFL_ONLYSTRINGS ) && ( c == '-' ) ) ||
 			// if special path name characters are allowed
 			( ( idLexer::flags & LEXFL_ALLOWPATHNAMES ) && ( c == '/' || c == '\\' || c == ':' || c == '.' ) ) );
+	return p;
+}
+
+/*
+================
+idLexer::CopyTokenText
+
+  appends the script text between start and end to the token
+================
+*/
+ID_INLINE void idLexer::CopyTokenText( idToken* token, const char* start, const char* end ) const
+{
+	int l = end - start;
+	
+	token->EnsureAlloced( token->len + l + 1, true );
+	memcpy( token->data + token->len, start, l );
+	token->len += l;
 	token->data[token->len] = '\0';
+}
+
+/*
+================
+idLexer::ReadName
+================
+*/
+int idLexer::ReadName( idToken* token )
+{
+	const char* end;
+	
+	token->type = TT_NAME;
+	end = ScanName( idLexer::script_p );
+	CopyTokenText( token, idLexer::script_p, end );
+	idLexer::script_p = end;
 	//the sub type is the length of the name
 	token->subtype = token->Length();
 	return 1;
@@ -770,13 +877,13 @@ int idLexer::ReadName( idToken* token )
 idLexer::CheckString
 ================
 */
-ID_INLINE int idLexer::CheckString( const char* str ) const
+ID_INLINE int idLexer::CheckString( const char* p, const char* str ) const
 {
 	int i;
 	
 	for( i = 0; str[i]; i++ )
 	{
-		if( idLexer::script_p[i] != str[i] )
+		if( p[i] != str[i] )
 		{
 			return false;
 		}
@@ -786,64 +893,62 @@ ID_INLINE int idLexer::CheckString( const char* str ) const
 
 /*
 ================
-idLexer::ReadNumber
+idLexer::ScanNumber
+
+  steps over the number at the script pointer and returns its sub type, the text of the
+  number runs from the start up to textEnd, precision and size suffixes are stepped over
+  but are not part of the text
 ================
 */
-int idLexer::ReadNumber( idToken* token )
+int idLexer::ScanNumber( int* subtype, const char** textEnd )
 {
 	int i;
 	int dot;
 	char c, c2;
+	const char* p;
 	
-	token->type = TT_NUMBER;
-	token->subtype = 0;
-	token->intvalue = 0;
-	token->floatvalue = 0;
+	p = idLexer::script_p;
+	*subtype = 0;
 	
-	c = *idLexer::script_p;
-	c2 = *( idLexer::script_p + 1 );
+	c = *p;
+	c2 = *( p + 1 );
 	
 	if( c == '0' && c2 != '.' )
 	{
 		// check for a hexadecimal number
 		if( c2 == 'x' || c2 == 'X' )
 		{
-			token->AppendDirty( *idLexer::script_p++ );
-			token->AppendDirty( *idLexer::script_p++ );
-			c = *idLexer::script_p;
+			p += 2;
+			c = *p;
 			while( ( c >= '0' && c <= '9' ) ||
 					( c >= 'a' && c <= 'f' ) ||
 					( c >= 'A' && c <= 'F' ) )
 			{
-				token->AppendDirty( c );
-				c = *( ++idLexer::script_p );
+				c = *( ++p );
 			}
-			token->subtype = TT_HEX | TT_INTEGER;
+			*subtype = TT_HEX | TT_INTEGER;
 		}
 		// check for a binary number
 		else if( c2 == 'b' || c2 == 'B' )
 		{
-			token->AppendDirty( *idLexer::script_p++ );
-			token->AppendDirty( *idLexer::script_p++ );
-			c = *idLexer::script_p;
+			p += 2;
+			c = *p;
 			while( c == '0' || c == '1' )
 			{
-				token->AppendDirty( c );
-				c = *( ++idLexer::script_p );
+				c = *( ++p );
 			}
-			token->subtype = TT_BINARY | TT_INTEGER;
+			*subtype = TT_BINARY | TT_INTEGER;
 		}
 		// its an octal number
 		else
 		{
-			token->AppendDirty( *idLexer::script_p++ );
-			c = *idLexer::script_p;
+			p++;
+			c = *p;
 			while( c >= '0' && c <= '7' )
 			{
-				token->AppendDirty( c );
-				c = *( ++idLexer::script_p );
+				c = *( ++p );
 			}
-			token->subtype = TT_OCTAL | TT_INTEGER;
+			*subtype = TT_OCTAL | TT_INTEGER;
 		}
 	}
 	else
@@ -863,8 +968,7 @@ int idLexer::ReadNumber( idToken* token )
 			{
 				break;
 			}
-			token->AppendDirty( c );
-			c = *( ++idLexer::script_p );
+			c = *( ++p );
 		}
 		if( c == 'e' && dot == 0 )
 		{
@@ -874,69 +978,58 @@ int idLexer::ReadNumber( idToken* token )
 		// if a floating point number
 		if( dot == 1 )
 		{
-			token->subtype = TT_DECIMAL | TT_FLOAT;
+			*subtype = TT_DECIMAL | TT_FLOAT;
 			// check for floating point exponent
 			if( c == 'e' )
 			{
-				//Append the e so that GetFloatValue code works
-				token->AppendDirty( c );
-				c = *( ++idLexer::script_p );
-				if( c == '-' )
+				//Keep the e in the text so the number evaluation works
+				c = *( ++p );
+				if( c == '-' || c == '+' )
 				{
-					token->AppendDirty( c );
-					c = *( ++idLexer::script_p );
-				}
-				else if( c == '+' )
-				{
-					token->AppendDirty( c );
-					c = *( ++idLexer::script_p );
+					c = *( ++p );
 				}
 				while( c >= '0' && c <= '9' )
 				{
-					token->AppendDirty( c );
-					c = *( ++idLexer::script_p );
+					c = *( ++p );
 				}
 			}
 			// check for floating point exception infinite 1.#INF or indefinite 1.#IND or NaN
 			else if( c == '#' )
 			{
 				c2 = 4;
-				if( CheckString( "INF" ) )
+				if( CheckString( p, "INF" ) )
 				{
-					token->subtype |= TT_INFINITE;
+					*subtype |= TT_INFINITE;
 				}
-				else if( CheckString( "IND" ) )
+				else if( CheckString( p, "IND" ) )
 				{
-					token->subtype |= TT_INDEFINITE;
+					*subtype |= TT_INDEFINITE;
 				}
-				else if( CheckString( "NAN" ) )
+				else if( CheckString( p, "NAN" ) )
 				{
-					token->subtype |= TT_NAN;
+					*subtype |= TT_NAN;
 				}
-				else if( CheckString( "QNAN" ) )
+				else if( CheckString( p, "QNAN" ) )
 				{
-					token->subtype |= TT_NAN;
+					*subtype |= TT_NAN;
 					c2++;
 				}
-				else if( CheckString( "SNAN" ) )
+				else if( CheckString( p, "SNAN" ) )
 				{
-					token->subtype |= TT_NAN;
+					*subtype |= TT_NAN;
 					c2++;
 				}
 				for( i = 0; i < c2; i++ )
 				{
-					token->AppendDirty( c );
-					c = *( ++idLexer::script_p );
+					c = *( ++p );
 				}
 				while( c >= '0' && c <= '9' )
 				{
-					token->AppendDirty( c );
-					c = *( ++idLexer::script_p );
+					c = *( ++p );
 				}
 				if( !( idLexer::flags & LEXFL_ALLOWFLOATEXCEPTIONS ) )
 				{
-					token->AppendDirty( 0 );	// zero terminate for c_str
-					idLexer::Error( "parsed %s", token->c_str() );
+					idLexer::Error( "parsed %.*s", ( int )( p - idLexer::script_p ), idLexer::script_p );
 				}
 			}
 		}
@@ -952,42 +1045,44 @@ int idLexer::ReadNumber( idToken* token )
 				idLexer::Error( "ip address should have three dots" );
 				return 0;
 			}
-			token->subtype = TT_IPADDRESS;
+			*subtype = TT_IPADDRESS;
 		}
 		else
 		{
-			token->subtype = TT_DECIMAL | TT_INTEGER;
+			*subtype = TT_DECIMAL | TT_INTEGER;
 		}
 	}
 	
-	if( token->subtype & TT_FLOAT )
+	*textEnd = p;
+	
+	if( *subtype & TT_FLOAT )
 	{
 		if( c > ' ' )
 		{
 			// single-precision: float
 			if( c == 'f' || c == 'F' )
 			{
-				token->subtype |= TT_SINGLE_PRECISION;
-				idLexer::script_p++;
+				*subtype |= TT_SINGLE_PRECISION;
+				p++;
 			}
 			// extended-precision: long double
 			else if( c == 'l' || c == 'L' )
 			{
-				token->subtype |= TT_EXTENDED_PRECISION;
-				idLexer::script_p++;
+				*subtype |= TT_EXTENDED_PRECISION;
+				p++;
 			}
 			// default is double-precision: double
 			else
 			{
-				token->subtype |= TT_DOUBLE_PRECISION;
+				*subtype |= TT_DOUBLE_PRECISION;
 			}
 		}
 		else
 		{
-			token->subtype |= TT_DOUBLE_PRECISION;
+			*subtype |= TT_DOUBLE_PRECISION;
 		}
 	}
-	else if( token->subtype & TT_INTEGER )
+	else if( *subtype & TT_INTEGER )
 	{
 		if( c > ' ' )
 		{
@@ -997,47 +1092,71 @@ int idLexer::ReadNumber( idToken* token )
 				// long integer
 				if( c == 'l' || c == 'L' )
 				{
-					token->subtype |= TT_LONG;
+					*subtype |= TT_LONG;
 				}
 				// unsigned integer
 				else if( c == 'u' || c == 'U' )
 				{
-					token->subtype |= TT_UNSIGNED;
+					*subtype |= TT_UNSIGNED;
 				}
 				else
 				{
 					break;
 				}
-				c = *( ++idLexer::script_p );
+				c = *( ++p );
 			}
 		}
 	}
-	else if( token->subtype & TT_IPADDRESS )
+	else if( *subtype & TT_IPADDRESS )
 	{
 		if( c == ':' )
 		{
-			token->AppendDirty( c );
-			c = *( ++idLexer::script_p );
+			c = *( ++p );
 			while( c >= '0' && c <= '9' )
 			{
-				token->AppendDirty( c );
-				c = *( ++idLexer::script_p );
+				c = *( ++p );
 			}
-			token->subtype |= TT_IPPORT;
+			*subtype |= TT_IPPORT;
+			*textEnd = p;
 		}
 	}
-	token->data[token->len] = '\0';
+	idLexer::script_p = p;
 	return 1;
 }
 
 /*
 ================
-idLexer::ReadPunctuation
+idLexer::ReadNumber
 ================
 */
-int idLexer::ReadPunctuation( idToken* token )
+int idLexer::ReadNumber( idToken* token )
+{
+	const char* start;
+	const char* textEnd;
+	
+	token->type = TT_NUMBER;
+	token->intvalue = 0;
+	token->floatvalue = 0;
+	
+	start = idLexer::script_p;
+	if( !ScanNumber( &token->subtype, &textEnd ) )
+	{
+		return 0;
+	}
+	CopyTokenText( token, start, textEnd );
+	return 1;
+}
+
+/*
+================
+idLexer::FindPunctuation
+
+  returns the longest punctuation at the script pointer and its length
+================
+*/
+ID_INLINE const punctuation_t* idLexer::FindPunctuation( int* length ) const
 {
-	int l, n, i;
+	int l, n;
 	const char* p;
 	const punctuation_t* punc;
 	
@@ -1046,11 +1165,9 @@ int idLexer::ReadPunctuation( idToken* token )
 	{
 		punc = &( idLexer::punctuations[n] );
 #else
-	int i;
-		
-	for( i = 0; idLexer::punctuations[i].p; i++ )
+	for( n = 0; idLexer::punctuations[n].p; n++ )
 	{
-		punc = &idLexer::punctuations[i];
+		punc = &idLexer::punctuations[n];
 #endif
 		p = punc->p;
 		// check for this punctuation in the script
@@ -1063,22 +1180,41 @@ int idLexer::ReadPunctuation( idToken* token )
 		}
 		if( !p[l] )
 		{
-			//
-			token->EnsureAlloced( l + 1, false );
-			for( i = 0; i <= l; i++ )
-			{
-				token->data[i] = p[i];
-			}
-			token->len = l;
-			//
-			idLexer::script_p += l;
-			token->type = TT_PUNCTUATION;
-			// sub type is the punctuation id
-			token->subtype = punc->n;
-			return 1;
+			*length = l;
+			return punc;
 		}
 	}
-	return 0;
+	return NULL;
+}
+
+/*
+================
+idLexer::ReadPunctuation
+================
+*/
+int idLexer::ReadPunctuation( idToken* token )
+{
+	int l, i;
+	const punctuation_t* punc;
+	
+	punc = FindPunctuation( &l );
+	if( punc == NULL )
+	{
+		return 0;
+	}
+	//
+	token->EnsureAlloced( l + 1, false );
+	for( i = 0; i <= l; i++ )
+	{
+		token->data[i] = punc->p[i];
+	}
+	token->len = l;
+	//
+	idLexer::script_p += l;
+	token->type = TT_PUNCTUATION;
+	// sub type is the punctuation id
+	token->subtype = punc->n;
+	return 1;
 }
 
 /*
@@ -1206,6 +1342,279 @@ int idLexer::ReadToken( idToken* token )
 	return 1;
 }
 
+/*
+================
+idLexer::ReadStringView
+
+  returns the text between the quotes when the string can be used as is,
+  strings with escape characters or strings that are concatenated are copied
+================
+*/
+int idLexer::ReadStringView( idTokenView* view, int quote )
+{
+	const char* p;
+	const char* tmpscript_p;
+	int tmpline;
+	bool concat;
+	
+	for( p = idLexer::script_p + 1; *p != quote; p++ )
+	{
+		if( *p == '\0' || *p == '\n' || ( *p == '\\' && !( idLexer::flags & LEXFL_NOSTRINGESCAPECHARS ) ) )
+		{
+			break;
+		}
+	}
+	if( *p == quote )
+	{
+		concat = false;
+		// check for a consecutive string the same way ReadString does
+		if( !( idLexer::flags & LEXFL_NOSTRINGCONCAT ) || ( ( idLexer::flags & LEXFL_ALLOWBACKSLASHSTRINGCONCAT ) && quote == '\"' ) )
+		{
+			tmpscript_p = idLexer::script_p;
+			tmpline = idLexer::line;
+			idLexer::script_p = p + 1;
+			if( idLexer::ReadWhiteSpace() )
+			{
+				concat = ( *idLexer::script_p == quote ) || ( ( idLexer::flags & LEXFL_NOSTRINGCONCAT ) && *idLexer::script_p == '\\' );
+			}
+			idLexer::script_p = tmpscript_p;
+			idLexer::line = tmpline;
+		}
+		if( !concat )
+		{
+			view->type = ( quote == '\"' ) ? TT_STRING : TT_LITERAL;
+			view->ptr = idLexer::script_p + 1;
+			view->len = p - view->ptr;
+			idLexer::script_p = p + 1;
+			if( view->type == TT_LITERAL )
+			{
+				if( !( idLexer::flags & LEXFL_ALLOWMULTICHARLITERALS ) )
+				{
+					if( view->len != 1 )
+					{
+						idLexer::Warning( "literal is not one character long" );
+					}
+				}
+				view->subtype = view->ptr[0];
+			}
+			else
+			{
+				// the sub type is the length of the string
+				view->subtype = view->len;
+			}
+			return 1;
+		}
+	}
+	// escape characters, concatenation and errors are handled by ReadString
+	idLexer::viewtoken.Empty();
+	if( !idLexer::ReadString( &viewtoken, quote ) )
+	{
+		return 0;
+	}
+	SetTokenView( idLexer::viewtoken, view );
+	return 1;
+}
+
+/*
+================
+idLexer::SetTokenView
+================
+*/
+ID_INLINE void idLexer::SetTokenView( const idToken& token, idTokenView* view ) const
+{
+	view->type = token.type;
+	view->subtype = token.subtype & ~TT_VALUESVALID;
+	view->ptr = token.c_str();
+	view->len = token.Length();
+}
+
+/*
+================
+idLexer::ReadTokenView
+
+  reads the next token without copying it, the view points into the script buffer
+  and is valid until the next token is read
+================
+*/
+int idLexer::ReadTokenView( idTokenView* view )
+{
+	int c;
+	const char* start;
+	const char* textEnd;
+	int length;
+	const punctuation_t* punc;
+	
+	if( !loaded )
+	{
+		idLib::common->Error( "idLexer::ReadTokenView: no file loaded" );
+		return 0;
+	}
+	
+	if( script_p == NULL )
+	{
+		return 0;
+	}
+	
+	// if there is a token available (from unreadToken)
+	if( tokenavailable )
+	{
+		tokenavailable = 0;
+		lastviewunread = true;
+		SetTokenView( idLexer::token, view );
+		view->line = idLexer::token.line;
+		view->linesCrossed = idLexer::token.linesCrossed;
+		return 1;
+	}
+	lastviewunread = false;
+	// save script pointer
+	lastScript_p = script_p;
+	// save line counter
+	lastline = line;
+	// start of the white space
+	whiteSpaceStart_p = script_p;
+	// read white space before token
+	if( !ReadWhiteSpace() )
+	{
+		return 0;
+	}
+	// end of the white space
+	idLexer::whiteSpaceEnd_p = script_p;
+	// line the token is on
+	view->line = line;
+	// number of lines crossed before token
+	view->linesCrossed = line - lastline;
+	
+	start = idLexer::script_p;
+	c = *start;
+	
+	// if we're keeping everything as whitespace deliminated strings
+	if( idLexer::flags & LEXFL_ONLYSTRINGS )
+	{
+		// if there is a leading quote
+		if( c == '\"' || c == '\'' )
+		{
+			return ReadStringView( view, c );
+		}
+		view->type = TT_NAME;
+		idLexer::script_p = ScanName( start );
+	}
+	// if there is a number
+	else if( ( c >= '0' && c <= '9' ) ||
+			 ( c == '.' && ( *( start + 1 ) >= '0' && *( start + 1 ) <= '9' ) ) )
+	{
+		view->type = TT_NUMBER;
+		if( !ScanNumber( &view->subtype, &textEnd ) )
+		{
+			return 0;
+		}
+		view->ptr = start;
+		view->len = textEnd - start;
+		// if names are allowed to start with a number
+		if( idLexer::flags & LEXFL_ALLOWNUMBERNAMES )
+		{
+			c = *idLexer::script_p;
+			if( ( c >= 'a' && c <= 'z' ) ||	( c >= 'A' && c <= 'Z' ) || c == '_' )
+			{
+				// the suffix of the number is not part of the token text so build a copy
+				idLexer::script_p = start;
+				idLexer::viewtoken.Empty();
+				if( !idLexer::ReadNumber( &viewtoken ) || !idLexer::ReadName( &viewtoken ) )
+				{
+					return 0;
+				}
+				SetTokenView( idLexer::viewtoken, view );
+			}
+		}
+		return 1;
+	}
+	// if there is a leading quote
+	else if( c == '\"' || c == '\'' )
+	{
+		return ReadStringView( view, c );
+	}
+	// if there is a name
+	else if( ( c >= 'a' && c <= 'z' ) ||	( c >= 'A' && c <= 'Z' ) || c == '_' )
+	{
+		view->type = TT_NAME;
+		idLexer::script_p = ScanName( start );
+	}
+	// names may also start with a slash when pathnames are allowed
+	else if( ( idLexer::flags & LEXFL_ALLOWPATHNAMES ) && ( ( c == '/' || c == '\\' ) || c == '.' ) )
+	{
+		view->type = TT_NAME;
+		idLexer::script_p = ScanName( start );
+	}
+	// check for punctuations
+	else
+	{
+		punc = FindPunctuation( &length );
+		if( punc == NULL )
+		{
+			idLexer::Error( "unknown punctuation %c", c );
+			return 0;
+		}
+		idLexer::script_p += length;
+		view->type = TT_PUNCTUATION;
+		view->subtype = punc->n;
+		view->ptr = start;
+		view->len = length;
+		return 1;
+	}
+	// the sub type of a name is the length of the name
+	view->ptr = start;
+	view->len = idLexer::script_p - start;
+	view->subtype = view->len;
+	return 1;
+}
+
+/*
+================
+idLexer::ReadTokenViewOnLine
+================
+*/
+int idLexer::ReadTokenViewOnLine( idTokenView* view )
+{
+	if( !idLexer::ReadTokenView( view ) )
+	{
+		idLexer::script_p = lastScript_p;
+		idLexer::line = lastline;
+		return false;
+	}
+	// if no lines were crossed before this token
+	if( !view->linesCrossed )
+	{
+		return true;
+	}
+	// restore our position
+	idLexer::UnreadTokenView();
+	*view = idTokenView();
+	return false;
+}
+
+/*
+================
+idLexer::UnreadTokenView
+
+  puts back the token view that was just read
+================
+*/
+void idLexer::UnreadTokenView()
+{
+	if( idLexer::tokenavailable )
+	{
+		idLib::common->FatalError( "idLexer::UnreadTokenView, unread token twice\n" );
+	}
+	if( idLexer::lastviewunread )
+	{
+		idLexer::tokenavailable = 1;
+	}
+	else
+	{
+		idLexer::script_p = lastScript_p;
+		idLexer::line = lastline;
+	}
+}
+
 /*
 ================
 idLexer::ExpectTokenString
@@ -1213,16 +1622,16 @@ idLexer::ExpectTokenString
 */
 int idLexer::ExpectTokenString( const char* string )
 {
-	idToken token;
+	idTokenView token;
 	
-	if( !idLexer::ReadToken( &token ) )
+	if( !idLexer::ReadTokenView( &token ) )
 	{
 		idLexer::Error( "couldn't find expected '%s'", string );
 		return 0;
 	}
 	if( token != string )
 	{
-		idLexer::Error( "expected '%s' but found '%s'", string, token.c_str() );
+		idLexer::Error( "expected '%s' but found '%.*s'", string, token.Length(), token.Ptr() );
 		return 0;
 	}
 	return 1;
@@ -1235,15 +1644,44 @@ idLexer::ExpectTokenType
 */
 int idLexer::ExpectTokenType( int type, int subtype, idToken* token )
 {
-	idStr str;
+	idTokenView view;
 	
 	if( !idLexer::ReadToken( token ) )
 	{
 		idLexer::Error( "couldn't read expected token" );
 		return 0;
 	}
+	SetTokenView( *token, &view );
+	return CheckTokenViewType( type, subtype, view );
+}
+
+/*
+================
+idLexer::ExpectTokenViewType
+================
+*/
+int idLexer::ExpectTokenViewType( int type, int subtype, idTokenView* view )
+{
+	if( !idLexer::ReadTokenView( view ) )
+	{
+		idLexer::Error( "couldn't read expected token" );
+		return 0;
+	}
+	return CheckTokenViewType( type, subtype, *view );
+}
+
+/*
+================
+idLexer::CheckTokenViewType
+
+  prints an error when the token is not of the expected type
+================
+*/
+int idLexer::CheckTokenViewType( int type, int subtype, const idTokenView& token )
+{
+	idStr str;
 	
-	if( token->type != type )
+	if( token.type != type )
 	{
 		switch( type )
 		{
@@ -1266,12 +1704,12 @@ int idLexer::ExpectTokenType( int type, int subtype, idToken* token )
 				str = "unknown type";
 				break;
 		}
-		idLexer::Error( "expected a %s but found '%s'", str.c_str(), token->c_str() );
+		idLexer::Error( "expected a %s but found '%.*s'", str.c_str(), token.Length(), token.Ptr() );
 		return 0;
 	}
-	if( token->type == TT_NUMBER )
+	if( token.type == TT_NUMBER )
 	{
-		if( ( token->subtype & subtype ) != subtype )
+		if( ( token.subtype & subtype ) != subtype )
 		{
 			str.Clear();
 			if( subtype & TT_DECIMAL ) str = "decimal ";
@@ -1283,20 +1721,20 @@ int idLexer::ExpectTokenType( int type, int subtype, idToken* token )
 			if( subtype & TT_FLOAT ) str += "float ";
 			if( subtype & TT_INTEGER ) str += "integer ";
 			str.StripTrailing( ' ' );
-			idLexer::Error( "expected %s but found '%s'", str.c_str(), token->c_str() );
+			idLexer::Error( "expected %s but found '%.*s'", str.c_str(), token.Length(), token.Ptr() );
 			return 0;
 		}
 	}
-	else if( token->type == TT_PUNCTUATION )
+	else if( token.type == TT_PUNCTUATION )
 	{
 		if( subtype < 0 )
 		{
 			idLexer::Error( "BUG: wrong punctuation subtype" );
 			return 0;
 		}
-		if( token->subtype != subtype )
+		if( token.subtype != subtype )
 		{
-			idLexer::Error( "expected '%s' but found '%s'", GetPunctuationFromId( subtype ), token->c_str() );
+			idLexer::Error( "expected '%s' but found '%.*s'", GetPunctuationFromId( subtype ), token.Length(), token.Ptr() );
 			return 0;
 		}
 	}
@@ -1328,9 +1766,9 @@ idLexer::CheckTokenString
 */
 int idLexer::CheckTokenString( const char* string )
 {
-	idToken tok;
+	idTokenView tok;
 	
-	if( !ReadToken( &tok ) )
+	if( !ReadTokenView( &tok ) )
 	{
 		return 0;
 	}
@@ -1340,8 +1778,7 @@ int idLexer::CheckTokenString( const char* string )
 		return 1;
 	}
 	// unread token
-	script_p = lastScript_p;
-	line = lastline;
+	UnreadTokenView();
 	return 0;
 }
 
@@ -1377,16 +1814,15 @@ idLexer::PeekTokenString
 */
 int idLexer::PeekTokenString( const char* string )
 {
-	idToken tok;
+	idTokenView tok;
 	
-	if( !ReadToken( &tok ) )
+	if( !ReadTokenView( &tok ) )
 	{
 		return 0;
 	}
 	
 	// unread token
-	script_p = lastScript_p;
-	line = lastline;
+	UnreadTokenView();
 	
 	// if the given string is available
 	if( tok == string )
@@ -1430,9 +1866,9 @@ idLexer::SkipUntilString
 */
 int idLexer::SkipUntilString( const char* string )
 {
-	idToken token;
+	idTokenView token;
 	
-	while( idLexer::ReadToken( &token ) )
+	while( idLexer::ReadTokenView( &token ) )
 	{
 		if( token == string )
 		{
@@ -1449,14 +1885,13 @@ idLexer::SkipRestOfLine
 */
 int idLexer::SkipRestOfLine()
 {
-	idToken token;
+	idTokenView token;
 	
-	while( idLexer::ReadToken( &token ) )
+	while( idLexer::ReadTokenView( &token ) )
 	{
 		if( token.linesCrossed )
 		{
-			idLexer::script_p = lastScript_p;
-			idLexer::line = lastline;
+			idLexer::UnreadTokenView();
 			return 1;
 		}
 	}
@@ -1473,13 +1908,13 @@ Internal brace depths are properly skipped.
 */
 int idLexer::SkipBracedSection( bool parseFirstBrace )
 {
-	idToken token;
+	idTokenView token;
 	int depth;
 	
 	depth = parseFirstBrace ? 0 : 1;
 	do
 	{
-		if( !ReadToken( &token ) )
+		if( !ReadTokenView( &token ) )
 		{
 			return false;
 		}
@@ -1586,21 +2021,21 @@ idLexer::ParseInt
 */
 int idLexer::ParseInt()
 {
-	idToken token;
+	idTokenView token;
 	
-	if( !idLexer::ReadToken( &token ) )
+	if( !idLexer::ReadTokenView( &token ) )
 	{
 		idLexer::Error( "couldn't read expected integer" );
 		return 0;
 	}
 	if( token.type == TT_PUNCTUATION && token == "-" )
 	{
-		idLexer::ExpectTokenType( TT_NUMBER, TT_INTEGER, &token );
+		idLexer::ExpectTokenViewType( TT_NUMBER, TT_INTEGER, &token );
 		return -( ( signed int ) token.GetIntValue() );
 	}
 	else if( token.type != TT_NUMBER || token.subtype == TT_FLOAT )
 	{
-		idLexer::Error( "expected integer value, found '%s'", token.c_str() );
+		idLexer::Error( "expected integer value, found '%.*s'", token.Length(), token.Ptr() );
 	}
 	return token.GetIntValue();
 }
@@ -1612,9 +2047,9 @@ idLexer::ParseBool
 */
 bool idLexer::ParseBool()
 {
-	idToken token;
+	idTokenView token;
 	
-	if( !idLexer::ExpectTokenType( TT_NUMBER, 0, &token ) )
+	if( !idLexer::ExpectTokenViewType( TT_NUMBER, 0, &token ) )
 	{
 		idLexer::Error( "couldn't read expected boolean" );
 		return false;
@@ -1629,14 +2064,14 @@ idLexer::ParseFloat
 */
 float idLexer::ParseFloat( bool* errorFlag )
 {
-	idToken token;
+	idTokenView token;
 	
 	if( errorFlag )
 	{
 		*errorFlag = false;
 	}
 	
-	if( !idLexer::ReadToken( &token ) )
+	if( !idLexer::ReadTokenView( &token ) )
 	{
 		if( errorFlag )
 		{
@@ -1651,19 +2086,19 @@ float idLexer::ParseFloat( bool* errorFlag )
 	}
 	if( token.type == TT_PUNCTUATION && token == "-" )
 	{
-		idLexer::ExpectTokenType( TT_NUMBER, 0, &token );
+		idLexer::ExpectTokenViewType( TT_NUMBER, 0, &token );
 		return -token.GetFloatValue();
 	}
 	else if( token.type != TT_NUMBER )
 	{
 		if( errorFlag )
 		{
-			idLexer::Warning( "expected float value, found '%s'", token.c_str() );
+			idLexer::Warning( "expected float value, found '%.*s'", token.Length(), token.Ptr() );
 			*errorFlag = true;
 		}
 		else
 		{
-			idLexer::Error( "expected float value, found '%s'", token.c_str() );
+			idLexer::Error( "expected float value, found '%.*s'", token.Length(), token.Ptr() );
 		}
 	}
 	return token.GetFloatValue();
@@ -2018,6 +2453,7 @@ void idLexer::Reset()
 	idLexer::whiteSpaceEnd_p = NULL;
 	// set if there's a token available in idLexer::token
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	
 	idLexer::line = 1;
 	idLexer::lastline = 1;
@@ -2101,6 +2537,7 @@ int idLexer::LoadFile( const char* filename, bool OSPath )
 	idLexer::end_p = &( idLexer::buffer[length] );
 	
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	idLexer::line = 1;
 	idLexer::lastline = 1;
 	idLexer::allocated = true;
@@ -2133,6 +2570,7 @@ int idLexer::LoadMemory( const char* ptr, int length, const char* name, int star
 	idLexer::end_p = &( idLexer::buffer[length] );
 	
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	idLexer::line = startLine;
 	idLexer::lastline = startLine;
 	idLexer::allocated = false;
@@ -2167,6 +2605,7 @@ void idLexer::FreeSource()
 		idLexer::allocated = false;
 	}
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	idLexer::token = "";
 	idLexer::loaded = false;
 }
@@ -2188,6 +2627,7 @@ idLexer::idLexer()
 	idLexer::line = 0;
 	idLexer::lastline = 0;
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
@@ -2210,6 +2650,7 @@ idLexer::idLexer( int flags )
 	idLexer::line = 0;
 	idLexer::lastline = 0;
 	idLexer::tokenavailable = 0;
+	idLexer::lastviewunread = false;
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
@@ -2279,3 +2720,128 @@ bool idLexer::HadError() const
 	return hadError;
 }
 
+
+/*
+================
+Lexer_TimeTokens
+
+  reads all tokens from the text and returns the time taken in microseconds
+================
+*/
+static uint64 Lexer_TimeTokens( const char* text, int length, const char* name, bool views, int& numTokens, double& valueSum )
+{
+	idLexer src( LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES | LEXFL_NOFATALERRORS );
+	idToken token;
+	idTokenView view;
+	
+	src.LoadMemory( text, length, name );
+	
+	const uint64 startTime = Sys_Microseconds();
+	if( views )
+	{
+		while( src.ReadTokenView( &view ) )
+		{
+			if( view.type == TT_NUMBER )
+			{
+				valueSum += view.GetDoubleValue();
+			}
+			numTokens++;
+		}
+	}
+	else
+	{
+		while( src.ReadToken( &token ) )
+		{
+			if( token.type == TT_NUMBER )
+			{
+				valueSum += token.GetDoubleValue();
+			}
+			numTokens++;
+		}
+	}
+	return Sys_Microseconds() - startTime;
+}
+
+/*
+================
+Lexer_CompareTokens
+
+  reads the text with ReadToken and ReadTokenView in lockstep and prints the first
+  token that differs in type, sub type, line or text
+================
+*/
+static bool Lexer_CompareTokens( const char* text, int length, const char* name )
+{
+	const int flags = LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES | LEXFL_NOFATALERRORS;
+	idLexer tokenSrc( text, length, name, flags );
+	idLexer viewSrc( text, length, name, flags );
+	idToken token;
+	idTokenView view;
+	idStr viewText;
+	
+	for( int i = 0; ; i++ )
+	{
+		const int readToken = tokenSrc.ReadToken( &token );
+		const int readView = viewSrc.ReadTokenView( &view );
+		if( !readToken && !readView )
+		{
+			return true;
+		}
+		if( !readToken || !readView )
+		{
+			idLib::Printf( "token %d: %s ended first\n", i, readToken ? "ReadTokenView" : "ReadToken" );
+			return false;
+		}
+		view.ToStr( viewText );
+		if( view.type != token.type || view.subtype != ( token.subtype & ~TT_VALUESVALID ) || view.line != token.line || viewText.Cmp( token.c_str() ) != 0 )
+		{
+			idLib::Printf( "token %d on line %d: ReadToken '%s' type %d subtype %d, ReadTokenView '%s' type %d subtype %d line %d\n",
+						   i, token.line, token.c_str(), token.type, token.subtype, viewText.c_str(), view.type, view.subtype, view.line );
+			return false;
+		}
+	}
+}
+
+CONSOLE_COMMAND( testLexer, "compares tokens per second of idLexer::ReadToken and ReadTokenView, usage: testLexer <file> [iterations]", 0 )
+{
+	if( args.Argc() < 2 )
+	{
+		idLib::Printf( "usage: testLexer <file> [iterations]\n" );
+		return;
+	}
+	const int iterations = idMath::ClampInt( 1, 1000, ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 10 );
+	
+	char* text = NULL;
+	const int length = idLib::fileSystem->ReadFile( args.Argv( 1 ), ( void** ) &text );
+	if( text == NULL )
+	{
+		idLib::Printf( "couldn't load %s\n", args.Argv( 1 ) );
+		return;
+	}
+	
+	int numTokens[2] = { 0, 0 };
+	double valueSum[2] = { 0.0, 0.0 };
+	uint64 time[2] = { 0, 0 };
+	for( int i = 0; i < iterations; i++ )
+	{
+		time[0] += Lexer_TimeTokens( text, length, args.Argv( 1 ), false, numTokens[0], valueSum[0] );
+		time[1] += Lexer_TimeTokens( text, length, args.Argv( 1 ), true, numTokens[1], valueSum[1] );
+	}
+	const bool match = Lexer_CompareTokens( text, length, args.Argv( 1 ) );
+	idLib::fileSystem->FreeFile( text );
+	
+	const double tokenRate = ( double )numTokens[0] / ( Max( time[0], ( uint64 )1 ) * 0.000001 );
+	const double viewRate = ( double )numTokens[1] / ( Max( time[1], ( uint64 )1 ) * 0.000001 );
+	idLib::Printf( "%d tokens in %d KB\n", numTokens[0] / iterations, length >> 10 );
+	idLib::Printf( "ReadToken:     %10.0f tokens/s\n", tokenRate );
+	idLib::Printf( "ReadTokenView: %10.0f tokens/s (%.2fx)\n", viewRate, viewRate / tokenRate );
+	
+	if( !match || numTokens[0] != numTokens[1] || valueSum[0] != valueSum[1] )
+	{
+		idLib::Printf( "[^1FAILED^0] token views differ from tokens.\n" );
+	}
+	else
+	{
+		idLib::Printf( "[^2PASSED^0] token views match tokens.\n" );
+	}
+}
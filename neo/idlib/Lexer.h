@@ -38,6 +38,10 @@ If you have questions concerning this license or the applicable additional terms
 	memory allocation if a source is loaded with LoadMemory().
 	However, idToken may still allocate memory for large strings.
 
+	ReadTokenView() returns an idTokenView that points into the script
+	buffer instead of copying the token text. Only strings with escape
+	characters or concatenated strings are copied into the lexer.
+
 	A number directly following the escape character '\' in a string is
 	assumed to be in decimal format instead of octal. Binary numbers of
 	the form 0b.. or 0B.. can also be used.
@@ -189,6 +193,14 @@ public:
 	void			UnreadToken( const idToken* token );
 	// read a token only if on the same line
 	int				ReadTokenOnLine( idToken* token );
+	// read a token without copying it, the view is valid until the next token is read
+	int				ReadTokenView( idTokenView* view );
+	// read a token view only if on the same line
+	int				ReadTokenViewOnLine( idTokenView* view );
+	// expect a token view of a certain type
+	int				ExpectTokenViewType( int type, int subtype, idTokenView* view );
+	// unread the token view that was just read
+	void			UnreadTokenView();
 	
 	//Returns the rest of the current line
 	const char*		ReadRestOfLine( idStr& out );
@@ -265,11 +277,13 @@ private:
 	int				line;					// current line in script
 	int				lastline;				// line before reading token
 	int				tokenavailable;			// set by unreadToken
+	bool			lastviewunread;			// set when the last token view was the unread token
 	int				flags;					// several script flags
 	const punctuation_t* punctuations;		// the punctuations used in the script
 	int* 			punctuationtable;		// ASCII table with punctuations
 	int* 			nextpunctuation;		// next punctuation in chain
 	idToken			token;					// available token
+	idToken			viewtoken;				// copy of the last token view that could not point into the buffer
 	idLexer* 		next;					// next script in a chain
 	bool			hadError;				// set by idLexer::Error, even if the error is supressed
 	
@@ -284,7 +298,14 @@ private:
 	int				ReadNumber( idToken* token );
 	int				ReadPunctuation( idToken* token );
 	int				ReadPrimitive( idToken* token );
-	int				CheckString( const char* str ) const;
+	int				ReadStringView( idTokenView* view, int quote );
+	const char* 	ScanName( const char* p ) const;
+	void			CopyTokenText( idToken* token, const char* start, const char* end ) const;
+	int				ScanNumber( int* subtype, const char** textEnd );
+	const punctuation_t* FindPunctuation( int* length ) const;
+	void			SetTokenView( const idToken& token, idTokenView* view ) const;
+	int				CheckTokenViewType( int type, int subtype, const idTokenView& token );
+	int				CheckString( const char* p, const char* str ) const;
 	int				NumLinesCrossed();
 };
 
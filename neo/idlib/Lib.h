@@ -332,6 +332,7 @@ public:
 #include "Swap.h"
 #include "Callback.h"
 #include "ParallelJobList.h"
+#include "Profiler.h"
 
 #include "SoftwareCache.h"
 
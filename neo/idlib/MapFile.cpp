@@ -88,7 +88,8 @@ idMapPatch* idMapPatch::Parse( idLexer& src, const idVec3& origin, bool patchDef
 {
 	float		info[7];
 	idDrawVert* vert;
-	idToken		token;
+	idTokenView	token;
+	idStr		material;
 	int			i, j;
 	
 	if( !src.ExpectTokenString( "{" ) )
@@ -97,11 +98,12 @@ idMapPatch* idMapPatch::Parse( idLexer& src, const idVec3& origin, bool patchDef
 	}
 	
 	// read the material (we had an implicit 'textures/' in the old format...)
-	if( !src.ReadToken( &token ) )
+	if( !src.ReadTokenView( &token ) )
 	{
 		src.Error( "idMapPatch::Parse: unexpected EOF" );
 		return NULL;
 	}
+	token.ToStr( material );
 	
 	// Parse it
 	if( patchDef3 )
@@ -126,11 +128,11 @@ idMapPatch* idMapPatch::Parse( idLexer& src, const idVec3& origin, bool patchDef
 	patch->SetSize( info[0], info[1] );
 	if( version < 2.0f )
 	{
-		patch->SetMaterial( "textures/" + token );
+		patch->SetMaterial( "textures/" + material );
 	}
 	else
 	{
-		patch->SetMaterial( token );
+		patch->SetMaterial( material );
 	}
 	
 	if( patchDef3 )
@@ -197,7 +199,7 @@ idMapPatch* idMapPatch::Parse( idLexer& src, const idVec3& origin, bool patchDef
 	}
 	
 	// read any key/value pairs
-	while( src.ReadToken( &token ) )
+	while( src.ReadTokenView( &token ) )
 	{
 		if( token == "}" )
 		{
@@ -206,9 +208,11 @@ idMapPatch* idMapPatch::Parse( idLexer& src, const idVec3& origin, bool patchDef
 		}
 		if( token.type == TT_STRING )
 		{
-			idStr key = token;
-			src.ExpectTokenType( TT_STRING, 0, &token );
-			patch->epairs.Set( key, token );
+			idStr key, value;
+			token.ToStr( key );
+			src.ExpectTokenViewType( TT_STRING, 0, &token );
+			token.ToStr( value );
+			patch->epairs.Set( key, value );
 		}
 	}
 	
@@ -284,7 +288,8 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 {
 	int i;
 	idVec3 planepts[3];
-	idToken token;
+	idTokenView token;
+	idStr key, value;
 	idList<idMapBrushSide*> sides;
 	idMapBrushSide*	side;
 	idDict epairs;
@@ -296,7 +301,7 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 	
 	do
 	{
-		if( !src.ReadToken( &token ) )
+		if( !src.ReadTokenView( &token ) )
 		{
 			src.Error( "idMapBrush::Parse: unexpected EOF" );
 			sides.DeleteContents( true );
@@ -318,24 +323,25 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 			// the token should be a key string for a key/value pair
 			if( token.type != TT_STRING )
 			{
-				src.Error( "idMapBrush::Parse: unexpected %s, expected ( or epair key string", token.c_str() );
+				src.Error( "idMapBrush::Parse: unexpected %.*s, expected ( or epair key string", token.Length(), token.Ptr() );
 				sides.DeleteContents( true );
 				return NULL;
 			}
 			
-			idStr key = token;
+			token.ToStr( key );
 			
-			if( !src.ReadTokenOnLine( &token ) || token.type != TT_STRING )
+			if( !src.ReadTokenViewOnLine( &token ) || token.type != TT_STRING )
 			{
 				src.Error( "idMapBrush::Parse: expected epair value string not found" );
 				sides.DeleteContents( true );
 				return NULL;
 			}
 			
-			epairs.Set( key, token );
+			token.ToStr( value );
+			epairs.Set( key, value );
 			
 			// try to read the next key
-			if( !src.ReadToken( &token ) )
+			if( !src.ReadTokenView( &token ) )
 			{
 				src.Error( "idMapBrush::Parse: unexpected EOF" );
 				sides.DeleteContents( true );
@@ -344,7 +350,7 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 		}
 		while( 1 );
 		
-		src.UnreadToken( &token );
+		src.UnreadTokenView();
 		
 		side = new( TAG_IDLIB ) idMapBrushSide();
 		sides.Append( side );
@@ -388,7 +394,7 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 		side->origin = origin;
 		
 		// read the material
-		if( !src.ReadTokenOnLine( &token ) )
+		if( !src.ReadTokenViewOnLine( &token ) )
 		{
 			src.Error( "idMapBrush::Parse: unable to read brush side material" );
 			sides.DeleteContents( true );
@@ -398,19 +404,20 @@ idMapBrush* idMapBrush::Parse( idLexer& src, const idVec3& origin, bool newForma
 		// we had an implicit 'textures/' in the old format...
 		if( version < 2.0f )
 		{
-			side->material = "textures/" + token;
+			side->material = "textures/";
+			side->material.Append( token.Ptr(), token.Length() );
 		}
 		else
 		{
-			side->material = token;
+			token.ToStr( side->material );
 		}
 		
 		// Q2 allowed override of default flags and values, but we don't any more
-		if( src.ReadTokenOnLine( &token ) )
+		if( src.ReadTokenViewOnLine( &token ) )
 		{
-			if( src.ReadTokenOnLine( &token ) )
+			if( src.ReadTokenViewOnLine( &token ) )
 			{
-				if( src.ReadTokenOnLine( &token ) )
+				if( src.ReadTokenViewOnLine( &token ) )
 				{
 				}
 			}
@@ -445,7 +452,7 @@ idMapBrush* idMapBrush::ParseQ3( idLexer& src, const idVec3& origin )
 	int i, shift[2], rotate;
 	float scale[2];
 	idVec3 planepts[3];
-	idToken token;
+	idTokenView token;
 	idList<idMapBrushSide*> sides;
 	idMapBrushSide*	side;
 	idDict epairs;
@@ -477,7 +484,7 @@ idMapBrush* idMapBrush::ParseQ3( idLexer& src, const idVec3& origin )
 		side->plane.FromPoints( planepts[0], planepts[1], planepts[2] );
 		
 		// read the material
-		if( !src.ReadTokenOnLine( &token ) )
+		if( !src.ReadTokenViewOnLine( &token ) )
 		{
 			src.Error( "idMapBrush::ParseQ3: unable to read brush side material" );
 			sides.DeleteContents( true );
@@ -485,7 +492,8 @@ idMapBrush* idMapBrush::ParseQ3( idLexer& src, const idVec3& origin )
 		}
 		
 		// we have an implicit 'textures/' in the old format
-		side->material = "textures/" + token;
+		side->material = "textures/";
+		side->material.Append( token.Ptr(), token.Length() );
 		
 		// read the texture shift, rotate and scale
 		shift[0] = src.ParseInt();
@@ -498,11 +506,11 @@ idMapBrush* idMapBrush::ParseQ3( idLexer& src, const idVec3& origin )
 		side->origin = origin;
 		
 		// Q2 allowed override of default flags and values, but we don't any more
-		if( src.ReadTokenOnLine( &token ) )
+		if( src.ReadTokenViewOnLine( &token ) )
 		{
-			if( src.ReadTokenOnLine( &token ) )
+			if( src.ReadTokenViewOnLine( &token ) )
 			{
-				if( src.ReadTokenOnLine( &token ) )
+				if( src.ReadTokenViewOnLine( &token ) )
 				{
 				}
 			}
@@ -577,7 +585,8 @@ idMapEntity::Parse
 */
 idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 {
-	idToken	token;
+	idTokenView token;
+	idStr key, value;
 	idMapEntity* mapEnt;
 	idMapPatch* mapPatch;
 	idMapBrush* mapBrush;
@@ -585,14 +594,14 @@ idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 	idVec3 origin;
 	double v1, v2, v3;
 	
-	if( !src.ReadToken( &token ) )
+	if( !src.ReadTokenView( &token ) )
 	{
 		return NULL;
 	}
 	
 	if( token != "{" )
 	{
-		src.Error( "idMapEntity::Parse: { not found, found %s", token.c_str() );
+		src.Error( "idMapEntity::Parse: { not found, found %.*s", token.Length(), token.Ptr() );
 		return NULL;
 	}
 	
@@ -607,7 +616,7 @@ idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 	worldent = false;
 	do
 	{
-		if( !src.ReadToken( &token ) )
+		if( !src.ReadTokenView( &token ) )
 		{
 			src.Error( "idMapEntity::Parse: EOF without closing brace" );
 			return NULL;
@@ -620,7 +629,7 @@ idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 		if( token == "{" )
 		{
 			// parse a brush or patch
-			if( !src.ReadToken( &token ) )
+			if( !src.ReadTokenView( &token ) )
 			{
 				src.Error( "idMapEntity::Parse: unexpected EOF" );
 				return NULL;
@@ -654,7 +663,7 @@ idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 			// assume it's a brush in Q3 or older style
 			else
 			{
-				src.UnreadToken( &token );
+				src.UnreadTokenView();
 				mapBrush = idMapBrush::ParseQ3( src, origin );
 				if( !mapBrush )
 				{
@@ -665,12 +674,13 @@ idMapEntity* idMapEntity::Parse( idLexer& src, bool worldSpawn, float version )
 		}
 		else
 		{
-			idStr key, value;
-			
 			// parse a key / value pair
-			key = token;
-			src.ReadTokenOnLine( &token );
-			value = token;
+			token.ToStr( key );
+			value.Empty();
+			if( src.ReadTokenViewOnLine( &token ) )
+			{
+				token.ToStr( value );
+			}
 			
 			// strip trailing spaces that sometimes get accidentally
 			// added in the editor
@@ -783,7 +793,7 @@ bool idMapFile::Parse( const char* filename, bool ignoreRegion, bool osPath )
 {
 	// no string concatenation for epairs and allow path names for materials
 	idLexer src( LEXFL_NOSTRINGCONCAT | LEXFL_NOSTRINGESCAPECHARS | LEXFL_ALLOWPATHNAMES );
-	idToken token;
+	idTokenView token;
 	idStr fullName;
 	idMapEntity* mapEnt;
 	int i, j, k;
@@ -818,7 +828,7 @@ bool idMapFile::Parse( const char* filename, bool ignoreRegion, bool osPath )
 	
 	if( src.CheckTokenString( "Version" ) )
 	{
-		src.ReadTokenOnLine( &token );
+		src.ReadTokenViewOnLine( &token );
 		version = token.GetFloatValue();
 	}
 	
@@ -1071,3 +1081,275 @@ bool idMapFile::NeedsReload()
 	}
 	return true;
 }
+
+/*
+===============================================================================
+
+	Map entity cache
+
+	The game only keeps the entity key/value pairs of a map, the primitives are only
+	needed to build the collision models when there is no up to date collision file.
+	The entity cache stores the key/value pairs as indices into a table with every
+	unique string stored once, so it can be loaded without going through the lexer.
+
+===============================================================================
+*/
+
+#define MAP_ENTITYCACHE_EXT			"bmap"
+
+static const unsigned int MAP_ENTITYCACHE_MAGIC		= ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'A' << 8 ) | 'P';
+static const int MAP_ENTITYCACHE_VERSION			= 1;
+
+/*
+===============
+MapEntityCacheNames
+
+  the source is the .reg file when there is one, like idMapFile::Parse
+===============
+*/
+static void MapEntityCacheNames( const char* filename, idStr& sourceName, idStr& cacheName )
+{
+	idStr baseName = filename;
+	baseName.StripFileExtension();
+	
+	sourceName = baseName;
+	sourceName.SetFileExtension( "reg" );
+	if( idLib::fileSystem->GetTimestamp( sourceName ) == FILE_NOT_FOUND_TIMESTAMP )
+	{
+		sourceName.SetFileExtension( "map" );
+	}
+	
+	cacheName = baseName;
+	cacheName.Insert( "generated/", 0 );
+	cacheName.SetFileExtension( MAP_ENTITYCACHE_EXT );
+}
+
+/*
+===============
+idMapFile::LoadEntityCache
+===============
+*/
+bool idMapFile::LoadEntityCache( const char* filename )
+{
+	idStr sourceName, cacheName;
+	idList<int> stringOffsets;
+	idList<char> strings;
+	idList<int> pairs;
+	
+	MapEntityCacheNames( filename, sourceName, cacheName );
+	
+	ID_TIME_T sourceTime = idLib::fileSystem->GetTimestamp( sourceName );
+	if( sourceTime == FILE_NOT_FOUND_TIMESTAMP )
+	{
+		return false;
+	}
+	
+	idFile* file = idLib::fileSystem->OpenFileReadMemory( cacheName );
+	if( file == NULL )
+	{
+		return false;
+	}
+	
+	unsigned int magic = 0;
+	int cacheVersion = 0;
+	int64 storedSourceTime = 0;
+	int64 storedFileTime = 0;
+	unsigned int storedCRC = 0;
+	float storedVersion = 0.0f;
+	int numStrings = 0;
+	int numChars = 0;
+	
+	file->ReadBig( magic );
+	file->ReadBig( cacheVersion );
+	file->ReadBig( storedSourceTime );
+	if( magic != MAP_ENTITYCACHE_MAGIC || cacheVersion != MAP_ENTITYCACHE_VERSION || storedSourceTime != ( int64 ) sourceTime )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+	file->ReadBig( storedFileTime );
+	file->ReadBig( storedCRC );
+	file->ReadBig( storedVersion );
+	
+	// string table
+	file->ReadBig( numStrings );
+	file->ReadBig( numChars );
+	if( numStrings < 0 || numChars <= 0 || numStrings > numChars )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+	stringOffsets.SetNum( numStrings );
+	file->ReadBigArray( stringOffsets.Ptr(), numStrings );
+	strings.SetNum( numChars );
+	if( file->Read( strings.Ptr(), numChars ) != numChars || strings[numChars - 1] != '\0' )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+	for( int i = 0; i < numStrings; i++ )
+	{
+		if( stringOffsets[i] < 0 || stringOffsets[i] >= numChars )
+		{
+			idLib::fileSystem->CloseFile( file );
+			return false;
+		}
+	}
+	
+	// entities
+	int numEntities = 0;
+	file->ReadBig( numEntities );
+	if( numEntities < 0 )
+	{
+		idLib::fileSystem->CloseFile( file );
+		return false;
+	}
+	
+	entities.DeleteContents( true );
+	entities.Resize( Max( numEntities, 1 ) );
+	
+	bool valid = true;
+	for( int i = 0; valid && i < numEntities; i++ )
+	{
+		int numPairs = -1;
+		file->ReadBig( numPairs );
+		if( numPairs < 0 || numPairs > ( file->Length() - file->Tell() ) / ( int )( 2 * sizeof( pairs[0] ) ) )
+		{
+			valid = false;
+			break;
+		}
+		pairs.SetNum( numPairs * 2 );
+		file->ReadBigArray( pairs.Ptr(), pairs.Num() );
+		
+		idMapEntity* mapEnt = new( TAG_IDLIB ) idMapEntity();
+		entities.Append( mapEnt );
+		
+		for( int j = 0; j < pairs.Num(); j += 2 )
+		{
+			int key = pairs[j + 0];
+			int value = pairs[j + 1];
+			if( key < 0 || key >= numStrings || value < 0 || value >= numStrings )
+			{
+				valid = false;
+				break;
+			}
+			mapEnt->epairs.Set( &strings[stringOffsets[key]], &strings[stringOffsets[value]] );
+		}
+	}
+	
+	idLib::fileSystem->CloseFile( file );
+	
+	if( !valid )
+	{
+		entities.DeleteContents( true );
+		return false;
+	}
+	
+	name = filename;
+	name.StripFileExtension();
+	version = storedVersion;
+	fileTime = ( ID_TIME_T ) storedFileTime;
+	geometryCRC = storedCRC;
+	hasPrimitiveData = false;
+	
+	return true;
+}
+
+/*
+===============
+idMapFile::WriteEntityCache
+===============
+*/
+bool idMapFile::WriteEntityCache() const
+{
+	idStr sourceName, cacheName;
+	idHashIndex stringHash( 1024, 1024 );
+	idList<int> stringOffsets;
+	idList<char> strings;
+	idList<int> pairs;
+	
+	if( !name.Length() )
+	{
+		return false;
+	}
+	
+	MapEntityCacheNames( name, sourceName, cacheName );
+	
+	ID_TIME_T sourceTime = idLib::fileSystem->GetTimestamp( sourceName );
+	if( sourceTime == FILE_NOT_FOUND_TIMESTAMP )
+	{
+		return false;
+	}
+	
+	strings.SetGranularity( 16384 );
+	stringOffsets.SetGranularity( 1024 );
+	pairs.SetGranularity( 4096 );
+	
+	// add every key and value to the string table once
+	for( int i = 0; i < entities.Num(); i++ )
+	{
+		const idDict& epairs = entities[i]->epairs;
+		for( int j = 0; j < epairs.GetNumKeyVals(); j++ )
+		{
+			const idKeyValue* kv = epairs.GetKeyVal( j );
+			const char* kvStrings[2] = { kv->GetKey().c_str(), kv->GetValue().c_str() };
+			for( int k = 0; k < 2; k++ )
+			{
+				int hash = idStr::Hash( kvStrings[k] );
+				int index;
+				for( index = stringHash.First( hash ); index != -1; index = stringHash.Next( index ) )
+				{
+					if( idStr::Cmp( &strings[stringOffsets[index]], kvStrings[k] ) == 0 )
+					{
+						break;
+					}
+				}
+				if( index == -1 )
+				{
+					int length = idStr::Length( kvStrings[k] ) + 1;
+					index = stringOffsets.Append( strings.Num() );
+					stringHash.Add( hash, index );
+					strings.SetNum( strings.Num() + length );
+					memcpy( &strings[strings.Num() - length], kvStrings[k], length );
+				}
+				pairs.Append( index );
+			}
+		}
+	}
+	if( strings.Num() == 0 )
+	{
+		strings.Append( '\0' );
+	}
+	
+	idFile* file = idLib::fileSystem->OpenFileWrite( cacheName, "fs_basepath" );
+	if( file == NULL )
+	{
+		return false;
+	}
+	
+	file->WriteBig( MAP_ENTITYCACHE_MAGIC );
+	file->WriteBig( MAP_ENTITYCACHE_VERSION );
+	file->WriteBig( ( int64 ) sourceTime );
+	file->WriteBig( ( int64 ) fileTime );
+	file->WriteBig( geometryCRC );
+	file->WriteBig( version );
+	
+	file->WriteBig( stringOffsets.Num() );
+	file->WriteBig( strings.Num() );
+	file->WriteBigArray( stringOffsets.Ptr(), stringOffsets.Num() );
+	file->Write( strings.Ptr(), strings.Num() );
+	
+	file->WriteBig( entities.Num() );
+	const int* pair = pairs.Ptr();
+	for( int i = 0; i < entities.Num(); i++ )
+	{
+		int numPairs = entities[i]->epairs.GetNumKeyVals();
+		file->WriteBig( numPairs );
+		file->WriteBigArray( pair, numPairs * 2 );
+		pair += numPairs * 2;
+	}
+	
+	idLib::fileSystem->CloseFile( file );
+	
+	return true;
+}
@@ -314,6 +314,12 @@ public:
 	// returns true if the file on disk changed
 	bool					NeedsReload();
 	
+	// the entity cache is a binary file in generated/ with only the entity key/value pairs
+	// of a parsed map, it is valid as long as the .reg or .map file it was parsed from is
+	// unchanged and a map loaded from it has no primitive data
+	bool					LoadEntityCache( const char* filename );
+	bool					WriteEntityCache() const;
+	
 	int						AddEntity( idMapEntity* mapentity );
 	idMapEntity* 			FindEntity( const char* name );
 	void					RemoveEntity( idMapEntity* mapEnt );
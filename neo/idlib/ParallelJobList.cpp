@@ -41,6 +41,7 @@ const char* jobNames[] =
 {
 	ASSERT_ENUM_STRING( JOBLIST_RENDERER_FRONTEND,	0 ),
 	ASSERT_ENUM_STRING( JOBLIST_RENDERER_BACKEND,	1 ),
+	ASSERT_ENUM_STRING( JOBLIST_SOUND,				2 ),
 	ASSERT_ENUM_STRING( JOBLIST_UTILITY,			9 ),
 };
 
@@ -740,9 +741,21 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		{
 			uint64 jobStart = Sys_Microseconds();
 			
+			// job names are only looked up while the profiler records
+			const bool profileJob = idProfiler::IsRecording();
+			if( profileJob )
+			{
+				idProfiler::BeginZone( GetJobName( jobList[state.nextJobIndex].function ) );
+			}
+			
 			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
 			jobList[state.nextJobIndex].executed = 1;
 			
+			if( profileJob )
+			{
+				idProfiler::EndZone();
+			}
+			
 			uint64 jobEnd = Sys_Microseconds();
 			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
 			
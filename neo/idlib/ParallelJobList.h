@@ -45,6 +45,7 @@ enum jobListId_t
 {
 	JOBLIST_RENDERER_FRONTEND	= 0,
 	JOBLIST_RENDERER_BACKEND	= 1,
+	JOBLIST_SOUND				= 2,
 	JOBLIST_UTILITY				= 9,			// won't print over-time warnings
 	
 	MAX_JOBLISTS				= 32			// the editor may cause quite a few to be allocated
@@ -0,0 +1,535 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+
+idCVar profile_hitchMsec( "profile_hitchMsec", "0", CVAR_INTEGER | CVAR_SYSTEM, "if > 0, the CPU profiler keeps recording and writes the last frames to profile/hitch_*.json whenever a frame takes longer than this" );
+
+/*
+================================================================================================
+
+	Per thread event buffers
+
+================================================================================================
+*/
+
+struct profileEvent_t
+{
+	const char* 	name;				// NULL for the end of a zone
+	uint64			time;				// Sys_Microseconds
+};
+
+static const int PROFILE_NAME_CACHE_SIZE = 256;		// has to be a power of two
+
+struct profileNameCache_t
+{
+	const char* 		name;			// pointer passed by the caller
+	const char* 		interned;
+};
+
+struct profileThread_t
+{
+	char				name[64];
+	profileEvent_t* 	events;			// MAX_EVENTS_PER_THREAD, allocated the first time the thread records
+	volatile uint32		numEvents;		// total written, the ring keeps the last MAX_EVENTS_PER_THREAD
+	volatile int		generation;		// recording the events belong to
+	volatile int		adding;			// set while the owning thread is inside AddProfileEvent
+	profileNameCache_t	nameCache[PROFILE_NAME_CACHE_SIZE];
+};
+
+volatile bool				idProfiler::recording = false;
+
+static idSysMutex			profileThreadsMutex;
+static profileThread_t* 	profileThreads[idProfiler::MAX_THREADS];
+static int					numProfileThreads;
+static ID_TLS				profileThreadIndex;			// 1 based index into profileThreads, -1 if there was no room
+
+static volatile int			profileGeneration;
+static int					profileCaptureFrames;		// frames left in a profileCapture, 0 if none is running
+static idStr				profileCaptureFileName;
+static uint64				profileLastFrameTime;
+static int					profileNumHitches;
+
+// interned zone names, never freed
+static idSysMutex			profileNamesMutex;
+static idList< char*, TAG_IDLIB >	profileNames;
+static idHashIndex			profileNamesHash;
+
+/*
+========================
+GetProfileThread
+========================
+*/
+static profileThread_t* GetProfileThread()
+{
+	int index = ( int )profileThreadIndex;
+	if( index == 0 )
+	{
+		idScopedCriticalSection lock( profileThreadsMutex );
+		if( numProfileThreads < idProfiler::MAX_THREADS )
+		{
+			profileThread_t* thread = ( profileThread_t* )Mem_ClearedAlloc( sizeof( profileThread_t ), TAG_IDLIB );
+			idStr::snPrintf( thread->name, sizeof( thread->name ), idLib::IsMainThread() ? "main" : "thread %d", numProfileThreads );
+			thread->generation = -1;
+			profileThreads[numProfileThreads] = thread;
+			SYS_MEMORYBARRIER;
+			index = ++numProfileThreads;
+		}
+		else
+		{
+			index = -1;
+		}
+		profileThreadIndex = index;
+	}
+	return ( index > 0 ) ? profileThreads[index - 1] : NULL;
+}
+
+/*
+========================
+InternProfileName
+
+Returns a copy of the name that lives as long as the profiler. The per thread cache is keyed
+by pointer and checked by content, so a pointer that gets reused for another name still works.
+========================
+*/
+static const char* InternProfileName( profileThread_t* thread, const char* name )
+{
+	profileNameCache_t& cached = thread->nameCache[( ( uintptr_t )name >> 3 ) & ( PROFILE_NAME_CACHE_SIZE - 1 )];
+	if( cached.name == name && idStr::Cmp( cached.interned, name ) == 0 )
+	{
+		return cached.interned;
+	}
+	
+	const int hash = idStr::Hash( name );
+	
+	idScopedCriticalSection lock( profileNamesMutex );
+	int i;
+	for( i = profileNamesHash.First( hash ); i != -1; i = profileNamesHash.Next( i ) )
+	{
+		if( idStr::Cmp( profileNames[i], name ) == 0 )
+		{
+			break;
+		}
+	}
+	if( i == -1 )
+	{
+		const int length = idStr::Length( name );
+		char* copy = ( char* )Mem_Alloc( length + 1, TAG_IDLIB );
+		memcpy( copy, name, length + 1 );
+		i = profileNames.Append( copy );
+		profileNamesHash.Add( hash, i );
+	}
+	
+	cached.name = name;
+	cached.interned = profileNames[i];
+	return cached.interned;
+}
+
+/*
+========================
+AddProfileEvent
+========================
+*/
+static void AddProfileEvent( const char* name )
+{
+	profileThread_t* thread = GetProfileThread();
+	if( thread == NULL )
+	{
+		return;
+	}
+	
+	// WriteCapture clears recording and then waits for adding to drop, so once it is set
+	// the recording flag has to be checked again
+	thread->adding = 1;
+	SYS_MEMORYBARRIER;
+	if( !idProfiler::IsRecording() )
+	{
+		thread->adding = 0;
+		return;
+	}
+	
+	// the owning thread resets its own buffer when a new recording started, so nothing else ever writes to it
+	if( thread->generation != profileGeneration )
+	{
+		if( thread->events == NULL )
+		{
+			thread->events = ( profileEvent_t* )Mem_Alloc( idProfiler::MAX_EVENTS_PER_THREAD * sizeof( profileEvent_t ), TAG_IDLIB );
+		}
+		thread->numEvents = 0;
+		thread->generation = profileGeneration;
+	}
+	
+	profileEvent_t& event = thread->events[thread->numEvents & ( idProfiler::MAX_EVENTS_PER_THREAD - 1 )];
+	event.name = ( name != NULL ) ? InternProfileName( thread, name ) : NULL;
+	event.time = Sys_Microseconds();
+	thread->numEvents++;
+	
+	SYS_MEMORYBARRIER;
+	thread->adding = 0;
+}
+
+/*
+================================================================================================
+
+	idProfiler
+
+================================================================================================
+*/
+
+/*
+========================
+idProfiler::BeginZone
+========================
+*/
+void idProfiler::BeginZone( const char* name )
+{
+	if( recording )
+	{
+		AddProfileEvent( name );
+	}
+}
+
+/*
+========================
+idProfiler::EndZone
+========================
+*/
+void idProfiler::EndZone()
+{
+	if( recording )
+	{
+		AddProfileEvent( NULL );
+	}
+}
+
+/*
+========================
+idProfiler::SetThreadName
+========================
+*/
+void idProfiler::SetThreadName( const char* name )
+{
+	profileThread_t* thread = GetProfileThread();
+	if( thread != NULL )
+	{
+		idStr::Copynz( thread->name, name, sizeof( thread->name ) );
+	}
+}
+
+/*
+========================
+idProfiler::StartRecording
+========================
+*/
+void idProfiler::StartRecording()
+{
+	profileGeneration++;
+	SYS_MEMORYBARRIER;
+	recording = true;
+	profileLastFrameTime = Sys_Microseconds();
+}
+
+/*
+========================
+idProfiler::StartCapture
+========================
+*/
+void idProfiler::StartCapture( int numFrames, const char* fileName )
+{
+	profileCaptureFileName = fileName;
+	profileCaptureFrames = Max( numFrames, 1 );
+	StartRecording();
+}
+
+/*
+========================
+idProfiler::EndFrame
+========================
+*/
+void idProfiler::EndFrame()
+{
+	const uint64 now = Sys_Microseconds();
+	const uint64 frameTime = now - profileLastFrameTime;
+	profileLastFrameTime = now;
+	
+	if( profileCaptureFrames > 0 )
+	{
+		if( --profileCaptureFrames == 0 )
+		{
+			recording = false;
+			WriteCapture( profileCaptureFileName );
+			if( profile_hitchMsec.GetInteger() > 0 )
+			{
+				StartRecording();
+			}
+		}
+		return;
+	}
+	
+	const int hitchMsec = profile_hitchMsec.GetInteger();
+	if( hitchMsec <= 0 )
+	{
+		recording = false;
+		return;
+	}
+	if( !recording )
+	{
+		StartRecording();
+		return;
+	}
+	if( frameTime > ( uint64 )hitchMsec * 1000 )
+	{
+		recording = false;
+		idLib::Printf( "profile: %.1f ms frame\n", frameTime / 1000.0f );
+		WriteCapture( va( "profile/hitch_%04d.json", profileNumHitches++ ) );
+		
+		// restarting also restarts the frame timer, so writing the trace doesn't count as the next hitch
+		StartRecording();
+	}
+}
+
+/*
+========================
+WriteJSONString
+========================
+*/
+static void WriteJSONString( idStr& out, const char* s )
+{
+	out += '"';
+	for( ; *s != '\0'; s++ )
+	{
+		if( *s == '"' || *s == '\\' )
+		{
+			out += '\\';
+			out += *s;
+		}
+		else if( ( unsigned char )*s >= ' ' )
+		{
+			out += *s;
+		}
+	}
+	out += '"';
+}
+
+struct profileZoneStats_t
+{
+	const char* 	name;
+	uint64			total;
+	uint64			max;
+	int				count;
+};
+
+/*
+========================
+SortZonesByMax
+========================
+*/
+static int SortZonesByMax( const profileZoneStats_t* a, const profileZoneStats_t* b )
+{
+	return ( a->max < b->max ) ? 1 : ( ( a->max > b->max ) ? -1 : 0 );
+}
+
+/*
+========================
+idProfiler::WriteCapture
+
+Pairs up the begin and end events of every thread, drops ends without a begin from before the
+ring wrapped and closes zones that were still open when the recording stopped.
+========================
+*/
+void idProfiler::WriteCapture( const char* fileName )
+{
+	static const int MAX_DEPTH = 256;
+	static const int WRITE_CHUNK = 64 * 1024;
+	
+	// the buffers are read without locks, so no thread may still be adding an event
+	recording = false;
+	SYS_MEMORYBARRIER;
+	
+	const int numThreads = numProfileThreads;
+	for( int t = 0; t < numThreads; t++ )
+	{
+		while( profileThreads[t]->adding )
+		{
+			Sys_Yield();
+		}
+	}
+	SYS_MEMORYBARRIER;
+	
+	idFile* file = idLib::fileSystem->OpenFileWrite( fileName );
+	if( file == NULL )
+	{
+		idLib::Warning( "profile: couldn't open %s", fileName );
+		return;
+	}
+	
+	// events are written relative to the oldest one
+	uint64 baseTime = ~( uint64 )0;
+	for( int t = 0; t < numThreads; t++ )
+	{
+		const profileThread_t* thread = profileThreads[t];
+		if( thread->generation != profileGeneration || thread->numEvents == 0 )
+		{
+			continue;
+		}
+		const uint32 numEvents = thread->numEvents;
+		const uint32 first = ( numEvents > ( uint32 )MAX_EVENTS_PER_THREAD ) ? numEvents - MAX_EVENTS_PER_THREAD : 0;
+		baseTime = Min( baseTime, thread->events[first & ( MAX_EVENTS_PER_THREAD - 1 )].time );
+	}
+	
+	idList< profileZoneStats_t, TAG_IDLIB > zones;
+	idHashIndex zoneHash;
+	
+	idStr out;
+	out.ReAllocate( WRITE_CHUNK + 1024, false );
+	out = "{\"traceEvents\":[\n";
+	
+	int totalEvents = 0;
+	int numWrittenThreads = 0;
+	bool firstEvent = true;
+	char buffer[256];
+	
+	for( int t = 0; t < numThreads; t++ )
+	{
+		const profileThread_t* thread = profileThreads[t];
+		if( thread->generation != profileGeneration || thread->numEvents == 0 )
+		{
+			continue;
+		}
+		numWrittenThreads++;
+		
+		idStr::snPrintf( buffer, sizeof( buffer ), "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", firstEvent ? "" : ",\n", t );
+		out += buffer;
+		WriteJSONString( out, thread->name );
+		out += "}}";
+		firstEvent = false;
+		
+		const uint32 numEvents = thread->numEvents;
+		const uint32 first = ( numEvents > ( uint32 )MAX_EVENTS_PER_THREAD ) ? numEvents - MAX_EVENTS_PER_THREAD : 0;
+		
+		const profileEvent_t* stack[MAX_DEPTH];
+		int depth = 0;
+		uint64 lastTime = 0;
+		
+		for( uint32 i = first; i < numEvents; i++ )
+		{
+			const profileEvent_t& event = thread->events[i & ( MAX_EVENTS_PER_THREAD - 1 )];
+			lastTime = event.time;
+			
+			if( event.name != NULL )
+			{
+				if( depth < MAX_DEPTH )
+				{
+					stack[depth] = &event;
+				}
+				depth++;
+				
+				idStr::snPrintf( buffer, sizeof( buffer ), ",\n{\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"name\":", t, ( int64 )( event.time - baseTime ) );
+				out += buffer;
+				WriteJSONString( out, event.name );
+				out += '}';
+			}
+			else
+			{
+				if( depth == 0 )
+				{
+					continue;
+				}
+				depth--;
+				
+				if( depth < MAX_DEPTH )
+				{
+					const char* name = stack[depth]->name;
+					const uint64 duration = event.time - stack[depth]->time;
+					
+					const int hash = idStr::Hash( name );
+					int z;
+					for( z = zoneHash.First( hash ); z != -1; z = zoneHash.Next( z ) )
+					{
+						if( zones[z].name == name || idStr::Cmp( zones[z].name, name ) == 0 )
+						{
+							break;
+						}
+					}
+					if( z == -1 )
+					{
+						profileZoneStats_t newZone = { name, 0, 0, 0 };
+						z = zones.Append( newZone );
+						zoneHash.Add( hash, z );
+					}
+					zones[z].total += duration;
+					zones[z].max = Max( zones[z].max, duration );
+					zones[z].count++;
+				}
+				
+				idStr::snPrintf( buffer, sizeof( buffer ), ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%lld}", t, ( int64 )( event.time - baseTime ) );
+				out += buffer;
+			}
+			totalEvents++;
+			
+			if( out.Length() > WRITE_CHUNK )
+			{
+				file->Write( out.c_str(), out.Length() );
+				out.Empty();
+			}
+		}
+		
+		for( ; depth > 0; depth-- )
+		{
+			idStr::snPrintf( buffer, sizeof( buffer ), ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%lld}", t, ( int64 )( lastTime - baseTime ) );
+			out += buffer;
+		}
+	}
+	
+	out += "\n]}\n";
+	file->Write( out.c_str(), out.Length() );
+	delete file;
+	
+	idLib::Printf( "profile: wrote %d events from %d threads to %s\n", totalEvents, numWrittenThreads, fileName );
+	
+	zones.Sort( SortZonesByMax );
+	for( int i = 0; i < zones.Num() && i < 10; i++ )
+	{
+		idLib::Printf( "%8.2f ms max %9.2f ms total %7d calls  %s\n", zones[i].max / 1000.0f, zones[i].total / 1000.0f, zones[i].count, zones[i].name );
+	}
+}
+
+/*
+========================
+profileCapture
+========================
+*/
+CONSOLE_COMMAND( profileCapture, "records frames with the CPU profiler and writes them as Chrome trace JSON, usage: profileCapture [frames] [file]", 0 )
+{
+	const int numFrames = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 60;
+	const char* fileName = ( args.Argc() > 2 ) ? args.Argv( 2 ) : "profile/capture.json";
+	
+	idProfiler::StartCapture( numFrames, fileName );
+	idLib::Printf( "profile: recording %d frames\n", Max( numFrames, 1 ) );
+}
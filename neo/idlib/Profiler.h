@@ -0,0 +1,85 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+/*
+================================================================================================
+
+	CPU Profiler
+
+	Scoped zones are recorded as begin / end events into a ring buffer per thread. Only the owning
+	thread writes to its buffer, so recording takes no locks and costs a flag test when no capture
+	is running. Writing a capture stops the recording and waits until no thread is still in the
+	middle of adding an event. A capture runs for a number of frames and is written as Chrome trace JSON, which
+	can be loaded in chrome://tracing or ui.perfetto.dev. profile_hitchMsec keeps the buffers
+	recording and writes the last frames whenever a frame takes too long.
+
+	Zone names are interned when they are recorded, so names of models or materials that are freed
+	before the capture is written stay valid.
+
+================================================================================================
+*/
+
+/*
+================================================
+idProfiler
+================================================
+*/
+class idProfiler
+{
+public:
+	static const int	MAX_THREADS = 64;
+	static const int	MAX_EVENTS_PER_THREAD = 1 << 17;		// ring buffer size, has to be a power of two
+	
+	static bool			IsRecording()
+	{
+		return recording;
+	}
+	
+	static void			BeginZone( const char* name );
+	static void			EndZone();
+	
+	// names the buffer of the calling thread in the trace
+	static void			SetThreadName( const char* name );
+	
+	// records numFrames frames and writes them to fileName
+	static void			StartCapture( int numFrames, const char* fileName );
+	
+	// called by the main thread at the end of every frame
+	static void			EndFrame();
+	
+private:
+	static void			StartRecording();
+	static void			WriteCapture( const char* fileName );
+	
+	static volatile bool	recording;
+};
+
+#endif // !__PROFILER_H__
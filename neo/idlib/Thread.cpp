@@ -212,6 +212,8 @@ int idSysThread::ThreadProc( idSysThread* thread )
 {
 	int retVal = 0;
 	
+	idProfiler::SetThreadName( thread->GetName() );
+	
 	try
 	{
 		if( thread->isWorker )
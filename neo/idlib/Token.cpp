@@ -32,17 +32,17 @@ If you have questions concerning this license or the applicable additional terms
 
 /*
 ================
-idToken::NumberValue
+idToken::EvaluateNumber
+
+  calculates the values of the number with the given sub type from the text between p and end,
+  used for both tokens and token views so they always produce the same values
 ================
 */
-void idToken::NumberValue()
+void idToken::EvaluateNumber( const char* p, const char* end, int subtype, unsigned int& intvalue, double& floatvalue )
 {
 	int i, pow, div, c;
-	const char* p;
 	double m;
 	
-	assert( type == TT_NUMBER );
-	p = c_str();
 	floatvalue = 0;
 	intvalue = 0;
 	// floating point number
@@ -68,29 +68,29 @@ void idToken::NumberValue()
 		}
 		else
 		{
-			while( *p && *p != '.' && *p != 'e' )
+			while( p < end && *p != '.' && *p != 'e' )
 			{
 				floatvalue = floatvalue * 10.0 + ( double )( *p - '0' );
 				p++;
 			}
-			if( *p == '.' )
+			if( p < end && *p == '.' )
 			{
 				p++;
-				for( m = 0.1; *p && *p != 'e'; p++ )
+				for( m = 0.1; p < end && *p != 'e'; p++ )
 				{
 					floatvalue = floatvalue + ( double )( *p - '0' ) * m;
 					m *= 0.1;
 				}
 			}
-			if( *p == 'e' )
+			if( p < end && *p == 'e' )
 			{
 				p++;
-				if( *p == '-' )
+				if( p < end && *p == '-' )
 				{
 					div = true;
 					p++;
 				}
-				else if( *p == '+' )
+				else if( p < end && *p == '+' )
 				{
 					div = false;
 					p++;
@@ -100,7 +100,7 @@ void idToken::NumberValue()
 					div = false;
 				}
 				pow = 0;
-				for( pow = 0; *p; p++ )
+				for( pow = 0; p < end; p++ )
 				{
 					pow = pow * 10 + ( int )( *p - '0' );
 				}
@@ -122,7 +122,7 @@ void idToken::NumberValue()
 	}
 	else if( subtype & TT_DECIMAL )
 	{
-		while( *p )
+		while( p < end )
 		{
 			intvalue = intvalue * 10 + ( *p - '0' );
 			p++;
@@ -132,7 +132,7 @@ void idToken::NumberValue()
 	else if( subtype & TT_IPADDRESS )
 	{
 		c = 0;
-		while( *p && *p != ':' )
+		while( p < end && *p != ':' )
 		{
 			if( *p == '.' )
 			{
@@ -161,7 +161,7 @@ void idToken::NumberValue()
 	{
 		// step over the first zero
 		p += 1;
-		while( *p )
+		while( p < end )
 		{
 			intvalue = ( intvalue << 3 ) + ( *p - '0' );
 			p++;
@@ -172,7 +172,7 @@ void idToken::NumberValue()
 	{
 		// step over the leading 0x or 0X
 		p += 2;
-		while( *p )
+		while( p < end )
 		{
 			intvalue <<= 4;
 			if( *p >= 'a' && *p <= 'f' )
@@ -189,13 +189,24 @@ void idToken::NumberValue()
 	{
 		// step over the leading 0b or 0B
 		p += 2;
-		while( *p )
+		while( p < end )
 		{
 			intvalue = ( intvalue << 1 ) + ( *p - '0' );
 			p++;
 		}
 		floatvalue = intvalue;
 	}
+}
+
+/*
+================
+idToken::NumberValue
+================
+*/
+void idToken::NumberValue()
+{
+	assert( type == TT_NUMBER );
+	EvaluateNumber( c_str(), c_str() + Length(), subtype, intvalue, floatvalue );
 	subtype |= TT_VALUESVALID;
 }
 
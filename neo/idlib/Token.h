@@ -98,6 +98,9 @@ public:
 	
 	void			NumberValue();				// calculate values for a TT_NUMBER
 	
+	// calculate the values of the number text between p and end with the given sub type
+	static void		EvaluateNumber( const char* p, const char* end, int subtype, unsigned int& intvalue, double& floatvalue );
+	
 private:
 	// DG: use int instead of long for 64bit compatibility
 	unsigned int	intvalue;							// integer value
@@ -180,4 +183,146 @@ ID_INLINE void idToken::AppendDirty( const char a )
 	data[len++] = a;
 }
 
+/*
+===============================================================================
+
+	idTokenView is a token read with idLexer::ReadTokenView
+
+	The text is not copied, the view points into the script buffer of the
+	lexer and is not zero terminated. A view is only valid until the next
+	token is read from the same lexer.
+
+===============================================================================
+*/
+
+class idTokenView
+{
+
+	friend class idLexer;
+	
+public:
+	int				type;								// token type
+	int				subtype;							// token sub type
+	int				line;								// line in script the token was on
+	int				linesCrossed;						// number of lines crossed in white space before token
+	
+public:
+	idTokenView();
+	
+	const char* 	Ptr() const;						// start of the token text, not zero terminated
+	int				Length() const;
+	void			ToStr( idStr& str ) const;			// copy the token text
+	
+	bool			operator==( const char* text ) const;
+	bool			operator!=( const char* text ) const;
+	int				Cmp( const char* text ) const;
+	int				Icmp( const char* text ) const;
+	int				Icmpn( const char* text, int n ) const;
+	
+	double			GetDoubleValue() const;				// double value of TT_NUMBER
+	float			GetFloatValue() const;				// float value of TT_NUMBER
+	unsigned long	GetUnsignedLongValue() const;		// unsigned long value of TT_NUMBER
+	int				GetIntValue() const;				// int value of TT_NUMBER
+	
+private:
+	const char* 	ptr;								// token text in the script buffer
+	int				len;								// length of the token text
+};
+
+ID_INLINE idTokenView::idTokenView() : type(), subtype(), line(), linesCrossed(), ptr( "" ), len()
+{
+}
+
+ID_INLINE const char* idTokenView::Ptr() const
+{
+	return ptr;
+}
+
+ID_INLINE int idTokenView::Length() const
+{
+	return len;
+}
+
+ID_INLINE void idTokenView::ToStr( idStr& str ) const
+{
+	str.Empty();
+	str.Append( ptr, len );
+}
+
+ID_INLINE int idTokenView::Cmp( const char* text ) const
+{
+	int c = idStr::Cmpn( ptr, text, len );
+	if( c != 0 )
+	{
+		return c;
+	}
+	// the text is at least as long as the token here
+	return ( text[len] != '\0' ) ? -1 : 0;
+}
+
+ID_INLINE int idTokenView::Icmp( const char* text ) const
+{
+	int c = idStr::Icmpn( ptr, text, len );
+	if( c != 0 )
+	{
+		return c;
+	}
+	return ( text[len] != '\0' ) ? -1 : 0;
+}
+
+ID_INLINE int idTokenView::Icmpn( const char* text, int n ) const
+{
+	if( len < n )
+	{
+		return Icmp( text );
+	}
+	return idStr::Icmpn( ptr, text, n );
+}
+
+ID_INLINE bool idTokenView::operator==( const char* text ) const
+{
+	return Cmp( text ) == 0;
+}
+
+ID_INLINE bool idTokenView::operator!=( const char* text ) const
+{
+	return Cmp( text ) != 0;
+}
+
+ID_INLINE double idTokenView::GetDoubleValue() const
+{
+	unsigned int intvalue;
+	double floatvalue;
+	
+	if( type != TT_NUMBER )
+	{
+		return 0.0;
+	}
+	idToken::EvaluateNumber( ptr, ptr + len, subtype, intvalue, floatvalue );
+	return floatvalue;
+}
+
+ID_INLINE float idTokenView::GetFloatValue() const
+{
+	return ( float ) GetDoubleValue();
+}
+
+ID_INLINE unsigned long idTokenView::GetUnsignedLongValue() const
+{
+	unsigned int intvalue;
+	double floatvalue;
+	
+	if( type != TT_NUMBER )
+	{
+		return 0;
+	}
+	idToken::EvaluateNumber( ptr, ptr + len, subtype, intvalue, floatvalue );
+	return intvalue;
+}
+
+ID_INLINE int idTokenView::GetIntValue() const
+{
+	return ( int ) GetUnsignedLongValue();
+}
+
 #endif /* !__TOKEN_H__ */
@@ -34,6 +34,11 @@ If you have questions concerning this license or the applicable additional terms
 
 	idStrPool
 
+	Strings are spread over a fixed number of shards by hash, each with its own
+	lock, so dictionaries can be copied, set and cleared from several threads at
+	once. Taking another reference to a pooled string (CopyString) and dropping
+	one that is not the last (FreeString) are lock free.
+
 ===============================================================================
 */
 
@@ -70,43 +75,84 @@ public:
 	}
 	
 private:
-	idStrPool* 			pool;
-	mutable int			numUsers;
+	idStrPool* 					pool;
+	int							hash;			// full hash, the low bits select the shard
+	mutable interlockedInt_t	numUsers;
 };
 
 class idStrPool
 {
 public:
-	idStrPool()
-	{
-		caseSensitive = true;
-	}
+	static const int	SHARD_BITS = 4;
+	static const int	NUM_SHARDS = 1 << SHARD_BITS;
+	
+	idStrPool();
+	~idStrPool();
 	
 	void				SetCaseSensitive( bool caseSensitive );
 	
 	int					Num() const
 	{
-		return pool.Num();
+		return numStrings;
 	}
 	size_t				Allocated() const;
 	size_t				Size() const;
 	
-	const idPoolStr* 	operator[]( int index ) const
-	{
-		return pool[index];
-	}
-	
 	const idPoolStr* 	AllocString( const char* string );
 	void				FreeString( const idPoolStr* poolStr );
 	const idPoolStr* 	CopyString( const idPoolStr* poolStr );
 	void				Clear();
 	
 private:
+	struct ALIGNTYPE128 poolShard_t
+	{
+		mutable mutexHandle_t	lock;
+		idList<idPoolStr*>		pool;
+		idHashIndex				poolHash;
+	};
+	
 	bool				caseSensitive;
-	idList<idPoolStr*>	pool;
-	idHashIndex			poolHash;
+	interlockedInt_t	numStrings;
+	poolShard_t			shards[NUM_SHARDS];
+	
+	int					HashString( const char* string ) const
+	{
+		return caseSensitive ? idStr::Hash( string ) : idStr::IHash( string );
+	}
+	static poolShard_t& ShardForHash( poolShard_t* shards, int hash )
+	{
+		return shards[hash & ( NUM_SHARDS - 1 )];
+	}
 };
 
+/*
+================
+idStrPool::idStrPool
+================
+*/
+ID_INLINE idStrPool::idStrPool()
+{
+	caseSensitive = true;
+	numStrings = 0;
+	for( int i = 0; i < NUM_SHARDS; i++ )
+	{
+		Sys_MutexCreate( shards[i].lock );
+	}
+}
+
+/*
+================
+idStrPool::~idStrPool
+================
+*/
+ID_INLINE idStrPool::~idStrPool()
+{
+	for( int i = 0; i < NUM_SHARDS; i++ )
+	{
+		Sys_MutexDestroy( shards[i].lock );
+	}
+}
+
 /*
 ================
 idStrPool::SetCaseSensitive
@@ -124,38 +170,36 @@ idStrPool::AllocString
 */
 ID_INLINE const idPoolStr* idStrPool::AllocString( const char* string )
 {
-	int i, hash;
+	int i, hash, key;
 	idPoolStr* poolStr;
 	
-	hash = poolHash.GenerateKey( string, caseSensitive );
-	if( caseSensitive )
-	{
-		for( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) )
-		{
-			if( pool[i]->Cmp( string ) == 0 )
-			{
-				pool[i]->numUsers++;
-				return pool[i];
-			}
-		}
-	}
-	else
+	hash = HashString( string );
+	key = hash >> SHARD_BITS;
+	poolShard_t& shard = ShardForHash( shards, hash );
+	
+	Sys_MutexLock( shard.lock, true );
+	
+	for( i = shard.poolHash.First( key ); i != -1; i = shard.poolHash.Next( i ) )
 	{
-		for( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) )
+		poolStr = shard.pool[i];
+		if( poolStr->hash == hash && ( caseSensitive ? poolStr->Cmp( string ) : poolStr->Icmp( string ) ) == 0 )
 		{
-			if( pool[i]->Icmp( string ) == 0 )
-			{
-				pool[i]->numUsers++;
-				return pool[i];
-			}
+			// this may revive a string whose last user is about to release it, FreeString checks for that
+			Sys_InterlockedIncrement( poolStr->numUsers );
+			Sys_MutexUnlock( shard.lock );
+			return poolStr;
 		}
 	}
 	
 	poolStr = new( TAG_IDLIB_STRING ) idPoolStr;
 	*static_cast<idStr*>( poolStr ) = string;
 	poolStr->pool = this;
+	poolStr->hash = hash;
 	poolStr->numUsers = 1;
-	poolHash.Add( hash, pool.Append( poolStr ) );
+	shard.poolHash.Add( key, shard.pool.Append( poolStr ) );
+	Sys_InterlockedIncrement( numStrings );
+	
+	Sys_MutexUnlock( shard.lock );
 	return poolStr;
 }
 
@@ -166,7 +210,7 @@ idStrPool::FreeString
 */
 ID_INLINE void idStrPool::FreeString( const idPoolStr* poolStr )
 {
-	int i, hash;
+	int i, hash, key;
 	
 	// foresthale 2014-05-15: it seems that pool can be empty already when we
 	// get here, and poolStr may point to freed memory, the call stack is:
@@ -182,7 +226,7 @@ ID_INLINE void idStrPool::FreeString( const idPoolStr* poolStr )
 	// foresthale 2014-05-28: several other call stacks can reach this point
 	// as well, so I am putting this code in, it is a ghastly hack and it
 	// would do us well to find the various entry points that lead to it.
-	if( pool.Num() == 0 )
+	if( numStrings == 0 )
 		return;
 
 	/*
@@ -204,36 +248,36 @@ ID_INLINE void idStrPool::FreeString( const idPoolStr* poolStr )
 	
 	assert( poolStr->pool == this );
 	
-	poolStr->numUsers--;
-	if( poolStr->numUsers <= 0 )
+	// the hash has to be read while we still hold a reference
+	hash = poolStr->hash;
+	if( Sys_InterlockedDecrement( poolStr->numUsers ) > 0 )
 	{
-		hash = poolHash.GenerateKey( poolStr->c_str(), caseSensitive );
-		if( caseSensitive )
-		{
-			for( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) )
-			{
-				if( pool[i]->Cmp( poolStr->c_str() ) == 0 )
-				{
-					break;
-				}
-			}
-		}
-		else
+		return;
+	}
+	
+	key = hash >> SHARD_BITS;
+	poolShard_t& shard = ShardForHash( shards, hash );
+	
+	Sys_MutexLock( shard.lock, true );
+	
+	// once the count dropped to zero another thread may have revived the string through
+	// AllocString and released it again, so only compare pointers until it is found
+	for( i = shard.poolHash.First( key ); i != -1; i = shard.poolHash.Next( i ) )
+	{
+		if( shard.pool[i] == poolStr )
 		{
-			for( i = poolHash.First( hash ); i != -1; i = poolHash.Next( i ) )
-			{
-				if( pool[i]->Icmp( poolStr->c_str() ) == 0 )
-				{
-					break;
-				}
-			}
+			break;
 		}
-		assert( i != -1 );
-		assert( pool[i] == poolStr );
-		delete pool[i];
-		pool.RemoveIndex( i );
-		poolHash.RemoveIndex( hash, i );
 	}
+	if( i != -1 && poolStr->numUsers == 0 )
+	{
+		delete shard.pool[i];
+		shard.pool.RemoveIndex( i );
+		shard.poolHash.RemoveIndex( key, i );
+		Sys_InterlockedDecrement( numStrings );
+	}
+	
+	Sys_MutexUnlock( shard.lock );
 }
 
 /*
@@ -249,7 +293,7 @@ ID_INLINE const idPoolStr* idStrPool::CopyString( const idPoolStr* poolStr )
 	if( poolStr->pool == this )
 	{
 		// the string is from this pool so just increase the user count
-		poolStr->numUsers++;
+		Sys_InterlockedIncrement( poolStr->numUsers );
 		return poolStr;
 	}
 	else
@@ -266,14 +310,21 @@ idStrPool::Clear
 */
 ID_INLINE void idStrPool::Clear()
 {
-	int i;
+	int i, j;
 	
-	for( i = 0; i < pool.Num(); i++ )
+	for( i = 0; i < NUM_SHARDS; i++ )
 	{
-		pool[i]->numUsers = 0;
+		poolShard_t& shard = shards[i];
+		Sys_MutexLock( shard.lock, true );
+		for( j = 0; j < shard.pool.Num(); j++ )
+		{
+			shard.pool[j]->numUsers = 0;
+		}
+		shard.pool.DeleteContents( true );
+		shard.poolHash.Free();
+		Sys_MutexUnlock( shard.lock );
 	}
-	pool.DeleteContents( true );
-	poolHash.Free();
+	numStrings = 0;
 }
 
 /*
@@ -283,13 +334,20 @@ idStrPool::Allocated
 */
 ID_INLINE size_t idStrPool::Allocated() const
 {
-	int i;
+	int i, j;
 	size_t size;
 	
-	size = pool.Allocated() + poolHash.Allocated();
-	for( i = 0; i < pool.Num(); i++ )
+	size = 0;
+	for( i = 0; i < NUM_SHARDS; i++ )
 	{
-		size += pool[i]->Allocated();
+		const poolShard_t& shard = shards[i];
+		Sys_MutexLock( shard.lock, true );
+		size += shard.pool.Allocated() + shard.poolHash.Allocated();
+		for( j = 0; j < shard.pool.Num(); j++ )
+		{
+			size += shard.pool[j]->Allocated();
+		}
+		Sys_MutexUnlock( shard.lock );
 	}
 	return size;
 }
@@ -301,13 +359,20 @@ idStrPool::Size
 */
 ID_INLINE size_t idStrPool::Size() const
 {
-	int i;
+	int i, j;
 	size_t size;
 	
-	size = pool.Size() + poolHash.Size();
-	for( i = 0; i < pool.Num(); i++ )
+	size = sizeof( *this );
+	for( i = 0; i < NUM_SHARDS; i++ )
 	{
-		size += pool[i]->Size();
+		const poolShard_t& shard = shards[i];
+		Sys_MutexLock( shard.lock, true );
+		size += shard.pool.Allocated() + shard.poolHash.Allocated();
+		for( j = 0; j < shard.pool.Num(); j++ )
+		{
+			size += shard.pool[j]->Size();
+		}
+		Sys_MutexUnlock( shard.lock );
 	}
 	return size;
 }
@@ -59,14 +59,16 @@ public:
 	void				LoadCubeFromMemory( int width, const byte* pics[6], int numLevels, textureFormat_t& textureFormat, textureColor_t& colorFormat, bool gammaMips, bool toolUsage, textureUsage_t usageParm );
 	
 	ID_TIME_T			LoadFromGeneratedFile( ID_TIME_T sourceFileTime, bool toolUsage );
+	// parses an already opened generated file, does not touch the file system
+	bool				LoadFromGeneratedFile( idFile* f, ID_TIME_T sourceFileTime );
 	ID_TIME_T			WriteGeneratedFile( ID_TIME_T sourceFileTime, bool toolUsage );
 	
-	const bimageFile_t& 	GetFileHeader()
+	const bimageFile_t& 	GetFileHeader() const
 	{
 		return fileData;
 	}
 	
-	int					NumImages()
+	int					NumImages() const
 	{
 		return images.Num();
 	}
@@ -125,7 +127,6 @@ private:
 	
 private:
 	void				MakeGeneratedFileName( idStr& gfn, bool toolUsage );
-	bool				LoadFromGeneratedFile( idFile* f, ID_TIME_T sourceFileTime );
 };
 
 #endif // __BINARYIMAGE_H__
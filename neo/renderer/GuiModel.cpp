@@ -48,6 +48,21 @@ idGuiModel::idGuiModel()
 	{
 		shaderParms[i] = 1.0f;
 	}
+	
+	recording = NULL;
+	recordFirstVert = 0;
+	recordFirstIndex = 0;
+	recordOverflow = false;
+}
+
+/*
+================
+idGuiModel::~idGuiModel
+================
+*/
+idGuiModel::~idGuiModel()
+{
+	caches.DeleteContents( true );
 }
 
 /*
@@ -94,7 +109,10 @@ void idGuiModel::BeginFrame()
 	indexPointer = ( triIndex_t* )vertexCache.MappedIndexBuffer( indexBlock );
 	numVerts = 0;
 	numIndexes = 0;
+	recording = NULL;
 	Clear();
+	
+	PurgeCaches();
 }
 
 idCVar	stereoRender_defaultGuiDepth( "stereoRender_defaultGuiDepth", "0", CVAR_RENDERER, "Fraction of separation when not specified" );
@@ -354,6 +372,48 @@ void idGuiModel::AdvanceSurf()
 	surf = &surfaces[ surfaces.Num() - 1 ];
 }
 
+/*
+=============
+R_SetCacheNum
+
+SetNum alone resizes to the exact size, which would reallocate on every AllocTris
+=============
+*/
+template< typename _type_ >
+static void R_SetCacheNum( idList<_type_, TAG_MODEL>& list, int num )
+{
+	if( num > list.NumAllocated() )
+	{
+		list.Resize( Max( num, list.NumAllocated() * 2 ) );
+	}
+	list.SetNum( num );
+}
+
+/*
+=============
+R_CopyCacheIndexes
+=============
+*/
+static void R_CopyCacheIndexes( triIndex_t* dest, const triIndex_t* src, int numIndexes, int firstVert )
+{
+	// recorded guis can start at an odd index after a triangle with an odd index count,
+	// write one index first so the pairs land on 4 byte boundaries
+	int i = 0;
+	if( numIndexes > 0 && ( ( uintptr_t )dest & ( sizeof( triIndex_t ) * 2 - 1 ) ) != 0 )
+	{
+		dest[0] = firstVert + src[0];
+		i = 1;
+	}
+	for( ; i + 1 < numIndexes; i += 2 )
+	{
+		WriteIndexPair( dest + i, firstVert + src[i], firstVert + src[i + 1] );
+	}
+	if( i < numIndexes )
+	{
+		dest[i] = firstVert + src[i];
+	}
+}
+
 /*
 =============
 AllocTris
@@ -373,6 +433,7 @@ idDrawVert* idGuiModel::AllocTris( int vertCount, const triIndex_t* tempIndexes,
 			warningFrame = tr.frameCount;
 			idLib::Warning( "idGuiModel::AllocTris: MAX_INDEXES exceeded" );
 		}
+		recordOverflow = true;
 		return NULL;
 	}
 	if( numVerts + vertCount > MAX_VERTS )
@@ -383,6 +444,7 @@ idDrawVert* idGuiModel::AllocTris( int vertCount, const triIndex_t* tempIndexes,
 			warningFrame = tr.frameCount;
 			idLib::Warning( "idGuiModel::AllocTris: MAX_VERTS exceeded" );
 		}
+		recordOverflow = true;
 		return NULL;
 	}
 	
@@ -407,6 +469,21 @@ idDrawVert* idGuiModel::AllocTris( int vertCount, const triIndex_t* tempIndexes,
 	
 	surf->numIndexes += indexCount;
 	
+	if( recording != NULL )
+	{
+		// record in local memory, EndCache copies everything to the frame buffers at once
+		R_SetCacheNum( recording->verts, numVerts - recordFirstVert );
+		R_SetCacheNum( recording->indexes, numIndexes - recordFirstIndex );
+		
+		const int recordVert = startVert - recordFirstVert;
+		triIndex_t* recordIndexes = recording->indexes.Ptr() + ( startIndex - recordFirstIndex );
+		for( int i = 0; i < indexCount; i++ )
+		{
+			recordIndexes[i] = recordVert + tempIndexes[i];
+		}
+		return recording->verts.Ptr() + recordVert;
+	}
+	
 	if( ( startIndex & 1 ) || ( indexCount & 1 ) )
 	{
 		// slow for write combined memory!
@@ -426,3 +503,155 @@ idDrawVert* idGuiModel::AllocTris( int vertCount, const triIndex_t* tempIndexes,
 	
 	return vertexPointer + startVert;
 }
+
+/*
+=============
+FindCache
+=============
+*/
+guiModelCache_t* idGuiModel::FindCache( const idUserInterface* gui ) const
+{
+	for( int i = 0; i < caches.Num(); i++ )
+	{
+		if( caches[i]->gui == gui )
+		{
+			return caches[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+=============
+PurgeCaches
+
+Guis are not told about the renderer, so caches of guis that are
+no longer drawn, or no longer exist, simply age out
+=============
+*/
+void idGuiModel::PurgeCaches()
+{
+	for( int i = caches.Num() - 1; i >= 0; i-- )
+	{
+		if( tr.frameCount - caches[i]->lastUsedFrame > CACHE_PURGE_FRAMES )
+		{
+			delete caches[i];
+			caches.RemoveIndexFast( i );
+		}
+	}
+}
+
+/*
+=============
+BeginCache
+
+Must be called right after Clear()
+=============
+*/
+bool idGuiModel::BeginCache( const idUserInterface* gui )
+{
+	if( recording != NULL )
+	{
+		return false;
+	}
+	assert( surfaces.Num() == 1 && surfaces[0].numIndexes == 0 );
+	
+	guiModelCache_t* cache = FindCache( gui );
+	if( cache == NULL )
+	{
+		cache = new( TAG_MODEL ) guiModelCache_t;
+		cache->gui = gui;
+		caches.Append( cache );
+	}
+	cache->drawKey = 0;
+	cache->lastUsedFrame = tr.frameCount;
+	cache->verts.SetNum( 0 );
+	cache->indexes.SetNum( 0 );
+	cache->surfaces.SetNum( 0 );
+	
+	recording = cache;
+	recordFirstVert = numVerts;
+	recordFirstIndex = numIndexes;
+	recordOverflow = false;
+	return true;
+}
+
+/*
+=============
+EndCache
+=============
+*/
+void idGuiModel::EndCache( int drawKey )
+{
+	guiModelCache_t* cache = recording;
+	if( cache == NULL )
+	{
+		return;
+	}
+	recording = NULL;
+	
+	// the frame still needs what was recorded
+	if( cache->verts.Num() > 0 )
+	{
+		WriteDrawVerts16( vertexPointer + recordFirstVert, cache->verts.Ptr(), cache->verts.Num() );
+	}
+	R_CopyCacheIndexes( indexPointer + recordFirstIndex, cache->indexes.Ptr(), cache->indexes.Num(), recordFirstVert );
+	
+	for( int i = 0; i < surfaces.Num(); i++ )
+	{
+		guiModelSurface_t s = surfaces[i];
+		s.firstIndex -= recordFirstIndex;
+		cache->surfaces.Append( s );
+	}
+	
+	// a gui that ran out of space is never replayed with missing parts
+	cache->drawKey = recordOverflow ? 0 : drawKey;
+}
+
+/*
+=============
+ReplayCache
+=============
+*/
+bool idGuiModel::ReplayCache( const idUserInterface* gui, int drawKey )
+{
+	if( drawKey <= 0 || recording != NULL )
+	{
+		return false;
+	}
+	
+	guiModelCache_t* cache = FindCache( gui );
+	if( cache == NULL || cache->drawKey != drawKey || cache->surfaces.Num() == 0 )
+	{
+		return false;
+	}
+	if( numVerts + cache->verts.Num() > MAX_VERTS || numIndexes + cache->indexes.Num() > MAX_INDEXES )
+	{
+		return false;
+	}
+	assert( surfaces.Num() == 1 && surfaces[0].numIndexes == 0 );
+	
+	const int firstVert = numVerts;
+	const int firstIndex = numIndexes;
+	
+	if( cache->verts.Num() > 0 )
+	{
+		WriteDrawVerts16( vertexPointer + firstVert, cache->verts.Ptr(), cache->verts.Num() );
+	}
+	R_CopyCacheIndexes( indexPointer + firstIndex, cache->indexes.Ptr(), cache->indexes.Num(), firstVert );
+	
+	surfaces.SetNum( 0 );
+	for( int i = 0; i < cache->surfaces.Num(); i++ )
+	{
+		guiModelSurface_t s = cache->surfaces[i];
+		s.firstIndex += firstIndex;
+		surfaces.Append( s );
+	}
+	surf = &surfaces[ surfaces.Num() - 1 ];
+	
+	numVerts += cache->verts.Num();
+	numIndexes += cache->indexes.Num();
+	
+	cache->lastUsedFrame = tr.frameCount;
+	return true;
+}
@@ -36,12 +36,27 @@ struct guiModelSurface_t
 	stereoDepthType_t		stereoType;
 };
 
+class idUserInterface;
+
+// geometry a gui emitted during one Redraw, kept in local memory so it can be replayed
+// while the gui reports the same draw key
+struct guiModelCache_t
+{
+	const idUserInterface* 					gui;
+	int										drawKey;
+	int										lastUsedFrame;
+	idList<idDrawVert, TAG_MODEL>			verts;
+	idList<triIndex_t, TAG_MODEL>			indexes;		// relative to the first cached vert
+	idList<guiModelSurface_t, TAG_MODEL>	surfaces;		// firstIndex relative to the first cached index
+};
+
 class idRenderMatrix;
 
 class idGuiModel
 {
 public:
 	idGuiModel();
+	~idGuiModel();
 	
 	void	Clear();
 	
@@ -59,9 +74,20 @@ public:
 	idDrawVert* AllocTris( int numVerts, const triIndex_t* indexes, int numIndexes, const idMaterial* material,
 						   const uint64 glState, const stereoDepthType_t stereoType );
 						   
+	// everything allocated between a Clear() and EndCache() is also recorded for the gui,
+	// returns false if another gui is already being recorded
+	bool	BeginCache( const idUserInterface* gui );
+	void	EndCache( int drawKey );
+	
+	// appends the geometry recorded for the gui after a Clear() if it was
+	// recorded with the same draw key
+	bool	ReplayCache( const idUserInterface* gui, int drawKey );
+	
 	//---------------------------
 private:
 	void	AdvanceSurf();
+	guiModelCache_t* FindCache( const idUserInterface* gui ) const;
+	void	PurgeCaches();
 	void	EmitSurfaces( float modelMatrix[16], float modelViewMatrix[16],
 						  bool depthHack, bool allowFullScreenStereoDepth, bool linkAsEntity );
 						  
@@ -86,5 +112,14 @@ private:
 	int		numIndexes;
 	
 	idList<guiModelSurface_t, TAG_MODEL>	surfaces;
+	
+	// caches are dropped when their gui was not drawn for this many frames
+	static const int CACHE_PURGE_FRAMES = 300;
+	
+	idList<guiModelCache_t*, TAG_MODEL>	caches;
+	guiModelCache_t* 			recording;
+	int							recordFirstVert;
+	int							recordFirstIndex;
+	bool						recordOverflow;
 };
 
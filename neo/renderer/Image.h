@@ -175,6 +175,11 @@ public:
 		levelLoadReferenced = true;
 	}
 	void		ActuallyLoadImage( bool fromBackEnd );
+	
+	// split version of ActuallyLoadImage for the level load pipeline, the binary image
+	// is read and parsed on other threads and only uploaded by FinishBinaryLoad
+	bool		PrepareBinaryLoad( idStr& binaryFileName, ID_TIME_T& sourceTime );
+	bool		FinishBinaryLoad( const idBinaryImage& im, ID_TIME_T fileTime );
 	//---------------------------------------------
 	// Platform specific implementations
 	//---------------------------------------------
@@ -228,6 +233,12 @@ private:
 	void				AllocImage();
 	void				DeriveOpts();
 	
+	void				PrepareLoad( idStrStatic< MAX_OSPATH >& generatedName );
+	bool				UseBinaryImage( const bimageFile_t& header, bool binaryFileFound ) const;
+	void				SetOptsFromBinaryImage( const bimageFile_t& header );
+	void				AddPreload();
+	void				UploadBinaryImage( const idBinaryImage& im );
+	
 	// parameters that define this image
 	idStr				imgName;				// game path, including extension (except for cube maps), may be an image program
 	cubeFiles_t			cubeFiles;				// If this is a cube map, and if so, what kind
@@ -32,6 +32,7 @@ If you have questions concerning this license or the applicable additional terms
 
 
 #include "tr_local.h"
+#include "../framework/LoadPipeline.h"
 
 // do this with a pointer, in case we want to make the actual manager
 // a private virtual subclass
@@ -922,6 +923,50 @@ void idImageManager::Preload( const idPreloadManifest& manifest, const bool& map
 	}
 }
 
+/*
+================================================
+idImageLoadItem
+
+Reads and parses the binary image off the main thread, only the texture
+upload happens in Finish. The images that were uploaded are collected in
+finished so their preload entries can be added after the pipeline drained.
+================================================
+*/
+class idImageLoadItem : public idLoadPipelineItem
+{
+public:
+	idImageLoadItem( idImage* image_, const char* binaryFileName, ID_TIME_T sourceFileTime_, idList< idImage* >* finished_ ) :
+		image( image_ ), binaryImage( image_->GetName() ), sourceFileTime( sourceFileTime_ ), parsed( false ), finished( finished_ )
+	{
+		fileName = binaryFileName;
+	}
+	
+	virtual void Decode()
+	{
+		parsed = binaryImage.LoadFromGeneratedFile( GetFile(), sourceFileTime );
+	}
+	virtual bool Finish()
+	{
+		if( parsed && image->FinishBinaryLoad( binaryImage, GetFileTime() ) )
+		{
+			finished->Append( image );
+			return true;
+		}
+		return false;
+	}
+	virtual void Fallback()
+	{
+		image->ActuallyLoadImage( false );
+	}
+	
+private:
+	idImage* 		image;
+	idBinaryImage	binaryImage;
+	ID_TIME_T		sourceFileTime;
+	bool			parsed;
+	idList< idImage* >* finished;
+};
+
 /*
 ===============
 idImageManager::LoadLevelImages
@@ -929,6 +974,9 @@ idImageManager::LoadLevelImages
 */
 int idImageManager::LoadLevelImages( bool pacifier )
 {
+	idLoadPipeline pipeline( "images" );
+	idList< idImage* > pipelineImages;
+	
 	int	loadCount = 0;
 	int pProgress = 0;
 	int imageCount = images.Num();
@@ -949,9 +997,25 @@ int idImageManager::LoadLevelImages( bool pacifier )
 		if( image->levelLoadReferenced && !image->IsLoaded() )
 		{
 			loadCount++;
-			image->ActuallyLoadImage( false );
+			
+			idStr binaryFileName;
+			ID_TIME_T sourceFileTime;
+			if( image->PrepareBinaryLoad( binaryFileName, sourceFileTime ) )
+			{
+				pipeline.AddItem( new( TAG_IMAGE ) idImageLoadItem( image, binaryFileName, sourceFileTime, &pipelineImages ) );
+			}
+			else
+			{
+				image->ActuallyLoadImage( false );
+			}
 		}
 	}
+	pipeline.Run( pacifier );
+	
+	for( int i = 0; i < pipelineImages.Num(); i++ )
+	{
+		pipelineImages[i]->AddPreload();
+	}
 	return loadCount;
 }
 
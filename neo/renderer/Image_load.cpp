@@ -520,43 +520,10 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 		return;
 	}
 	
-	if( com_productionMode.GetInteger() != 0 )
-	{
-		sourceFileTime = FILE_NOT_FOUND_TIMESTAMP;
-		if( cubeFiles != CF_2D )
-		{
-			opts.textureType = TT_CUBIC;
-			repeat = TR_CLAMP;
-		}
-	}
-	else
-	{
-		// RB begin
-		if( cubeFiles == CF_2D_ARRAY )
-		{
-			opts.textureType = TT_2D_ARRAY;
-		}
-		// RB end
-		else if( cubeFiles != CF_2D )
-		{
-			opts.textureType = TT_CUBIC;
-			repeat = TR_CLAMP;
-			R_LoadCubeImages( GetName(), cubeFiles, NULL, NULL, &sourceFileTime );
-		}
-		else
-		{
-			opts.textureType = TT_2D;
-			R_LoadImageProgram( GetName(), NULL, NULL, NULL, &sourceFileTime, &usage );
-		}
-	}
+	idStrStatic< MAX_OSPATH > generatedName;
+	PrepareLoad( generatedName );
 	
 	const bool toolUsage = IsToolUsage( usage );
-
-	// Figure out opts.colorFormat and opts.format so we can make sure the binary image is up to date
-	DeriveOpts();
-	
-	idStrStatic< MAX_OSPATH > generatedName = GetName();
-	GetGeneratedName( generatedName, usage, cubeFiles );
 	
 	idBinaryImage im( generatedName );
 	binaryFileTime = (!toolUsage || r_cacheToolImages.GetBool()) ? im.LoadFromGeneratedFile( sourceFileTime, toolUsage ) : FILE_NOT_FOUND_TIMESTAMP;
@@ -609,25 +576,10 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 	
 	const bimageFile_t& header = im.GetFileHeader();
 
-	if( ( (fileSystem->InProductionMode() || sourceFileTime<=0) && binaryFileFound )
-		|| ( ( binaryFileFound )
-			&& ( header.colorFormat == opts.colorFormat )
-			&& ( header.format == opts.format )
-			&& ( header.textureType == opts.textureType )
-			&& ( !toolUsage || r_cacheToolImages.GetBool() )
-			) )
+	if( UseBinaryImage( header, binaryFileFound ) )
 	{
-		opts.width = header.width;
-		opts.height = header.height;
-		opts.numLevels = header.numLevels;
-		opts.colorFormat = ( textureColor_t )header.colorFormat;
-		opts.format = ( textureFormat_t )header.format;
-		opts.textureType = ( textureType_t )header.textureType;
-		if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
-		{
-			// for resource gathering write this image to the preload file for this map
-			fileSystem->AddImagePreload( GetName(), filter, repeat, usage, cubeFiles );
-		}
+		SetOptsFromBinaryImage( header );
+		AddPreload();
 	}
 	else
 	{
@@ -734,6 +686,168 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 			binaryFileTime = im.WriteGeneratedFile( sourceFileTime, toolUsage );
 	}
 
+	UploadBinaryImage( im );
+}
+
+/*
+===============
+idImage::PrepareLoad
+
+Sets up the texture options and source time stamp, then returns the name the
+binary image is generated under. This is the part of ActuallyLoadImage that runs
+before the binary image is looked at.
+===============
+*/
+void idImage::PrepareLoad( idStrStatic< MAX_OSPATH >& generatedName )
+{
+	if( com_productionMode.GetInteger() != 0 )
+	{
+		sourceFileTime = FILE_NOT_FOUND_TIMESTAMP;
+		if( cubeFiles != CF_2D )
+		{
+			opts.textureType = TT_CUBIC;
+			repeat = TR_CLAMP;
+		}
+	}
+	else
+	{
+		// RB begin
+		if( cubeFiles == CF_2D_ARRAY )
+		{
+			opts.textureType = TT_2D_ARRAY;
+		}
+		// RB end
+		else if( cubeFiles != CF_2D )
+		{
+			opts.textureType = TT_CUBIC;
+			repeat = TR_CLAMP;
+			R_LoadCubeImages( GetName(), cubeFiles, NULL, NULL, &sourceFileTime );
+		}
+		else
+		{
+			opts.textureType = TT_2D;
+			R_LoadImageProgram( GetName(), NULL, NULL, NULL, &sourceFileTime, &usage );
+		}
+	}
+	
+	// Figure out opts.colorFormat and opts.format so we can make sure the binary image is up to date
+	DeriveOpts();
+	
+	generatedName = GetName();
+	GetGeneratedName( generatedName, usage, cubeFiles );
+}
+
+/*
+===============
+idImage::PrepareBinaryLoad
+
+Used by the level load pipeline. Returns false if the image can't come straight from
+a binary image, otherwise binaryFileName is the file to parse and hand to
+FinishBinaryLoad and sourceTime the time stamp it has to match.
+===============
+*/
+bool idImage::PrepareBinaryLoad( idStr& binaryFileName, ID_TIME_T& sourceTime )
+{
+	if( !R_IsInitialized() || generatorFunction )
+	{
+		return false;
+	}
+	
+	idStrStatic< MAX_OSPATH > generatedName;
+	PrepareLoad( generatedName );
+	
+	const bool toolUsage = IsToolUsage( usage );
+	if( toolUsage && !r_cacheToolImages.GetBool() )
+	{
+		return false;
+	}
+	
+	idBinaryImage::GetGeneratedFileName( binaryFileName, generatedName, toolUsage );
+	sourceTime = sourceFileTime;
+	return true;
+}
+
+/*
+===============
+idImage::FinishBinaryLoad
+
+Uploads a binary image that was read and parsed by the level load pipeline. Returns
+false without touching the image if ActuallyLoadImage would have rebuilt it instead.
+===============
+*/
+bool idImage::FinishBinaryLoad( const idBinaryImage& im, ID_TIME_T fileTime )
+{
+	const bimageFile_t& header = im.GetFileHeader();
+	if( !UseBinaryImage( header, true ) )
+	{
+		return false;
+	}
+	
+	binaryFileTime = fileTime;
+	SetOptsFromBinaryImage( header );
+	UploadBinaryImage( im );
+	return true;
+}
+
+/*
+===============
+idImage::UseBinaryImage
+
+True if the generated binary image is up to date for the current options
+===============
+*/
+bool idImage::UseBinaryImage( const bimageFile_t& header, bool binaryFileFound ) const
+{
+	const bool toolUsage = IsToolUsage( usage );
+	
+	return ( ( (fileSystem->InProductionMode() || sourceFileTime<=0) && binaryFileFound )
+		|| ( ( binaryFileFound )
+			&& ( header.colorFormat == opts.colorFormat )
+			&& ( header.format == opts.format )
+			&& ( header.textureType == opts.textureType )
+			&& ( !toolUsage || r_cacheToolImages.GetBool() )
+			) );
+}
+
+/*
+===============
+idImage::SetOptsFromBinaryImage
+===============
+*/
+void idImage::SetOptsFromBinaryImage( const bimageFile_t& header )
+{
+	opts.width = header.width;
+	opts.height = header.height;
+	opts.numLevels = header.numLevels;
+	opts.colorFormat = ( textureColor_t )header.colorFormat;
+	opts.format = ( textureFormat_t )header.format;
+	opts.textureType = ( textureType_t )header.textureType;
+}
+
+/*
+===============
+idImage::AddPreload
+
+Not done by SetOptsFromBinaryImage because the level load pipeline calls that
+from its finish stage, which must not touch the file system
+===============
+*/
+void idImage::AddPreload()
+{
+	if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
+	{
+		// for resource gathering write this image to the preload file for this map
+		fileSystem->AddImagePreload( GetName(), filter, repeat, usage, cubeFiles );
+	}
+}
+
+/*
+===============
+idImage::UploadBinaryImage
+===============
+*/
+void idImage::UploadBinaryImage( const idBinaryImage& im )
+{
 	AllocImage();
 	
 	
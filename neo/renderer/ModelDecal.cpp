@@ -54,6 +54,7 @@ firstDecal( 0 ),
 nextDecal( 0 ),
 firstDeferredDecal( 0 ),
 nextDeferredDecal( 0 ),
+numDeferredDecalJobs( 0 ),
 numDecalMaterials( 0 ),
 index( -1 ),
 demoSerialWrite(0),
@@ -213,6 +214,7 @@ void idRenderModelDecal::ReUse()
 	nextDecal = 0;
 	firstDeferredDecal = 0;
 	nextDeferredDecal = 0;
+	numDeferredDecalJobs = 0;
 	numDecalMaterials = 0;
 	demoSerialCurrent++;
 }
@@ -303,13 +305,20 @@ void idRenderModelDecal::CreateDecalFromWinding( const idWinding& w, const idMat
 /*
 ============
 R_DecalPointCullStatic
+
+Also projects the texture axis onto all points, so the triangles that are kept
+don't have to do it again for each of their corners
 ============
 */
-static void R_DecalPointCullStatic( byte* cullBits, const idPlane* planes, const idDrawVert* verts, const int numVerts )
+static void R_DecalPointCullStatic( byte* cullBits, float* texCoordS, float* texCoordT, const decalProjectionParms_t& parms, const idDrawVert* verts, const int numVerts )
 {
 	assert_16_byte_aligned( cullBits );
+	assert_16_byte_aligned( texCoordS );
+	assert_16_byte_aligned( texCoordT );
 	assert_16_byte_aligned( verts );
 
+	const idPlane* planes = parms.boundingPlanes;
+
 
 	idODSStreamedArray< idDrawVert, 16, SBT_DOUBLE, 4 > vertsODS( verts, numVerts );
 
@@ -358,6 +367,25 @@ static void R_DecalPointCullStatic( byte* cullBits, const idPlane* planes, const
 	const __m128 p5Z = _mm_splat_ps( p5, 2 );
 	const __m128 p5W = _mm_splat_ps( p5, 3 );
 
+	const __m128 t0 = _mm_loadu_ps( parms.textureAxis[ 0 ].ToFloatPtr() );
+	const __m128 t1 = _mm_loadu_ps( parms.textureAxis[ 1 ].ToFloatPtr() );
+
+	const __m128 t0X = _mm_splat_ps( t0, 0 );
+	const __m128 t0Y = _mm_splat_ps( t0, 1 );
+	const __m128 t0Z = _mm_splat_ps( t0, 2 );
+	const __m128 t0W = _mm_splat_ps( t0, 3 );
+
+	const __m128 t1X = _mm_splat_ps( t1, 0 );
+	const __m128 t1Y = _mm_splat_ps( t1, 1 );
+	const __m128 t1Z = _mm_splat_ps( t1, 2 );
+	const __m128 t1W = _mm_splat_ps( t1, 3 );
+
+	const __m128 originX = _mm_set1_ps( parms.projectionOrigin.x );
+	const __m128 originY = _mm_set1_ps( parms.projectionOrigin.y );
+	const __m128 originZ = _mm_set1_ps( parms.projectionOrigin.z );
+
+	const bool parallel = parms.parallel;
+
 	for ( int i = 0; i < numVerts; )
 	{
 
@@ -411,6 +439,29 @@ static void R_DecalPointCullStatic( byte* cullBits, const idPlane* planes, const
 			__m128i b0 = _mm_packus_epi16( s0, s0 );
 
 			*(unsigned int*)&cullBits[ i ] = _mm_cvtsi128_si32( b0 );
+
+			// a perspective projection uses the texture coordinates where the ray
+			// from the projection origin intersects the far bounding plane
+			__m128 tX = vX;
+			__m128 tY = vY;
+			__m128 tZ = vZ;
+			if ( !parallel )
+			{
+				const __m128 dirX = _mm_sub_ps( vX, originX );
+				const __m128 dirY = _mm_sub_ps( vY, originY );
+				const __m128 dirZ = _mm_sub_ps( vZ, originZ );
+
+				const __m128 dd = _mm_madd_ps( dirX, p5X, _mm_madd_ps( dirY, p5Y, _mm_mul_ps( dirZ, p5Z ) ) );
+				__m128 scale = _mm_sub_ps( vector_float_zero, _mm_div_ps( d5, dd ) );
+				scale = _mm_and_ps( scale, _mm_cmpneq_ps( dd, vector_float_zero ) );
+
+				tX = _mm_madd_ps( dirX, scale, vX );
+				tY = _mm_madd_ps( dirY, scale, vY );
+				tZ = _mm_madd_ps( dirZ, scale, vZ );
+			}
+
+			_mm_store_ps( &texCoordS[ i ], _mm_madd_ps( tX, t0X, _mm_madd_ps( tY, t0Y, _mm_madd_ps( tZ, t0Z, t0W ) ) ) );
+			_mm_store_ps( &texCoordT[ i ], _mm_madd_ps( tX, t1X, _mm_madd_ps( tY, t1Y, _mm_madd_ps( tZ, t1Z, t1W ) ) ) );
 		}
 	}
 
@@ -418,11 +469,31 @@ static void R_DecalPointCullStatic( byte* cullBits, const idPlane* planes, const
 
 /*
 =================
-idRenderModelDecal::CreateDecal
+R_AddProjectedWinding
 =================
 */
-void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalProjectionParms_t& localParms )
+static void R_AddProjectedWinding( decalProjectionJob_t* job, const idWinding& w )
 {
+	for ( int i = 0; i < w.GetNumPoints(); i++ )
+	{
+		job->points.Append( w[ i ] );
+	}
+	job->windingPoints.Append( w.GetNumPoints() );
+}
+
+/*
+=================
+R_ProjectDecal
+
+Clips the model to the projection volume, only writes to the job so it can
+run on any thread
+=================
+*/
+static void R_ProjectDecal( decalProjectionJob_t* job )
+{
+	const idRenderModel* model = job->model;
+	const decalProjectionParms_t& localParms = *job->parms;
+
 	int maxVerts = 0;
 	for ( int surfNum = 0; surfNum < model->NumSurfaces(); surfNum++ )
 	{
@@ -434,6 +505,8 @@ void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalPro
 	}
 
 	idTempArray< byte > cullBits( ALIGN( maxVerts, 4 ) );
+	idTempArray< float > texCoordS( ALIGN( maxVerts, 4 ) );
+	idTempArray< float > texCoordT( ALIGN( maxVerts, 4 ) );
 
 	// check all model surfaces
 	for ( int surfNum = 0; surfNum < model->NumSurfaces(); surfNum++ )
@@ -464,7 +537,7 @@ void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalPro
 		assert( tri->staticModelWithJoints == NULL );
 
 		// catagorize all points by the planes
-		R_DecalPointCullStatic( cullBits.Ptr(), localParms.boundingPlanes, tri->verts, tri->numVerts );
+		R_DecalPointCullStatic( cullBits.Ptr(), texCoordS.Ptr(), texCoordT.Ptr(), localParms, tri->verts, tri->numVerts );
 
 		// start streaming the indexes
 		idODSStreamedArray< triIndex_t, 256, SBT_QUAD, 3 > indexesODS( tri->indexes, tri->numIndexes );
@@ -502,30 +575,14 @@ void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalPro
 				}
 
 				// create a winding with texture coordinates for the triangle
+				const int triIndexes[ 3 ] = { i0, i1, i2 };
 				idFixedWinding fw;
 				fw.SetNumPoints( 3 );
-				if ( localParms.parallel )
-				{
-					for ( int j = 0; j < 3; j++ )
-					{
-						fw[ j ] = verts[ j ]->xyz;
-						fw[ j ].s = localParms.textureAxis[ 0 ].Distance( verts[ j ]->xyz );
-						fw[ j ].t = localParms.textureAxis[ 1 ].Distance( verts[ j ]->xyz );
-					}
-				}
-				else
+				for ( int j = 0; j < 3; j++ )
 				{
-					for ( int j = 0; j < 3; j++ )
-					{
-						const idVec3 dir = verts[ j ]->xyz - localParms.projectionOrigin;
-						float scale;
-						localParms.boundingPlanes[ NUM_DECAL_BOUNDING_PLANES - 1 ].RayIntersection( verts[ j ]->xyz, dir, scale );
-						const idVec3 intersection = verts[ j ]->xyz + scale * dir;
-
-						fw[ j ] = verts[ j ]->xyz;
-						fw[ j ].s = localParms.textureAxis[ 0 ].Distance( intersection );
-						fw[ j ].t = localParms.textureAxis[ 1 ].Distance( intersection );
-					}
+					fw[ j ] = verts[ j ]->xyz;
+					fw[ j ].s = texCoordS[ triIndexes[ j ] ];
+					fw[ j ].t = texCoordT[ triIndexes[ j ] ];
 				}
 
 				const int orBits = cullBits[ i0 ] | cullBits[ i1 ] | cullBits[ i2 ];
@@ -550,21 +607,63 @@ void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalPro
 
 					if ( fw.Split( &back, localParms.fadePlanes[ 0 ], 0.1f ) == SIDE_CROSS )
 					{
-						CreateDecalFromWinding( back, localParms.material, localParms.fadePlanes, localParms.fadeDepth, localParms.startTime );
+						R_AddProjectedWinding( job, back );
 					}
 
 					if ( fw.Split( &back, localParms.fadePlanes[ 1 ], 0.1f ) == SIDE_CROSS )
 					{
-						CreateDecalFromWinding( back, localParms.material, localParms.fadePlanes, localParms.fadeDepth, localParms.startTime );
+						R_AddProjectedWinding( job, back );
 					}
 
-					CreateDecalFromWinding( fw, localParms.material, localParms.fadePlanes, localParms.fadeDepth, localParms.startTime );
+					R_AddProjectedWinding( job, fw );
 				}
 			}
 		}
 	}
 }
 
+REGISTER_PARALLEL_JOB( R_ProjectDecal, "R_ProjectDecal" );
+
+/*
+=================
+idRenderModelDecal::AddProjectedWindings
+=================
+*/
+void idRenderModelDecal::AddProjectedWindings( const decalProjectionJob_t& job )
+{
+	const decalProjectionParms_t& parms = *job.parms;
+
+	idFixedWinding w;
+	int firstPoint = 0;
+	for ( int i = 0; i < job.windingPoints.Num(); i++ )
+	{
+		const int numPoints = job.windingPoints[ i ];
+		w.SetNumPoints( numPoints );
+		for ( int j = 0; j < numPoints; j++ )
+		{
+			w[ j ] = job.points[ firstPoint + j ];
+		}
+		firstPoint += numPoints;
+
+		CreateDecalFromWinding( w, parms.material, parms.fadePlanes, parms.fadeDepth, parms.startTime );
+	}
+}
+
+/*
+=================
+idRenderModelDecal::CreateDecal
+=================
+*/
+void idRenderModelDecal::CreateDecal( const idRenderModel* model, const decalProjectionParms_t& localParms )
+{
+	decalProjectionJob_t job;
+	job.model = model;
+	job.parms = &localParms;
+
+	R_ProjectDecal( &job );
+	AddProjectedWindings( job );
+}
+
 /*
 =====================
 idRenderModelDecal::CreateDeferredDecals
@@ -584,6 +683,49 @@ void idRenderModelDecal::CreateDeferredDecals( const idRenderModel* model )
 	nextDeferredDecal = 0;
 }
 
+/*
+=====================
+idRenderModelDecal::AddDeferredDecalJobs
+=====================
+*/
+void idRenderModelDecal::AddDeferredDecalJobs( const idRenderModel* model, idParallelJobList* jobList )
+{
+	numDeferredDecalJobs = 0;
+	for ( unsigned int i = firstDeferredDecal; i < nextDeferredDecal; i++ )
+	{
+		const decalProjectionParms_t& parms = deferredDecals[ i & ( MAX_DEFERRED_DECALS - 1 ) ];
+		if ( parms.startTime > tr.viewDef->renderView.time[ 0 ] - DEFFERED_DECAL_TIMEOUT )
+		{
+			decalProjectionJob_t& job = deferredDecalJobs[ numDeferredDecalJobs++ ];
+			job.model = model;
+			job.parms = &parms;
+			job.points.SetNum( 0 );
+			job.windingPoints.SetNum( 0 );
+			jobList->AddJob( ( jobRun_t )R_ProjectDecal, &job );
+		}
+	}
+}
+
+/*
+=====================
+idRenderModelDecal::FinishDeferredDecals
+
+Adds the windings of the finished jobs in the order the decals were deferred
+=====================
+*/
+void idRenderModelDecal::FinishDeferredDecals()
+{
+	for ( unsigned int i = 0; i < numDeferredDecalJobs; i++ )
+	{
+		AddProjectedWindings( deferredDecalJobs[ i ] );
+		deferredDecalJobs[ i ].points.Clear();
+		deferredDecalJobs[ i ].windingPoints.Clear();
+	}
+	numDeferredDecalJobs = 0;
+	firstDeferredDecal = 0;
+	nextDeferredDecal = 0;
+}
+
 /*
 =====================
 idRenderModelDecal::AddDeferredDecal
@@ -39,6 +39,10 @@ If you have questions concerning this license or the applicable additional terms
 	be one that receives lighting, because no interactions are generated
 	for these lightweight surfaces.
 
+	New decals are deferred until the model is visible. The front end then
+	clips the model to each deferred projection on a separate job and adds
+	the resulting windings to the decals once all the jobs have finished.
+
 	FIXME:	Decals on models in portalled off areas do not get freed
 			until the area becomes visible again.
 
@@ -76,6 +80,15 @@ struct decalProjectionParms_t
 	bool					force;
 };
 
+// the windings of a deferred decal clipped to the model on a front end job
+struct decalProjectionJob_t
+{
+	const idRenderModel* 			model;
+	const decalProjectionParms_t* 	parms;
+	idList< idVec5, TAG_DECAL >		points;
+	idList< int, TAG_DECAL >		windingPoints;		// number of points in each winding
+};
+
 // RB begin
 #if defined(_WIN32)
 ALIGNTYPE16 struct decal_t
@@ -119,6 +132,15 @@ public:
 	// Creates a decal on the given model.
 	void						CreateDeferredDecals( const idRenderModel* model );
 	
+	// Adds a job for each deferred decal, FinishDeferredDecals adds the decals once the jobs are done.
+	void						AddDeferredDecalJobs( const idRenderModel* model, idParallelJobList* jobList );
+	void						FinishDeferredDecals();
+	
+	bool						HasDeferredDecals() const
+	{
+		return nextDeferredDecal != firstDeferredDecal;
+	}
+	
 	// Remove decals that are completely faded away.
 	void						RemoveFadedDecals( int time );
 	
@@ -140,11 +162,15 @@ private:
 	unsigned int				firstDeferredDecal;
 	unsigned int				nextDeferredDecal;
 	
+	decalProjectionJob_t		deferredDecalJobs[MAX_DEFERRED_DECALS];
+	unsigned int				numDeferredDecalJobs;
+	
 	const idMaterial* 			decalMaterials[MAX_DECALS];
 	unsigned int				numDecalMaterials;
 	
 	void						CreateDecalFromWinding( const idWinding& w, const idMaterial* decalMaterial, const idPlane fadePlanes[2], float fadeDepth, int startTime );
 	void						CreateDecal( const idRenderModel* model, const decalProjectionParms_t& localParms );
+	void						AddProjectedWindings( const decalProjectionJob_t& job );
 };
 
 #endif /* !__MODELDECAL_H__ */
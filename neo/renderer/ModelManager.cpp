@@ -33,6 +33,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Model_local.h"
 #include "tr_local.h"	// just for R_FreeWorldInteractions and R_CreateWorldInteractions
+#include "../framework/LoadPipeline.h"
 
 idCVar r_binaryLoadRenderModels( "r_binaryLoadRenderModels", "1", 0, "enable binary load/write of render models" );
 idCVar preload_MapModels( "preload_MapModels", "1", CVAR_SYSTEM | CVAR_BOOL, "preload models during begin or end levelload" );
@@ -61,6 +62,9 @@ public:
 	
 	virtual	void			PrintMemInfo( MemInfo_t* mi );
 	
+	// level load pipeline, returns false if the model has to go through FindModel
+	bool					LoadPreloadedModel( const char* modelName, idFile* binaryFile, ID_TIME_T sourceTimeStamp );
+	
 private:
 	idList<idRenderModel*, TAG_MODEL>	models;
 	idHashIndex				hash;
@@ -70,6 +74,8 @@ private:
 	bool					insideLevelLoad;		// don't actually load now
 	
 	idRenderModel* 			GetModel( const char* modelName, bool createIfNotFound );
+	idRenderModel* 			AllocModelForExtension( const char* extension ) const;
+	void					RegisterNewModel( idRenderModel* model );
 	
 	static void				PrintModel_f( const idCmdArgs& args );
 	static void				ListModels_f( const idCmdArgs& args );
@@ -333,28 +339,7 @@ idRenderModel* idRenderModelManagerLocal::GetModel( const char* _modelName, bool
 	
 	// determine which subclass of idRenderModel to initialize
 	
-	idRenderModel* model = NULL;
-	
-	if( ( extension.Icmp( "ase" ) == 0 ) || ( extension.Icmp( "lwo" ) == 0 ) || ( extension.Icmp( "flt" ) == 0 ) || ( extension.Icmp( "ma" ) == 0 ) )
-	{
-		model = new( TAG_MODEL ) idRenderModelStatic;
-	}
-	else if( extension.Icmp( MD5_MESH_EXT ) == 0 )
-	{
-		model = new( TAG_MODEL ) idRenderModelMD5;
-	}
-	else if( extension.Icmp( "md3" ) == 0 )
-	{
-		model = new( TAG_MODEL ) idRenderModelMD3;
-	}
-	else if( extension.Icmp( "prt" ) == 0 )
-	{
-		model = new( TAG_MODEL ) idRenderModelPrt;
-	}
-	else if( extension.Icmp( "liquid" ) == 0 )
-	{
-		model = new( TAG_MODEL ) idRenderModelLiquid;
-	}
+	idRenderModel* model = AllocModelForExtension( extension );
 	
 	idStrStatic< MAX_OSPATH > generatedFileName;
 	
@@ -433,14 +418,103 @@ idRenderModel* idRenderModelManagerLocal::GetModel( const char* _modelName, bool
 		return NULL;
 	}
 	
+	RegisterNewModel( model );
+	
+	return model;
+}
+
+/*
+=================
+idRenderModelManagerLocal::AllocModelForExtension
+
+determine which subclass of idRenderModel to initialize, NULL for unknown formats
+=================
+*/
+idRenderModel* idRenderModelManagerLocal::AllocModelForExtension( const char* extension ) const
+{
+	if( ( idStr::Icmp( extension, "ase" ) == 0 ) || ( idStr::Icmp( extension, "lwo" ) == 0 ) || ( idStr::Icmp( extension, "flt" ) == 0 ) || ( idStr::Icmp( extension, "ma" ) == 0 ) )
+	{
+		return new( TAG_MODEL ) idRenderModelStatic;
+	}
+	else if( idStr::Icmp( extension, MD5_MESH_EXT ) == 0 )
+	{
+		return new( TAG_MODEL ) idRenderModelMD5;
+	}
+	else if( idStr::Icmp( extension, "md3" ) == 0 )
+	{
+		return new( TAG_MODEL ) idRenderModelMD3;
+	}
+	else if( idStr::Icmp( extension, "prt" ) == 0 )
+	{
+		return new( TAG_MODEL ) idRenderModelPrt;
+	}
+	else if( idStr::Icmp( extension, "liquid" ) == 0 )
+	{
+		return new( TAG_MODEL ) idRenderModelLiquid;
+	}
+	return NULL;
+}
+
+/*
+=================
+idRenderModelManagerLocal::RegisterNewModel
+=================
+*/
+void idRenderModelManagerLocal::RegisterNewModel( idRenderModel* model )
+{
 	if( cvarSystem->GetCVarBool( "fs_buildgame" ) )
 	{
 		fileSystem->AddModelPreload( model->Name() );
 	}
 	
 	AddModel( model );
+}
+
+/*
+=================
+idRenderModelManagerLocal::LoadPreloadedModel
+
+Level load pipeline version of GetModel for a model that isn't known yet, the binary
+model has already been read into memory. Anything that would need the file system
+returns false and is left to FindModel once the pipeline has drained.
+=================
+*/
+bool idRenderModelManagerLocal::LoadPreloadedModel( const char* modelName, idFile* binaryFile, ID_TIME_T sourceTimeStamp )
+{
+	if( !r_binaryLoadRenderModels.GetBool() || cvarSystem->GetCVarBool( "fs_buildresources" ) )
+	{
+		return false;
+	}
 	
-	return model;
+	idStrStatic< MAX_OSPATH > canonical = modelName;
+	canonical.ToLower();
+	
+	idStrStatic< MAX_OSPATH > extension;
+	canonical.ExtractFileExtension( extension );
+	
+	const int key = hash.GenerateKey( canonical, false );
+	for( int i = hash.First( key ); i != -1; i = hash.Next( i ) )
+	{
+		if( canonical.Icmp( models[i]->Name() ) == 0 )
+		{
+			return false;
+		}
+	}
+	
+	idRenderModel* model = AllocModelForExtension( extension );
+	if( model == NULL )
+	{
+		return false;
+	}
+	if( !model->SupportsBinaryModel() || !model->LoadBinaryModel( binaryFile, sourceTimeStamp ) )
+	{
+		delete model;
+		return false;
+	}
+	
+	model->SetLevelLoadReferenced( true );
+	RegisterNewModel( model );
+	return true;
 }
 
 /*
@@ -640,6 +714,42 @@ void idRenderModelManagerLocal::BeginLevelLoad()
 	vertexCache.FreeStaticData();
 }
 
+/*
+================================================
+idModelLoadItem
+
+Looks up the time stamp of the source model when the binary file is opened and reads
+the binary model on the pipeline I/O thread, the model is built on the main thread
+since that registers materials
+================================================
+*/
+class idModelLoadItem : public idLoadPipelineItem
+{
+public:
+	idModelLoadItem( const char* modelName_, const char* binaryFileName ) : modelName( modelName_ ), sourceTimeStamp( FILE_NOT_FOUND_TIMESTAMP )
+	{
+		fileName = binaryFileName;
+	}
+	
+	virtual bool Open()
+	{
+		sourceTimeStamp = fileSystem->GetTimestamp( modelName );
+		return idLoadPipelineItem::Open();
+	}
+	virtual bool Finish()
+	{
+		return localModelManager.LoadPreloadedModel( modelName, GetFile(), sourceTimeStamp );
+	}
+	virtual void Fallback()
+	{
+		renderModelManager->FindModel( modelName );
+	}
+	
+private:
+	idStrStatic< MAX_OSPATH >	modelName;
+	ID_TIME_T					sourceTimeStamp;
+};
+
 /*
 =================
 
@@ -654,6 +764,9 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 		// preload this levels images
 		int	start = Sys_Milliseconds();
 		int numLoaded = 0;
+		
+		// binary models are read by the load pipeline in resource file order
+		idLoadPipeline pipeline( "models" );
 		idList< preloadSort_t > preloadSort;
 		preloadSort.Resize( manifest.NumResources() );
 		for( int i = 0; i < manifest.NumResources(); i++ )
@@ -668,15 +781,29 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 				idStrStatic< 16 > ext;
 				filename.ExtractFileExtension( ext );
 				filename.SetFileExtension( va( "b%s", ext.c_str() ) );
+				
+				// only the models that have their binary file in a resource container are preloaded
+				if( !fileSystem->GetResourceCacheEntry( filename, rc ) )
+				{
+					continue;
+				}
+				
+				idRenderModel* model = CheckModel( p.resourceName );
+				if( model != NULL )
+				{
+					model->SetLevelLoadReferenced( true );
+				}
+				else
+				{
+					pipeline.AddItem( new( TAG_MODEL ) idModelLoadItem( p.resourceName, filename ) );
+				}
+				numLoaded++;
 			}
 			if( p.resType == PRELOAD_PARTICLE )
 			{
 				filename = "generated/particles/";
 				filename += p.resourceName;
 				filename += ".bprt";
-			}
-			if( !filename.IsEmpty() )
-			{
 				if( fileSystem->GetResourceCacheEntry( filename, rc ) )
 				{
 					preloadSort_t ps = {};
@@ -687,24 +814,16 @@ void idRenderModelManagerLocal::Preload( const idPreloadManifest& manifest )
 			}
 		}
 		
+		pipeline.Run( false );
+		
+		// particle decls read their own binary files, so they have to wait for the pipeline
 		preloadSort.SortWithTemplate( idSort_Preload() );
 		
 		for( int i = 0; i < preloadSort.Num(); i++ )
 		{
 			const preloadSort_t& ps = preloadSort[ i ];
 			const preloadEntry_s& p = manifest.GetPreloadByIndex( ps.idx );
-			if( p.resType == PRELOAD_MODEL )
-			{
-				idRenderModel* model = FindModel( p.resourceName );
-				if( model != NULL )
-				{
-					model->SetLevelLoadReferenced( true );
-				}
-			}
-			else if( p.resType == PRELOAD_PARTICLE )
-			{
-				declManager->FindType( DECL_PARTICLE, p.resourceName );
-			}
+			declManager->FindType( DECL_PARTICLE, p.resourceName );
 			numLoaded++;
 		}
 		
@@ -45,6 +45,7 @@ idRenderModelOverlay::idRenderModelOverlay() :
 	nextOverlay( 0 ),
 	firstDeferredOverlay( 0 ),
 	nextDeferredOverlay( 0 ),
+	numDeferredOverlayJobs( 0 ),
 	numOverlayMaterials( 0 ),
 	index(-1),
 	demoSerialWrite(0),
@@ -77,6 +78,7 @@ void idRenderModelOverlay::ReUse()
 	nextOverlay = 0;
 	firstDeferredOverlay = 0;
 	nextDeferredOverlay = 0;
+	numDeferredOverlayJobs = 0;
 	numOverlayMaterials = 0;
 	demoSerialCurrent++;
 	
@@ -281,15 +283,20 @@ static void R_OverlayPointCullSkinned( byte* cullBits, halfFloat_t* texCoordS, h
 
 /*
 =====================
-idRenderModelOverlay::CreateOverlay
+R_ProjectOverlay
 
 This projects on both front and back sides to avoid seams
 The material should be clamped, because entire triangles are added, some of which
 may extend well past the 0.0 to 1.0 texture range
+
+Only writes to the job so it can run on any thread
 =====================
 */
-void idRenderModelOverlay::CreateOverlay( const idRenderModel* model, const idPlane localTextureAxis[2], const idMaterial* material )
+static void R_ProjectOverlay( overlayProjectionJob_t* job )
 {
+	const idRenderModel* model = job->model;
+	const idPlane* localTextureAxis = job->localTextureAxis;
+	
 	// count up the maximum possible vertices and indexes per surface
 	int maxVerts = 0;
 	int maxIndexes = 0;
@@ -423,12 +430,8 @@ void idRenderModelOverlay::CreateOverlay( const idRenderModel* model, const idPl
 			overlayIndexes[numIndexes + 2] = 0;
 		}
 		
-		demoSerialCurrent++;		
-
-		// allocate a new overlay
-		overlay_t& overlay = overlays[nextOverlay++ & ( MAX_OVERLAYS - 1 )];
-		FreeOverlay( overlay );
-		overlay.material = material;
+		overlay_t& overlay = job->overlays.Alloc();
+		overlay.material = job->material;
 		overlay.surfaceNum = surfNum;
 		overlay.surfaceId = surf->id;
 		overlay.numIndexes = numIndexes;
@@ -439,12 +442,51 @@ void idRenderModelOverlay::CreateOverlay( const idRenderModel* model, const idPl
 		memcpy( overlay.verts, overlayVerts.Ptr(), numVerts * sizeof( overlayVertex_t ) );
 		overlay.maxReferencedVertex = maxReferencedVertex;
 		overlay.writtenToDemo = false;
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_ProjectOverlay, "R_ProjectOverlay" );
+
+/*
+=====================
+idRenderModelOverlay::AddProjectedOverlays
+
+Takes over the overlays created by the job
+=====================
+*/
+void idRenderModelOverlay::AddProjectedOverlays( overlayProjectionJob_t& job )
+{
+	for( int i = 0; i < job.overlays.Num(); i++ )
+	{
+		demoSerialCurrent++;
+		
+		// allocate a new overlay
+		overlay_t& overlay = overlays[nextOverlay++ & ( MAX_OVERLAYS - 1 )];
+		FreeOverlay( overlay );
+		overlay = job.overlays[i];
 		
 		if( nextOverlay - firstOverlay > MAX_OVERLAYS )
 		{
 			firstOverlay = nextOverlay - MAX_OVERLAYS;
 		}
 	}
+	job.overlays.Clear();
+}
+
+/*
+=====================
+idRenderModelOverlay::CreateOverlay
+=====================
+*/
+void idRenderModelOverlay::CreateOverlay( const idRenderModel* model, const idPlane localTextureAxis[2], const idMaterial* material )
+{
+	overlayProjectionJob_t job;
+	job.model = model;
+	job.localTextureAxis = localTextureAxis;
+	job.material = material;
+	
+	R_ProjectOverlay( &job );
+	AddProjectedOverlays( job );
 }
 
 /*
@@ -466,6 +508,47 @@ void idRenderModelOverlay::CreateDeferredOverlays( const idRenderModel* model )
 	nextDeferredOverlay = 0;
 }
 
+/*
+====================
+idRenderModelOverlay::AddDeferredOverlayJobs
+====================
+*/
+void idRenderModelOverlay::AddDeferredOverlayJobs( const idRenderModel* model, idParallelJobList* jobList )
+{
+	numDeferredOverlayJobs = 0;
+	for( unsigned int i = firstDeferredOverlay; i < nextDeferredOverlay; i++ )
+	{
+		const overlayProjectionParms_t& parms = deferredOverlays[i & ( MAX_DEFERRED_OVERLAYS - 1 )];
+		if( parms.startTime > tr.viewDef->renderView.time[0] -  DEFFERED_OVERLAY_TIMEOUT )
+		{
+			overlayProjectionJob_t& job = deferredOverlayJobs[numDeferredOverlayJobs++];
+			job.model = model;
+			job.localTextureAxis = parms.localTextureAxis;
+			job.material = parms.material;
+			job.overlays.SetNum( 0 );
+			jobList->AddJob( ( jobRun_t )R_ProjectOverlay, &job );
+		}
+	}
+}
+
+/*
+====================
+idRenderModelOverlay::FinishDeferredOverlays
+
+Adds the overlays of the finished jobs in the order they were deferred
+====================
+*/
+void idRenderModelOverlay::FinishDeferredOverlays()
+{
+	for( unsigned int i = 0; i < numDeferredOverlayJobs; i++ )
+	{
+		AddProjectedOverlays( deferredOverlayJobs[i] );
+	}
+	numDeferredOverlayJobs = 0;
+	firstDeferredOverlay = 0;
+	nextDeferredOverlay = 0;
+}
+
 /*
 ====================
 idRenderModelOverlay::AddDeferredOverlay
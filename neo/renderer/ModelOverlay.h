@@ -45,6 +45,9 @@ If you have questions concerning this license or the applicable additional terms
 	one that receives lighting, because no interactions are generated
 	for these lightweight surfaces.
 
+	New overlays are deferred until the model is visible, the front end then
+	projects each of them on a separate job.
+
 ===============================================================================
 */
 
@@ -80,6 +83,16 @@ struct overlay_t
 	mutable bool		writtenToDemo;
 };
 
+// the overlays of a deferred projection, created on a front end job and
+// handed over to the model once all the jobs have finished
+struct overlayProjectionJob_t
+{
+	const idRenderModel* 		model;
+	const idPlane* 				localTextureAxis;
+	const idMaterial* 			material;
+	idList< overlay_t, TAG_MODEL >	overlays;
+};
+
 class idRenderModelOverlay
 {
 public:
@@ -91,6 +104,15 @@ public:
 	void						AddDeferredOverlay( const overlayProjectionParms_t& localParms );
 	void						CreateDeferredOverlays( const idRenderModel* model );
 	
+	// Adds a job for each deferred overlay, FinishDeferredOverlays adds the overlays once the jobs are done.
+	void						AddDeferredOverlayJobs( const idRenderModel* model, idParallelJobList* jobList );
+	void						FinishDeferredOverlays();
+	
+	bool						HasDeferredOverlays() const
+	{
+		return nextDeferredOverlay != firstDeferredOverlay;
+	}
+	
 	unsigned int				GetNumOverlayDrawSurfs();
 	struct drawSurf_t* 			CreateOverlayDrawSurf( const struct viewEntity_t* space, const idRenderModel* baseModel, unsigned int index );
 	
@@ -109,10 +131,14 @@ private:
 	unsigned int				firstDeferredOverlay;
 	unsigned int				nextDeferredOverlay;
 	
+	overlayProjectionJob_t		deferredOverlayJobs[MAX_DEFERRED_OVERLAYS];
+	unsigned int				numDeferredOverlayJobs;
+	
 	const idMaterial* 			overlayMaterials[MAX_OVERLAYS];
 	unsigned int				numOverlayMaterials;
 	
 	void						CreateOverlay( const idRenderModel* model, const idPlane localTextureAxis[2], const idMaterial* material );
+	void						AddProjectedOverlays( overlayProjectionJob_t& job );
 	void						FreeOverlay( overlay_t& overlay );
 };
 
@@ -35,6 +35,182 @@ If you have questions concerning this license or the applicable additional terms
 
 static const char* parametricParticle_SnapshotName = "_ParametricParticle_Snapshot_";
 
+idCVar r_useParticleBatches( "r_useParticleBatches", "1", CVAR_RENDERER | CVAR_BOOL, "create the particles of a stage in SIMD batches instead of one at a time" );
+idCVar r_verifyParticleBatches( "r_verifyParticleBatches", "0", CVAR_RENDERER | CVAR_BOOL, "compare the batched particles against the ones created one at a time and print the differences" );
+
+static const int PARTICLE_BATCH_SIZE = 64;
+
+/*
+====================
+R_VerifyParticleBatch
+
+Creates the particles again with idParticleStage::CreateParticle and compares
+the vertex streams, the quad corners are allowed to differ by float rounding.
+Returns false and prints the first difference if they don't match
+====================
+*/
+static bool R_VerifyParticleBatch( const idParticleStage* stage, const particleGen_t* gens, const int numGens, const idDrawVert* verts, const int numVerts )
+{
+	const float XYZ_EPSILON = 0.01f;
+	const float ST_EPSILON = 1e-5f;
+	
+	idTempArray<idDrawVert> refVerts( numGens * 4 * stage->NumQuadsPerParticle() );
+	
+	int numRefVerts = 0;
+	for( int i = 0; i < numGens; i++ )
+	{
+		particleGen_t g = gens[i];
+		numRefVerts += stage->CreateParticle( &g, refVerts.Ptr() + numRefVerts );
+	}
+	
+	if( numRefVerts != numVerts )
+	{
+		common->Printf( "R_VerifyParticleBatch: %s created %d verts instead of %d\n", stage->material->GetName(), numVerts, numRefVerts );
+		return false;
+	}
+	
+	for( int i = 0; i < numVerts; i++ )
+	{
+		const idDrawVert& a = verts[i];
+		const idDrawVert& b = refVerts[i];
+		
+		if( !a.xyz.Compare( b.xyz, XYZ_EPSILON ) || !a.GetTexCoord().Compare( b.GetTexCoord(), ST_EPSILON ) ||
+				a.color[0] != b.color[0] || a.color[1] != b.color[1] || a.color[2] != b.color[2] || a.color[3] != b.color[3] )
+		{
+			common->Printf( "R_VerifyParticleBatch: %s vert %d differs: (%s) (%s) instead of (%s) (%s)\n", stage->material->GetName(), i,
+							a.xyz.ToString(), a.GetTexCoord().ToString(), b.xyz.ToString(), b.GetTexCoord().ToString() );
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+====================
+R_CreateParticleBatch
+
+Returns the number of verts created, a particle that doesn't get drawn
+because it is faded out or beyond a kill region creates none
+====================
+*/
+static int R_CreateParticleBatch( const idParticleStage* stage, particleGen_t* gens, const int numGens, idDrawVert* verts )
+{
+	if( !r_useParticleBatches.GetBool() )
+	{
+		int numVerts = 0;
+		for( int i = 0; i < numGens; i++ )
+		{
+			numVerts += stage->CreateParticle( &gens[i], verts + numVerts );
+		}
+		return numVerts;
+	}
+	
+	if( !r_verifyParticleBatches.GetBool() )
+	{
+		return stage->CreateParticles( gens, numGens, verts );
+	}
+	
+	// the particles step their random generators, keep the inputs for the reference
+	particleGen_t refGens[PARTICLE_BATCH_SIZE];
+	memcpy( refGens, gens, numGens * sizeof( gens[0] ) );
+	
+	int numVerts = stage->CreateParticles( gens, numGens, verts );
+	R_VerifyParticleBatch( stage, refGens, numGens, verts, numVerts );
+	return numVerts;
+}
+
+/*
+====================
+testParticleBatches
+
+Runs every stage of every loaded particle decl through the batched and the
+one at a time path with fixed seeds, so both can be compared without a map
+====================
+*/
+CONSOLE_COMMAND( testParticleBatches, "compares the batched particles of all loaded particle decls against the ones created one at a time", 0 )
+{
+	renderEntity_t renderEntity;
+	memset( &renderEntity, 0, sizeof( renderEntity ) );
+	renderEntity.axis = mat3_identity;
+	for( int i = 0; i < 4; i++ )
+	{
+		renderEntity.shaderParms[i] = 1.0f;
+	}
+	
+	renderView_t renderView;
+	memset( &renderView, 0, sizeof( renderView ) );
+	renderView.viewaxis = mat3_identity;
+	
+	particleGen_t gens[PARTICLE_BATCH_SIZE];
+	particleGen_t refGens[PARTICLE_BATCH_SIZE];
+	
+	int numStages = 0;
+	int numBatches = 0;
+	int numFailed = 0;
+	
+	const int numDecls = declManager->GetNumDecls( DECL_PARTICLE );
+	for( int declNum = 0; declNum < numDecls; declNum++ )
+	{
+		const idDeclParticle* particleSystem = declManager->ParticleByIndex( declNum );
+		if( particleSystem == NULL )
+		{
+			continue;
+		}
+		
+		for( int stageNum = 0; stageNum < particleSystem->stages.Num(); stageNum++ )
+		{
+			const idParticleStage* stage = particleSystem->stages[stageNum];
+			if( !stage->material || stage->totalParticles <= 0 || stage->particleLife <= 0.0f )
+			{
+				continue;
+			}
+			numStages++;
+			
+			idTempArray<idDrawVert> verts( PARTICLE_BATCH_SIZE * 4 * stage->NumQuadsPerParticle() );
+			
+			for( int first = 0; first < stage->totalParticles; first += PARTICLE_BATCH_SIZE )
+			{
+				const int numGens = Min( stage->totalParticles - first, PARTICLE_BATCH_SIZE );
+				for( int i = 0; i < numGens; i++ )
+				{
+					particleGen_t& g = gens[i];
+					
+					g.renderEnt = &renderEntity;
+					g.renderView = &renderView;
+					g.origin.Zero();
+					g.axis.Identity();
+					g.index = first + i;
+					g.random.SetSeed( ( g.index << 10 ) & idRandom::MAX_RAND );
+					g.originalRandom = g.random;
+					g.frac = ( g.index + 0.5f ) / stage->totalParticles;
+					g.age = g.frac * stage->particleLife;
+				}
+				
+				// the particles step their random generators, keep the inputs for the reference
+				memcpy( refGens, gens, numGens * sizeof( gens[0] ) );
+				
+				const int numVerts = stage->CreateParticles( gens, numGens, verts.Ptr() );
+				numBatches++;
+				if( !R_VerifyParticleBatch( stage, refGens, numGens, verts.Ptr(), numVerts ) )
+				{
+					common->Printf( "%s stage %d particles %d-%d don't match\n", particleSystem->GetName(), stageNum, first, first + numGens - 1 );
+					numFailed++;
+				}
+			}
+		}
+	}
+	
+	common->Printf( "%d batches from %d stages in %d particle decls\n", numBatches, numStages, numDecls );
+	if( numFailed > 0 )
+	{
+		common->Printf( "[^1FAILED^0] %d batches differ from the particles created one at a time.\n", numFailed );
+	}
+	else
+	{
+		common->Printf( "[^2PASSED^0] batched particles match the ones created one at a time.\n" );
+	}
+}
+
 /*
 ====================
 idRenderModelPrt::idRenderModelPrt
@@ -119,12 +295,17 @@ idRenderModel* idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 		staticModel->InitEmpty( parametricParticle_SnapshotName );
 	}
 	
-	particleGen_t g;
+	particleGen_t gens[PARTICLE_BATCH_SIZE];
+	
+	for( int i = 0; i < PARTICLE_BATCH_SIZE; i++ )
+	{
+		gens[i].renderEnt = renderEntity;
+		gens[i].renderView = &viewDef->renderView;
+		gens[i].origin.Zero();
+		gens[i].axis.Identity();
+	}
 	
-	g.renderEnt = renderEntity;
-	g.renderView = &viewDef->renderView;
-	g.origin.Zero();
-	g.axis.Identity();
+	const renderView_t* renderView = &viewDef->renderView;
 	
 	for( int stageNum = 0; stageNum < particleSystem->stages.Num(); stageNum++ )
 	{
@@ -146,7 +327,7 @@ idRenderModel* idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 		
 		idRandom steppingRandom, steppingRandom2;
 		
-		int stageAge = g.renderView->time[renderEntity->timeGroup] + renderEntity->shaderParms[SHADERPARM_TIMEOFFSET] * 1000 - stage->timeOffset * 1000;
+		int stageAge = renderView->time[renderEntity->timeGroup] + renderEntity->shaderParms[SHADERPARM_TIMEOFFSET] * 1000 - stage->timeOffset * 1000;
 		int	stageCycle = stageAge / stage->cycleMsec;
 		
 		// some particles will be in this cycle, some will be in the previous cycle
@@ -174,10 +355,13 @@ idRenderModel* idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 		}
 		
 		int numVerts = 0;
+		int numGens = 0;
 		idDrawVert* verts = surf->geometry->verts;
 		
 		for( int index = 0; index < stage->totalParticles; index++ )
 		{
+			particleGen_t& g = gens[numGens];
+			
 			g.index = index;
 			
 			// bump the random
@@ -236,8 +420,15 @@ idRenderModel* idRenderModelPrt::InstantiateDynamicModel( const struct renderEnt
 			
 			g.age = g.frac * stage->particleLife;
 			
-			// if the particle doesn't get drawn because it is faded out or beyond a kill region, don't increment the verts
-			numVerts += stage->CreateParticle( &g, verts + numVerts );
+			if( ++numGens == PARTICLE_BATCH_SIZE )
+			{
+				numVerts += R_CreateParticleBatch( stage, gens, numGens, verts + numVerts );
+				numGens = 0;
+			}
+		}
+		if( numGens > 0 )
+		{
+			numVerts += R_CreateParticleBatch( stage, gens, numGens, verts + numVerts );
 		}
 		
 		// numVerts must be a multiple of 4
@@ -57,13 +57,14 @@ static void R_PerformanceCounters()
 	
 	if( r_showDynamic.GetBool() )
 	{
-		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
+		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i (cached:%i)\n",
 						tr.pc.c_entityDefCallbacks,
 						tr.pc.c_generateMd5,
 						tr.pc.c_deformedVerts,
 						tr.pc.c_deformedIndexes / 3,
 						tr.pc.c_tangentIndexes / 3,
-						tr.pc.c_guiSurfs
+						tr.pc.c_guiSurfs,
+						tr.pc.c_guiSurfsCached
 					  );
 	}
 	
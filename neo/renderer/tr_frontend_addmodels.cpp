@@ -37,6 +37,7 @@ idCVar r_skipStaticShadows( "r_skipStaticShadows", "0", CVAR_RENDERER | CVAR_BOO
 idCVar r_skipDynamicShadows( "r_skipDynamicShadows", "0", CVAR_RENDERER | CVAR_BOOL, "skip dynamic shadows" );
 idCVar r_useParallelAddModels( "r_useParallelAddModels", "1", CVAR_RENDERER | CVAR_BOOL, "add all models in parallel with jobs" );
 idCVar r_useParallelAddShadows( "r_useParallelAddShadows", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = off, 1 = threaded", 0, 1 );
+idCVar r_useParallelAddDecals( "r_useParallelAddDecals", "1", CVAR_RENDERER | CVAR_BOOL, "project new decals and overlays in parallel with jobs" );
 idCVar r_useShadowPreciseInsideTest( "r_useShadowPreciseInsideTest", "1", CVAR_RENDERER | CVAR_BOOL, "use a precise and more expensive test to determine whether the view is inside a shadow volume" );
 idCVar r_cullDynamicShadowTriangles( "r_cullDynamicShadowTriangles", "1", CVAR_RENDERER | CVAR_BOOL, "cull occluder triangles that are outside the light frustum so they do not contribute to the dynamic shadow volume" );
 idCVar r_cullDynamicLightTriangles( "r_cullDynamicLightTriangles", "1", CVAR_RENDERER | CVAR_BOOL, "cull surface triangles that are outside the light frustum so they do not get rendered for interactions" );
@@ -370,6 +371,7 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 	vEntity->drawSurfs = NULL;
 	vEntity->staticShadowVolumes = NULL;
 	vEntity->dynamicShadowVolumes = NULL;
+	vEntity->deferredProjectionModel = NULL;
 	
 	// globals we really should pass in...
 	const viewDef_t* viewDef = tr.viewDef;
@@ -514,7 +516,15 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 		
 		if( entityDef->decals != NULL && !r_skipDecals.GetBool() )
 		{
-			entityDef->decals->CreateDeferredDecals( model );
+			if( r_useParallelAddDecals.GetBool() && entityDef->decals->HasDeferredDecals() )
+			{
+				// project them on separate jobs once all models have been added
+				vEntity->deferredProjectionModel = model;
+			}
+			else
+			{
+				entityDef->decals->CreateDeferredDecals( model );
+			}
 			
 			unsigned int numDrawSurfs = entityDef->decals->GetNumDecalDrawSurfs();
 			for( unsigned int i = 0; i < numDrawSurfs; i++ )
@@ -531,7 +541,15 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 		
 		if( entityDef->overlays != NULL && !r_skipOverlays.GetBool() )
 		{
-			entityDef->overlays->CreateDeferredOverlays( model );
+			if( r_useParallelAddDecals.GetBool() && entityDef->overlays->HasDeferredOverlays() )
+			{
+				// project them on separate jobs once all models have been added
+				vEntity->deferredProjectionModel = model;
+			}
+			else
+			{
+				entityDef->overlays->CreateDeferredOverlays( model );
+			}
 			
 			unsigned int numDrawSurfs = entityDef->overlays->GetNumOverlayDrawSurfs();
 			for( unsigned int i = 0; i < numDrawSurfs; i++ )
@@ -1296,6 +1314,67 @@ void R_LinkDrawSurfToView( drawSurf_t* drawSurf, viewDef_t* viewDef )
 	viewDef->numDrawSurfs++;
 }
 
+/*
+===================
+R_AddDeferredProjections
+
+A single hit can project onto many area and entity models, each deferred
+decal and overlay is clipped to its model on a separate job instead of all
+of them running inside the R_AddSingleModel job of their model.
+===================
+*/
+static void R_AddDeferredProjections()
+{
+	int numModels = 0;
+	
+	for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+	{
+		const idRenderModel* model = vEntity->deferredProjectionModel;
+		if( model == NULL )
+		{
+			continue;
+		}
+		
+		idRenderEntityLocal* entityDef = vEntity->entityDef;
+		if( entityDef->decals != NULL && !r_skipDecals.GetBool() )
+		{
+			entityDef->decals->AddDeferredDecalJobs( model, tr.frontEndJobList );
+		}
+		if( entityDef->overlays != NULL && !r_skipOverlays.GetBool() )
+		{
+			entityDef->overlays->AddDeferredOverlayJobs( model, tr.frontEndJobList );
+		}
+		numModels++;
+	}
+	
+	if( numModels == 0 )
+	{
+		return;
+	}
+	
+	tr.frontEndJobList->Submit();
+	tr.frontEndJobList->Wait();
+	
+	for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+	{
+		if( vEntity->deferredProjectionModel == NULL )
+		{
+			continue;
+		}
+		
+		idRenderEntityLocal* entityDef = vEntity->entityDef;
+		if( entityDef->decals != NULL && !r_skipDecals.GetBool() )
+		{
+			entityDef->decals->FinishDeferredDecals();
+		}
+		if( entityDef->overlays != NULL && !r_skipOverlays.GetBool() )
+		{
+			entityDef->overlays->FinishDeferredOverlays();
+		}
+		vEntity->deferredProjectionModel = NULL;
+	}
+}
+
 /*
 ===================
 R_AddModels
@@ -1333,6 +1412,13 @@ void R_AddModels()
 		}
 	}
 	
+	//-------------------------------------------------
+	// Kick off a job for each deferred decal and overlay of the visible models.
+	// They are added to the models when all jobs are done and drawn from the
+	// next frame on.
+	//-------------------------------------------------
+	R_AddDeferredProjections();
+	
 	//-------------------------------------------------
 	// Kick off jobs to setup static and dynamic shadow volumes.
 	//-------------------------------------------------
@@ -179,9 +179,23 @@ static void R_RenderGuiSurf( idUserInterface* gui, const drawSurf_t* drawSurf )
 	
 	tr.guiRecursionLevel++;
 	
-	// call the gui, which will call the 2D drawing functions
+	// call the gui, which will call the 2D drawing functions, unless it
+	// did not change since its geometry was recorded
 	tr.guiModel->Clear();
-	gui->Redraw( tr.viewDef->renderView.time[0] );
+	const int drawKey = ( r_useCachedGuis.GetBool() && r_skipGuiShaders.GetInteger() == 0 ) ? gui->GetDrawCacheKey() : -1;
+	if( tr.guiModel->ReplayCache( gui, drawKey ) )
+	{
+		tr.pc.c_guiSurfsCached++;
+	}
+	else
+	{
+		const bool record = ( drawKey >= 0 ) && tr.guiModel->BeginCache( gui );
+		gui->Redraw( tr.viewDef->renderView.time[0] );
+		if( record )
+		{
+			tr.guiModel->EndCache( gui->GetDrawCacheKey() );
+		}
+	}
 	tr.guiModel->EmitToCurrentView( modelMatrix, drawSurf->space->weaponDepthHack );
 	tr.guiModel->Clear();
 	
@@ -460,6 +460,8 @@ Parms will typically be allocated with R_FrameAlloc
 */
 void R_RenderView( viewDef_t* parms )
 {
+	SCOPED_PROFILE_EVENT( "R_RenderView" );
+	
 	// save view in case we are a subview
 	viewDef_t* oldView = tr.viewDef;
 	
@@ -500,7 +502,10 @@ void R_RenderView( viewDef_t* parms )
 	static_cast<idRenderWorldLocal*>( parms->renderWorld )->FindViewLightsAndEntities();
 	
 	// wait for any shadow volume jobs from the previous frame to finish
-	tr.frontEndJobList->Wait();
+	{
+		SCOPED_PROFILE_EVENT( "Wait FrontEndJobs" );
+		tr.frontEndJobList->Wait();
+	}
 	
 	// make sure that interactions exist for all light / entity combinations that are visible
 	// add any pre-generated light shadows, and calculate the light shader values
@@ -388,6 +388,9 @@ struct viewEntity_t
 	// R_AddSingleModel will build a chain of parameters here to setup shadow volumes
 	staticShadowVolumeParms_t* 		staticShadowVolumes;
 	dynamicShadowVolumeParms_t* 	dynamicShadowVolumes;
+	
+	// R_AddSingleModel sets this when deferred decals or overlays have to be projected onto the model
+	const idRenderModel* 			deferredProjectionModel;
 };
 
 
@@ -667,6 +670,7 @@ struct performanceCounters_t
 	int		c_entityReferences;
 	int		c_lightReferences;
 	int		c_guiSurfs;
+	int		c_guiSurfsCached;	// gui surfaces that replayed their recorded geometry instead of redrawing
 	int		frontEndMicroSec;	// sum of time in all RE_RenderScene's in a frame
 };
 
@@ -974,6 +978,7 @@ extern idCVar r_useLightScissors;			// 1 = use custom scissor rectangle for each
 extern idCVar r_useEntityPortalCulling;		// 0 = none, 1 = box
 extern idCVar r_skipPrelightShadows;		// 1 = skip the dmap generated static shadow volumes
 extern idCVar r_useCachedDynamicModels;		// 1 = cache snapshots of dynamic models
+extern idCVar r_useCachedGuis;				// 1 = replay the recorded geometry of unchanged in-world guis
 extern idCVar r_useScissor;					// 1 = scissor clip as portals and lights are processed
 extern idCVar r_usePortals;					// 1 = use portals to perform area culling, otherwise draw everything
 extern idCVar r_useStateCaching;			// avoid redundant state changes in GL_*() calls
@@ -70,6 +70,7 @@ idSoundSample_OpenAL::idSoundSample_OpenAL()
 {
 	timestamp = FILE_NOT_FOUND_TIMESTAMP;
 	loaded = false;
+	pcmDecoded = false;
 	neverPurge = false;
 	levelLoadReferenced = false;
 	
@@ -158,35 +159,108 @@ bool idSoundSample_OpenAL::LoadGeneratedSample( const idStr& filename )
 	idFileLocal fileIn( fileSystem->OpenFileReadMemory( filename ) );
 	if( fileIn != NULL )
 	{
-		uint32 magic;
-		fileIn->ReadBig( magic );
-		fileIn->ReadBig( timestamp );
-		fileIn->ReadBig( loaded );
-		fileIn->ReadBig( playBegin );
-		fileIn->ReadBig( playLength );
-		idWaveFile::ReadWaveFormatDirect( format, fileIn );
-		int num;
-		fileIn->ReadBig( num );
-		amplitude.Clear();
-		amplitude.SetNum( num );
-		fileIn->Read( amplitude.Ptr(), amplitude.Num() );
-		fileIn->ReadBig( totalBufferSize );
-		fileIn->ReadBig( num );
-		buffers.SetNum( num );
-		for( int i = 0; i < num; i++ )
-		{
-			fileIn->ReadBig( buffers[ i ].numSamples );
-			fileIn->ReadBig( buffers[ i ].bufferSize );
-			buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
-			fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
-			buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
-		}
-		return true;
+		return LoadGeneratedSample( fileIn );
 	}
 #endif
 	
 	return false;
 }
+
+/*
+========================
+idSoundSample_OpenAL::LoadGeneratedSample
+
+Only reads from fileIn, so the level load pipeline can run it off the main thread
+========================
+*/
+bool idSoundSample_OpenAL::LoadGeneratedSample( idFile* fileIn )
+{
+	uint32 magic;
+	fileIn->ReadBig( magic );
+	fileIn->ReadBig( timestamp );
+	fileIn->ReadBig( loaded );
+	fileIn->ReadBig( playBegin );
+	fileIn->ReadBig( playLength );
+	idWaveFile::ReadWaveFormatDirect( format, fileIn );
+	int num;
+	fileIn->ReadBig( num );
+	amplitude.Clear();
+	amplitude.SetNum( num );
+	fileIn->Read( amplitude.Ptr(), amplitude.Num() );
+	fileIn->ReadBig( totalBufferSize );
+	fileIn->ReadBig( num );
+	buffers.SetNum( num );
+	for( int i = 0; i < num; i++ )
+	{
+		fileIn->ReadBig( buffers[ i ].numSamples );
+		fileIn->ReadBig( buffers[ i ].bufferSize );
+		buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
+		fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
+		buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
+	}
+	return true;
+}
+
+/*
+========================
+idSoundSample_OpenAL::DecodeSampleData
+
+Converts ADPCM data to the PCM OpenAL is fed with. Safe to call from any thread,
+CreateOpenALBuffer does it itself if nobody did before. Returns false if the
+data could not be decoded, the caller decides how to report it.
+========================
+*/
+bool idSoundSample_OpenAL::DecodeSampleData()
+{
+	if( format.basic.formatTag != idWaveFile::FORMAT_ADPCM || pcmDecoded )
+	{
+		return true;
+	}
+	
+	// RB: decode idWaveFile::FORMAT_ADPCM to idWaveFile::FORMAT_PCM
+	
+	void* buffer = buffers[0].buffer;
+	uint32 bufferSize = buffers[0].bufferSize;
+	
+	if( MS_ADPCM_decode( ( uint8** ) &buffer, &bufferSize ) < 0 )
+	{
+		return false;
+	}
+	
+	buffers[0].buffer = buffer;
+	buffers[0].bufferSize = bufferSize;
+	
+	totalBufferSize = bufferSize;
+	pcmDecoded = true;
+	return true;
+}
+
+/*
+========================
+idSoundSample_OpenAL::FinishGeneratedSample
+
+Main thread part of a sample loaded by the level load pipeline, takes over
+the buffers the pipeline loaded into staged
+========================
+*/
+void idSoundSample_OpenAL::FinishGeneratedSample( idSoundSample_OpenAL& staged )
+{
+	FreeData();
+	
+	timestamp = staged.timestamp;
+	playBegin = staged.playBegin;
+	playLength = staged.playLength;
+	format = staged.format;
+	totalBufferSize = staged.totalBufferSize;
+	pcmDecoded = staged.pcmDecoded;
+	amplitude.Swap( staged.amplitude );
+	buffers.Swap( staged.buffers );
+	loaded = true;
+	
+	// upload PCM data to OpenAL
+	CreateOpenALBuffer();
+}
+
 /*
 ========================
 idSoundSample_OpenAL::Load
@@ -297,20 +371,13 @@ void idSoundSample_OpenAL::CreateOpenALBuffer()
 		
 		if( format.basic.formatTag == idWaveFile::FORMAT_ADPCM )
 		{
-			// RB: decode idWaveFile::FORMAT_ADPCM to idWaveFile::FORMAT_PCM
-			
-			buffer = buffers[0].buffer;
-			bufferSize = buffers[0].bufferSize;
-			
-			if( MS_ADPCM_decode( ( uint8** ) &buffer, &bufferSize ) < 0 )
+			if( !DecodeSampleData() )
 			{
 				common->Error( "idSoundSample_OpenAL::CreateOpenALBuffer: could not decode ADPCM '%s' to 16 bit format", GetName() );
 			}
 			
-			buffers[0].buffer = buffer;
-			buffers[0].bufferSize = bufferSize;
-			
-			totalBufferSize = bufferSize;
+			buffer = buffers[0].buffer;
+			bufferSize = buffers[0].bufferSize;
 		}
 		else if( format.basic.formatTag == idWaveFile::FORMAT_XMA2 )
 		{
@@ -622,6 +689,7 @@ void idSoundSample_OpenAL::FreeData()
 	timestamp = FILE_NOT_FOUND_TIMESTAMP;
 	memset( &format, 0, sizeof( format ) );
 	loaded = false;
+	pcmDecoded = false;
 	totalBufferSize = 0;
 	playBegin = 0;
 	playLength = 0;
@@ -1030,7 +1098,8 @@ int32 idSoundSample_OpenAL::MS_ADPCM_nibble( MS_ADPCM_decodeState_t* state, int8
 
 int idSoundSample_OpenAL::MS_ADPCM_decode( uint8** audio_buf, uint32* audio_len )
 {
-	static MS_ADPCM_decodeState_t	states[2];
+	// not static, the level load pipeline decodes samples on several threads at once
+	MS_ADPCM_decodeState_t			states[2];
 	MS_ADPCM_decodeState_t*			state[2];
 	
 	uint8* freeable, *encoded, *decoded;
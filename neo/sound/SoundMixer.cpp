@@ -0,0 +1,861 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+
+#include "snd_local.h"
+#include "SoundMixer.h"
+
+idCVar s_mixerBenchmarkWave( "s_mixerBenchmarkWave", "", CVAR_SOUND, "if set, s_mixerBenchmark also writes the mixed output to this .wav file" );
+
+static const float PCM16_TO_FLOAT = 1.0f / 32768.0f;
+static const float FRACTION_TO_FLOAT = 1.0f / 65536.0f;
+
+/*
+================================================================================================
+
+	idSoundMixerSink_Null
+
+================================================================================================
+*/
+
+/*
+========================
+idSoundMixerSink_Null::Write
+========================
+*/
+void idSoundMixerSink_Null::Write( const float* frames, int numFrames, int numChannels )
+{
+	for( int i = 0; i < numFrames * numChannels; i++ )
+	{
+		peak = Max( peak, idMath::Fabs( frames[i] ) );
+	}
+	framesWritten += numFrames;
+}
+
+/*
+================================================================================================
+
+	idSoundMixerSink_Wave
+
+================================================================================================
+*/
+
+/*
+========================
+idSoundMixerSink_Wave::idSoundMixerSink_Wave
+========================
+*/
+idSoundMixerSink_Wave::idSoundMixerSink_Wave() :
+	file( NULL ),
+	sampleRate( 0 ),
+	numChannels( 0 ),
+	dataSize( 0 )
+{
+}
+
+/*
+========================
+idSoundMixerSink_Wave::~idSoundMixerSink_Wave
+========================
+*/
+idSoundMixerSink_Wave::~idSoundMixerSink_Wave()
+{
+	Close();
+}
+
+/*
+========================
+idSoundMixerSink_Wave::Open
+========================
+*/
+bool idSoundMixerSink_Wave::Open( const char* fileName, int sampleRate_, int numChannels_ )
+{
+	Close();
+	
+	file = fileSystem->OpenFileWrite( fileName );
+	if( file == NULL )
+	{
+		idLib::Warning( "idSoundMixerSink_Wave: couldn't open %s", fileName );
+		return false;
+	}
+	sampleRate = sampleRate_;
+	numChannels = numChannels_;
+	dataSize = 0;
+	
+	// the sizes are patched when the file is closed
+	WriteHeader();
+	return true;
+}
+
+/*
+========================
+idSoundMixerSink_Wave::WriteHeader
+========================
+*/
+void idSoundMixerSink_Wave::WriteHeader()
+{
+	const int blockSize = numChannels * sizeof( int16 );
+	
+	file->Write( "RIFF", 4 );
+	file->WriteUnsignedInt( 36 + dataSize );
+	file->Write( "WAVE", 4 );
+	
+	file->Write( "fmt ", 4 );
+	file->WriteUnsignedInt( 16 );
+	file->WriteUnsignedShort( idWaveFile::FORMAT_PCM );
+	file->WriteUnsignedShort( numChannels );
+	file->WriteUnsignedInt( sampleRate );
+	file->WriteUnsignedInt( sampleRate * blockSize );
+	file->WriteUnsignedShort( blockSize );
+	file->WriteUnsignedShort( 16 );
+	
+	file->Write( "data", 4 );
+	file->WriteUnsignedInt( dataSize );
+}
+
+/*
+========================
+idSoundMixerSink_Wave::Close
+========================
+*/
+void idSoundMixerSink_Wave::Close()
+{
+	if( file == NULL )
+	{
+		return;
+	}
+	file->Seek( 0, FS_SEEK_SET );
+	WriteHeader();
+	
+	delete file;
+	file = NULL;
+}
+
+/*
+========================
+idSoundMixerSink_Wave::Write
+========================
+*/
+void idSoundMixerSink_Wave::Write( const float* frames, int numFrames, int numChannels_ )
+{
+	if( file == NULL )
+	{
+		return;
+	}
+	assert( numChannels_ == numChannels );
+	
+	const int numSamples = numFrames * numChannels;
+	convertBuffer.SetNum( numSamples );
+	int16* dest = convertBuffer.Ptr();
+	
+	int i = 0;
+	const __m128 scale = _mm_set1_ps( 32767.0f );
+	for( ; i + 8 <= numSamples; i += 8 )
+	{
+		// _mm_packs_epi32 saturates, so out of range output clips instead of wrapping
+		__m128i a = _mm_cvtps_epi32( _mm_mul_ps( _mm_loadu_ps( frames + i + 0 ), scale ) );
+		__m128i b = _mm_cvtps_epi32( _mm_mul_ps( _mm_loadu_ps( frames + i + 4 ), scale ) );
+		_mm_storeu_si128( ( __m128i* )( dest + i ), _mm_packs_epi32( a, b ) );
+	}
+	for( ; i < numSamples; i++ )
+	{
+		dest[i] = idMath::ClampShort( idMath::Ftoi( frames[i] * 32767.0f ) );
+	}
+	
+	const int numBytes = numSamples * sizeof( int16 );
+	file->Write( dest, numBytes );
+	dataSize += numBytes;
+}
+
+/*
+================================================================================================
+
+	idSoundMixer
+
+================================================================================================
+*/
+
+/*
+========================
+idSoundMixer::idSoundMixer
+========================
+*/
+idSoundMixer::idSoundMixer() :
+	sampleRate( 0 ),
+	useSIMD( true ),
+	sink( NULL ),
+	mixBuffer( NULL )
+{
+	memset( voices, 0, sizeof( voices ) );
+}
+
+/*
+========================
+idSoundMixer::~idSoundMixer
+========================
+*/
+idSoundMixer::~idSoundMixer()
+{
+	Shutdown();
+}
+
+/*
+========================
+idSoundMixer::Init
+========================
+*/
+void idSoundMixer::Init( int sampleRate_, idSoundMixerSink* sink_ )
+{
+	Shutdown();
+	
+	sampleRate = sampleRate_;
+	sink = sink_;
+	mixBuffer = ( float* )Mem_Alloc16( MIX_BLOCK_FRAMES * OUTPUT_CHANNELS * sizeof( float ), TAG_AUDIO );
+	memset( voices, 0, sizeof( voices ) );
+}
+
+/*
+========================
+idSoundMixer::Shutdown
+========================
+*/
+void idSoundMixer::Shutdown()
+{
+	if( mixBuffer != NULL )
+	{
+		Mem_Free16( mixBuffer );
+		mixBuffer = NULL;
+	}
+	memset( voices, 0, sizeof( voices ) );
+	sink = NULL;
+}
+
+/*
+========================
+idSoundMixer::AllocVoice
+========================
+*/
+int idSoundMixer::AllocVoice()
+{
+	for( int i = 0; i < MAX_VOICES; i++ )
+	{
+		if( !voices[i].allocated )
+		{
+			memset( &voices[i], 0, sizeof( voices[i] ) );
+			voices[i].allocated = true;
+			voices[i].pitch = 1.0f;
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+========================
+idSoundMixer::FreeVoice
+========================
+*/
+void idSoundMixer::FreeVoice( int voice )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	voices[voice].allocated = false;
+	voices[voice].playing = false;
+}
+
+/*
+========================
+idSoundMixer::UpdateStep
+========================
+*/
+void idSoundMixer::UpdateStep( mixerVoice_t& voice )
+{
+	if( voice.sampleRate <= 0 || sampleRate <= 0 )
+	{
+		voice.step = 1 << 16;
+		return;
+	}
+	const float ratio = idMath::ClampFloat( 1.0f / 65536.0f, ( float )MAX_PITCH, voice.pitch * voice.sampleRate / sampleRate );
+	voice.step = Max( 1, idMath::Ftoi( ratio * 65536.0f ) );
+}
+
+/*
+========================
+idSoundMixer::SetVoiceSource
+========================
+*/
+void idSoundMixer::SetVoiceSource( int voice, const int16* samples, int numFrames, int numChannels, int voiceSampleRate, bool looping )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	assert( numChannels == 1 || numChannels == 2 );
+	
+	mixerVoice_t& v = voices[voice];
+	v.samples = samples;
+	v.numFrames = numFrames;
+	v.numChannels = numChannels;
+	v.sampleRate = voiceSampleRate;
+	v.looping = looping;
+	v.loopSamples = NULL;
+	v.loopNumFrames = 0;
+	v.position = 0;
+	v.fraction = 0;
+	UpdateStep( v );
+}
+
+/*
+========================
+idSoundMixer::SetVoiceLoop
+========================
+*/
+void idSoundMixer::SetVoiceLoop( int voice, const int16* samples, int numFrames )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	mixerVoice_t& v = voices[voice];
+	v.loopSamples = ( numFrames > 0 ) ? samples : NULL;
+	v.loopNumFrames = numFrames;
+}
+
+/*
+========================
+idSoundMixer::SetVoicePosition
+========================
+*/
+void idSoundMixer::SetVoicePosition( int voice, int frame )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	mixerVoice_t& v = voices[voice];
+	v.position = Max( frame, 0 );
+	v.fraction = 0;
+	WrapPosition( v );
+}
+
+/*
+========================
+idSoundMixer::SetVoiceVolume
+========================
+*/
+void idSoundMixer::SetVoiceVolume( int voice, float left, float right )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	mixerVoice_t& v = voices[voice];
+	v.targetGain[0] = left;
+	v.targetGain[1] = right;
+	if( !v.playing )
+	{
+		// don't ramp in from whatever the voice was set to before it started
+		v.gain[0] = left;
+		v.gain[1] = right;
+	}
+}
+
+/*
+========================
+idSoundMixer::SetVoicePitch
+========================
+*/
+void idSoundMixer::SetVoicePitch( int voice, float pitch )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	voices[voice].pitch = pitch;
+	UpdateStep( voices[voice] );
+}
+
+/*
+========================
+idSoundMixer::StartVoice
+========================
+*/
+void idSoundMixer::StartVoice( int voice )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	mixerVoice_t& v = voices[voice];
+	// a voice that played to its end stays stopped
+	v.playing = ( v.samples != NULL && v.position < v.numFrames );
+}
+
+/*
+========================
+idSoundMixer::StopVoice
+========================
+*/
+void idSoundMixer::StopVoice( int voice )
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	voices[voice].playing = false;
+}
+
+/*
+========================
+idSoundMixer::IsVoicePlaying
+========================
+*/
+bool idSoundMixer::IsVoicePlaying( int voice ) const
+{
+	assert( voice >= 0 && voice < MAX_VOICES );
+	return voices[voice].playing;
+}
+
+/*
+========================
+idSoundMixer::GetNumPlayingVoices
+========================
+*/
+int idSoundMixer::GetNumPlayingVoices() const
+{
+	int num = 0;
+	for( int i = 0; i < MAX_VOICES; i++ )
+	{
+		num += voices[i].playing ? 1 : 0;
+	}
+	return num;
+}
+
+/*
+========================
+idSoundMixer::Mix
+========================
+*/
+void idSoundMixer::Mix( int numFrames )
+{
+	if( mixBuffer == NULL )
+	{
+		return;
+	}
+	while( numFrames > 0 )
+	{
+		const int blockFrames = Min( numFrames, MIX_BLOCK_FRAMES );
+		memset( mixBuffer, 0, blockFrames * OUTPUT_CHANNELS * sizeof( float ) );
+		MixBlock( mixBuffer, blockFrames );
+		if( sink != NULL )
+		{
+			sink->Write( mixBuffer, blockFrames, OUTPUT_CHANNELS );
+		}
+		numFrames -= blockFrames;
+	}
+}
+
+/*
+========================
+idSoundMixer::MixBlock
+========================
+*/
+void idSoundMixer::MixBlock( float* dest, int numFrames )
+{
+	for( int i = 0; i < MAX_VOICES; i++ )
+	{
+		if( voices[i].playing )
+		{
+			MixVoice( voices[i], dest, numFrames );
+		}
+	}
+}
+
+/*
+========================
+idSoundMixer::SafeFrames
+
+Returns how many of the next numFrames output frames can be resampled without reading past the end of the source
+========================
+*/
+int idSoundMixer::SafeFrames( const mixerVoice_t& voice, int numFrames ) const
+{
+	// output frame k reads source frames position + ( ( fraction + k * step ) >> 16 ) and the one after it
+	const int64 limit = ( ( int64 )( voice.numFrames - 1 - voice.position ) << 16 ) - voice.fraction;
+	if( limit <= 0 )
+	{
+		return 0;
+	}
+	const int64 safe = ( limit + voice.step - 1 ) / voice.step;
+	return ( int )Min( safe, ( int64 )numFrames );
+}
+
+/*
+========================
+idSoundMixer::MixVoice
+========================
+*/
+void idSoundMixer::MixVoice( mixerVoice_t& voice, float* dest, int numFrames )
+{
+	float gainL = voice.gain[0];
+	float gainR = voice.gain[1];
+	const float stepL = ( voice.targetGain[0] - gainL ) / numFrames;
+	const float stepR = ( voice.targetGain[1] - gainR ) / numFrames;
+	voice.gain[0] = voice.targetGain[0];
+	voice.gain[1] = voice.targetGain[1];
+	
+	int done = 0;
+	while( done < numFrames && voice.playing )
+	{
+		const int safe = SafeFrames( voice, numFrames - done );
+		
+		int count;
+		if( useSIMD && safe >= 4 )
+		{
+			count = safe & ~3;
+			MixVoiceSIMD( voice, dest + done * OUTPUT_CHANNELS, count, gainL, gainR, stepL, stepR );
+			WrapPosition( voice );
+		}
+		else
+		{
+			// the frame on the end of the source wraps or fades out, which only the generic path handles
+			count = Max( safe, 1 );
+			MixVoiceGeneric( voice, dest + done * OUTPUT_CHANNELS, count, gainL, gainR, stepL, stepR );
+		}
+		gainL += stepL * count;
+		gainR += stepR * count;
+		done += count;
+	}
+}
+
+/*
+========================
+idSoundMixer::WrapPosition
+
+Loops the voice back to the start, moves it on to its loop source or stops it once it steps past the end of the source
+========================
+*/
+void idSoundMixer::WrapPosition( mixerVoice_t& voice )
+{
+	while( voice.position >= voice.numFrames )
+	{
+		voice.position -= voice.numFrames;
+		if( !voice.looping )
+		{
+			if( voice.loopSamples == NULL )
+			{
+				voice.position += voice.numFrames;
+				voice.playing = false;
+				return;
+			}
+			voice.samples = voice.loopSamples;
+			voice.numFrames = voice.loopNumFrames;
+			voice.looping = true;
+		}
+	}
+}
+
+/*
+========================
+idSoundMixer::MixVoiceGeneric
+========================
+*/
+void idSoundMixer::MixVoiceGeneric( mixerVoice_t& voice, float* dest, int numFrames, float gainL, float gainR, float stepL, float stepR )
+{
+	const int channels = voice.numChannels;
+	
+	for( int i = 0; i < numFrames && voice.playing; i++ )
+	{
+		// WrapPosition may have moved the voice on to its loop source
+		const int16* samples = voice.samples;
+		const int p0 = voice.position;
+		int p1 = p0 + 1;
+		const int16* next = samples;
+		if( p1 >= voice.numFrames )
+		{
+			p1 = 0;
+			next = voice.looping ? samples : voice.loopSamples;
+		}
+		const float f = voice.fraction * FRACTION_TO_FLOAT;
+		
+		const float l0 = samples[p0 * channels];
+		const float l1 = ( next != NULL ) ? next[p1 * channels] : 0.0f;
+		const float left = ( l0 + ( l1 - l0 ) * f ) * PCM16_TO_FLOAT;
+		
+		float right = left;
+		if( channels == 2 )
+		{
+			const float r0 = samples[p0 * 2 + 1];
+			const float r1 = ( next != NULL ) ? next[p1 * 2 + 1] : 0.0f;
+			right = ( r0 + ( r1 - r0 ) * f ) * PCM16_TO_FLOAT;
+		}
+		
+		dest[i * 2 + 0] += left * gainL;
+		dest[i * 2 + 1] += right * gainR;
+		gainL += stepL;
+		gainR += stepR;
+		
+		const uint32 offset = voice.fraction + voice.step;
+		voice.position += offset >> 16;
+		voice.fraction = offset & 0xFFFF;
+		WrapPosition( voice );
+	}
+}
+
+/*
+========================
+idSoundMixer::MixVoiceSIMD
+
+numFrames has to be a multiple of 4 and all frames have to be inside the source, see SafeFrames
+========================
+*/
+void idSoundMixer::MixVoiceSIMD( mixerVoice_t& voice, float* dest, int numFrames, float gainL, float gainR, float stepL, float stepR )
+{
+	assert( ( numFrames & 3 ) == 0 );
+	
+	const __m128 pcmScale = _mm_set1_ps( PCM16_TO_FLOAT );
+	__m128 vGainL = _mm_setr_ps( gainL, gainL + stepL, gainL + stepL * 2.0f, gainL + stepL * 3.0f );
+	__m128 vGainR = _mm_setr_ps( gainR, gainR + stepR, gainR + stepR * 2.0f, gainR + stepR * 3.0f );
+	const __m128 vStepL = _mm_set1_ps( stepL * 4.0f );
+	const __m128 vStepR = _mm_set1_ps( stepR * 4.0f );
+	
+	const int16* samples = voice.samples;
+	
+	if( voice.step == ( 1 << 16 ) && voice.fraction == 0 )
+	{
+		// source and output rate match, so the samples are converted directly without interpolation
+		const int16* src = samples + voice.position * voice.numChannels;
+		if( voice.numChannels == 1 )
+		{
+			for( int i = 0; i < numFrames; i += 4 )
+			{
+				__m128i s = _mm_loadl_epi64( ( const __m128i* )( src + i ) );
+				s = _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 );
+				const __m128 m = _mm_mul_ps( _mm_cvtepi32_ps( s ), pcmScale );
+				
+				const __m128 left = _mm_mul_ps( m, vGainL );
+				const __m128 right = _mm_mul_ps( m, vGainR );
+				float* d = dest + i * 2;
+				_mm_storeu_ps( d + 0, _mm_add_ps( _mm_loadu_ps( d + 0 ), _mm_unpacklo_ps( left, right ) ) );
+				_mm_storeu_ps( d + 4, _mm_add_ps( _mm_loadu_ps( d + 4 ), _mm_unpackhi_ps( left, right ) ) );
+				
+				vGainL = _mm_add_ps( vGainL, vStepL );
+				vGainR = _mm_add_ps( vGainR, vStepR );
+			}
+		}
+		else
+		{
+			for( int i = 0; i < numFrames; i += 4 )
+			{
+				const __m128i s = _mm_loadu_si128( ( const __m128i* )( src + i * 2 ) );
+				const __m128 lr01 = _mm_mul_ps( _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) ), pcmScale );
+				const __m128 lr23 = _mm_mul_ps( _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) ), pcmScale );
+				
+				float* d = dest + i * 2;
+				_mm_storeu_ps( d + 0, _mm_add_ps( _mm_loadu_ps( d + 0 ), _mm_mul_ps( lr01, _mm_unpacklo_ps( vGainL, vGainR ) ) ) );
+				_mm_storeu_ps( d + 4, _mm_add_ps( _mm_loadu_ps( d + 4 ), _mm_mul_ps( lr23, _mm_unpackhi_ps( vGainL, vGainR ) ) ) );
+				
+				vGainL = _mm_add_ps( vGainL, vStepL );
+				vGainR = _mm_add_ps( vGainR, vStepR );
+			}
+		}
+		voice.position += numFrames;
+		return;
+	}
+	
+	// linear interpolation, SSE2 has no gather so each output frame fetches the two source frames
+	// it interpolates between with a single 32 (mono) or 64 (stereo) bit load
+	const int16* base = samples + voice.position * voice.numChannels;
+	const uint32 step = voice.step;
+	uint32 offset = voice.fraction;
+	
+	const __m128 fractionScale = _mm_set1_ps( FRACTION_TO_FLOAT );
+	const __m128i fractionMask = _mm_set1_epi32( 0xFFFF );
+	__m128i vOffset = _mm_setr_epi32( offset, offset + step, offset + step * 2, offset + step * 3 );
+	const __m128i vStep = _mm_set1_epi32( step * 4 );
+	
+	for( int i = 0; i < numFrames; i += 4, offset += step * 4 )
+	{
+		const uint32 i0 = ( offset ) >> 16;
+		const uint32 i1 = ( offset + step ) >> 16;
+		const uint32 i2 = ( offset + step * 2 ) >> 16;
+		const uint32 i3 = ( offset + step * 3 ) >> 16;
+		
+		const __m128 f = _mm_mul_ps( _mm_cvtepi32_ps( _mm_and_si128( vOffset, fractionMask ) ), fractionScale );
+		vOffset = _mm_add_epi32( vOffset, vStep );
+		
+		float* d = dest + i * 2;
+		if( voice.numChannels == 1 )
+		{
+			const __m128i pairs = _mm_setr_epi32( *( const int32* )( base + i0 ), *( const int32* )( base + i1 ), *( const int32* )( base + i2 ), *( const int32* )( base + i3 ) );
+			const __m128 a = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_slli_epi32( pairs, 16 ), 16 ) );
+			const __m128 b = _mm_cvtepi32_ps( _mm_srai_epi32( pairs, 16 ) );
+			const __m128 m = _mm_mul_ps( _mm_add_ps( a, _mm_mul_ps( _mm_sub_ps( b, a ), f ) ), pcmScale );
+			
+			const __m128 left = _mm_mul_ps( m, vGainL );
+			const __m128 right = _mm_mul_ps( m, vGainR );
+			_mm_storeu_ps( d + 0, _mm_add_ps( _mm_loadu_ps( d + 0 ), _mm_unpacklo_ps( left, right ) ) );
+			_mm_storeu_ps( d + 4, _mm_add_ps( _mm_loadu_ps( d + 4 ), _mm_unpackhi_ps( left, right ) ) );
+		}
+		else
+		{
+			// each load holds L0 R0 L1 R1 of one output frame, shuffle them into LR pairs of the first and second source frame
+			const __m128 q01 = _mm_castsi128_ps( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )( base + i0 * 2 ) ), _mm_loadl_epi64( ( const __m128i* )( base + i1 * 2 ) ) ) );
+			const __m128 q23 = _mm_castsi128_ps( _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )( base + i2 * 2 ) ), _mm_loadl_epi64( ( const __m128i* )( base + i3 * 2 ) ) ) );
+			const __m128i first = _mm_castps_si128( _mm_shuffle_ps( q01, q23, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+			const __m128i second = _mm_castps_si128( _mm_shuffle_ps( q01, q23, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+			
+			const __m128 a01 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( first, first ), 16 ) );
+			const __m128 a23 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( first, first ), 16 ) );
+			const __m128 b01 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( second, second ), 16 ) );
+			const __m128 b23 = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( second, second ), 16 ) );
+			
+			const __m128 lr01 = _mm_mul_ps( _mm_add_ps( a01, _mm_mul_ps( _mm_sub_ps( b01, a01 ), _mm_unpacklo_ps( f, f ) ) ), pcmScale );
+			const __m128 lr23 = _mm_mul_ps( _mm_add_ps( a23, _mm_mul_ps( _mm_sub_ps( b23, a23 ), _mm_unpackhi_ps( f, f ) ) ), pcmScale );
+			_mm_storeu_ps( d + 0, _mm_add_ps( _mm_loadu_ps( d + 0 ), _mm_mul_ps( lr01, _mm_unpacklo_ps( vGainL, vGainR ) ) ) );
+			_mm_storeu_ps( d + 4, _mm_add_ps( _mm_loadu_ps( d + 4 ), _mm_mul_ps( lr23, _mm_unpackhi_ps( vGainL, vGainR ) ) ) );
+		}
+		
+		vGainL = _mm_add_ps( vGainL, vStepL );
+		vGainR = _mm_add_ps( vGainR, vStepR );
+	}
+	
+	voice.position += offset >> 16;
+	voice.fraction = offset & 0xFFFF;
+}
+
+/*
+================================================================================================
+
+	Benchmark
+
+================================================================================================
+*/
+
+/*
+========================
+MixerBenchmarkRun
+========================
+*/
+static int64 MixerBenchmarkRun( idSoundMixer& mixer, const idList< int16, TAG_AUDIO >* sources, const int* sourceRates, const int* sourceChannels, int numSources, int numVoices, int numFrames, bool useSIMD )
+{
+	idRandom rand( 0 );
+	
+	mixer.SetUseSIMD( useSIMD );
+	for( int i = 0; i < numVoices; i++ )
+	{
+		const int voice = mixer.AllocVoice();
+		const int source = i % numSources;
+		const int channels = sourceChannels[source];
+		mixer.SetVoiceSource( voice, sources[source].Ptr(), sources[source].Num() / channels, channels, sourceRates[source], true );
+		
+		// every other round through the sources plays at a random pitch, so each source
+		// is mixed both at its native pitch and resampled
+		if( ( i / numSources ) & 1 )
+		{
+			mixer.SetVoicePitch( voice, 0.8f + rand.RandomFloat() * 0.4f );
+		}
+		const float pan = rand.RandomFloat();
+		const float volume = 0.5f / numVoices;
+		mixer.SetVoiceVolume( voice, volume * ( 1.0f - pan ), volume * pan );
+		mixer.StartVoice( voice );
+	}
+	
+	const int64 start = Sys_Microseconds();
+	for( int done = 0; done < numFrames; done += idSoundMixer::MIX_BLOCK_FRAMES )
+	{
+		// move the voices around a little so the volume ramps are exercised too
+		for( int i = 0; i < numVoices; i += 7 )
+		{
+			const float pan = rand.RandomFloat();
+			const float volume = 0.5f / numVoices;
+			mixer.SetVoiceVolume( i, volume * ( 1.0f - pan ), volume * pan );
+		}
+		mixer.Mix( Min( idSoundMixer::MIX_BLOCK_FRAMES, numFrames - done ) );
+	}
+	const int64 end = Sys_Microseconds();
+	
+	for( int i = 0; i < numVoices; i++ )
+	{
+		mixer.FreeVoice( i );
+	}
+	return end - start;
+}
+
+/*
+========================
+s_mixerBenchmark
+========================
+*/
+CONSOLE_COMMAND( s_mixerBenchmark, "mixes synthetic voices with the software mixer into a null sink, usage: s_mixerBenchmark [voices] [seconds]", 0 )
+{
+	const int numVoices = idMath::ClampInt( 1, idSoundMixer::MAX_VOICES, ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 256 );
+	const float seconds = idMath::ClampFloat( 0.1f, 600.0f, ( args.Argc() > 2 ) ? atof( args.Argv( 2 ) ) : 10.0f );
+	
+	const int outputRate = 48000;
+	const int numFrames = idMath::Ftoi( seconds * outputRate );
+	
+	// a mix of native rate and resampled, mono and stereo sources
+	static const int numSources = 4;
+	const int sourceRates[numSources] = { 48000, 22050, 48000, 44100 };
+	const int sourceChannels[numSources] = { 1, 1, 2, 2 };
+	idList< int16, TAG_AUDIO > sources[numSources];
+	
+	idRandom rand( 1 );
+	for( int s = 0; s < numSources; s++ )
+	{
+		const int frames = sourceRates[s];
+		const float freq = 110.0f * ( s + 1 );
+		sources[s].SetNum( frames * sourceChannels[s] );
+		for( int i = 0; i < frames; i++ )
+		{
+			const float tone = idMath::Sin( idMath::TWO_PI * freq * i / sourceRates[s] ) * 0.7f;
+			for( int c = 0; c < sourceChannels[s]; c++ )
+			{
+				const float noise = rand.CRandomFloat() * 0.1f;
+				sources[s][i * sourceChannels[s] + c] = ( int16 )idMath::Ftoi( ( tone + noise ) * 32767.0f );
+			}
+		}
+	}
+	
+	idSoundMixer mixer;
+	idSoundMixerSink_Null nullSink;
+	idSoundMixerSink_Wave waveSink;
+	
+	idSoundMixerSink* sink = &nullSink;
+	if( s_mixerBenchmarkWave.GetString()[0] != '\0' && waveSink.Open( s_mixerBenchmarkWave.GetString(), outputRate, idSoundMixer::OUTPUT_CHANNELS ) )
+	{
+		sink = &waveSink;
+	}
+	
+	const double audioMsec = 1000.0 * numFrames / outputRate;
+	
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		const bool useSIMD = ( pass == 0 );
+		mixer.Init( outputRate, useSIMD ? sink : &nullSink );
+		
+		const int64 usec = MixerBenchmarkRun( mixer, sources, sourceRates, sourceChannels, numSources, numVoices, numFrames, useSIMD );
+		const double msec = Max( usec, ( int64 )1 ) / 1000.0;
+		
+		idLib::Printf( "%-6s %d voices, %.1f s of %d Hz audio in %.2f ms: %.0f voices mixed per ms (%.1fx realtime)\n",
+					   useSIMD ? "sse2" : "scalar", numVoices, audioMsec / 1000.0, outputRate, msec,
+					   numVoices * audioMsec / msec, audioMsec / msec );
+	}
+	mixer.Shutdown();
+	
+	if( sink == &waveSink )
+	{
+		waveSink.Close();
+		idLib::Printf( "wrote %s\n", s_mixerBenchmarkWave.GetString() );
+	}
+	else
+	{
+		idLib::Printf( "peak output level %.3f\n", nullSink.GetPeak() );
+	}
+}
@@ -0,0 +1,206 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __SOUNDMIXER_H__
+#define __SOUNDMIXER_H__
+
+/*
+================================================================================================
+
+	Software Voice Mixer
+
+	Resamples and mixes 16 bit PCM voices into an interleaved stereo float buffer with SSE2 and
+	hands the mixed blocks to an output sink. It has no dependency on an audio device, so it can
+	run headless with the null sink or render into a .wav file.
+	
+	Builds without OpenAL or XAudio2 play their voices through it, see sound/stub. The OpenAL
+	and XAudio2 backends still mix on the device.
+
+================================================================================================
+*/
+
+/*
+================================================
+idSoundMixerSink
+
+Destination for the mixed output blocks.
+================================================
+*/
+class idSoundMixerSink
+{
+public:
+	virtual				~idSoundMixerSink() {}
+	
+	// frames are interleaved with numChannels floats per frame in the -1..1 range
+	virtual void		Write( const float* frames, int numFrames, int numChannels ) = 0;
+};
+
+/*
+================================================
+idSoundMixerSink_Null
+
+Throws the output away, used for headless runs and benchmarking.
+================================================
+*/
+class idSoundMixerSink_Null : public idSoundMixerSink
+{
+public:
+	idSoundMixerSink_Null() : framesWritten( 0 ), peak( 0.0f ) {}
+	
+	virtual void		Write( const float* frames, int numFrames, int numChannels );
+	
+	int64				GetFramesWritten() const
+	{
+		return framesWritten;
+	}
+	float				GetPeak() const
+	{
+		return peak;
+	}
+	
+private:
+	int64				framesWritten;
+	float				peak;
+};
+
+/*
+================================================
+idSoundMixerSink_Wave
+
+Writes the output as a 16 bit PCM .wav file.
+================================================
+*/
+class idSoundMixerSink_Wave : public idSoundMixerSink
+{
+public:
+	idSoundMixerSink_Wave();
+	virtual				~idSoundMixerSink_Wave();
+	
+	bool				Open( const char* fileName, int sampleRate, int numChannels );
+	void				Close();
+	
+	virtual void		Write( const float* frames, int numFrames, int numChannels );
+	
+private:
+	void				WriteHeader();
+	
+	idFile* 			file;
+	int					sampleRate;
+	int					numChannels;
+	uint32				dataSize;
+	idList< int16, TAG_AUDIO >	convertBuffer;
+};
+
+/*
+================================================
+idSoundMixer
+================================================
+*/
+class idSoundMixer
+{
+public:
+	static const int	MAX_VOICES = 512;
+	static const int	OUTPUT_CHANNELS = 2;
+	static const int	MIX_BLOCK_FRAMES = 256;			// frames mixed per block, volume changes ramp over one block
+	static const int	MAX_PITCH = 8;					// maximum source to output rate ratio
+	
+	idSoundMixer();
+	~idSoundMixer();
+	
+	void				Init( int sampleRate, idSoundMixerSink* sink );
+	void				Shutdown();
+	
+	int					GetSampleRate() const
+	{
+		return sampleRate;
+	}
+	void				SetSink( idSoundMixerSink* s )
+	{
+		sink = s;
+	}
+	void				SetUseSIMD( bool b )
+	{
+		useSIMD = b;
+	}
+	
+	// returns -1 if all voices are in use
+	int					AllocVoice();
+	void				FreeVoice( int voice );
+	
+	// the sample data is referenced, not copied, and has to stay valid while the voice plays
+	void				SetVoiceSource( int voice, const int16* samples, int numFrames, int numChannels, int sampleRate, bool looping );
+	// a non looping source continues with this one and loops it, it has to have the source's channels and rate
+	void				SetVoiceLoop( int voice, const int16* samples, int numFrames );
+	void				SetVoicePosition( int voice, int frame );
+	void				SetVoiceVolume( int voice, float left, float right );
+	void				SetVoicePitch( int voice, float pitch );
+	void				StartVoice( int voice );
+	void				StopVoice( int voice );
+	bool				IsVoicePlaying( int voice ) const;
+	
+	int					GetNumPlayingVoices() const;
+	
+	// mixes numFrames output frames and writes them to the sink
+	void				Mix( int numFrames );
+	
+private:
+	struct mixerVoice_t
+	{
+		const int16* 	samples;
+		int				numFrames;
+		const int16* 	loopSamples;
+		int				loopNumFrames;
+		int				numChannels;
+		int				sampleRate;
+		bool			looping;
+		bool			allocated;
+		bool			playing;
+		float			pitch;
+		uint32			step;				// 16.16 fixed point source frames per output frame
+		int				position;			// source frame
+		uint32			fraction;			// 16 bit fraction of a source frame
+		float			gain[OUTPUT_CHANNELS];
+		float			targetGain[OUTPUT_CHANNELS];
+	};
+	
+	void				MixBlock( float* dest, int numFrames );
+	void				MixVoice( mixerVoice_t& voice, float* dest, int numFrames );
+	int					SafeFrames( const mixerVoice_t& voice, int numFrames ) const;
+	static void			WrapPosition( mixerVoice_t& voice );
+	void				MixVoiceGeneric( mixerVoice_t& voice, float* dest, int numFrames, float gainL, float gainR, float stepL, float stepR );
+	void				MixVoiceSIMD( mixerVoice_t& voice, float* dest, int numFrames, float gainL, float gainR, float stepL, float stepR );
+	void				UpdateStep( mixerVoice_t& voice );
+	
+	int					sampleRate;
+	bool				useSIMD;
+	idSoundMixerSink* 	sink;
+	float* 				mixBuffer;			// MIX_BLOCK_FRAMES * OUTPUT_CHANNELS, 16 byte aligned
+	mixerVoice_t		voices[MAX_VOICES];
+};
+
+#endif // !__SOUNDMIXER_H__
@@ -154,33 +154,79 @@ bool idSoundSample_XAudio2::LoadGeneratedSample( const idStr& filename )
 	idFileLocal fileIn( fileSystem->OpenFileReadMemory( filename ) );
 	if( fileIn != NULL )
 	{
-		uint32 magic;
-		fileIn->ReadBig( magic );
-		fileIn->ReadBig( timestamp );
-		fileIn->ReadBig( loaded );
-		fileIn->ReadBig( playBegin );
-		fileIn->ReadBig( playLength );
-		idWaveFile::ReadWaveFormatDirect( format, fileIn );
-		int num;
-		fileIn->ReadBig( num );
-		amplitude.Clear();
-		amplitude.SetNum( num );
-		fileIn->Read( amplitude.Ptr(), amplitude.Num() );
-		fileIn->ReadBig( totalBufferSize );
-		fileIn->ReadBig( num );
-		buffers.SetNum( num );
-		for( int i = 0; i < num; i++ )
-		{
-			fileIn->ReadBig( buffers[ i ].numSamples );
-			fileIn->ReadBig( buffers[ i ].bufferSize );
-			buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
-			fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
-			buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
-		}
-		return true;
+		return LoadGeneratedSample( fileIn );
 	}
 	return false;
 }
+
+/*
+========================
+idSoundSample_XAudio2::LoadGeneratedSample
+
+Only reads from fileIn, so the level load pipeline can run it off the main thread
+========================
+*/
+bool idSoundSample_XAudio2::LoadGeneratedSample( idFile* fileIn )
+{
+	uint32 magic;
+	fileIn->ReadBig( magic );
+	fileIn->ReadBig( timestamp );
+	fileIn->ReadBig( loaded );
+	fileIn->ReadBig( playBegin );
+	fileIn->ReadBig( playLength );
+	idWaveFile::ReadWaveFormatDirect( format, fileIn );
+	int num;
+	fileIn->ReadBig( num );
+	amplitude.Clear();
+	amplitude.SetNum( num );
+	fileIn->Read( amplitude.Ptr(), amplitude.Num() );
+	fileIn->ReadBig( totalBufferSize );
+	fileIn->ReadBig( num );
+	buffers.SetNum( num );
+	for( int i = 0; i < num; i++ )
+	{
+		fileIn->ReadBig( buffers[ i ].numSamples );
+		fileIn->ReadBig( buffers[ i ].bufferSize );
+		buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
+		fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
+		buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
+	}
+	return true;
+}
+
+/*
+========================
+idSoundSample_XAudio2::DecodeSampleData
+
+Nothing to convert, the data is handed to the hardware as it is stored
+========================
+*/
+bool idSoundSample_XAudio2::DecodeSampleData()
+{
+	return true;
+}
+
+/*
+========================
+idSoundSample_XAudio2::FinishGeneratedSample
+
+Main thread part of a sample loaded by the level load pipeline, takes over
+the buffers the pipeline loaded into staged
+========================
+*/
+void idSoundSample_XAudio2::FinishGeneratedSample( idSoundSample_XAudio2& staged )
+{
+	FreeData();
+	
+	timestamp = staged.timestamp;
+	playBegin = staged.playBegin;
+	playLength = staged.playLength;
+	format = staged.format;
+	totalBufferSize = staged.totalBufferSize;
+	amplitude.Swap( staged.amplitude );
+	buffers.Swap( staged.buffers );
+	loaded = true;
+}
 /*
 ========================
 idSoundSample_XAudio2::Load
@@ -44,6 +44,14 @@ public:
 	// Loads and initializes the resource based on the name.
 	virtual void	 LoadResource();
 	
+	// LoadResource split up for the level load pipeline. The first two only
+	// touch the sample they are called on, so the pipeline runs them on a
+	// staging sample off the main thread and FinishGeneratedSample moves the
+	// staged data into the real sample on the main thread
+	bool			LoadGeneratedSample( idFile* fileIn );
+	bool			DecodeSampleData();
+	void			FinishGeneratedSample( idSoundSample_XAudio2& staged );
+	
 	void			SetName( const char* n )
 	{
 		name = n;
@@ -650,7 +650,7 @@ void idSoundEmitterLocal::Update( int currentTime )
 			if( soundInArea != -1 && soundInArea != soundWorld->listener.area )
 			{
 				spatializedDistance = maxDistance * METERS_TO_DOOM;
-				soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, origin, this );
+				soundWorld->ResolveEmitterOrigin( soundInArea, this );
 				spatializedDistance *= DOOM_TO_METERS;
 			}
 		}
@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "WaveFile.h"
 
+#if defined(USE_OPENAL) || defined(_MSC_VER)
+
 // Maximum number of voices we can have allocated
 #define MAX_HARDWARE_VOICES 48
 
@@ -40,6 +42,15 @@ If you have questions concerning this license or the applicable additional terms
 // This is limited primarily by seeking on the optical drive, secondarily by memory consumption, and tertiarily by CPU time spent mixing
 #define MAX_HARDWARE_CHANNELS 64
 
+#else
+
+// The software mixer of the stub backend isn't limited by hardware sources, only by idSoundMixer::MAX_VOICES,
+// which has to hold the doubled voice list of idSoundHardware. s_maxEmitterChannels still caps it at 48 by default
+#define MAX_HARDWARE_VOICES 256
+#define MAX_HARDWARE_CHANNELS ( MAX_HARDWARE_VOICES * 2 )
+
+#endif
+
 // We may need up to 3 buffers for each hardware voice if they are all long sounds
 #define MAX_SOUND_BUFFERS ( MAX_HARDWARE_VOICES * 3 )
 
@@ -379,6 +390,50 @@ public:
 	};
 	
 	void			ResolveOrigin( const int stackDepth, const soundPortalTrace_t* prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal* def );
+	
+	// Every chain of portals that leads from an area to the listener area, so the emitters
+	// only have to measure the distance along each chain instead of walking the portals.
+	// Built the first time an emitter in the area needs them and thrown away when the listener
+	// changes area. Closed portals only add distance, so their state is read when measuring.
+	struct soundPortalLink_t
+	{
+		const idWinding* 	w;
+		qhandle_t			portalHandle;
+	};
+	
+	struct soundAreaPortals_t
+	{
+		soundAreaPortals_t() : tooManyChains( false ), built( false ) {}
+		
+		idList<soundPortalLink_t, TAG_AUDIO>	links;			// all chains back to back
+		idList<int, TAG_AUDIO>					chainEnds;		// one past the last link of each chain
+		bool									tooManyChains;	// use ResolveOrigin for emitters in this area
+		volatile bool							built;
+	};
+	
+	void			ResolveEmitterOrigin( const int soundArea, idSoundEmitterLocal* def );
+	
+	void			ClearPortalChains();
+	void			UpdatePortalChains();
+	const soundAreaPortals_t* 	GetPortalChains( const int soundArea );
+	void			FindPortalChains( soundAreaPortals_t& chains, const int area, idStaticList<int, 16>& pathAreas, idStaticList<soundPortalLink_t, 16>& path, int& steps );
+	void			ResolveOriginFromChains( const soundAreaPortals_t& chains, const idVec3& soundOrigin, idSoundEmitterLocal* def );
+	
+	idList<soundAreaPortals_t, TAG_AUDIO>	portalChains;				// indexed by area, all leading to portalChainsListenerArea
+	idList<int, TAG_AUDIO>					listenerAreaHops;			// fewest portals between each area and the listener area, -1 if there is no path
+	int										portalChainsListenerArea;
+	idSysMutex								portalChainsMutex;
+	
+	// Emitters are spatialized on the job threads, in batches
+	struct emitterJobParms_t
+	{
+		idSoundEmitterLocal** 	emitters;
+		int						numEmitters;
+		int						currentTime;
+	};
+	idList<emitterJobParms_t, TAG_AUDIO>	emitterJobParms;
+	
+	void			UpdateEmitters( const int currentTime );
 };
 
 
@@ -540,6 +595,8 @@ public:
 	void					FreeVoice( idSoundVoice* );
 	
 	idSoundSample* 			LoadSample( const char* name );
+	// queues a level load referenced sample on the load pipeline
+	void					AddSampleLoad( class idLoadPipeline& pipeline, idSoundSample* sample );
 	
 	virtual void			Preload( idPreloadManifest& preload );
 	
@@ -588,6 +645,8 @@ public:
 	
 	idRandom2					random;
 	
+	idParallelJobList* 			emitterJobList;				// idSoundWorldLocal::UpdateEmitters
+	
 	int							soundTime;
 	bool						muted;
 	bool						musicMuted;
@@ -599,6 +658,7 @@ public:
 	
 	idSoundSystemLocal() :
 		currentSoundWorld( NULL ),
+		emitterJobList( NULL ),
 		soundTime( 0 ),
 		muted( false ),
 		musicMuted( false ),
@@ -31,6 +31,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "precompiled.h"
 
 #include "snd_local.h"
+#include "../framework/LoadPipeline.h"
 
 idCVar s_noSound( "s_noSound", "0", CVAR_BOOL, "returns NULL for all sounds loaded and does not update the sound rendering" );
 
@@ -159,6 +160,8 @@ void idSoundSystemLocal::Init()
 		InitStreamBuffers();
 	}
 	
+	emitterJobList = parallelJobManager->AllocJobList( JOBLIST_SOUND, JOBLIST_PRIORITY_MEDIUM, 256, 0, NULL );
+	
 	cmdSystem->AddCommand( "testSound", TestSound_f, 0, "tests a sound", idCmdSystem::ArgCompletion_SoundName );
 	cmdSystem->AddCommand( "s_restart", RestartSound_f, 0, "restart sound system" );
 	cmdSystem->AddCommand( "listSamples", ListSamples_f, 0, "lists all loaded sound samples" );
@@ -222,6 +225,12 @@ void idSoundSystemLocal::Shutdown()
 	hardware.Shutdown();
 	FreeStreamBuffers();
 	samples.DeleteContents( true );
+	
+	if( emitterJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( emitterJobList );
+		emitterJobList = NULL;
+	}
 	sampleHash.Free();
 }
 
@@ -565,6 +574,73 @@ void idSoundSystemLocal::BeginLevelLoad()
 
 
 
+/*
+================================================
+idSoundLoadItem
+
+Parses the generated sample and converts it to PCM off the main thread. The
+decode threads only write to the staging sample owned by the item, the sample
+that is in use is only changed by Finish, and samples that failed to decode
+go through Fallback so any error is raised on the main thread.
+================================================
+*/
+class idSoundLoadItem : public idLoadPipelineItem
+{
+public:
+	idSoundLoadItem( idSoundSample* sample_, const char* generatedName ) : sample( sample_ ), parsed( false )
+	{
+		fileName = generatedName;
+		staged.SetName( sample->GetName() );
+	}
+	
+	virtual void Decode()
+	{
+		parsed = staged.LoadGeneratedSample( GetFile() ) && staged.DecodeSampleData();
+	}
+	virtual bool Finish()
+	{
+		if( !parsed )
+		{
+			return false;
+		}
+		sample->FinishGeneratedSample( staged );
+		return true;
+	}
+	virtual void Fallback()
+	{
+		sample->LoadResource();
+	}
+	
+private:
+	idSoundSample* 	sample;
+	idSoundSample	staged;
+	bool			parsed;
+};
+
+/*
+========================
+idSoundSystemLocal::AddSampleLoad
+
+Queues the sample on the level load pipeline, samples that need anything but their
+generated file are loaded right away instead.
+========================
+*/
+void idSoundSystemLocal::AddSampleLoad( idLoadPipeline& pipeline, idSoundSample* sample )
+{
+	const char* name = sample->GetName();
+	if( s_noSound.GetBool() || idStr::Icmpn( name, "_default", 8 ) == 0 || idStr::FindText( name, "/vo/", false ) >= 0 || cvarSystem->GetCVarBool( "fs_buildresources" ) )
+	{
+		sample->LoadResource();
+		return;
+	}
+	
+	idStrStatic< MAX_OSPATH > generatedName = "generated/";
+	generatedName.Append( name );
+	generatedName.Append( ".idwav" );
+	
+	pipeline.AddItem( new( TAG_AUDIO ) idSoundLoadItem( sample, generatedName ) );
+}
+
 /*
 ========================
 idSoundSystemLocal::Preload
@@ -578,12 +654,10 @@ void idSoundSystemLocal::Preload( idPreloadManifest& manifest )
 	int	start = Sys_Milliseconds();
 	int numLoaded = 0;
 	
-	idList< preloadSort_t > preloadSort;
-	preloadSort.Resize( manifest.NumResources() );
+	idLoadPipeline pipeline( "sounds" );
 	for( int i = 0; i < manifest.NumResources(); i++ )
 	{
 		const preloadEntry_s& p = manifest.GetPreloadByIndex( i );
-		idResourceCacheEntry rc;
 		// FIXME: write these out sorted
 		if( p.resType == PRELOAD_SAMPLE )
 		{
@@ -591,35 +665,20 @@ void idSoundSystemLocal::Preload( idPreloadManifest& manifest )
 			{
 				continue;
 			}
-			filename  = "generated/";
-			filename += p.resourceName;
-			filename.SetFileExtension( "idwav" );
-			if( fileSystem->GetResourceCacheEntry( filename, rc ) )
+			filename = p.resourceName;
+			filename.Replace( "generated/", "" );
+			numLoaded++;
+			idSoundSample* sample = LoadSample( filename );
+			if( sample != NULL && !sample->IsLoaded() )
 			{
-				preloadSort_t ps = {};
-				ps.idx = i;
-				ps.ofs = rc.offset;
-				preloadSort.Append( ps );
+				sample->SetLevelLoadReferenced();
+				AddSampleLoad( pipeline, sample );
 			}
 		}
 	}
 	
-	preloadSort.SortWithTemplate( idSort_Preload() );
-	
-	for( int i = 0; i < preloadSort.Num(); i++ )
-	{
-		const preloadSort_t& ps = preloadSort[ i ];
-		const preloadEntry_s& p = manifest.GetPreloadByIndex( ps.idx );
-		filename = p.resourceName;
-		filename.Replace( "generated/", "" );
-		numLoaded++;
-		idSoundSample* sample = LoadSample( filename );
-		if( sample != NULL && !sample->IsLoaded() )
-		{
-			sample->LoadResource();
-			sample->SetLevelLoadReferenced();
-		}
-	}
+	// the pipeline reads them in resource file order
+	pipeline.Run( false );
 	
 	int	end = Sys_Milliseconds();
 	common->Printf( "%05d sounds preloaded in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
@@ -643,8 +702,7 @@ void idSoundSystemLocal::EndLevelLoad()
 	int		keepCount = 0;
 	int		loadCount = 0;
 	
-	idList< preloadSort_t > preloadSort;
-	preloadSort.Resize( samples.Num() );
+	idLoadPipeline pipeline( "sounds" );
 	
 	for( int i = 0; i < samples.Num(); i++ )
 	{
@@ -663,34 +721,13 @@ void idSoundSystemLocal::EndLevelLoad()
 		}
 		if( samples[i]->GetLevelLoadReferenced() )
 		{
-			idStrStatic< MAX_OSPATH > filename  = "generated/";
-			filename += samples[ i ]->GetName();
-			filename.SetFileExtension( "idwav" );
-			preloadSort_t ps = {};
-			ps.idx = i;
-			idResourceCacheEntry rc;
-			if( fileSystem->GetResourceCacheEntry( filename, rc ) )
-			{
-				ps.ofs = rc.offset;
-			}
-			else
-			{
-				ps.ofs = 0;
-			}
-			preloadSort.Append( ps );
+			AddSampleLoad( pipeline, samples[i] );
 			loadCount++;
 		}
 	}
-	preloadSort.SortWithTemplate( idSort_Preload() );
-	mSoundCount = preloadSort.Num();
-	for( int i = 0; i < preloadSort.Num(); i++ )
-	{
-		mSoundProgress = 100 * i / mSoundCount;
-		common->UpdateLevelLoadPacifier(true,mSoundProgress);
-		
-		
-		samples[ preloadSort[ i ].idx ]->LoadResource();
-	}
+	
+	// the pipeline reads them in resource file order
+	pipeline.Run( true );
 	int	end = Sys_Milliseconds();
 	
 	common->Printf( "%5i sounds loaded in %5.1f seconds\n", loadCount, ( end - start ) * 0.001 );
@@ -44,6 +44,8 @@ idCVar s_doorDistanceAdd( "s_doorDistanceAdd", "150", CVAR_FLOAT, "reduce sound
 idCVar s_drawSounds( "s_drawSounds", "0", CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
 idCVar s_showVoices( "s_showVoices", "0", CVAR_BOOL, "show active voices" );
 idCVar s_volume_dB( "s_volume_dB", "0", CVAR_ARCHIVE | CVAR_FLOAT, "volume in dB" );
+idCVar s_emitterJobs( "s_emitterJobs", "1", CVAR_BOOL, "spatialize the sound emitters on the job threads" );
+idCVar s_cachePortalChains( "s_cachePortalChains", "1", CVAR_BOOL, "keep the portal chains from each area to the listener area instead of walking the portals for every emitter" );
 extern idCVar s_noSound;
 
 extern void WriteDeclCache( idDemoFile* f, int demoCategory, int demoCode, declType_t  declType );
@@ -80,6 +82,8 @@ idSoundWorldLocal::idSoundWorldLocal()
 	
 	slowmoSpeed = 1.0f;
 	enviroSuitActive = false;
+	
+	portalChainsListenerArea = -1;
 }
 
 /*
@@ -341,7 +345,8 @@ void idSoundWorldLocal::Update()
 	// ------------------
 	// Update emitters
 	//
-	// Only loop through the list once to avoid extra cache misses
+	// Finished one-shot emitters are freed first, UpdateEmitters spatializes the rest on
+	// the job threads, then their channels are sorted into the hardware list
 	// ------------------
 	
 	// The naming convention is weird here because we reuse the name "channel"
@@ -376,11 +381,13 @@ void idSoundWorldLocal::Update()
 				emitters[e]->index = e;
 			}
 			emitters.SetNum( lastEmitter );
-			continue;
 		}
-		
-		emitters[e]->Update( currentTime );
-		
+	}
+	
+	UpdateEmitters( currentTime );
+	
+	for( int e = emitters.Num() - 1; e >= 0; e-- )
+	{
 		totalEmitterChannels += emitters[e]->channels.Num();
 		
 		// sort the active channels into the hardware list
@@ -618,6 +625,9 @@ void idSoundWorldLocal::ClearAllSoundEmitters()
 	}
 	emitters.Clear();
 	localSound = AllocSoundEmitter();
+	
+	// the render world may have loaded a different map
+	ClearPortalChains();
 }
 
 /*
@@ -760,6 +770,56 @@ set at maxDistance
 */
 static const int MAX_PORTAL_TRACE_DEPTH = 10;
 
+/*
+===================
+PortalSoundOrigin
+
+The point on the portal on the way from the sound to the listener
+===================
+*/
+static idVec3 PortalSoundOrigin( const idWinding& w, const idVec3& soundOrigin, const idVec3& listenerPos )
+{
+	idVec3	source;
+	
+	idPlane	pl;
+	w.GetPlane( pl );
+	
+	float	scale;
+	idVec3	dir = listenerPos - soundOrigin;
+	if( !pl.RayIntersection( soundOrigin, dir, scale ) )
+	{
+		source = w.GetCenter();
+	}
+	else
+	{
+		source = soundOrigin + scale * dir;
+		
+		// if this point isn't inside the portal edges, slide it in
+		for( int i = 0 ; i < w.GetNumPoints() ; i++ )
+		{
+			int j = ( i + 1 ) % w.GetNumPoints();
+			idVec3	edgeDir = w[j].ToVec3() - w[i].ToVec3();
+			idVec3	edgeNormal;
+			
+			edgeNormal.Cross( pl.Normal(), edgeDir );
+			
+			idVec3	fromVert = source - w[j].ToVec3();
+			
+			float d = edgeNormal * fromVert;
+			if( d > 0 )
+			{
+				// move it in
+				float div = edgeNormal.Normalize();
+				d /= div;
+				
+				source -= d * edgeNormal;
+			}
+		}
+	}
+	
+	return source;
+}
+
 void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTrace_t* prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal* def )
 {
 
@@ -827,51 +887,337 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 		}
 		
 		// pick a point on the portal to serve as our virtual sound origin
-		idVec3	source;
+		idVec3 source = PortalSoundOrigin( *re.w, soundOrigin, listener.pos );
+		
+		idVec3 tlen = source - soundOrigin;
+		float tlenLength = tlen.LengthFast();
+		
+		ResolveOrigin( stackDepth + 1, &newStack, otherArea, dist + tlenLength + occlusionDistance, source, def );
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::ResolveEmitterOrigin
+
+Sets def->spatializedDistance and def->spatializedOrigin for a sound in soundArea.
+  this is called by the emitter update jobs
+===================
+*/
+void idSoundWorldLocal::ResolveEmitterOrigin( const int soundArea, idSoundEmitterLocal* def )
+{
+	if( s_cachePortalChains.GetBool() )
+	{
+		const soundAreaPortals_t* chains = GetPortalChains( soundArea );
+		if( chains != NULL && !chains->tooManyChains )
+		{
+			ResolveOriginFromChains( *chains, def->origin, def );
+			return;
+		}
+	}
+	
+	ResolveOrigin( 0, NULL, soundArea, 0.0f, def->origin, def );
+}
+
+/*
+===================
+idSoundWorldLocal::ClearPortalChains
+===================
+*/
+void idSoundWorldLocal::ClearPortalChains()
+{
+	portalChains.Clear();
+	listenerAreaHops.Clear();
+	portalChainsListenerArea = -1;
+}
+
+/*
+===================
+idSoundWorldLocal::UpdatePortalChains
+
+Throws away the portal chains when the listener changed area.
+  this is called by the main thread, before the emitter update jobs
+===================
+*/
+void idSoundWorldLocal::UpdatePortalChains()
+{
+	if( renderWorld == NULL || listener.area < 0 )
+	{
+		return;
+	}
+	
+	const int numAreas = renderWorld->NumAreas();
+	if( listener.area == portalChainsListenerArea && portalChains.Num() == numAreas )
+	{
+		return;
+	}
+	
+	portalChainsListenerArea = listener.area;
+	
+	portalChains.Clear();
+	portalChains.SetNum( numAreas );
+	
+	// breadth first walk out from the listener, so the chains can skip the areas that can't
+	// reach the listener within MAX_PORTAL_TRACE_DEPTH portals
+	listenerAreaHops.SetNum( numAreas );
+	for( int i = 0; i < numAreas; i++ )
+	{
+		listenerAreaHops[i] = -1;
+	}
+	
+	idList<int, TAG_AUDIO> queue;
+	queue.SetGranularity( numAreas );
+	queue.Append( listener.area );
+	listenerAreaHops[listener.area] = 0;
+	
+	for( int q = 0; q < queue.Num(); q++ )
+	{
+		const int area = queue[q];
+		if( listenerAreaHops[area] == MAX_PORTAL_TRACE_DEPTH )
+		{
+			continue;
+		}
+		
+		const int numPortals = renderWorld->NumPortalsInArea( area );
+		for( int p = 0; p < numPortals; p++ )
+		{
+			exitPortal_t re = renderWorld->GetPortal( area, p );
+			const int otherArea = ( re.areas[0] == area ) ? re.areas[1] : re.areas[0];
+			if( listenerAreaHops[otherArea] == -1 )
+			{
+				listenerAreaHops[otherArea] = listenerAreaHops[area] + 1;
+				queue.Append( otherArea );
+			}
+		}
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::GetPortalChains
+
+Returns the portal chains from soundArea to the listener area, building them the first time.
+  this is called by the emitter update jobs
+===================
+*/
+static const int MAX_PORTAL_CHAINS		= 64;		// areas with more ways to the listener use ResolveOrigin
+static const int MAX_PORTAL_CHAIN_STEPS	= 4096;
+
+const idSoundWorldLocal::soundAreaPortals_t* idSoundWorldLocal::GetPortalChains( const int soundArea )
+{
+	if( soundArea < 0 || soundArea >= portalChains.Num() )
+	{
+		return NULL;
+	}
+	
+	soundAreaPortals_t& chains = portalChains[soundArea];
+	if( chains.built )
+	{
+		return &chains;
+	}
+	
+	idScopedCriticalSection lock( portalChainsMutex );
+	
+	if( !chains.built )
+	{
+		idStaticList<int, 16> pathAreas;
+		idStaticList<soundPortalLink_t, 16> path;
+		int steps = 0;
+		
+		pathAreas.Append( soundArea );
+		if( listenerAreaHops[soundArea] != -1 )
+		{
+			FindPortalChains( chains, soundArea, pathAreas, path, steps );
+		}
+		
+		SYS_MEMORYBARRIER;
+		chains.built = true;
+	}
+	
+	return &chains;
+}
+
+/*
+===================
+idSoundWorldLocal::FindPortalChains
+
+Same walk as ResolveOrigin, without the distances
+===================
+*/
+void idSoundWorldLocal::FindPortalChains( soundAreaPortals_t& chains, const int area, idStaticList<int, 16>& pathAreas, idStaticList<soundPortalLink_t, 16>& path, int& steps )
+{
+	if( ++steps > MAX_PORTAL_CHAIN_STEPS )
+	{
+		chains.tooManyChains = true;
+	}
+	if( chains.tooManyChains )
+	{
+		return;
+	}
+	
+	const int numPortals = renderWorld->NumPortalsInArea( area );
+	for( int p = 0; p < numPortals; p++ )
+	{
+		exitPortal_t re = renderWorld->GetPortal( area, p );
+		const int otherArea = ( re.areas[0] == area ) ? re.areas[1] : re.areas[0];
+		
+		// if this area is already in our portal chain, don't bother looking into it
+		if( pathAreas.FindIndex( otherArea ) != -1 )
+		{
+			continue;
+		}
+		
+		// can't reach the listener from there in time
+		const int hops = listenerAreaHops[otherArea];
+		if( hops == -1 || path.Num() + 1 + hops > MAX_PORTAL_TRACE_DEPTH )
+		{
+			continue;
+		}
 		
-		idPlane	pl;
-		re.w->GetPlane( pl );
+		soundPortalLink_t link;
+		link.w = re.w;
+		link.portalHandle = re.portalHandle;
 		
-		float	scale;
-		idVec3	dir = listener.pos - soundOrigin;
-		if( !pl.RayIntersection( soundOrigin, dir, scale ) )
+		if( otherArea == portalChainsListenerArea )
 		{
-			source = re.w->GetCenter();
+			if( chains.chainEnds.Num() == MAX_PORTAL_CHAINS )
+			{
+				chains.tooManyChains = true;
+				return;
+			}
+			for( int i = 0; i < path.Num(); i++ )
+			{
+				chains.links.Append( path[i] );
+			}
+			chains.links.Append( link );
+			chains.chainEnds.Append( chains.links.Num() );
+			continue;
 		}
-		else
+		
+		path.Append( link );
+		pathAreas.Append( otherArea );
+		
+		FindPortalChains( chains, otherArea, pathAreas, path, steps );
+		
+		path.SetNum( path.Num() - 1 );
+		pathAreas.SetNum( pathAreas.Num() - 1 );
+		
+		if( chains.tooManyChains )
+		{
+			return;
+		}
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::ResolveOriginFromChains
+
+Same result as ResolveOrigin, measured along the cached portal chains
+===================
+*/
+void idSoundWorldLocal::ResolveOriginFromChains( const soundAreaPortals_t& chains, const idVec3& soundOrigin, idSoundEmitterLocal* def )
+{
+	const float doorDistanceAdd = s_doorDistanceAdd.GetFloat();
+	
+	int start = 0;
+	for( int c = 0; c < chains.chainEnds.Num(); c++ )
+	{
+		const int end = chains.chainEnds[c];
+		
+		idVec3 origin = soundOrigin;
+		float dist = 0.0f;
+		
+		int l;
+		for( l = start; l < end; l++ )
 		{
-			source = soundOrigin + scale * dir;
+			const soundPortalLink_t& link = chains.links[l];
 			
-			// if this point isn't inside the portal edges, slide it in
-			for( int i = 0 ; i < re.w->GetNumPoints() ; i++ )
+			// air blocking windows will block sound like closed doors
+			const float occlusionDistance = ( renderWorld->GetPortalState( link.portalHandle ) & ( PS_BLOCK_VIEW | PS_BLOCK_AIR ) ) ? doorDistanceAdd : 0.0f;
+			
+			idVec3 source = PortalSoundOrigin( *link.w, origin, listener.pos );
+			dist += ( source - origin ).LengthFast() + occlusionDistance;
+			origin = source;
+			
+			if( dist >= def->spatializedDistance )
 			{
-				int j = ( i + 1 ) % re.w->GetNumPoints();
-				idVec3	edgeDir = ( *( re.w ) )[j].ToVec3() - ( *( re.w ) )[i].ToVec3();
-				idVec3	edgeNormal;
-				
-				edgeNormal.Cross( pl.Normal(), edgeDir );
-				
-				idVec3	fromVert = source - ( *( re.w ) )[j].ToVec3();
-				
-				float d = edgeNormal * fromVert;
-				if( d > 0 )
-				{
-					// move it in
-					float div = edgeNormal.Normalize();
-					d /= div;
-					
-					source -= d * edgeNormal;
-				}
+				// we can't possibly hear the sound through this chain of portals
+				break;
 			}
 		}
+		start = end;
 		
-		idVec3 tlen = source - soundOrigin;
-		float tlenLength = tlen.LengthFast();
+		if( l < end )
+		{
+			continue;
+		}
 		
-		ResolveOrigin( stackDepth + 1, &newStack, otherArea, dist + tlenLength + occlusionDistance, source, def );
+		float fullDist = dist + ( origin - listener.pos ).LengthFast();
+		if( fullDist < def->spatializedDistance )
+		{
+			def->spatializedDistance = fullDist;
+			def->spatializedOrigin = origin;
+		}
+	}
+}
+
+/*
+========================
+UpdateEmittersJob
+========================
+*/
+static void UpdateEmittersJob( idSoundWorldLocal::emitterJobParms_t* parms )
+{
+	for( int i = 0; i < parms->numEmitters; i++ )
+	{
+		parms->emitters[i]->Update( parms->currentTime );
 	}
 }
 
+REGISTER_PARALLEL_JOB( UpdateEmittersJob, "UpdateEmittersJob" );
+
+/*
+========================
+idSoundWorldLocal::UpdateEmitters
+
+Spatializes all the emitters, spread over the job threads when there are enough of them
+========================
+*/
+static const int EMITTERS_PER_JOB = 16;
+
+void idSoundWorldLocal::UpdateEmitters( const int currentTime )
+{
+	UpdatePortalChains();
+	
+	idParallelJobList* jobList = soundSystemLocal.emitterJobList;
+	
+	if( jobList == NULL || !s_emitterJobs.GetBool() || emitters.Num() < EMITTERS_PER_JOB * 2 )
+	{
+		for( int e = emitters.Num() - 1; e >= 0; e-- )
+		{
+			emitters[e]->Update( currentTime );
+		}
+		return;
+	}
+	
+	const int numJobs = ( emitters.Num() + EMITTERS_PER_JOB - 1 ) / EMITTERS_PER_JOB;
+	emitterJobParms.SetNum( numJobs );
+	
+	for( int j = 0; j < numJobs; j++ )
+	{
+		emitterJobParms_t& parms = emitterJobParms[j];
+		parms.emitters = emitters.Ptr() + j * EMITTERS_PER_JOB;
+		parms.numEmitters = Min( EMITTERS_PER_JOB, emitters.Num() - j * EMITTERS_PER_JOB );
+		parms.currentTime = currentTime;
+		
+		jobList->AddJob( ( jobRun_t )UpdateEmittersJob, &parms );
+	}
+	
+	jobList->Submit();
+	jobList->Wait();
+}
+
 /*
 ========================
 idSoundWorldLocal::StartWritingDemo
@@ -0,0 +1,179 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+#include "../snd_local.h"
+
+idCVar s_mixerWaveFile( "s_mixerWaveFile", "", CVAR_SOUND, "if set, the software mixer writes its output to this .wav file instead of discarding it, read when the sound system starts" );
+idCVar s_mixerMaxLatency( "s_mixerMaxLatency", "250", CVAR_INTEGER, "milliseconds of audio the software mixer catches up on at most after a stall, the rest is skipped" );
+extern idCVar s_volume_dB;
+
+// The whole system runs at this sample rate
+static const int SYSTEM_SAMPLE_RATE = 44100;
+
+/*
+========================
+idSoundHardware::idSoundHardware
+========================
+*/
+idSoundHardware::idSoundHardware()
+{
+	masterVolume = 1.0f;
+	mixStartTime = 0;
+	framesMixed = 0;
+	
+	voices.SetNum( 0 );
+	freeVoices.SetNum( 0 );
+}
+
+/*
+========================
+idSoundHardware::Init
+========================
+*/
+void idSoundHardware::Init()
+{
+	common->Printf( "Setup software mixer... " );
+	
+	idSoundMixerSink* sink = &nullSink;
+	if( s_mixerWaveFile.GetString()[0] != '\0' && waveSink.Open( s_mixerWaveFile.GetString(), SYSTEM_SAMPLE_RATE, idSoundMixer::OUTPUT_CHANNELS ) )
+	{
+		sink = &waveSink;
+	}
+	mixer.Init( SYSTEM_SAMPLE_RATE, sink );
+	
+	common->Printf( "Done, writing to %s.\n", ( sink == &waveSink ) ? s_mixerWaveFile.GetString() : "the null sink" );
+	
+	idSoundVoice::InitSurround( idSoundMixer::OUTPUT_CHANNELS, idWaveFile::CHANNEL_MASK_FRONT_LEFT | idWaveFile::CHANNEL_MASK_FRONT_RIGHT );
+	
+	// every voice keeps its mixer voice for as long as the mixer runs
+	assert( voices.Max() <= idSoundMixer::MAX_VOICES );
+	voices.SetNum( voices.Max() );
+	freeVoices.SetNum( voices.Max() );
+	for( int i = 0; i < voices.Num(); i++ )
+	{
+		voices[i] = idSoundVoice();
+		voices[i].mixerVoice = mixer.AllocVoice();
+		freeVoices[i] = &voices[i];
+	}
+	
+	mixStartTime = Sys_Microseconds();
+	framesMixed = 0;
+}
+
+/*
+========================
+idSoundHardware::Shutdown
+========================
+*/
+void idSoundHardware::Shutdown()
+{
+	voices.Clear();
+	freeVoices.Clear();
+	
+	mixer.Shutdown();
+	waveSink.Close();
+}
+
+/*
+========================
+idSoundHardware::AllocateVoice
+========================
+*/
+idSoundVoice* idSoundHardware::AllocateVoice( const idSoundSample* leadinSample, const idSoundSample* loopingSample )
+{
+	if( leadinSample == NULL )
+	{
+		return NULL;
+	}
+	if( loopingSample != NULL )
+	{
+		// the mixer continues from the leadin into the loop without switching formats
+		if( ( leadinSample->NumChannels() != loopingSample->NumChannels() ) || ( leadinSample->SampleRate() != loopingSample->SampleRate() ) )
+		{
+			idLib::Warning( "Leadin/looping format mismatch: %s & %s", leadinSample->GetName(), loopingSample->GetName() );
+			loopingSample = NULL;
+		}
+	}
+	
+	if( freeVoices.Num() == 0 )
+	{
+		return NULL;
+	}
+	
+	idSoundVoice* voice = freeVoices[freeVoices.Num() - 1];
+	freeVoices.SetNum( freeVoices.Num() - 1 );
+	voice->Create( leadinSample, loopingSample );
+	return voice;
+}
+
+/*
+========================
+idSoundHardware::FreeVoice
+========================
+*/
+void idSoundHardware::FreeVoice( idSoundVoice* voice )
+{
+	// the mixer only runs in Update, so the voice is silent as soon as it is stopped
+	voice->Stop();
+	freeVoices.Append( voice );
+}
+
+/*
+========================
+idSoundHardware::Update
+
+Mixes the audio that played since the last update
+========================
+*/
+void idSoundHardware::Update()
+{
+	masterVolume = soundSystem->IsMuted() ? 0.0f : DBtoLinear( s_volume_dB.GetFloat() );
+	
+	if( mixer.GetSampleRate() == 0 )
+	{
+		// Init hasn't been called yet
+		return;
+	}
+	
+	const int64 elapsed = Sys_Microseconds() - mixStartTime;
+	const int64 targetFrames = elapsed * SYSTEM_SAMPLE_RATE / 1000000;
+	const int64 maxFrames = ( int64 )Max( s_mixerMaxLatency.GetInteger(), 1 ) * SYSTEM_SAMPLE_RATE / 1000;
+	if( targetFrames - framesMixed > maxFrames )
+	{
+		// a hitch or a load, don't spend the next frame mixing audio nobody hears
+		framesMixed = targetFrames - maxFrames;
+	}
+	
+	const int numFrames = ( int )( targetFrames - framesMixed );
+	if( numFrames > 0 )
+	{
+		mixer.Mix( numFrames );
+		framesMixed += numFrames;
+	}
+}
@@ -3,6 +3,7 @@
 
 Doom 3 BFG Edition GPL Source Code
 Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 1997-2012 Sam Lantinga <slouken@libsdl.org>  (MS ADPCM decoder)
 
 This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
 
@@ -82,6 +83,8 @@ idSoundSample::idSoundSample()
 	playLength = 0;
 	
 	lastPlayedTime = 0;
+	
+	pcmDecoded = false;
 }
 
 /*
@@ -156,33 +159,126 @@ bool idSoundSample::LoadGeneratedSample( const idStr& filename )
 	idFileLocal fileIn( fileSystem->OpenFileReadMemory( filename ) );
 	if( fileIn != NULL )
 	{
-		uint32 magic;
-		fileIn->ReadBig( magic );
-		fileIn->ReadBig( timestamp );
-		fileIn->ReadBig( loaded );
-		fileIn->ReadBig( playBegin );
-		fileIn->ReadBig( playLength );
-		idWaveFile::ReadWaveFormatDirect( format, fileIn );
-		int num;
-		fileIn->ReadBig( num );
-		amplitude.Clear();
-		amplitude.SetNum( num );
-		fileIn->Read( amplitude.Ptr(), amplitude.Num() );
-		fileIn->ReadBig( totalBufferSize );
-		fileIn->ReadBig( num );
-		buffers.SetNum( num );
-		for( int i = 0; i < num; i++ )
-		{
-			fileIn->ReadBig( buffers[ i ].numSamples );
-			fileIn->ReadBig( buffers[ i ].bufferSize );
-			buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
-			fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
-			buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
-		}
-		return true;
+		return LoadGeneratedSample( fileIn );
 	}
 	return false;
 }
+
+/*
+========================
+idSoundSample::LoadGeneratedSample
+
+Only reads from fileIn, so the level load pipeline can run it off the main thread
+========================
+*/
+bool idSoundSample::LoadGeneratedSample( idFile* fileIn )
+{
+	uint32 magic;
+	fileIn->ReadBig( magic );
+	fileIn->ReadBig( timestamp );
+	fileIn->ReadBig( loaded );
+	fileIn->ReadBig( playBegin );
+	fileIn->ReadBig( playLength );
+	idWaveFile::ReadWaveFormatDirect( format, fileIn );
+	int num;
+	fileIn->ReadBig( num );
+	amplitude.Clear();
+	amplitude.SetNum( num );
+	fileIn->Read( amplitude.Ptr(), amplitude.Num() );
+	fileIn->ReadBig( totalBufferSize );
+	fileIn->ReadBig( num );
+	buffers.SetNum( num );
+	for( int i = 0; i < num; i++ )
+	{
+		fileIn->ReadBig( buffers[ i ].numSamples );
+		fileIn->ReadBig( buffers[ i ].bufferSize );
+		buffers[ i ].buffer = AllocBuffer( buffers[ i ].bufferSize, GetName() );
+		fileIn->Read( buffers[ i ].buffer, buffers[ i ].bufferSize );
+		buffers[ i ].buffer = GPU_CONVERT_CPU_TO_CPU_CACHED_READONLY_ADDRESS( buffers[ i ].buffer );
+	}
+	return true;
+}
+
+/*
+========================
+idSoundSample::DecodeSampleData
+
+Converts ADPCM data to the PCM the mixer plays. Safe to call from any thread,
+LoadResource does it itself. Returns false if the data could not be decoded,
+the caller decides how to report it.
+========================
+*/
+bool idSoundSample::DecodeSampleData()
+{
+	if( format.basic.formatTag != idWaveFile::FORMAT_ADPCM || pcmDecoded )
+	{
+		return true;
+	}
+	
+	void* buffer = buffers[0].buffer;
+	uint32 bufferSize = buffers[0].bufferSize;
+	
+	if( MS_ADPCM_decode( ( uint8** ) &buffer, &bufferSize ) < 0 )
+	{
+		return false;
+	}
+	
+	buffers[0].buffer = buffer;
+	buffers[0].bufferSize = bufferSize;
+	
+	totalBufferSize = bufferSize;
+	pcmDecoded = true;
+	return true;
+}
+
+/*
+========================
+idSoundSample::GetMixerFrames
+========================
+*/
+const int16* idSoundSample::GetMixerFrames( int& numFrames ) const
+{
+	numFrames = 0;
+	
+	const bool pcm = ( format.basic.formatTag == idWaveFile::FORMAT_PCM && format.basic.bitsPerSample == 16 );
+	const bool decoded = ( format.basic.formatTag == idWaveFile::FORMAT_ADPCM && pcmDecoded );
+	if( ( !pcm && !decoded ) || buffers.Num() != 1 || ( NumChannels() != 1 && NumChannels() != 2 ) )
+	{
+		return NULL;
+	}
+	
+	const int bufferFrames = buffers[0].bufferSize / ( NumChannels() * ( int )sizeof( int16 ) );
+	numFrames = Min( playLength, bufferFrames - playBegin );
+	if( numFrames <= 0 )
+	{
+		numFrames = 0;
+		return NULL;
+	}
+	return ( const int16* )buffers[0].buffer + playBegin * NumChannels();
+}
+
+/*
+========================
+idSoundSample::FinishGeneratedSample
+
+Main thread part of a sample loaded by the level load pipeline, takes over
+the buffers the pipeline loaded into staged
+========================
+*/
+void idSoundSample::FinishGeneratedSample( idSoundSample& staged )
+{
+	FreeData();
+	
+	timestamp = staged.timestamp;
+	playBegin = staged.playBegin;
+	playLength = staged.playLength;
+	format = staged.format;
+	totalBufferSize = staged.totalBufferSize;
+	pcmDecoded = staged.pcmDecoded;
+	amplitude.Swap( staged.amplitude );
+	buffers.Swap( staged.buffers );
+	loaded = true;
+}
 /*
 ========================
 idSoundSample::Load
@@ -257,6 +353,12 @@ void idSoundSample::LoadResource()
 					}
 				}
 			}
+			
+			if( !DecodeSampleData() )
+			{
+				idLib::Warning( "idSoundSample::LoadResource: could not decode ADPCM '%s' to 16 bit format", GetName() );
+				MakeDefault();
+			}
 			return;
 		}
 	}
@@ -510,6 +612,7 @@ void idSoundSample::FreeData()
 	totalBufferSize = 0;
 	playBegin = 0;
 	playLength = 0;
+	pcmDecoded = false;
 }
 
 /*
@@ -552,3 +655,184 @@ float idSoundSample::GetAmplitude( int timeMS ) const
 	}
 	return ( float )amplitude[index] / 255.0f;
 }
+
+int32 idSoundSample::MS_ADPCM_nibble( MS_ADPCM_decodeState_t* state, int8 nybble )
+{
+	const int32 max_audioval = ( ( 1 << ( 16 - 1 ) ) - 1 );
+	const int32 min_audioval = -( 1 << ( 16 - 1 ) );
+	const int32 adaptive[] =
+	{
+		230, 230, 230, 230, 307, 409, 512, 614,
+		768, 614, 512, 409, 307, 230, 230, 230
+	};
+	
+	int32 new_sample, delta;
+	
+	new_sample = ( ( state->iSamp1 * state->coef1 ) +
+				   ( state->iSamp2 * state->coef2 ) ) / 256;
+				   
+	if( nybble & 0x08 )
+	{
+		new_sample += state->iDelta * ( nybble - 0x10 );
+	}
+	else
+	{
+		new_sample += state->iDelta * nybble;
+	}
+	
+	if( new_sample < min_audioval )
+	{
+		new_sample = min_audioval;
+	}
+	else if( new_sample > max_audioval )
+	{
+		new_sample = max_audioval;
+	}
+	
+	delta = ( ( int32 ) state->iDelta * adaptive[nybble] ) / 256;
+	if( delta < 16 )
+	{
+		delta = 16;
+	}
+	
+	state->iDelta = ( uint16 ) delta;
+	state->iSamp2 = state->iSamp1;
+	state->iSamp1 = ( int16 ) new_sample;
+	
+	return ( new_sample );
+}
+
+int idSoundSample::MS_ADPCM_decode( uint8** audio_buf, uint32* audio_len )
+{
+	// not static, the level load pipeline decodes samples on several threads at once
+	MS_ADPCM_decodeState_t			states[2];
+	MS_ADPCM_decodeState_t*			state[2];
+	
+	uint8* freeable, *encoded, *decoded;
+	int32 encoded_len, samplesleft;
+	int8 nybble;
+	int8 stereo;
+	int32 new_sample;
+	
+	// Allocate the proper sized output buffer
+	encoded_len = *audio_len;
+	encoded = *audio_buf;
+	freeable = *audio_buf;
+	
+	*audio_len = ( encoded_len / format.basic.blockSize ) * format.extra.adpcm.samplesPerBlock * format.basic.numChannels * sizeof( int16 );
+	
+	*audio_buf = ( uint8* ) Mem_Alloc( *audio_len, TAG_AUDIO );
+	if( *audio_buf == NULL )
+	{
+		//SDL_Error( SDL_ENOMEM );
+		return ( -1 );
+	}
+	decoded = *audio_buf;
+	
+	assert( format.basic.numChannels == 1 || format.basic.numChannels == 2 );
+	
+	// Get ready... Go!
+	stereo = ( format.basic.numChannels == 2 ) ? 1 : 0;
+	state[0] = &states[0];
+	state[1] = &states[stereo];
+	
+	while( encoded_len >= format.basic.blockSize )
+	{
+		// Grab the initial information for this block
+		state[0]->hPredictor = *encoded++;
+		
+		assert( state[0]->hPredictor < format.extra.adpcm.numCoef );
+		state[0]->hPredictor = idMath::ClampInt( 0, 6, state[0]->hPredictor );
+		
+		state[0]->coef1 = format.extra.adpcm.aCoef[state[0]->hPredictor].coef1;
+		state[0]->coef2 = format.extra.adpcm.aCoef[state[0]->hPredictor].coef2;
+		
+		if( stereo )
+		{
+			state[1]->hPredictor = *encoded++;
+			
+			assert( state[1]->hPredictor < format.extra.adpcm.numCoef );
+			state[1]->hPredictor = idMath::ClampInt( 0, 6, state[1]->hPredictor );
+			
+			state[1]->coef1 = format.extra.adpcm.aCoef[state[1]->hPredictor].coef1;
+			state[1]->coef2 = format.extra.adpcm.aCoef[state[1]->hPredictor].coef2;
+		}
+		
+		state[0]->iDelta = ( ( encoded[1] << 8 ) | encoded[0] );
+		encoded += sizeof( int16 );
+		if( stereo )
+		{
+			state[1]->iDelta = ( ( encoded[1] << 8 ) | encoded[0] );
+			encoded += sizeof( int16 );
+		}
+		
+		state[0]->iSamp1 = ( ( encoded[1] << 8 ) | encoded[0] );
+		encoded += sizeof( int16 );
+		if( stereo )
+		{
+			state[1]->iSamp1 = ( ( encoded[1] << 8 ) | encoded[0] );
+			encoded += sizeof( int16 );
+		}
+		
+		state[0]->iSamp2 = ( ( encoded[1] << 8 ) | encoded[0] );
+		encoded += sizeof( int16 );
+		if( stereo )
+		{
+			state[1]->iSamp2 = ( ( encoded[1] << 8 ) | encoded[0] );
+			encoded += sizeof( int16 );
+		}
+		
+		
+		
+		// Store the two initial samples we start with
+		decoded[0] = state[0]->iSamp2 & 0xFF;
+		decoded[1] = ( state[0]->iSamp2 >> 8 ) & 0xFF;
+		decoded += 2;
+		if( stereo )
+		{
+			decoded[0] = state[1]->iSamp2 & 0xFF;
+			decoded[1] = ( state[1]->iSamp2 >> 8 ) & 0xFF;
+			decoded += 2;
+		}
+		
+		decoded[0] = state[0]->iSamp1 & 0xFF;
+		decoded[1] = ( state[0]->iSamp1 >> 8 ) & 0xFF;
+		decoded += 2;
+		if( stereo )
+		{
+			decoded[0] = state[1]->iSamp1 & 0xFF;
+			decoded[1] = ( state[1]->iSamp1 >> 8 ) & 0xFF;
+			decoded += 2;
+		}
+		
+		// Decode and store the other samples in this block
+		samplesleft = ( format.extra.adpcm.samplesPerBlock - 2 ) * format.basic.numChannels;
+		
+		while( samplesleft > 0 )
+		{
+			nybble = ( *encoded ) >> 4;
+			new_sample = MS_ADPCM_nibble( state[0], nybble );
+			
+			decoded[0] = new_sample & 0xFF;
+			decoded[1] = ( new_sample >> 8 ) & 0xFF;
+			decoded += 2;
+			
+			nybble = ( *encoded ) & 0x0F;
+			new_sample = MS_ADPCM_nibble( state[1], nybble );
+			
+			decoded[0] = new_sample & 0xFF;
+			decoded[1] = ( new_sample >> 8 ) & 0xFF;
+			decoded += 2;
+			
+			++encoded;
+			samplesleft -= 2;
+		}
+		
+		encoded_len -= format.basic.blockSize;
+	}
+	
+	Mem_Free( freeable );
+	
+	return 0;
+}
+
@@ -35,6 +35,10 @@ If you have questions concerning this license or the applicable additional terms
  * actual implementations may *not* work!
  * (Making them virtual should be evaluated for performance-loss though, it would make the code
  *  cleaner and may be feasible)
+ *
+ * The voices are mixed in software by idSoundMixer into a null sink, or into a .wav file when
+ * s_mixerWaveFile is set. There is no audio device, so this backend runs headless and isn't
+ * limited by the number of hardware sources.
  */
 
 #ifndef SOUNDSTUB_H_
@@ -42,59 +46,72 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "idlib/precompiled.h" // TIME_T
 #include "../WaveFile.h"
+#include "../SoundMixer.h"
 
 class idSoundVoice : public idSoundVoice_Base
 {
 public:
-	void					Create( const idSoundSample* leadinSample, const idSoundSample* loopingSample ) {}
+	idSoundVoice();
+	
+	void					Create( const idSoundSample* leadinSample, const idSoundSample* loopingSample );
 	
 	// Start playing at a particular point in the buffer.  Does an Update() too
-	void					Start( int offsetMS, int ssFlags ) {}
+	void					Start( int offsetMS, int ssFlags );
 	
 	// Stop playing.
-	void					Stop() {}
+	void					Stop();
 	
 	// Stop consuming buffers
-	void					Pause() {}
+	void					Pause();
 	// Start consuming buffers again
-	void					UnPause() {}
+	void					UnPause();
 	
-	// Sends new position/volume/pitch information to the hardware
-	bool					Update()
-	{
-		return false;
-	}
+	// Sends new position/volume/pitch information to the mixer
+	bool					Update();
 	
 	// returns the RMS levels of the most recently processed block of audio, SSF_FLICKER must have been passed to Start
 	float					GetAmplitude()
 	{
-		return 0.0f;
+		// like the OpenAL backend, there is no level meter
+		return 1.0f;
 	}
 	
 	// returns true if we can re-use this voice
 	bool					CompatibleFormat( idSoundSample* s )
 	{
-		return false;
+		// the mixer resamples and converts every voice itself
+		return true;
 	}
 	
 	uint32					GetSampleRate() const
 	{
-		return 0;
+		return sampleRate;
 	}
 	
 	// callback function
 	void					OnBufferStart( idSoundSample* sample, int bufferNumber ) {}
+	
+	bool					IsPlaying() const;
+	
+private:
+	friend class idSoundHardware;
+	
+	int						mixerVoice;
+	const idSoundSample* 	leadinSample;
+	const idSoundSample* 	loopingSample;
+	uint32					sampleRate;
+	bool					paused;
 };
 
 class idSoundHardware
 {
 public:
-	idSoundHardware() {}
+	idSoundHardware();
 	
-	void			Init() {}
-	void			Shutdown() {}
+	void			Init();
+	void			Shutdown();
 	
-	void 			Update() {}
+	void 			Update();
 	
 	// FIXME: this is a bad name when having multiple sound backends... and maybe it's not even needed
 	void* 		GetIXAudio2() const // NOTE: originally this returned IXAudio2*, but that was casted to void later anyway
@@ -102,23 +119,34 @@ public:
 		return NULL;
 	}
 	
-	idSoundVoice* 	AllocateVoice( const idSoundSample* leadinSample, const idSoundSample* loopingSample )
-	{
-		return NULL;
-	}
-	
-	void			FreeVoice( idSoundVoice* voice ) {}
+	idSoundVoice* 	AllocateVoice( const idSoundSample* leadinSample, const idSoundSample* loopingSample );
+	void			FreeVoice( idSoundVoice* voice );
 	
 	int				GetNumZombieVoices() const
 	{
+		// the mixer stops voices right away, so they are never zombies
 		return 0;
 	}
 	
 	int				GetNumFreeVoices() const
 	{
-		return 0;
+		return freeVoices.Num();
 	}
 	
+private:
+	friend class idSoundVoice;
+	
+	idSoundMixer			mixer;
+	idSoundMixerSink_Null	nullSink;
+	idSoundMixerSink_Wave	waveSink;
+	
+	float					masterVolume;		// s_volume_dB, 0 when muted
+	int64					mixStartTime;		// microseconds
+	int64					framesMixed;		// since mixStartTime
+	
+	// a voice is freed as soon as it is stopped, the list is only doubled to keep it the size of the other backends'
+	idStaticList<idSoundVoice, MAX_HARDWARE_VOICES* 2 > voices;
+	idStaticList<idSoundVoice*, MAX_HARDWARE_VOICES* 2 > freeVoices;
 };
 
 // ok, this one isn't really a stub, because it seems to be XAudio-independent,
@@ -133,6 +161,18 @@ public:
 	// Loads and initializes the resource based on the name.
 	virtual void	 LoadResource();
 	
+	// LoadResource split up for the level load pipeline. The first two only
+	// touch the sample they are called on, so the pipeline runs them on a
+	// staging sample off the main thread and FinishGeneratedSample moves the
+	// staged data into the real sample on the main thread
+	bool			LoadGeneratedSample( idFile* fileIn );
+	bool			DecodeSampleData();
+	void			FinishGeneratedSample( idSoundSample& staged );
+	
+	// the 16 bit PCM frames between playBegin and the end of the sample for the mixer,
+	// NULL if the sample has none (defaulted, XMA2 or not decoded)
+	const int16* 	GetMixerFrames( int& numFrames ) const;
+	
 	void			SetName( const char* n )
 	{
 		name = n;
@@ -233,6 +273,20 @@ protected:
 	bool			LoadGeneratedSample( const idStr& name );
 	void			WriteGeneratedSample( idFile* fileOut );
 	
+	struct MS_ADPCM_decodeState_t
+	{
+		uint8 hPredictor;
+		int16 coef1;
+		int16 coef2;
+		
+		uint16 iDelta;
+		int16 iSamp1;
+		int16 iSamp2;
+	};
+	
+	int32			MS_ADPCM_nibble( MS_ADPCM_decodeState_t* state, int8 nybble );
+	int				MS_ADPCM_decode( uint8** audio_buf, uint32* audio_len );
+	
 	struct sampleBuffer_t
 	{
 		void* buffer;
@@ -259,6 +313,8 @@ protected:
 	
 	idWaveFile::waveFmt_t	format;
 	
+	bool			pcmDecoded;			// ADPCM buffers were already converted by DecodeSampleData
+	
 	idList<byte, TAG_AMPLITUDE> amplitude;
 };
 
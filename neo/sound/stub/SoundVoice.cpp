@@ -0,0 +1,228 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+#include "../snd_local.h"
+
+idCVar s_debugHardware( "s_debugHardware", "0", CVAR_BOOL, "Print a message any time a hardware voice changes" );
+
+/*
+========================
+idSoundVoice::idSoundVoice
+========================
+*/
+idSoundVoice::idSoundVoice()
+	:
+	mixerVoice( -1 ),
+	leadinSample( NULL ),
+	loopingSample( NULL ),
+	sampleRate( 0 ),
+	paused( true )
+{
+}
+
+/*
+========================
+idSoundVoice::Create
+========================
+*/
+void idSoundVoice::Create( const idSoundSample* leadinSample_, const idSoundSample* loopingSample_ )
+{
+	leadinSample = leadinSample_;
+	loopingSample = loopingSample_;
+	sampleRate = leadinSample->SampleRate();
+	paused = true;
+	
+	if( s_debugHardware.GetBool() )
+	{
+		if( loopingSample == NULL || loopingSample == leadinSample )
+		{
+			idLib::Printf( "%dms: %i created for %s\n", Sys_Milliseconds(), mixerVoice, leadinSample->GetName() );
+		}
+		else
+		{
+			idLib::Printf( "%dms: %i created for %s and %s\n", Sys_Milliseconds(), mixerVoice, leadinSample->GetName(), loopingSample->GetName() );
+		}
+	}
+}
+
+/*
+========================
+idSoundVoice::Start
+========================
+*/
+void idSoundVoice::Start( int offsetMS, int ssFlags )
+{
+	if( s_debugHardware.GetBool() )
+	{
+		idLib::Printf( "%dms: %i starting %s @ %dms\n", Sys_Milliseconds(), mixerVoice, leadinSample ? leadinSample->GetName() : "<null>", offsetMS );
+	}
+	
+	if( leadinSample == NULL )
+	{
+		return;
+	}
+	
+	if( leadinSample->IsDefault() )
+	{
+		idLib::Warning( "Starting defaulted sound sample %s", leadinSample->GetName() );
+	}
+	
+	assert( offsetMS >= 0 );
+	int offsetSamples = MsecToSamples( offsetMS, leadinSample->SampleRate() );
+	if( loopingSample == NULL && offsetSamples >= leadinSample->NumSamples() )
+	{
+		return;
+	}
+	
+	int leadinFrames = 0;
+	const int16* leadinData = leadinSample->GetMixerFrames( leadinFrames );
+	int loopingFrames = 0;
+	const int16* loopingData = ( loopingSample != NULL ) ? loopingSample->GetMixerFrames( loopingFrames ) : NULL;
+	
+	idSoundMixer& mixer = soundSystemLocal.hardware.mixer;
+	if( offsetSamples < leadinFrames || loopingData == NULL )
+	{
+		mixer.SetVoiceSource( mixerVoice, leadinData, leadinFrames, leadinSample->NumChannels(), leadinSample->SampleRate(), false );
+		mixer.SetVoiceLoop( mixerVoice, loopingData, loopingFrames );
+	}
+	else
+	{
+		// started after the leadin finished
+		mixer.SetVoiceSource( mixerVoice, loopingData, loopingFrames, loopingSample->NumChannels(), loopingSample->SampleRate(), true );
+		offsetSamples -= leadinFrames;
+	}
+	mixer.SetVoicePosition( mixerVoice, offsetSamples );
+	
+	Update();
+	UnPause();
+}
+
+/*
+========================
+idSoundVoice::Update
+========================
+*/
+bool idSoundVoice::Update()
+{
+	if( leadinSample == NULL )
+	{
+		return false;
+	}
+	
+	const int srcChannels = leadinSample->NumChannels();
+	
+	float pLevelMatrix[ MAX_CHANNELS_PER_VOICE * MAX_CHANNELS_PER_VOICE ] = { 0 };
+	CalculateSurround( srcChannels, pLevelMatrix, gain * soundSystemLocal.hardware.masterVolume );
+	
+	// the output is stereo, so the matrix is srcChannels x 2 and a stereo source only uses its diagonal
+	idSoundMixer& mixer = soundSystemLocal.hardware.mixer;
+	if( srcChannels == 1 )
+	{
+		mixer.SetVoiceVolume( mixerVoice, pLevelMatrix[0], pLevelMatrix[1] );
+	}
+	else
+	{
+		mixer.SetVoiceVolume( mixerVoice, pLevelMatrix[0], pLevelMatrix[3] );
+	}
+	mixer.SetVoicePitch( mixerVoice, pitch );
+	
+	return true;
+}
+
+/*
+========================
+idSoundVoice::IsPlaying
+========================
+*/
+bool idSoundVoice::IsPlaying() const
+{
+	return soundSystemLocal.hardware.mixer.IsVoicePlaying( mixerVoice );
+}
+
+/*
+========================
+idSoundVoice::Pause
+========================
+*/
+void idSoundVoice::Pause()
+{
+	if( paused )
+	{
+		return;
+	}
+	
+	if( s_debugHardware.GetBool() )
+	{
+		idLib::Printf( "%dms: %i pausing %s\n", Sys_Milliseconds(), mixerVoice, leadinSample ? leadinSample->GetName() : "<null>" );
+	}
+	
+	// the mixer keeps the position of a stopped voice
+	soundSystemLocal.hardware.mixer.StopVoice( mixerVoice );
+	paused = true;
+}
+
+/*
+========================
+idSoundVoice::UnPause
+========================
+*/
+void idSoundVoice::UnPause()
+{
+	if( !paused )
+	{
+		return;
+	}
+	
+	if( s_debugHardware.GetBool() )
+	{
+		idLib::Printf( "%dms: %i unpausing %s\n", Sys_Milliseconds(), mixerVoice, leadinSample ? leadinSample->GetName() : "<null>" );
+	}
+	
+	soundSystemLocal.hardware.mixer.StartVoice( mixerVoice );
+	paused = false;
+}
+
+/*
+========================
+idSoundVoice::Stop
+========================
+*/
+void idSoundVoice::Stop()
+{
+	if( !paused && s_debugHardware.GetBool() )
+	{
+		idLib::Printf( "%dms: %i stopping %s\n", Sys_Milliseconds(), mixerVoice, leadinSample ? leadinSample->GetName() : "<null>" );
+	}
+	
+	// drop the sample data too, the samples may be freed once the voice is stopped
+	idSoundMixer& mixer = soundSystemLocal.hardware.mixer;
+	mixer.StopVoice( mixerVoice );
+	mixer.SetVoiceSource( mixerVoice, NULL, 0, 1, 0, false );
+	paused = true;
+}
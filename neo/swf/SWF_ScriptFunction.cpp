@@ -32,6 +32,7 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar swf_debug( "swf_debug", "0", CVAR_INTEGER | CVAR_ARCHIVE, "debug swf scripts.  1 shows traces/errors.  2 also shows warnings.  3 also shows disassembly.  4 shows parameters in the disassembly." );
 idCVar swf_debugInvoke( "swf_debugInvoke", "0", CVAR_INTEGER, "debug swf functions being called from game." );
+idCVar swf_useInlineCaches( "swf_useInlineCaches", "1", CVAR_BOOL, "remember where member lookups were resolved at each call site in swf scripts" );
 
 idSWFConstantPool::idSWFConstantPool()
 {
@@ -68,6 +69,268 @@ void idSWFConstantPool::Copy( const idSWFConstantPool& other )
 	}
 }
 
+/*
+========================
+idSWFScriptProgram::~idSWFScriptProgram
+========================
+*/
+idSWFScriptProgram::~idSWFScriptProgram()
+{
+	for( int i = 0; i < constants.Num(); i++ )
+	{
+		constants[i]->Release();
+	}
+	for( int i = 0; i < functions.Num(); i++ )
+	{
+		if( functions[i].program != NULL )
+		{
+			functions[i].program->Release();
+		}
+	}
+	for( int i = 0; i < memberCaches.Num(); i++ )
+	{
+		if( memberCaches[i].name != NULL )
+		{
+			memberCaches[i].name->Release();
+		}
+	}
+}
+
+/*
+========================
+idSWFScriptProgram::Decode
+
+Every record is read the same way Run would have consumed it, records that Run
+can't handle are still skipped over so branches can land past them
+========================
+*/
+idSWFScriptProgram* idSWFScriptProgram::Decode( const byte* data, uint32 length )
+{
+	idSWFScriptProgram* program = new( TAG_SWF ) idSWFScriptProgram( data, length );
+	
+	// instruction starting at each byte, so branch offsets can be turned into instruction indexes
+	idList< int, TAG_SWF > offsetToInstruction;
+	offsetToInstruction.SetNum( length + 1 );
+	for( int i = 0; i < offsetToInstruction.Num(); i++ )
+	{
+		offsetToInstruction[i] = -1;
+	}
+	
+	idSWFBitStream bitstream( data, length, false );
+	while( bitstream.Tell() < bitstream.Length() )
+	{
+		offsetToInstruction[ bitstream.Tell() ] = program->instructions.Num();
+		
+		swfInstruction_t& instruction = program->instructions.Alloc();
+		instruction.code = ( swfAction_t )bitstream.ReadU8();
+		instruction.recordLength = 0;
+		instruction.arg0 = 0;
+		instruction.arg1 = 0;
+		instruction.target = NULL;
+		if( instruction.code >= 0x80 )
+		{
+			instruction.recordLength = bitstream.ReadU16();
+		}
+		
+		switch( instruction.code )
+		{
+			case Action_GotoFrame:
+				instruction.arg0 = bitstream.ReadU16() + 1;
+				break;
+			case Action_SetTarget:
+			case Action_GoToLabel:
+				instruction.target = ( const char* )bitstream.ReadData( instruction.recordLength );
+				break;
+			case Action_Push:
+			{
+				instruction.arg0 = program->pushValues.Num();
+				idSWFBitStream pushstream( bitstream.ReadData( instruction.recordLength ), instruction.recordLength, false );
+				while( pushstream.Tell() < pushstream.Length() )
+				{
+					swfPushValue_t& push = program->pushValues.Alloc();
+					push.type = pushstream.ReadU8();
+					push.index = 0;
+					switch( push.type )
+					{
+						case 0:
+							push.value.SetString( pushstream.ReadString() );
+							break;
+						case 1:
+							push.value.SetFloat( pushstream.ReadFloat() );
+							break;
+						case 2:
+							push.value.SetNULL();
+							break;
+						case 3:
+							push.value.SetUndefined();
+							break;
+						case 4:
+							push.index = pushstream.ReadU8();
+							break;
+						case 5:
+							push.value.SetBool( pushstream.ReadU8() != 0 );
+							break;
+						case 6:
+							push.value.SetFloat( ( float )pushstream.ReadDouble() );
+							break;
+						case 7:
+							push.value.SetInteger( pushstream.ReadS32() );
+							break;
+						case 8:
+							push.index = pushstream.ReadU8();
+							break;
+						case 9:
+							push.index = pushstream.ReadU16();
+							break;
+						default:
+							// nothing gets pushed for these
+							program->pushValues.SetNum( program->pushValues.Num() - 1 );
+							break;
+					}
+				}
+				instruction.arg1 = program->pushValues.Num() - instruction.arg0;
+				break;
+			}
+			case Action_Jump:
+			case Action_If:
+			{
+				int16 offset = bitstream.ReadS16();
+				instruction.arg0 = ( int )bitstream.Tell() + offset;
+				break;
+			}
+			case Action_GotoFrame2:
+				instruction.arg0 = bitstream.ReadU8();
+				if( instruction.arg0 & 2 )
+				{
+					instruction.arg1 = bitstream.ReadU16();
+				}
+				break;
+			case Action_ConstantPool:
+			{
+				uint16 numConstants = bitstream.ReadU16();
+				instruction.arg0 = program->constants.Num();
+				instruction.arg1 = numConstants;
+				for( int i = 0; i < numConstants; i++ )
+				{
+					program->constants.Append( idSWFScriptString::Alloc( bitstream.ReadString() ) );
+				}
+				break;
+			}
+			case Action_DefineFunction:
+			case Action_DefineFunction2:
+			{
+				instruction.arg0 = program->functions.Num();
+				
+				swfFunctionDef_t& function = program->functions.Alloc();
+				function.name = bitstream.ReadString();
+				function.numParms = bitstream.ReadU16();
+				function.numRegs = 0;
+				function.flags = 0;
+				function.firstParm = program->parms.Num();
+				function.program = NULL;
+				
+				if( instruction.code == Action_DefineFunction2 )
+				{
+					// The number of registers is from 0 to 255, although valid values are 1 to 256.
+					// There must always be at least one register for DefineFunction2, to hold "this" or "super" when required.
+					function.numRegs = bitstream.ReadU8() + 1;
+					
+					// Note that SWF byte-ordering causes the flag bits to be reversed per-byte
+					// from how the swf_file_format_spec_v10.pdf document describes the ordering in ActionDefineFunction2.
+					// PreloadThisFlag is byte 0, not 7, PreloadGlobalFlag is 8, not 15.
+					function.flags = bitstream.ReadU16();
+				}
+				
+				for( int i = 0; i < function.numParms; i++ )
+				{
+					swfParmDef_t& parm = program->parms.Alloc();
+					parm.reg = 0;
+					if( instruction.code == Action_DefineFunction2 )
+					{
+						parm.reg = bitstream.ReadU8();
+					}
+					parm.name = bitstream.ReadString();
+					if( instruction.code == Action_DefineFunction2 && parm.reg >= function.numRegs )
+					{
+						idLib::Warning( "SWF: Parameter %s in function %s bound to out of range register %d", parm.name, function.name, parm.reg );
+						parm.reg = 0;
+					}
+				}
+				
+				// the body gets decoded into its own program the first time the function is defined
+				function.length = bitstream.ReadU16();
+				function.data = bitstream.ReadData( function.length );
+				break;
+			}
+			case Action_With:
+			{
+				int withSize = bitstream.ReadU16();
+				instruction.arg0 = ( int )bitstream.Tell() + withSize;
+				break;
+			}
+			case Action_StoreRegister:
+				instruction.arg0 = bitstream.ReadU8();
+				break;
+			case Action_GetMember:
+			case Action_SetMember:
+			case Action_CallMethod:
+				instruction.arg0 = program->memberCaches.Num();
+				program->memberCaches.Alloc();
+				break;
+			default:
+				if( instruction.code >= 0x80 )
+				{
+					bitstream.ReadData( instruction.recordLength );
+				}
+				break;
+		}
+	}
+	offsetToInstruction[ length ] = program->instructions.Num();
+	
+	// branches that don't land on an instruction end the script, just like seeking off the end of the bitstream did
+	for( int i = 0; i < program->instructions.Num(); i++ )
+	{
+		swfInstruction_t& instruction = program->instructions[i];
+		if( instruction.code == Action_Jump || instruction.code == Action_If )
+		{
+			int target = instruction.arg0;
+			instruction.arg0 = ( target >= 0 && target <= ( int )length ) ? offsetToInstruction[ target ] : -1;
+		}
+		else if( instruction.code == Action_With )
+		{
+			int target = instruction.arg0;
+			instruction.arg0 = ( target >= 0 && target <= ( int )length ) ? offsetToInstruction[ target ] : -1;
+			if( instruction.arg0 < i )
+			{
+				instruction.arg0 = program->instructions.Num();
+			}
+		}
+	}
+	
+	return program;
+}
+
+/*
+========================
+idSWFScriptProgram::GetMemberCache
+========================
+*/
+swfPropertyCache_t& idSWFScriptProgram::GetMemberCache( int n, idSWFScriptString* name )
+{
+	swfMemberCache_t& cache = memberCaches[n];
+	if( cache.name != name )
+	{
+		name->AddRef();
+		if( cache.name != NULL )
+		{
+			cache.name->Release();
+		}
+		cache.name = name;
+		cache.property = swfPropertyCache_t();
+	}
+	return cache.property;
+}
+
 /*
 ========================
 idSWFScriptFunction_Script::~idSWFScriptFunction_Script
@@ -75,6 +338,10 @@ idSWFScriptFunction_Script::~idSWFScriptFunction_Script
 */
 idSWFScriptFunction_Script::~idSWFScriptFunction_Script()
 {
+	if( program != NULL )
+	{
+		program->Release();
+	}
 	for( int i = 0; i < scope.Num(); i++ )
 	{
 		if( verify( scope[i] ) )
@@ -88,6 +355,39 @@ idSWFScriptFunction_Script::~idSWFScriptFunction_Script()
 	}
 }
 
+/*
+========================
+idSWFScriptFunction_Script::SetData
+========================
+*/
+void idSWFScriptFunction_Script::SetData( const byte* _data, uint32 _length )
+{
+	if( program != NULL )
+	{
+		program->Release();
+		program = NULL;
+	}
+	data = _data;
+	length = _length;
+}
+
+/*
+========================
+idSWFScriptFunction_Script::SetProgram
+========================
+*/
+void idSWFScriptFunction_Script::SetProgram( idSWFScriptProgram* _program )
+{
+	_program->AddRef();
+	if( program != NULL )
+	{
+		program->Release();
+	}
+	program = _program;
+	data = program->data;
+	length = program->length;
+}
+
 /*
 ========================
 idSWFScriptFunction_Script::Call
@@ -121,7 +421,10 @@ idSWFScriptFunction_Script::Call
 */
 idSWFScriptVar idSWFScriptFunction_Script::Call( idSWFScriptObject* thisObject, const idSWFParmList& parms )
 {
-	idSWFBitStream bitstream( data, length, false );
+	if( program == NULL )
+	{
+		program = idSWFScriptProgram::Decode( data, length );
+	}
 	
 	// We assume scope[0] is the global scope
 	assert( scope.Num() > 0 );
@@ -249,7 +552,11 @@ idSWFScriptVar idSWFScriptFunction_Script::Call( idSWFScriptObject* thisObject,
 	scope.Append( locals );
 	locals->AddRef();
 	
-	idSWFScriptVar retVal = Run( thisObject, stack, bitstream );
+	// the script can swap out this function's program while it's running
+	idSWFScriptProgram* runProgram = program;
+	runProgram->AddRef();
+	idSWFScriptVar retVal = Run( runProgram, thisObject, stack, 0, runProgram->instructions.Num() );
+	runProgram->Release();
 	
 	assert( scope.Num() == scopeSize + 1 );
 	for( int i = scopeSize; i < scope.Num(); i++ )
@@ -555,7 +862,7 @@ const char* GetSwfActionName( swfAction_t code )
 idSWFScriptFunction_Script::Run
 ========================
 */
-idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, idSWFStack& stack, idSWFBitStream& bitstream )
+idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptProgram* runProgram, idSWFScriptObject* thisObject, idSWFStack& stack, int firstInstruction, int endInstruction )
 {
 	static int callstackLevel = -1;
 	idSWFSpriteInstance* thisSprite = thisObject->GetSprite();
@@ -568,14 +875,11 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 	
 	callstackLevel++;
 	
-	while( bitstream.Tell() < bitstream.Length() )
+	int pc = firstInstruction;
+	while( pc >= firstInstruction && pc < endInstruction )
 	{
-		swfAction_t code = ( swfAction_t )bitstream.ReadU8();
-		uint16 recordLength = 0;
-		if( code >= 0x80 )
-		{
-			recordLength = bitstream.ReadU16();
-		}
+		const idSWFScriptProgram::swfInstruction_t& instruction = runProgram->instructions[ pc++ ];
+		swfAction_t code = instruction.code;
 		
 		if( swf_debug.GetInteger() >= 3 )
 		{
@@ -653,8 +957,8 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 				break;
 			case Action_GotoFrame:
 			{
-				assert( recordLength == 2 );
-				int frameNum = bitstream.ReadU16() + 1;
+				assert( instruction.recordLength == 2 );
+				int frameNum = instruction.arg0;
 				if( verify( currentTarget != NULL ) )
 				{
 					currentTarget->RunTo( frameNum );
@@ -667,7 +971,7 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			}
 			case Action_SetTarget:
 			{
-				const char* targetName = ( const char* )bitstream.ReadData( recordLength );
+				const char* targetName = instruction.target;
 				if( verify( thisSprite != NULL ) )
 				{
 					currentTarget = thisSprite->ResolveTarget( targetName );
@@ -680,7 +984,7 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			}
 			case Action_GoToLabel:
 			{
-				const char* targetName = ( const char* )bitstream.ReadData( recordLength );
+				const char* targetName = instruction.target;
 				if( verify( currentTarget != NULL ) )
 				{
 					currentTarget->RunTo( currentTarget->FindFrame( targetName ) );
@@ -693,41 +997,20 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			}
 			case Action_Push:
 			{
-				idSWFBitStream pushstream( bitstream.ReadData( recordLength ), recordLength, false );
-				while( pushstream.Tell() < pushstream.Length() )
+				for( int i = 0; i < instruction.arg1; i++ )
 				{
-					uint8 type = pushstream.ReadU8();
-					switch( type )
+					const idSWFScriptProgram::swfPushValue_t& push = runProgram->pushValues[ instruction.arg0 + i ];
+					switch( push.type )
 					{
-						case 0:
-							stack.Alloc().SetString( pushstream.ReadString() );
-							break;
-						case 1:
-							stack.Alloc().SetFloat( pushstream.ReadFloat() );
-							break;
-						case 2:
-							stack.Alloc().SetNULL();
-							break;
-						case 3:
-							stack.Alloc().SetUndefined();
-							break;
 						case 4:
-							stack.Alloc() = registers[ pushstream.ReadU8() ];
-							break;
-						case 5:
-							stack.Alloc().SetBool( pushstream.ReadU8() != 0 );
-							break;
-						case 6:
-							stack.Alloc().SetFloat( ( float )pushstream.ReadDouble() );
-							break;
-						case 7:
-							stack.Alloc().SetInteger( pushstream.ReadS32() );
+							stack.Alloc() = registers[ push.index ];
 							break;
 						case 8:
-							stack.Alloc().SetString( constants.Get( pushstream.ReadU8() ) );
-							break;
 						case 9:
-							stack.Alloc().SetString( constants.Get( pushstream.ReadU16() ) );
+							stack.Alloc().SetString( constants.Get( push.index ) );
+							break;
+						default:
+							stack.Alloc() = push.value;
 							break;
 					}
 				}
@@ -804,14 +1087,13 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 				stack.A().SetString( va( "%c", stack.A().ToInteger() ) );
 				break;
 			case Action_Jump:
-				bitstream.Seek( bitstream.ReadS16() );
+				pc = instruction.arg0;
 				break;
 			case Action_If:
 			{
-				int16 offset = bitstream.ReadS16();
 				if( stack.A().ToBool() )
 				{
-					bitstream.Seek( offset );
+					pc = instruction.arg0;
 				}
 				stack.Pop( 1 );
 				break;
@@ -856,12 +1138,8 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			case Action_GotoFrame2:
 			{
 			
-				uint32 frameNum = 0;
-				uint8 flags = bitstream.ReadU8();
-				if( flags & 2 )
-				{
-					frameNum += bitstream.ReadU16();
-				}
+				uint32 frameNum = instruction.arg1;
+				uint8 flags = instruction.arg0;
 				
 				if( verify( thisSprite != NULL ) )
 				{
@@ -986,7 +1264,15 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 				if( stack.B().IsObject() )
 				{
 					object = stack.B().GetObject();
-					function = object->Get( functionName );
+					idSWFScriptString* memberName = stack.A().GetScriptString();
+					if( memberName != NULL && !memberName->IsEmpty() && swf_useInlineCaches.GetBool() )
+					{
+						function = object->Get( memberName->c_str(), runProgram->GetMemberCache( instruction.arg0, memberName ) );
+					}
+					else
+					{
+						function = object->Get( functionName );
+					}
 					if( !function.IsFunction() )
 					{
 						idLib::PrintfIf( swf_debug.GetInteger() > 1, "SWF: unknown method %s on %s\n", functionName.c_str(), object->DefaultValue( true ).ToString().c_str() );
@@ -1021,88 +1307,50 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			case Action_ConstantPool:
 			{
 				constants.Clear();
-				uint16 numConstants = bitstream.ReadU16();
-				for( int i = 0; i < numConstants; i++ )
+				for( int i = 0; i < instruction.arg1; i++ )
 				{
-					constants.Append( idSWFScriptString::Alloc( bitstream.ReadString() ) );
+					idSWFScriptString* constant = runProgram->constants[ instruction.arg0 + i ];
+					constant->AddRef();
+					constants.Append( constant );
 				}
 				break;
 			}
 			case Action_DefineFunction:
+			case Action_DefineFunction2:
 			{
-				idStr functionName = bitstream.ReadString();
-				
-				idSWFScriptFunction_Script* newFunction = idSWFScriptFunction_Script::Alloc();
-				newFunction->SetScope( scope );
-				newFunction->SetConstants( constants );
-				newFunction->SetDefaultSprite( defaultSprite );
-				
-				uint16 numParms = bitstream.ReadU16();
-				newFunction->AllocParameters( numParms );
-				for( int i = 0; i < numParms; i++ )
-				{
-					newFunction->SetParameter( i, 0, bitstream.ReadString() );
-				}
-				uint16 codeSize = bitstream.ReadU16();
-				newFunction->SetData( bitstream.ReadData( codeSize ), codeSize );
-				
-				if( functionName.IsEmpty() )
+				idSWFScriptProgram::swfFunctionDef_t& function = runProgram->functions[ instruction.arg0 ];
+				if( function.program == NULL )
 				{
-					stack.Alloc().SetFunction( newFunction );
-				}
-				else
-				{
-					thisObject->Set( functionName, idSWFScriptVar( newFunction ) );
+					function.program = idSWFScriptProgram::Decode( function.data, function.length );
 				}
-				newFunction->Release();
-				break;
-			}
-			case Action_DefineFunction2:
-			{
-				idStr functionName = bitstream.ReadString();
 				
 				idSWFScriptFunction_Script* newFunction = idSWFScriptFunction_Script::Alloc();
 				newFunction->SetScope( scope );
 				newFunction->SetConstants( constants );
 				newFunction->SetDefaultSprite( defaultSprite );
 				
-				uint16 numParms = bitstream.ReadU16();
-				
-				// The number of registers is from 0 to 255, although valid values are 1 to 256.
-				// There must always be at least one register for DefineFunction2, to hold "this" or "super" when required.
-				uint8 numRegs = bitstream.ReadU8() + 1;
-				
-				// Note that SWF byte-ordering causes the flag bits to be reversed per-byte
-				// from how the swf_file_format_spec_v10.pdf document describes the ordering in ActionDefineFunction2.
-				// PreloadThisFlag is byte 0, not 7, PreloadGlobalFlag is 8, not 15.
-				uint16 flags = bitstream.ReadU16();
-				
-				newFunction->AllocParameters( numParms );
-				newFunction->AllocRegisters( numRegs );
-				newFunction->SetFlags( flags );
+				newFunction->AllocParameters( function.numParms );
+				if( code == Action_DefineFunction2 )
+				{
+					newFunction->AllocRegisters( function.numRegs );
+					newFunction->SetFlags( function.flags );
+				}
 				
-				for( int i = 0; i < numParms; i++ )
+				for( int i = 0; i < function.numParms; i++ )
 				{
-					uint8 reg = bitstream.ReadU8();
-					const char* name = bitstream.ReadString();
-					if( reg >= numRegs )
-					{
-						idLib::Warning( "SWF: Parameter %s in function %s bound to out of range register %d", name, functionName.c_str(), reg );
-						reg = 0;
-					}
-					newFunction->SetParameter( i, reg, name );
+					const idSWFScriptProgram::swfParmDef_t& parm = runProgram->parms[ function.firstParm + i ];
+					newFunction->SetParameter( i, parm.reg, parm.name );
 				}
 				
-				uint16 codeSize = bitstream.ReadU16();
-				newFunction->SetData( bitstream.ReadData( codeSize ), codeSize );
+				newFunction->SetProgram( function.program );
 				
-				if( functionName.IsEmpty() )
+				if( function.name[0] == '\0' )
 				{
 					stack.Alloc().SetFunction( newFunction );
 				}
 				else
 				{
-					thisObject->Set( functionName, idSWFScriptVar( newFunction ) );
+					thisObject->Set( function.name, idSWFScriptVar( newFunction ) );
 				}
 				newFunction->Release();
 				break;
@@ -1179,6 +1427,11 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 					{
 						stack.B() = object->Get( stack.A().ToInteger() );
 					}
+					else if( stack.A().GetScriptString() != NULL && swf_useInlineCaches.GetBool() )
+					{
+						idSWFScriptString* memberName = stack.A().GetScriptString();
+						stack.B() = object->Get( memberName->c_str(), runProgram->GetMemberCache( instruction.arg0, memberName ) );
+					}
 					else
 					{
 						stack.B() = object->Get( stack.A().ToString() );
@@ -1247,6 +1500,11 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 					{
 						object->Set( stack.B().ToInteger(), stack.A() );
 					}
+					else if( stack.B().GetScriptString() != NULL && swf_useInlineCaches.GetBool() )
+					{
+						idSWFScriptString* memberName = stack.B().GetScriptString();
+						object->Set( memberName->c_str(), stack.A(), runProgram->GetMemberCache( instruction.arg0, memberName ) );
+					}
 					else
 					{
 						object->Set( stack.B().ToString(), stack.A() );
@@ -1390,15 +1648,14 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			}
 			case Action_With:
 			{
-				int withSize = bitstream.ReadU16();
-				idSWFBitStream bitstream2( bitstream.ReadData( withSize ), withSize, false );
+				int bodyEnd = instruction.arg0;
 				if( stack.A().IsObject() )
 				{
 					idSWFScriptObject* withObject = stack.A().GetObject();
 					withObject->AddRef();
 					stack.Pop( 1 );
 					scope.Append( withObject );
-					Run( thisObject, stack, bitstream2 );
+					Run( runProgram, thisObject, stack, pc, bodyEnd );
 					scope.SetNum( scope.Num() - 1 );
 					withObject->Release();
 				}
@@ -1410,6 +1667,7 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 					}
 					stack.Pop( 1 );
 				}
+				pc = bodyEnd;
 				break;
 			}
 			case Action_ToNumber:
@@ -1520,7 +1778,7 @@ idSWFScriptVar idSWFScriptFunction_Script::Run( idSWFScriptObject* thisObject, i
 			}
 			case Action_StoreRegister:
 			{
-				uint8 registerNumber = bitstream.ReadU8();
+				uint8 registerNumber = instruction.arg0;
 				registers[ registerNumber ] = stack.A();
 				break;
 			}
@@ -178,6 +178,99 @@ public:
 	}
 };
 
+/*
+========================
+Action script bytecode decoded once into a flat list of instructions, so running it
+doesn't have to parse the bitstream again every time. Branch offsets are resolved to
+instruction indexes, pushed strings and constant pools are allocated up front and every
+member access gets its own property cache. A program is shared by all the functions
+defined from the same bytecode.
+========================
+*/
+class idSWFScriptProgram
+{
+public:
+	static idSWFScriptProgram* 	Decode( const byte* data, uint32 length );
+	
+	void	AddRef()
+	{
+		refCount++;
+	}
+	void	Release()
+	{
+		if( --refCount == 0 )
+		{
+			delete this;
+		}
+	}
+	
+	const byte* 	GetData() const
+	{
+		return data;
+	}
+	
+private:
+	friend class idSWFScriptFunction_Script;
+	
+	idSWFScriptProgram( const byte* _data, uint32 _length ) : refCount( 1 ), data( _data ), length( _length ) { }
+	~idSWFScriptProgram();
+	
+	struct swfInstruction_t
+	{
+		swfAction_t		code;
+		uint16			recordLength;
+		int				arg0;		// depends on the code, see Decode
+		int				arg1;
+		const char* 	target;		// SetTarget and GoToLabel
+	};
+	
+	struct swfPushValue_t
+	{
+		uint8			type;		// the Action_Push type byte
+		uint16			index;		// register or constant
+		idSWFScriptVar	value;		// everything else
+	};
+	
+	struct swfFunctionDef_t
+	{
+		const char* 		name;
+		uint16				numParms;
+		uint8				numRegs;	// DefineFunction2 only
+		uint16				flags;
+		int					firstParm;
+		const byte* 		data;
+		uint16				length;
+		idSWFScriptProgram* program;	// decoded the first time the function is defined
+	};
+	
+	struct swfParmDef_t
+	{
+		const char* 	name;
+		uint8			reg;
+	};
+	
+	struct swfMemberCache_t
+	{
+		swfMemberCache_t() : name( NULL ) { }
+		
+		idSWFScriptString* 	name;	// only hits if the same string is looked up again
+		swfPropertyCache_t	property;
+	};
+	
+	swfPropertyCache_t& 	GetMemberCache( int n, idSWFScriptString* name );
+	
+	int											refCount;
+	const byte* 								data;
+	uint32										length;
+	
+	idList< swfInstruction_t, TAG_SWF >			instructions;
+	idList< swfPushValue_t, TAG_SWF >			pushValues;
+	idList< idSWFScriptString*, TAG_SWF >		constants;
+	idList< swfFunctionDef_t, TAG_SWF >			functions;
+	idList< swfParmDef_t, TAG_SWF >				parms;
+	idList< swfMemberCache_t, TAG_SWF >			memberCaches;
+};
+
 /*
 ========================
 idSWFScriptFunction_Script is a script function that's implemented in action script
@@ -186,7 +279,7 @@ idSWFScriptFunction_Script is a script function that's implemented in action scr
 class idSWFScriptFunction_Script : public idSWFScriptFunction
 {
 public:
-	idSWFScriptFunction_Script() : refCount( 1 ), flags( 0 ), data( NULL ), length( 0 ), prototype( NULL ), defaultSprite( NULL )
+	idSWFScriptFunction_Script() : refCount( 1 ), flags( 0 ), data( NULL ), length( 0 ), program( NULL ), prototype( NULL ), defaultSprite( NULL )
 	{
 		registers.SetNum( 4 );
 	}
@@ -213,11 +306,9 @@ public:
 	{
 		flags = _flags;
 	}
-	void	SetData( const byte* _data, uint32 _length )
-	{
-		data = _data;
-		length = _length;
-	}
+	void	SetData( const byte* _data, uint32 _length );
+	// Same as SetData, but with code that's already been decoded
+	void	SetProgram( idSWFScriptProgram* _program );
 	void	SetScope( idList<idSWFScriptObject*>& scope );
 	void	SetConstants( const idSWFConstantPool& _constants )
 	{
@@ -255,7 +346,7 @@ public:
 	virtual idSWFScriptVar	Call( idSWFScriptObject* thisObject, const idSWFParmList& parms );
 	
 private:
-	idSWFScriptVar Run( idSWFScriptObject* thisObject, idSWFStack& stack, idSWFBitStream& bitstream );
+	idSWFScriptVar Run( idSWFScriptProgram* runProgram, idSWFScriptObject* thisObject, idSWFStack& stack, int firstInstruction, int endInstruction );
 	
 private:
 	int					refCount;
@@ -263,6 +354,7 @@ private:
 	uint16				flags;
 	const  byte* 		data;
 	uint32				length;
+	idSWFScriptProgram* program;		// decoded data, created on the first call if it wasn't set
 	idSWFScriptObject* prototype;
 	
 	idSWFSpriteInstance* defaultSprite;		// some actions have an implicit sprite they work off of (e.g. Action_GotoFrame outside of object scope)
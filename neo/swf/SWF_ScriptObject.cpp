@@ -32,6 +32,23 @@ If you have questions concerning this license or the applicable additional terms
 
 idCVar swf_debugShowAddress( "swf_debugShowAddress", "0", CVAR_BOOL, "shows addresses along with object types when they are serialized" );
 
+static int swfNextShape = 1;
+
+/*
+========================
+NewShape
+========================
+*/
+static int NewShape()
+{
+	int newShape = swfNextShape++;
+	if( swfNextShape <= 0 )
+	{
+		swfNextShape = 1;
+	}
+	return newShape;
+}
+
 
 /*
 ========================
@@ -66,7 +83,7 @@ idSWFScriptObject::swfNamedVar_t& idSWFScriptObject::swfNamedVar_t::operator=( c
 idSWFScriptObject::idSWFScriptObject
 ========================
 */
-idSWFScriptObject::idSWFScriptObject() : refCount( 1 ), noAutoDelete( false ), prototype( NULL ), objectType( SWF_OBJECT_OBJECT )
+idSWFScriptObject::idSWFScriptObject() : refCount( 1 ), noAutoDelete( false ), prototype( NULL ), shape( 0 ), objectType( SWF_OBJECT_OBJECT )
 {
 	data.sprite = NULL;
 	data.text = NULL;
@@ -132,6 +149,7 @@ void idSWFScriptObject::Clear()
 	{
 		variablesHash[i] = -1;
 	}
+	shape = NewShape();
 }
 
 /*
@@ -337,6 +355,8 @@ void idSWFScriptObject::Set( const char* name, const idSWFScriptVar& value )
 				variables[i].hashNext = variablesHash[hash];
 				variablesHash[hash] = i;
 			}
+			// variables moved around, forget any cached lookups
+			shape = NewShape();
 		}
 		else
 		{
@@ -363,6 +383,56 @@ void idSWFScriptObject::Set( const char* name, const idSWFScriptVar& value )
 	}
 }
 
+/*
+========================
+idSWFScriptObject::Get
+========================
+*/
+idSWFScriptVar idSWFScriptObject::Get( const char* name, swfPropertyCache_t& cache )
+{
+	swfNamedVar_t* variable = GetVariable( name, false, cache );
+	if( variable == NULL )
+	{
+		return idSWFScriptVar();
+	}
+	else
+	{
+		if( variable->native )
+		{
+			return variable->native->Get( this );
+		}
+		else
+		{
+			return variable->value;
+		}
+	}
+}
+
+/*
+========================
+idSWFScriptObject::Set
+========================
+*/
+void idSWFScriptObject::Set( const char* name, const idSWFScriptVar& value, swfPropertyCache_t& cache )
+{
+	if( objectType == SWF_OBJECT_ARRAY )
+	{
+		// arrays have to keep their length in sync
+		Set( name, value );
+		return;
+	}
+	
+	swfNamedVar_t* variable = GetVariable( name, true, cache );
+	if( variable->native )
+	{
+		variable->native->Set( this, value );
+	}
+	else if( ( variable->flags & SWF_VAR_FLAG_READONLY ) == 0 )
+	{
+		variable->value = value;
+	}
+}
+
 /*
 ========================
 idSWFScriptObject::Set
@@ -561,6 +631,60 @@ idSWFScriptObject::swfNamedVar_t* idSWFScriptObject::GetVariable( const char* na
 	return NULL;
 }
 
+/*
+========================
+idSWFScriptObject::GetVariable
+
+Only lookups that end in the object itself or in its direct prototype are cached,
+anything further up the prototype chain goes through the hash every time
+========================
+*/
+idSWFScriptObject::swfNamedVar_t* idSWFScriptObject::GetVariable( const char* name, bool create, swfPropertyCache_t& cache )
+{
+	if( cache.shape == shape )
+	{
+		if( cache.protoShape == 0 )
+		{
+			return &variables[ cache.index ];
+		}
+		if( prototype != NULL && prototype->shape == cache.protoShape && variables.Num() == cache.numVariables )
+		{
+			swfNamedVar_t* variable = &prototype->variables[ cache.index ];
+			if( variable->native != NULL || !create )
+			{
+				return variable;
+			}
+		}
+	}
+	
+	swfNamedVar_t* variable = GetVariable( name, create );
+	
+	cache.shape = 0;
+	if( variable == NULL )
+	{
+		return NULL;
+	}
+	const swfNamedVar_t* ownVariables = variables.Ptr();
+	if( variable >= ownVariables && variable < ownVariables + variables.Num() )
+	{
+		cache.shape = shape;
+		cache.protoShape = 0;
+		cache.index = variable - ownVariables;
+	}
+	else if( prototype != NULL )
+	{
+		const swfNamedVar_t* protoVariables = prototype->variables.Ptr();
+		if( variable >= protoVariables && variable < protoVariables + prototype->variables.Num() )
+		{
+			cache.shape = shape;
+			cache.protoShape = prototype->shape;
+			cache.numVariables = variables.Num();
+			cache.index = variable - protoVariables;
+		}
+	}
+	return variable;
+}
+
 /*
 ========================
 idSWFScriptObject::MakeArray
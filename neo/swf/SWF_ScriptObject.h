@@ -99,6 +99,23 @@ protected:
 		idSWFScriptVar Get( class idSWFScriptObject * object ) { return pThis->z; }	\
 	} swfScriptVar_##x;
 
+/*
+========================
+Remembers where a named lookup on an object was resolved. Every object carries a shape
+number that changes whenever one of its variables could move, so a call site that keeps
+seeing the same object can go straight to the variable without hashing the name again.
+========================
+*/
+struct swfPropertyCache_t
+{
+	swfPropertyCache_t() : shape( 0 ), protoShape( 0 ), numVariables( 0 ), index( -1 ) { }
+	
+	int		shape;			// 0 when nothing is cached
+	int		protoShape;		// 0 when the variable is the object's own
+	int		numVariables;	// a new own variable could hide the one found in the prototype
+	int		index;
+};
+
 /*
 ========================
 An object in an action script is a collection of variables. functions are also variables.
@@ -163,6 +180,9 @@ public:
 	idSWFTextInstance* 		GetText( const char* name );
 	void					Set( int index, const idSWFScriptVar& value );
 	void					Set( const char* name, const idSWFScriptVar& value );
+	// same as above, for script call sites that look up the same name over and over
+	idSWFScriptVar			Get( const char* name, swfPropertyCache_t& cache );
+	void					Set( const char* name, const idSWFScriptVar& value, swfPropertyCache_t& cache );
 	void					SetNative( const char* name, idSWFScriptNativeVariable* native );
 	bool					HasProperty( const char* name );
 	bool					HasValidProperty( const char* name );
@@ -215,6 +235,8 @@ private:
 	
 	idSWFScriptObject* 		prototype;
 	
+	int						shape;
+	
 	enum swfObjectType_t
 	{
 		SWF_OBJECT_OBJECT,
@@ -231,6 +253,7 @@ private:
 	
 	swfNamedVar_t* 	GetVariable( int index, bool create );
 	swfNamedVar_t* 	GetVariable( const char* name, bool create );
+	swfNamedVar_t* 	GetVariable( const char* name, bool create, swfPropertyCache_t& cache );
 };
 
 #endif // !__SWF_SCRIPTOBJECT_H__
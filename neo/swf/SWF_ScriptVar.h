@@ -192,6 +192,11 @@ public:
 		assert( type == SWF_VAR_FUNCTION );
 		return value.function;
 	}
+	// the shared string of a SWF_VAR_STRING, NULL for every other type including string ids
+	idSWFScriptString* 		GetScriptString() const
+	{
+		return ( type == SWF_VAR_STRING ) ? value.string : NULL;
+	}
 	idSWFSpriteInstance* 	ToSprite();
 	idSWFTextInstance* 		ToText();
 	
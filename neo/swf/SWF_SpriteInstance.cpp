@@ -89,7 +89,7 @@ void idSWFSpriteInstance::Init( idSWFSprite* _sprite, idSWFSpriteInstance* _pare
 	
 	for( int i = 0; i < sprite->doInitActions.Num(); i++ )
 	{
-		actionScript->SetData( sprite->doInitActions[i].Ptr(), sprite->doInitActions[i].Length() );
+		actionScript->SetProgram( sprite->GetActionProgram( sprite->doInitActions[i].Ptr(), sprite->doInitActions[i].Length() ) );
 		actionScript->Call( scriptObject, idSWFParmList() );
 	}
 	
@@ -331,7 +331,7 @@ bool idSWFSpriteInstance::RunActions()
 	
 	for( int i = 0; i < actions.Num(); i++ )
 	{
-		actionScript->SetData( actions[i].data, actions[i].dataLength );
+		actionScript->SetProgram( sprite->GetActionProgram( actions[i].data, actions[i].dataLength ) );
 		actionScript->Call( scriptObject, idSWFParmList() );
 	}
 	actions.SetNum( 0 );
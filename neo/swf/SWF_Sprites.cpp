@@ -49,9 +49,35 @@ idSWFSprite::~idSWFSprite
 */
 idSWFSprite::~idSWFSprite()
 {
+	for( int i = 0; i < actionPrograms.Num(); i++ )
+	{
+		actionPrograms[i]->Release();
+	}
 	Mem_Free( commandBuffer );
 }
 
+/*
+========================
+idSWFSprite::GetActionProgram
+
+Every instance of the sprite runs the same frame actions, so they're decoded once here
+========================
+*/
+idSWFScriptProgram* idSWFSprite::GetActionProgram( const byte* data, uint32 length )
+{
+	int hash = actionProgramHash.GenerateKey( ( int )( ( intptr_t )data >> 2 ) );
+	for( int i = actionProgramHash.First( hash ); i != -1; i = actionProgramHash.Next( i ) )
+	{
+		if( actionPrograms[i]->GetData() == data )
+		{
+			return actionPrograms[i];
+		}
+	}
+	idSWFScriptProgram* program = idSWFScriptProgram::Decode( data, length );
+	actionProgramHash.Add( hash, actionPrograms.Append( program ) );
+	return program;
+}
+
 /*
 ========================
 idSWF::DefineSprite
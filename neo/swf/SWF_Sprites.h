@@ -53,6 +53,9 @@ public:
 		return swf;
 	}
 	
+	// Returns the decoded version of a DoAction or DoInitAction in this sprite
+	class idSWFScriptProgram* GetActionProgram( const byte* data, uint32 length );
+	
 private:
 	friend class idSWFSpriteInstance;
 	friend class idSWFScriptFunction_Script;
@@ -84,6 +87,8 @@ private:
 	
 	byte* commandBuffer;
 	
+	idList< class idSWFScriptProgram*, TAG_SWF > actionPrograms;
+	idHashIndex actionProgramHash;
 };
 
 #endif // !__SWF_SPRITES_H__
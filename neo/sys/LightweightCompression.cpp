@@ -434,6 +434,371 @@ void idLZWCompressor::ClearHash()
 	memset( hash, 0xFF, sizeof( hash ) );
 }
 
+/*
+========================
+ByteLZRead32
+========================
+*/
+ID_INLINE static uint32 ByteLZRead32( const uint8* p )
+{
+	uint32 value;
+	memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+/*
+========================
+ByteLZHash
+========================
+*/
+ID_INLINE static int ByteLZHash( uint32 sequence )
+{
+	return ( int )( ( sequence * 2654435761U ) >> ( 32 - idByteLZCompressor::HASH_BITS ) );
+}
+
+/*
+========================
+idByteLZCompressor::Start
+========================
+*/
+void idByteLZCompressor::Start( uint8* data_, int maxSize_, bool append )
+{
+	memset( hash, 0, sizeof( hash ) );
+	
+	if( append )
+	{
+		// Rebuild the match hash from the history left by the previous job
+		const uint8* window = lzData->window;
+		const int end = Min( lzData->scanPos, lzData->windowLength - MIN_MATCH + 1 );
+		for( int i = 0; i < end; i++ )
+		{
+			hash[ByteLZHash( ByteLZRead32( window + i ) )] = ( uint16 )( i + 1 );
+		}
+	}
+	else
+	{
+		lzData->windowLength	= 0;
+		lzData->scanPos			= 0;
+		lzData->literalStart	= 0;
+		lzData->bytesWritten	= 0;
+	}
+	
+	data		= data_;
+	maxSize		= maxSize_;
+	overflowed	= false;
+	
+	bytesRead	= 0;
+	readPos		= 0;
+	
+	Save();
+}
+
+/*
+========================
+idByteLZCompressor::WriteByte
+========================
+*/
+void idByteLZCompressor::WriteByte( uint8 value )
+{
+	if( lzData->windowLength >= byteLZCompressionData_t::WINDOW_SIZE )
+	{
+		overflowed = true;
+		return;
+	}
+	
+	lzData->window[lzData->windowLength++] = value;
+	
+	if( lzData->windowLength - lzData->scanPos >= ENCODE_LOOKAHEAD * 2 )
+	{
+		Encode( lzData->windowLength - ENCODE_LOOKAHEAD );
+	}
+	
+	// At any point, if we can't perform an End call, then trigger an overflow
+	const int pending = lzData->windowLength - lzData->literalStart;
+	if( lzData->bytesWritten + pending + pending / 255 + 2 > maxSize )
+	{
+		overflowed = true;
+	}
+}
+
+/*
+========================
+idByteLZCompressor::Encode
+Greedy parse of the uncompressed stream from scanPos up to limit, emitting a sequence for each match found.
+Bytes that don't match stay pending as literals for the next sequence.
+========================
+*/
+void idByteLZCompressor::Encode( int limit )
+{
+	const uint8* window = lzData->window;
+	const int end = lzData->windowLength;
+	int pos = lzData->scanPos;
+	
+	limit = Min( limit, end - MIN_MATCH + 1 );
+	
+	while( pos < limit )
+	{
+		const uint32 sequence = ByteLZRead32( window + pos );
+		const int h = ByteLZHash( sequence );
+		const int candidate = hash[h] - 1;
+		
+		hash[h] = ( uint16 )( pos + 1 );
+		
+		// candidates past pos are left over from a Restore
+		if( candidate < 0 || candidate >= pos || pos - candidate > MAX_OFFSET || ByteLZRead32( window + candidate ) != sequence )
+		{
+			pos++;
+			continue;
+		}
+		
+		int length = MIN_MATCH;
+		while( pos + length < end && window[candidate + length] == window[pos + length] )
+		{
+			length++;
+		}
+		
+		if( !WriteSequence( pos, pos - candidate, length ) )
+		{
+			break;
+		}
+		
+		for( int i = pos + 1; i < pos + length && i <= end - MIN_MATCH; i++ )
+		{
+			hash[ByteLZHash( ByteLZRead32( window + i ) )] = ( uint16 )( i + 1 );
+		}
+		
+		pos += length;
+		lzData->literalStart = pos;
+	}
+	
+	lzData->scanPos = pos;
+}
+
+/*
+========================
+idByteLZCompressor::WriteSequence
+Writes the pending literals up to matchPos, followed by the match (a matchLength of 0 ends the stream)
+========================
+*/
+bool idByteLZCompressor::WriteSequence( int matchPos, int offset, int matchLength )
+{
+	const int literals = matchPos - lzData->literalStart;
+	const int matchCode = matchLength - MIN_MATCH;
+	
+	int needed = 1 + literals + ( literals + 240 ) / 255;
+	if( matchLength > 0 )
+	{
+		needed += 2 + ( matchCode + 240 ) / 255;
+	}
+	
+	if( lzData->bytesWritten + needed > maxSize )
+	{
+		overflowed = true;
+		return false;
+	}
+	
+	uint8* out = data + lzData->bytesWritten;
+	
+	*out++ = ( uint8 )( ( Min( literals, 15 ) << 4 ) | ( matchLength > 0 ? Min( matchCode, 15 ) : 0 ) );
+	
+	if( literals >= 15 )
+	{
+		int length = literals - 15;
+		for( ; length >= 255; length -= 255 )
+		{
+			*out++ = 255;
+		}
+		*out++ = ( uint8 )length;
+	}
+	
+	memcpy( out, lzData->window + lzData->literalStart, literals );
+	out += literals;
+	
+	if( matchLength > 0 )
+	{
+		*out++ = ( uint8 )( offset & 0xFF );
+		*out++ = ( uint8 )( offset >> 8 );
+		
+		if( matchCode >= 15 )
+		{
+			int length = matchCode - 15;
+			for( ; length >= 255; length -= 255 )
+			{
+				*out++ = 255;
+			}
+			*out++ = ( uint8 )length;
+		}
+	}
+	
+	lzData->bytesWritten = ( int )( out - data );
+	
+	return true;
+}
+
+/*
+========================
+idByteLZCompressor::End
+========================
+*/
+int idByteLZCompressor::End()
+{
+	Encode( lzData->windowLength );
+	
+	if( lzData->windowLength > lzData->literalStart )
+	{
+		if( !WriteSequence( lzData->windowLength, 0, 0 ) )
+		{
+			return -1;
+		}
+		lzData->literalStart	= lzData->windowLength;
+		lzData->scanPos			= lzData->windowLength;
+	}
+	
+	return Length() > 0 ? Length() : -1;		// Total bytes written (or failure)
+}
+
+/*
+========================
+idByteLZCompressor::Save
+========================
+*/
+void idByteLZCompressor::Save()
+{
+	assert( !overflowed );
+	
+	savedWindowLength	= lzData->windowLength;
+	savedScanPos		= lzData->scanPos;
+	savedLiteralStart	= lzData->literalStart;
+	savedBytesWritten	= lzData->bytesWritten;
+}
+
+/*
+========================
+idByteLZCompressor::Restore
+========================
+*/
+void idByteLZCompressor::Restore()
+{
+	lzData->windowLength	= savedWindowLength;
+	lzData->scanPos			= savedScanPos;
+	lzData->literalStart	= savedLiteralStart;
+	lzData->bytesWritten	= savedBytesWritten;
+}
+
+/*
+========================
+idByteLZCompressor::ReadLength
+========================
+*/
+int idByteLZCompressor::ReadLength()
+{
+	int length = 0;
+	while( bytesRead < maxSize )
+	{
+		const int value = data[bytesRead++];
+		length += value;
+		if( value != 255 )
+		{
+			break;
+		}
+	}
+	return length;
+}
+
+/*
+========================
+idByteLZCompressor::DecodeSequence
+Decodes the next sequence into the window, returns false when there is nothing left to read
+========================
+*/
+bool idByteLZCompressor::DecodeSequence()
+{
+	if( bytesRead >= maxSize )
+	{
+		return false;
+	}
+	
+	uint8* window = lzData->window;
+	const int token = data[bytesRead++];
+	
+	int literals = token >> 4;
+	if( literals == 15 )
+	{
+		literals += ReadLength();
+	}
+	
+	if( literals > maxSize - bytesRead || literals > byteLZCompressionData_t::WINDOW_SIZE - lzData->windowLength )
+	{
+		bytesRead = maxSize;
+		return false;
+	}
+	
+	memcpy( window + lzData->windowLength, data + bytesRead, literals );
+	lzData->windowLength += literals;
+	bytesRead += literals;
+	
+	if( bytesRead == maxSize )
+	{
+		return literals > 0;		// Last sequence has no match
+	}
+	
+	if( maxSize - bytesRead < 2 )
+	{
+		bytesRead = maxSize;
+		return false;
+	}
+	
+	const int offset = data[bytesRead] | ( data[bytesRead + 1] << 8 );
+	bytesRead += 2;
+	
+	int length = token & 15;
+	if( length == 15 )
+	{
+		length += ReadLength();
+	}
+	length += MIN_MATCH;
+	
+	if( offset == 0 || offset > lzData->windowLength || length > byteLZCompressionData_t::WINDOW_SIZE - lzData->windowLength )
+	{
+		bytesRead = maxSize;
+		return false;
+	}
+	
+	// Matches can overlap the bytes they produce, so copy forward one byte at a time
+	const uint8* src = window + lzData->windowLength - offset;
+	uint8* dest = window + lzData->windowLength;
+	for( int i = 0; i < length; i++ )
+	{
+		dest[i] = src[i];
+	}
+	lzData->windowLength += length;
+	
+	return true;
+}
+
+/*
+========================
+idByteLZCompressor::ReadByte
+========================
+*/
+int idByteLZCompressor::ReadByte( bool ignoreOverflow )
+{
+	while( readPos == lzData->windowLength )
+	{
+		if( !DecodeSequence() )
+		{
+			if( !ignoreOverflow )
+			{
+				overflowed = true;
+				assert( !"idByteLZCompressor::ReadByte overflowed!" );
+			}
+			return -1;
+		}
+	}
+	
+	return lzData->window[readPos++];
+}
+
 /*
 ========================
 idZeroRunLengthCompressor
@@ -446,6 +811,17 @@ void idZeroRunLengthCompressor::Start( uint8* dest_, idLZWCompressor* comp_, int
 	zeroCount	= 0;
 	dest		= dest_;
 	comp		= comp_;
+	lzComp		= NULL;
+	compressed	= 0;
+	maxSize		= maxSize_;
+}
+
+void idZeroRunLengthCompressor::Start( uint8* dest_, idByteLZCompressor* lzComp_, int maxSize_ )
+{
+	zeroCount	= 0;
+	dest		= dest_;
+	comp		= NULL;
+	lzComp		= lzComp_;
 	compressed	= 0;
 	maxSize		= maxSize_;
 }
@@ -465,6 +841,11 @@ bool idZeroRunLengthCompressor::WriteRun()
 			comp->WriteByte( 0 );
 			comp->WriteByte( ( uint8 )zeroCount );
 		}
+		else if( lzComp != NULL )
+		{
+			lzComp->WriteByte( 0 );
+			lzComp->WriteByte( ( uint8 )zeroCount );
+		}
 		else
 		{
 			*dest++ = 0;
@@ -498,6 +879,10 @@ bool idZeroRunLengthCompressor::WriteByte( uint8 value )
 		{
 			comp->WriteByte( value );
 		}
+		else if( lzComp != NULL )
+		{
+			lzComp->WriteByte( value );
+		}
 		else
 		{
 			*dest++ = value;
@@ -569,5 +954,9 @@ int idZeroRunLengthCompressor::ReadInternal()
 	{
 		return comp->ReadByte();
 	}
+	if( lzComp != NULL )
+	{
+		return lzComp->ReadByte();
+	}
 	return *dest++;
 }
\ No newline at end of file
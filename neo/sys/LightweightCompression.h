@@ -199,6 +199,135 @@ private:
 	int					savedTempBits;
 };
 
+struct byteLZCompressionData_t
+{
+	static const int	WINDOW_SIZE		= ( 1 << 15 );
+	
+	uint8					window[WINDOW_SIZE];	// Uncompressed stream (history for the encoder, output of the decoder)
+	int						windowLength;
+	
+	int						scanPos;				// Encoder: next position to search for a match at
+	int						literalStart;			// Encoder: first byte not yet covered by a sequence
+	int						bytesWritten;
+};
+
+/*
+========================
+idByteLZCompressor
+Byte oriented lz77 encoder/decoder. Cheaper than the lzw coder on both ends, since it works
+on whole bytes and copies literal runs and matches instead of walking code chains.
+
+A stream is a list of sequences:
+	token		high nibble is the literal count, low nibble is the match length - MIN_MATCH
+				(a nibble of 15 is followed by extra length bytes, each 255 means keep reading)
+	literals
+	offset		16 bit little endian distance back into the uncompressed stream
+The last sequence of a stream is literals only and ends at the end of the compressed data.
+
+Same interface as idLZWCompressor, so the snapshot code can use either one.
+========================
+*/
+class idByteLZCompressor
+{
+public:
+	idByteLZCompressor( byteLZCompressionData_t* lzData_ ) : lzData( lzData_ ) {}
+	
+	static const int	MIN_MATCH			= 4;
+	static const int	MAX_OFFSET			= 0xFFFF;
+	static const int	ENCODE_LOOKAHEAD	= 64;		// Raw bytes held back so matches aren't cut short at the end of what was written so far
+	static const int	HASH_BITS			= 12;
+	static const int	HASH_SIZE			= 1 << HASH_BITS;
+	
+	void	Start( uint8* data_, int maxSize, bool append = false );
+	int		ReadByte( bool ignoreOverflow = false );
+	void	WriteByte( uint8 value );
+	int		End();
+	
+	// Compressed bytes so far, counting the bytes that haven't been encoded yet as literals
+	int		Length() const
+	{
+		return lzData->bytesWritten + ( lzData->windowLength - lzData->literalStart );
+	}
+	int		GetReadCount() const
+	{
+		return bytesRead;
+	}
+	
+	void	Save();
+	void	Restore();
+	
+	bool	IsOverflowed()
+	{
+		return overflowed;
+	}
+	
+	int		Write( const void* data, int length )
+	{
+		uint8* src = ( uint8* )data;
+		
+		for( int i = 0; i < length && !IsOverflowed(); i++ )
+		{
+			WriteByte( src[i] );
+		}
+		
+		return length;
+	}
+	
+	int		Read( void* data, int length, bool ignoreOverflow = false )
+	{
+		uint8* src = ( uint8* )data;
+		
+		for( int i = 0; i < length; i++ )
+		{
+			int byte = ReadByte( ignoreOverflow );
+			
+			if( byte == -1 )
+			{
+				return i;
+			}
+			
+			src[i] = ( uint8 )byte;
+		}
+		
+		return length;
+	}
+	
+	template<class type> ID_INLINE size_t WriteAgnostic( const type& c )
+	{
+		return Write( &c, sizeof( c ) );
+	}
+	
+	template<class type> ID_INLINE size_t ReadAgnostic( type& c, bool ignoreOverflow = false )
+	{
+		size_t r = Read( &c, sizeof( c ), ignoreOverflow );
+		return r;
+	}
+	
+private:
+	void	Encode( int limit );
+	bool	WriteSequence( int matchPos, int offset, int matchLength );
+	bool	DecodeSequence();
+	int		ReadLength();
+	
+	byteLZCompressionData_t* 	lzData;
+	uint16						hash[HASH_SIZE];		// Last position + 1 of each hashed 4 byte sequence, 0 is empty
+	
+	uint8* 				data;		// Read/write
+	int					maxSize;
+	bool				overflowed;
+	
+	// For reading
+	int					bytesRead;
+	int					readPos;
+	
+	// saving/restoring when overflow (when writing).
+	// Must call End directly after restoring
+	int					savedWindowLength;
+	int					savedScanPos;
+	int					savedLiteralStart;
+	int					savedBytesWritten;
+};
+
 /*
 ========================
 idZeroRunLengthCompressor
@@ -213,6 +342,7 @@ public:
 	}
 	
 	void Start( uint8* dest_, idLZWCompressor* comp_, int maxSize_ );
+	void Start( uint8* dest_, idByteLZCompressor* lzComp_, int maxSize_ );
 	bool WriteRun();
 	bool WriteByte( uint8 value );
 	byte ReadByte();
@@ -230,6 +360,7 @@ private:
 	
 	int					zeroCount;		// Number of pending zeroes
 	idLZWCompressor* 	comp;
+	idByteLZCompressor* lzComp;
 	uint8* 				destStart;
 	uint8* 				dest;
 	int					compressed;		// Compressed size
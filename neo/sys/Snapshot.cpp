@@ -225,6 +225,7 @@ void idSnapShot::operator=( const idSnapShot& other )
 			state.objectNum		= otherState.objectNum;
 			state.buffer		= otherState.buffer;
 			state.visMask		= otherState.visMask;
+			state.lowPriorityMask = otherState.lowPriorityMask;
 			state.stale			= otherState.stale;
 			state.deleted		= otherState.deleted;
 			state.changedCount	= otherState.changedCount;
@@ -243,10 +244,22 @@ idSnapShot::PeekDeltaSequence
 */
 void idSnapShot::PeekDeltaSequence( const char* deltaMem, int deltaSize, int& sequence, int& baseSequence )
 {
+	// The first byte holds the codec the delta was written with
+	if( deltaSize > 0 && deltaMem[0] == SNAP_CODEC_BYTELZ )
+	{
+		byteLZCompressionData_t	lzData;
+		idByteLZCompressor		lzCompressor( &lzData );
+		
+		lzCompressor.Start( ( uint8* )deltaMem + 1, deltaSize - 1 );
+		lzCompressor.ReadAgnostic( sequence );
+		lzCompressor.ReadAgnostic( baseSequence );
+		return;
+	}
+	
 	lzwCompressionData_t	lzwData;
 	idLZWCompressor			lzwCompressor( &lzwData );
 	
-	lzwCompressor.Start( ( uint8* )deltaMem, deltaSize );
+	lzwCompressor.Start( ( uint8* )deltaMem + 1, deltaSize - 1 );
 	lzwCompressor.ReadAgnostic( sequence );
 	lzwCompressor.ReadAgnostic( baseSequence );
 }
@@ -257,18 +270,38 @@ idSnapShot::ReadDeltaForJob
 ========================
 */
 bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIndex, idSnapShot* templateStates )
+{
+	if( deltaSize > 0 && deltaMem[0] == SNAP_CODEC_BYTELZ )
+	{
+		byteLZCompressionData_t	lzData;
+		idByteLZCompressor		lzCompressor( &lzData );
+		
+		lzCompressor.Start( ( uint8* )deltaMem + 1, deltaSize - 1 );
+		return ReadDeltaStream( lzCompressor, deltaSize, visIndex, templateStates );
+	}
+	
+	lzwCompressionData_t	lzwData;
+	idLZWCompressor			lzwCompressor( &lzwData );
+	
+	lzwCompressor.Start( ( uint8* )deltaMem + 1, deltaSize - 1 );
+	return ReadDeltaStream( lzwCompressor, deltaSize, visIndex, templateStates );
+}
+
+/*
+========================
+idSnapShot::ReadDeltaStream
+========================
+*/
+template< class compressor_t >
+bool idSnapShot::ReadDeltaStream( compressor_t& lzwCompressor, int deltaSize, int visIndex, idSnapShot* templateStates )
 {
 
 	bool report = net_verboseSnapshotReport.GetBool();
 	net_verboseSnapshotReport.SetBool( false );
 	
-	lzwCompressionData_t		lzwData;
 	idZeroRunLengthCompressor	rleCompressor;
-	idLZWCompressor				lzwCompressor( &lzwData );
 	int bytesRead = 0; // how many uncompressed bytes we read in. Used to figure out compression ratio
 	
-	lzwCompressor.Start( ( uint8* )deltaMem, deltaSize );
-	
 	// Skip past sequence and baseSequence
 	int sequence		= 0;
 	int baseSequence	= 0;
@@ -615,6 +648,36 @@ idSnapShot::objectState_t* idSnapShot::GetTemplateState( int objNum, idSnapShot*
 	return oldState;
 }
 
+/*
+========================
+idSnapShot::SkipLowPriorityObject
+
+Returns true if an update of an object that the client already has can wait for a later delta.
+Only every lowPriorityRate-th of the low priority objects goes out, rotating with lowPriorityOffset.
+========================
+*/
+bool idSnapShot::SkipLowPriorityObject( const submitDeltaJobsInfo_t& submitDeltaJobsInfo, const objectState_t& newState, const objectState_t& oldState )
+{
+	if( submitDeltaJobsInfo.lowPriorityRate <= 1 || submitDeltaJobsInfo.visIndex <= 0 )
+	{
+		return false;
+	}
+	
+	const uint32 visBit = BIT( submitDeltaJobsInfo.visIndex );
+	if( ( newState.lowPriorityMask & visBit ) == 0 )
+	{
+		return false;
+	}
+	
+	// never hold back visibility changes
+	if( ( newState.visMask & visBit ) == 0 || ( oldState.visMask & visBit ) == 0 )
+	{
+		return false;
+	}
+	
+	return ( ( newState.objectNum + submitDeltaJobsInfo.lowPriorityOffset ) % submitDeltaJobsInfo.lowPriorityRate ) != 0;
+}
+
 /*
 ========================
 idSnapShot::SubmitWriteDeltaToJobs
@@ -686,6 +749,12 @@ void idSnapShot::SubmitWriteDeltaToJobs( const submitDeltaJobsInfo_t& submitDelt
 				// New state (even though snapObj existed, its size was zero)
 				oldState = GetTemplateState( newState.objectNum, submitDeltaJobInfo.templateStates, &newState );
 			}
+			else if( SkipLowPriorityObject( submitDeltaJobInfo, newState, *oldState ) )
+			{
+				// not writing the object acks the old state, it gets its turn in a later delta
+				j++;
+				continue;
+			}
 			
 			SubmitObjectJob( submitDeltaJobInfo, &newState, oldState, baseObjParms, curObjParms, curHeader, curObjMemory, curlzwParms );
 			j++;
@@ -1078,6 +1147,7 @@ idSnapShot::objectState_t* idSnapShot::S_AddObject( int objectNum, uint32 visMas
 	objectSize_t size = _size;
 	objectState_t& state = FindOrCreateObjectByID( objectNum );
 	state.visMask = visMask;
+	state.lowPriorityMask = 0;
 	if( state.buffer.Size() == size && state.buffer.NumRefs() == 1 )
 	{
 		// re-use the same buffer
@@ -1092,6 +1162,32 @@ idSnapShot::objectState_t* idSnapShot::S_AddObject( int objectNum, uint32 visMas
 	return &state;
 }
 
+/*
+========================
+idSnapShot::S_AddObjectFromSnapshot
+========================
+*/
+idSnapShot::objectState_t* idSnapShot::S_AddObjectFromSnapshot( int objectNum, uint32 visMask, const idSnapShot& oldss, const byte* data, int size )
+{
+	const objectState_t* oldState = oldss.FindObjectByID( objectNum );
+	if( oldState == NULL || oldState->buffer.Size() == 0 || ( int )oldState->buffer.Size() != size || memcmp( oldState->buffer.Ptr(), data, size ) != 0 )
+	{
+		return NULL;
+	}
+	
+	// the reference count is a single byte, states that never change get a fresh buffer now and then
+	if( oldState->buffer.NumRefs() >= 128 )
+	{
+		return NULL;
+	}
+	
+	objectState_t& state = FindOrCreateObjectByID( objectNum );
+	state.visMask = visMask;
+	state.lowPriorityMask = 0;
+	state.buffer = oldState->buffer;		// only takes a reference
+	return &state;
+}
+
 /*
 ========================
 idSnapShot::CopyObject
@@ -1112,6 +1208,7 @@ bool idSnapShot::CopyObject( const idSnapShot& oldss, int objectNum, bool forceS
 	
 	newState.buffer			= oldState.buffer;
 	newState.visMask		= oldState.visMask;
+	newState.lowPriorityMask = oldState.lowPriorityMask;
 	newState.stale			= oldState.stale;
 	newState.deleted		= oldState.deleted;
 	newState.changedCount	= oldState.changedCount;
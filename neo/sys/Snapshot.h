@@ -93,7 +93,7 @@ public:
 			_Release();
 		}
 		void Alloc( int size );
-		int NumRefs()
+		int NumRefs() const
 		{
 			return data == NULL ? 0 : data[size];
 		}
@@ -105,6 +105,10 @@ public:
 		{
 			return data == NULL ? NULL : data ;
 		}
+		const byte* Ptr() const
+		{
+			return data;
+		}
 		byte& operator[]( int i )
 		{
 			return data[i];
@@ -124,6 +128,7 @@ public:
 		objectState_t() :
 			objectNum( 0 ),
 			visMask( MAX_UNSIGNED_TYPE( uint32 ) ),
+			lowPriorityMask( 0 ),
 			stale( false ),
 			deleted( false ),
 			changedCount( 0 ),
@@ -135,6 +140,7 @@ public:
 		uint16			objectNum;
 		objectBuffer_t	buffer;
 		uint32			visMask;
+		uint32			lowPriorityMask;	// clients that get this object less often when their snapshots don't fit net_optimalSnapDeltaSize
 		bool			stale;			// easy way for clients to check if ss obj is stale. Probably temp till client side of vismask system is more fleshed out
 		bool			deleted;
 		int				changedCount;	// Incremented each time the state changed
@@ -156,6 +162,8 @@ public:
 		idSnapShot* 		oldSnap;				// snap we are comparing this snap to (to produce a delta)
 		int					visIndex;
 		int					baseSequence;
+		int					lowPriorityRate;		// only every n-th low priority object update is sent, 0 sends all of them
+		int					lowPriorityOffset;		// rotates which low priority objects go out with this delta
 		
 		idSnapShot* 		templateStates;			// states for new snapObj that arent in old states
 		
@@ -176,6 +184,9 @@ public:
 		return S_AddObject( objectNum, visMask, ( const char* )buffer, size, tag );
 	}
 	objectState_t* S_AddObject( int objectNum, uint32 visMask, const char* buffer, int size, const char* tag = NULL );
+	// Adds an object that shares the buffer of the same object in another snapshot if that holds
+	// exactly the given data, returns NULL if it doesn't
+	objectState_t* S_AddObjectFromSnapshot( int objectNum, uint32 visMask, const idSnapShot& oldss, const byte* data, int size );
 	bool CopyObject( const idSnapShot& oldss, int objectNum, bool forceStale = false );
 	int CompareObject( const idSnapShot* oldss, int objectNum, int start = 0, int end = 0, int oldStart = 0 );
 	
@@ -244,6 +255,9 @@ private:
 		bool							saveDictionary		// If true, this is the first of several calls which will be appended
 	);
 	
+	bool SkipLowPriorityObject( const submitDeltaJobsInfo_t& submitDeltaJobsInfo, const objectState_t& newState, const objectState_t& oldState );
+	template< class compressor_t >
+	bool ReadDeltaStream( compressor_t& lzwCompressor, int deltaSize, int visIndex, idSnapShot* templateStates );
 	void WriteObject( idFile* file, int visIndex, objectState_t* newState, objectState_t* oldState, int& lastobjectNum );
 	void FreeObjectState( int index );
 };
@@ -31,6 +31,9 @@ If you have questions concerning this license or the applicable additional terms
 #include "precompiled.h"
 
 idCVar net_optimalSnapDeltaSize( "net_optimalSnapDeltaSize", "1000", CVAR_INTEGER, "Optimal size of snapshot delta msgs." );
+idCVar net_snapLowPriorityRate( "net_snapLowPriorityRate", "4", CVAR_INTEGER, "when deltas don't fit net_optimalSnapDeltaSize, low priority objects are only updated in one of this many snapshots", 1, 32 );
+idCVar net_snapCodec( "net_snapCodec", "1", CVAR_INTEGER, "compressor used for the snapshot deltas of new connections. 0 = lzw, 1 = byte lz", 0, SNAP_CODEC_COUNT - 1 );
+idCVar net_snapCodecCapture( "net_snapCodecCapture", "", 0, "appends every snapshot delta sent or received to this file, for net_snapCodecBenchmark" );
 idCVar net_debugBaseStates( "net_debugBaseStates", "0", CVAR_BOOL, "Log out base state information" );
 idCVar net_skipClientDeltaAppend( "net_skipClientDeltaAppend", "0", CVAR_BOOL, "Simulate delta receive buffer overflowing" );
 
@@ -90,6 +93,12 @@ void idSnapshotProcessor::Reset( bool cstor )
 	
 	partialBaseSequence = -1;
 	
+	throttleLowPriority = false;
+	lowPriorityOffset = 0;
+	
+	// clients read whichever codec the delta was written with, so each connection can use a different one
+	snapCodec = net_snapCodec.GetInteger();
+	
 	memset( &jobMemory->lzwInOutData, 0, sizeof( jobMemory->lzwInOutData ) );
 }
 
@@ -136,16 +145,49 @@ bool idSnapshotProcessor::ApplyDeltaToSnapshot( idSnapShot& snap, const char* de
 static int g_maxlwMem = 100;
 #endif
 
+/*
+========================
+CaptureSnapshotDelta
+========================
+*/
+static void CaptureSnapshotDelta( const uint8* deltaData, int deltaSize )
+{
+	static idFile* captureFile = NULL;
+	static idStr captureName;
+	
+	if( captureName.Cmp( net_snapCodecCapture.GetString() ) != 0 )
+	{
+		if( captureFile != NULL )
+		{
+			idLib::Printf( "Captured %d bytes of snapshot deltas to %s\n", captureFile->Length(), captureName.c_str() );
+			fileSystem->CloseFile( captureFile );
+			captureFile = NULL;
+		}
+		captureName = net_snapCodecCapture.GetString();
+		if( captureName.Length() > 0 )
+		{
+			captureFile = fileSystem->OpenFileWrite( captureName );
+		}
+	}
+	
+	if( captureFile != NULL )
+	{
+		captureFile->WriteInt( deltaSize );
+		captureFile->Write( deltaData, deltaSize );
+	}
+}
+
 /*
 ========================
 idSnapshotProcessor::SubmitPendingSnap
 ========================
 */
-void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData )
+void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, byteLZCompressionData_t* byteLZData )
 {
 
 	assert_16_byte_aligned( objMemory );
 	assert_16_byte_aligned( lzwData );
+	assert_16_byte_aligned( byteLZData );
 	
 	assert( hasPendingSnap );
 	assert( jobMemory->lzwInOutData.numlzwDeltas == 0 );
@@ -168,7 +210,9 @@ void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int
 	jobMemory->lzwInOutData.optimalLength	= net_optimalSnapDeltaSize.GetInteger();
 	jobMemory->lzwInOutData.snapSequence	= snapSequence;
 	jobMemory->lzwInOutData.lastObjId		= 0;
+	jobMemory->lzwInOutData.codec			= snapCodec;
 	jobMemory->lzwInOutData.lzwData			= lzwData;
+	jobMemory->lzwInOutData.byteLZData		= byteLZData;
 	
 	idSnapShot::submitDeltaJobsInfo_t submitInfo;
 	
@@ -193,6 +237,10 @@ void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int
 	submitInfo.visIndex			= visIndex;
 	submitInfo.baseSequence		= baseSequence;
 	
+	// rotate the low priority objects through the deltas while they don't fit
+	submitInfo.lowPriorityRate		= throttleLowPriority ? net_snapLowPriorityRate.GetInteger() : 0;
+	submitInfo.lowPriorityOffset	= lowPriorityOffset++;
+	
 	submitInfo.lzwInOutData		= &jobMemory->lzwInOutData;
 	
 	pendingSnap.SubmitWriteDeltaToJobs( submitInfo );
@@ -250,6 +298,7 @@ int idSnapshotProcessor::GetPendingSnapDelta( byte* outBuffer, int maxLength )
 	
 	// Copy to out buffer
 	memcpy( outBuffer, deltaData, size );
+	CaptureSnapshotDelta( deltaData, size );
 	
 	// Set the sequence to what this delta actually belongs to
 	assert( jobMemory->lzwDeltas[0].snapSequence == snapSequence + 1 );
@@ -285,6 +334,12 @@ int idSnapshotProcessor::GetPendingSnapDelta( byte* outBuffer, int maxLength )
 		// We sent the full snap, we can stop sending this pending snap now...
 		NET_VERBOSESNAPSHOT_PRINT_LEVEL( 5, va( "  wrote enough deltas to a full snapshot\n" ) ); // FIXME: peer number?
 		
+		// stop rotating low priority objects once a whole snap fits in a single delta with room to spare
+		if( partialBaseSequence == -1 && jobMemory->lzwDeltas[0].size < net_optimalSnapDeltaSize.GetInteger() / 2 )
+		{
+			throttleLowPriority = false;
+		}
+		
 		hasPendingSnap = false;
 		partialBaseSequence = -1;
 		
@@ -292,6 +347,7 @@ int idSnapshotProcessor::GetPendingSnapDelta( byte* outBuffer, int maxLength )
 	else
 	{
 		partialBaseSequence = deltaBaseSequence;
+		throttleLowPriority = true;
 	}
 	
 	return size;
@@ -357,6 +413,8 @@ bool idSnapshotProcessor::ReceiveSnapshotDelta( const byte* deltaData, int delta
 	// Update our snapshot sequence number to the newer one we just got (now that it's safe)
 	snapSequence = deltaSequence;
 	
+	CaptureSnapshotDelta( deltaData, deltaLength );
+	
 	if( deltas.Num() > 10 )
 	{
 		NET_VERBOSESNAPSHOT_PRINT( "NET: ReceiveSnapshotDelta: deltas.Num() > 10: %d\n   ", deltas.Num() );
@@ -571,3 +629,160 @@ void idSnapshotProcessor::AddSnapObjTemplate( int objID, idBitMsg& msg )
 		state->expectedSequence = snapSequence;
 	}
 }
+
+/*
+========================
+SnapCodecRoundTrip
+Compresses the stream with the compressor, then makes sure it decompresses back to the same bytes
+========================
+*/
+template< class compressor_t >
+static bool SnapCodecRoundTrip( compressor_t& compressor, const byte* raw, int rawSize, byte* comp, int maxComp, byte* decoded, uint64& compressTime, uint64& decompressTime, int& compSize )
+{
+	uint64 start = Sys_Microseconds();
+	compressor.Start( comp, maxComp );
+	compressor.Write( raw, rawSize );
+	if( compressor.IsOverflowed() )
+	{
+		return false;
+	}
+	compSize = compressor.End();
+	compressTime += Sys_Microseconds() - start;
+	
+	if( compSize <= 0 )
+	{
+		return false;
+	}
+	
+	start = Sys_Microseconds();
+	compressor.Start( comp, compSize );
+	int decodedSize = compressor.Read( decoded, rawSize, true );
+	decompressTime += Sys_Microseconds() - start;
+	
+	return decodedSize == rawSize && memcmp( raw, decoded, rawSize ) == 0;
+}
+
+/*
+========================
+net_snapCodecBenchmark
+========================
+*/
+CONSOLE_COMMAND( net_snapCodecBenchmark, "compares the snapshot delta codecs on deltas captured with net_snapCodecCapture", 0 )
+{
+	if( args.Argc() < 2 )
+	{
+		idLib::Printf( "usage: net_snapCodecBenchmark <capture file> [passes]\n" );
+		return;
+	}
+	
+	idFile* file = fileSystem->OpenFileRead( args.Argv( 1 ) );
+	if( file == NULL )
+	{
+		idLib::Printf( "Couldn't open %s\n", args.Argv( 1 ) );
+		return;
+	}
+	
+	const int passes = args.Argc() > 2 ? Max( 1, atoi( args.Argv( 2 ) ) ) : 10;
+	const int MAX_STREAM = byteLZCompressionData_t::WINDOW_SIZE;
+	
+	lzwCompressionData_t* lzwData = ( lzwCompressionData_t* )Mem_Alloc( sizeof( lzwCompressionData_t ), TAG_NETWORKING );
+	byteLZCompressionData_t* byteLZData = ( byteLZCompressionData_t* )Mem_Alloc( sizeof( byteLZCompressionData_t ), TAG_NETWORKING );
+	idLZWCompressor* lzwCompressor = new( TAG_NETWORKING ) idLZWCompressor( lzwData );
+	idByteLZCompressor* byteLZCompressor = new( TAG_NETWORKING ) idByteLZCompressor( byteLZData );
+	
+	idList< byte > delta;
+	idList< byte > comp;
+	idList< byte > decoded;
+	comp.SetNum( MAX_STREAM * 2 );
+	decoded.SetNum( MAX_STREAM );
+	
+	// Unpack the captured deltas back to the streams the snapshot jobs compressed
+	idList< byte > streams;
+	idList< int > streamSizes;
+	int capturedBytes = 0;
+	
+	while( file->Tell() < file->Length() )
+	{
+		int deltaSize = 0;
+		file->ReadInt( deltaSize );
+		if( deltaSize <= 1 || deltaSize > file->Length() - file->Tell() )
+		{
+			break;
+		}
+		delta.SetNum( deltaSize );
+		file->Read( delta.Ptr(), deltaSize );
+		capturedBytes += deltaSize;
+		
+		int streamSize = 0;
+		if( delta[0] == SNAP_CODEC_BYTELZ )
+		{
+			byteLZCompressor->Start( delta.Ptr() + 1, deltaSize - 1 );
+			streamSize = byteLZCompressor->Read( decoded.Ptr(), MAX_STREAM, true );
+		}
+		else
+		{
+			lzwCompressor->Start( delta.Ptr() + 1, deltaSize - 1 );
+			streamSize = lzwCompressor->Read( decoded.Ptr(), MAX_STREAM, true );
+		}
+		
+		if( streamSize > 0 )
+		{
+			const int offset = streams.Num();
+			streams.SetNum( offset + streamSize );
+			memcpy( streams.Ptr() + offset, decoded.Ptr(), streamSize );
+			streamSizes.Append( streamSize );
+		}
+	}
+	fileSystem->CloseFile( file );
+	
+	const int rawBytes = streams.Num();
+	idLib::Printf( "%d deltas, %d captured bytes, %d uncompressed bytes, %d passes\n", streamSizes.Num(), capturedBytes, rawBytes, passes );
+	
+	if( rawBytes > 0 )
+	{
+		static const char* codecNames[SNAP_CODEC_COUNT] = { "lzw", "byte lz" };
+		
+		for( int codec = 0; codec < SNAP_CODEC_COUNT; codec++ )
+		{
+			uint64 compressTime = 0;
+			uint64 decompressTime = 0;
+			int compBytes = 0;
+			int failed = 0;
+			
+			for( int pass = 0; pass < passes; pass++ )
+			{
+				const byte* raw = streams.Ptr();
+				for( int i = 0; i < streamSizes.Num(); raw += streamSizes[i++] )
+				{
+					int compSize = 0;
+					bool ok;
+					if( codec == SNAP_CODEC_BYTELZ )
+					{
+						ok = SnapCodecRoundTrip( *byteLZCompressor, raw, streamSizes[i], comp.Ptr(), comp.Num(), decoded.Ptr(), compressTime, decompressTime, compSize );
+					}
+					else
+					{
+						ok = SnapCodecRoundTrip( *lzwCompressor, raw, streamSizes[i], comp.Ptr(), comp.Num(), decoded.Ptr(), compressTime, decompressTime, compSize );
+					}
+					
+					if( pass == 0 )
+					{
+						compBytes += compSize + 1;		// Codec byte
+						failed += ok ? 0 : 1;
+					}
+				}
+			}
+			
+			const double totalBytes = ( double )rawBytes * passes;
+			idLib::Printf( "%-8s %8d bytes  ratio %.3f  compress %7.1f MB/s  decompress %7.1f MB/s%s\n", codecNames[codec], compBytes,
+						   ( float )compBytes / ( float )rawBytes,
+						   totalBytes / Max( compressTime, ( uint64 )1 ), totalBytes / Max( decompressTime, ( uint64 )1 ),
+						   failed > 0 ? va( "  (%d streams failed)", failed ) : "" );
+		}
+	}
+	
+	delete lzwCompressor;
+	delete byteLZCompressor;
+	Mem_Free( lzwData );
+	Mem_Free( byteLZData );
+}
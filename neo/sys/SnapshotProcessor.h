@@ -55,7 +55,7 @@ public:
 	bool ApplyDeltaToSnapshot( idSnapShot& snap, const char* deltaMem, int deltaSize, int visIndex );
 	// Attempts to write the currently pending snap to the supplied buffer, which can then be sent as an unreliable msg.
 	// SubmitPendingSnap will submit the pending snap to a job, so that it can be retrieved later for sending.
-	void SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData );
+	void SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, byteLZCompressionData_t* byteLZData );
 	// GetPendingSnapDelta
 	int GetPendingSnapDelta( byte* outBuffer, int maxLength );
 	// If PendingSnapReadyToSend is true, then GetPendingSnapDelta will return something to send
@@ -174,6 +174,11 @@ private:
 	idSnapShot		submittedTemplateStates;
 	
 	int				partialBaseSequence;
+	
+	int				snapCodec;				// snapCodec_t used for the deltas of this connection, picked when it starts
+	
+	bool			throttleLowPriority;	// set while deltas don't fit net_optimalSnapDeltaSize, low priority objects are rotated
+	int				lowPriorityOffset;
 };
 
 #endif /* !__SNAP_PROCESSOR_H__ */
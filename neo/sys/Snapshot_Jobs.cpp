@@ -57,11 +57,11 @@ ID_INLINE bool ObjectsSame( objJobState_t& newState, objJobState_t& oldState )
 		return false;		// Can't match if sizes different
 	}
 	
-	/*
-	if ( newState.data == oldState.data ) {
+	// the server shares the buffers of objects that didn't change between snapshots
+	if( newState.data == oldState.data )
+	{
 		return true;		// Definite match
 	}
-	*/
 	
 	if( memcmp( newState.data, oldState.data, newState.size ) == 0 )
 	{
@@ -170,7 +170,7 @@ void SnapshotObjectJob( objParms_t* parms )
 		// New object, write out full state
 		assert( newState.valid );
 		// delta against an empty snap
-		rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
+		rleCompressor.Start( dataStart, ( idLZWCompressor* )NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
 		rleCompressor.WriteBytes( newState.data, newState.size );
 		header->csize = rleCompressor.End();
 		header->flags |= OBJ_NEW;
@@ -195,7 +195,7 @@ void SnapshotObjectJob( objParms_t* parms )
 		if( !visChange || visSendState )
 		{
 			int compareSize = Min( newState.size, oldState.size );
-			rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
+			rleCompressor.Start( dataStart, ( idLZWCompressor* )NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
 			for( int b = 0; b < compareSize; b++ )
 			{
 				byte delta = newState.data[b] - oldState.data[b];
@@ -245,7 +245,8 @@ void SnapshotObjectJob( objParms_t* parms )
 FinishLZWStream
 ========================
 */
-static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+template< class compressor_t >
+static void FinishLZWStream( lzwParm_t* parm, compressor_t* lzwCompressor )
 {
 	if( lzwCompressor->IsOverflowed() )
 	{
@@ -265,7 +266,7 @@ static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 		return;
 	}
 	
-	int size = lzwCompressor->Length();
+	int size = lzwCompressor->Length() + 1;		// Codec byte
 	
 	pendingDelta.offset			= parm->ioData->lzwBytes;		// Remember offset into buffer
 	pendingDelta.size			= size;							// Remember size
@@ -280,12 +281,14 @@ static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 NewLZWStream
 ========================
 */
-static void NewLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+template< class compressor_t >
+static void NewLZWStream( lzwParm_t* parm, compressor_t* lzwCompressor )
 {
 
-	// Reset compressor
-	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes;
-	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize );
+	// Reset compressor, the stream starts after the codec byte
+	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes - 1;
+	parm->ioData->lzwMem[parm->ioData->lzwBytes] = ( uint8 )parm->ioData->codec;
+	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes + 1], maxSize );
 	
 	parm->ioData->lastObjId = 0;
 	
@@ -301,47 +304,26 @@ static void NewLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 ContinueLZWStream
 ========================
 */
-static void ContinueLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+template< class compressor_t >
+static void ContinueLZWStream( lzwParm_t* parm, compressor_t* lzwCompressor )
 {
 	// Continue compressor where we left off
-	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes;
-	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize, true );
+	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes - 1;
+	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes + 1], maxSize, true );
 }
 
 /*
 ========================
-LZWJobInternal
+WriteDeltaStream
 This job takes a stream of objects, which should already be zrle compressed, and then lzw compresses them
 and builds a final delta packet ready to be sent to peers.
 ========================
 */
-void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
+template< class compressor_t >
+static void WriteDeltaStream( lzwParm_t* parm, compressor_t& lzwCompressor )
 {
 	assert( parm->numObjects > 0 );
 	
-#ifndef ALLOW_MULTIPLE_DELTAS
-	if( parm->ioData->numlzwDeltas > 0 )
-	{
-		// Currently, we don't use fragmented deltas.
-		// We only send the first one and rely on a full snap being sent to get the whole snap across
-		assert( parm->ioData->numlzwDeltas == 1 );
-		assert( !parm->ioData->fullSnap );
-		return;
-	}
-#endif
-	
-	assert( parm->ioData->lzwBytes < parm->ioData->maxlzwMem );
-	
-	dmaTag = dmaTag;
-	
-#ifdef __GNUC__
-	// DG: remove ALIGN16 for GCC/clang, as they can't use it here and clang gets an error
-	idLZWCompressor lzwCompressor( parm->ioData->lzwData );
-	// DG end
-#else
-	ALIGN16( idLZWCompressor lzwCompressor( parm->ioData->lzwData ) );
-#endif
-	
 	if( parm->fragmented )
 	{
 		// This packet was partially written out, we need to continue writing, using previous lzw dictionary values
@@ -398,7 +380,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		numChangedObjProcessed++;
 		
 		// Write obj id as delta into stream
-		lzwCompressor.WriteAgnostic<uint16>( ( uint16 )( header->objID - parm->ioData->lastObjId ) );
+		lzwCompressor.template WriteAgnostic<uint16>( ( uint16 )( header->objID - parm->ioData->lastObjId ) );
 		parm->ioData->lastObjId = ( uint16 )header->objID;
 		
 		// Check special stale/notstale flags
@@ -406,7 +388,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		{
 			// Write stale/notstale flag
 			objectSize_t value = ( header->flags & OBJ_VIS_STALE ) ? SIZE_STALE : SIZE_NOT_STALE;
-			lzwCompressor.WriteAgnostic<objectSize_t>( value );
+			lzwCompressor.template WriteAgnostic<objectSize_t>( value );
 		}
 		
 		if( header->flags & OBJ_VIS_STALE )
@@ -417,12 +399,12 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		if( header->flags & OBJ_DELETED )
 		{
 			// Object was deleted
-			lzwCompressor.WriteAgnostic<objectSize_t>( 0 );
+			lzwCompressor.template WriteAgnostic<objectSize_t>( 0 );
 			continue;
 		}
 		
 		// Write size
-		lzwCompressor.WriteAgnostic<objectSize_t>( ( objectSize_t )header->size );
+		lzwCompressor.template WriteAgnostic<objectSize_t>( ( objectSize_t )header->size );
 		
 		// Get compressed data area
 		uint8* compressedData = header->data;
@@ -469,7 +451,51 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		// the compressor did some work, wrote data to lzwMem, but since we didn't call FinishLZWStream to end the compression,
 		// we need to figure how much needs to be DMA'ed back out
 		assert( parm->ioData->lzwBytes == 0 ); // I don't think we ever hit this with lzwBytes != 0, but adding it just in case
-		parm->ioData->lzwDmaOut = parm->ioData->lzwBytes + lzwCompressor.Length();
+		parm->ioData->lzwDmaOut = parm->ioData->lzwBytes + lzwCompressor.Length() + 1;
+	}
+}
+
+/*
+========================
+LZWJobInternal
+========================
+*/
+void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
+{
+#ifndef ALLOW_MULTIPLE_DELTAS
+	if( parm->ioData->numlzwDeltas > 0 )
+	{
+		// Currently, we don't use fragmented deltas.
+		// We only send the first one and rely on a full snap being sent to get the whole snap across
+		assert( parm->ioData->numlzwDeltas == 1 );
+		assert( !parm->ioData->fullSnap );
+		return;
+	}
+#endif
+	
+	assert( parm->ioData->lzwBytes < parm->ioData->maxlzwMem );
+	
+	dmaTag = dmaTag;
+	
+	if( parm->ioData->codec == SNAP_CODEC_BYTELZ )
+	{
+#ifdef __GNUC__
+		idByteLZCompressor lzCompressor( parm->ioData->byteLZData );
+#else
+		ALIGN16( idByteLZCompressor lzCompressor( parm->ioData->byteLZData ) );
+#endif
+		WriteDeltaStream( parm, lzCompressor );
+	}
+	else
+	{
+#ifdef __GNUC__
+		// DG: remove ALIGN16 for GCC/clang, as they can't use it here and clang gets an error
+		idLZWCompressor lzwCompressor( parm->ioData->lzwData );
+		// DG end
+#else
+		ALIGN16( idLZWCompressor lzwCompressor( parm->ioData->lzwData ) );
+#endif
+		WriteDeltaStream( parm, lzwCompressor );
 	}
 	
 	assert( parm->ioData->lzwBytes < parm->ioData->maxlzwMem );
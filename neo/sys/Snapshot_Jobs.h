@@ -51,6 +51,15 @@ static const uint32 OBJ_DELETED			= ( 1 << 3 );			// Object was deleted (not goi
 static const uint32 OBJ_DIFFERENT		= ( 1 << 4 );			// Objects are in both snaps, but different
 static const uint32 OBJ_SAME			= ( 1 << 5 );			// Objects are in both snaps, and are the same (we don't send these, which means ack)
 
+// Compressor used for the final delta packets. The first byte of every delta packet holds the codec
+// so the receiving end can read deltas from servers using either one
+enum snapCodec_t
+{
+	SNAP_CODEC_LZW,				// idLZWCompressor
+	SNAP_CODEC_BYTELZ,			// idByteLZCompressor
+	SNAP_CODEC_COUNT
+};
+
 // This struct is used to communicate data from the obj jobs to the lzw job
 struct ALIGNTYPE16 objHeader_t
 {
@@ -110,7 +119,9 @@ struct ALIGNTYPE16 lzwInOutData_t
 	int						optimalLength;			// Optimal length of lzw streams
 	int						snapSequence;
 	uint16					lastObjId;				// Last obj id written out
+	int						codec;					// snapCodec_t used for the delta packets
 	lzwCompressionData_t* 	lzwData;
+	byteLZCompressionData_t* byteLZData;
 };
 
 // Input to the job that takes the results of the delta'd zrle obj's, and turns them into lzw delta packets
@@ -849,6 +849,143 @@ void Net_SendUDPPacket( int netSocket, int length, const void* data, const netad
 	}
 }
 
+/*
+================================================================================================
+
+	Batched UDP I/O
+
+	Each socket gets a ring of received packets that is refilled with a single recvmmsg call and
+	handed out one at a time by idUDP::GetPacket, and a queue of outgoing packets that is sent with
+	sendmmsg when it's full or at idUDP::EndSendBatch.
+
+================================================================================================
+*/
+
+idCVar net_udpBatch( "net_udpBatch", "1", CVAR_BOOL | CVAR_NOCHEAT, "receive and send UDP packets in batches (recvmmsg/sendmmsg), used for sockets opened afterwards" );
+
+#if defined( __linux__ )
+#define ID_NET_UDP_BATCH
+#endif
+
+static const int UDP_BATCH_PACKETS		= 32;
+static const int UDP_BATCH_PACKET_SIZE	= 1500;		// the session never sends more than a single ethernet frame
+
+struct udpBatch_t
+{
+	int				recvCount;
+	int				recvRead;
+	int				recvSize[ UDP_BATCH_PACKETS ];		// -1 for packets that didn't fit
+	sockaddr_in		recvFrom[ UDP_BATCH_PACKETS ];
+	
+	int				sendCount;
+	int				sendSize[ UDP_BATCH_PACKETS ];
+	sockaddr_in		sendTo[ UDP_BATCH_PACKETS ];
+	bool			sendBroadcast[ UDP_BATCH_PACKETS ];
+	
+	char			recvData[ UDP_BATCH_PACKETS ][ UDP_BATCH_PACKET_SIZE ];
+	char			sendData[ UDP_BATCH_PACKETS ][ UDP_BATCH_PACKET_SIZE ];
+};
+
+/*
+========================
+Net_ReceiveUDPBatch
+
+Returns the number of slots filled, including the ones that were truncated.
+========================
+*/
+static int Net_ReceiveUDPBatch( int netSocket, udpBatch_t* batch )
+{
+#ifdef ID_NET_UDP_BATCH
+	mmsghdr		msgs[ UDP_BATCH_PACKETS ];
+	iovec		iovs[ UDP_BATCH_PACKETS ];
+	
+	memset( msgs, 0, sizeof( msgs ) );
+	for( int i = 0; i < UDP_BATCH_PACKETS; i++ )
+	{
+		iovs[i].iov_base = batch->recvData[i];
+		iovs[i].iov_len = UDP_BATCH_PACKET_SIZE;
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &batch->recvFrom[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof( batch->recvFrom[i] );
+	}
+	
+	int ret = recvmmsg( netSocket, msgs, UDP_BATCH_PACKETS, MSG_DONTWAIT, NULL );
+	if( ret == SOCKET_ERROR )
+	{
+		int err = Net_GetLastError();
+		if( err != D3_NET_EWOULDBLOCK && err != D3_NET_ECONNRESET )
+		{
+			idLib::Printf( "Net_ReceiveUDPBatch: %s\n", NET_ErrorString() );
+		}
+		return 0;
+	}
+	
+	for( int i = 0; i < ret; i++ )
+	{
+		batch->recvSize[i] = msgs[i].msg_len;
+		if( ( msgs[i].msg_hdr.msg_flags & MSG_TRUNC ) != 0 )
+		{
+			netadr_t from;
+			Net_SockadrToNetadr( &batch->recvFrom[i], &from );
+			idLib::Printf( "Net_ReceiveUDPBatch: oversize packet from %s\n", Sys_NetAdrToString( from ) );
+			batch->recvSize[i] = -1;
+		}
+	}
+	return ret;
+#else
+	return 0;
+#endif
+}
+
+/*
+========================
+Net_SendUDPBatch
+========================
+*/
+static void Net_SendUDPBatch( int netSocket, udpBatch_t* batch )
+{
+#ifdef ID_NET_UDP_BATCH
+	mmsghdr		msgs[ UDP_BATCH_PACKETS ];
+	iovec		iovs[ UDP_BATCH_PACKETS ];
+	
+	memset( msgs, 0, sizeof( msgs ) );
+	for( int i = 0; i < batch->sendCount; i++ )
+	{
+		iovs[i].iov_base = batch->sendData[i];
+		iovs[i].iov_len = batch->sendSize[i];
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &batch->sendTo[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof( batch->sendTo[i] );
+	}
+	
+	int sent = 0;
+	while( sent < batch->sendCount )
+	{
+		int ret = sendmmsg( netSocket, &msgs[sent], batch->sendCount - sent, 0 );
+		if( ret <= 0 )
+		{
+			int err = Net_GetLastError();
+			if( err == EINTR )
+			{
+				continue;
+			}
+			// the error belongs to the first packet that wasn't sent, skip it and send the rest
+			// some PPP links do not allow broadcasts and return an error
+			if( !( err == D3_NET_EADDRNOTAVAIL && batch->sendBroadcast[sent] ) )
+			{
+				idLib::Printf( "UDP sendmmsg error - packet dropped: %s\n", NET_ErrorString() );
+			}
+			sent++;
+			continue;
+		}
+		sent += ret;
+	}
+#endif
+	batch->sendCount = 0;
+}
+
 static void ip_to_addr( const char ip[4], char* addr )
 {
 	idStr::snPrintf( addr, 16, "%d.%d.%d.%d", ( unsigned char )ip[0], ( unsigned char )ip[1],
@@ -1405,6 +1542,8 @@ idUDP::idUDP()
 	netSocket = 0;
 	memset( &bound_to, 0, sizeof( bound_to ) );
 	silent = false;
+	batch = NULL;
+	sendBatching = false;
 	packetsRead = 0;
 	bytesRead = 0;
 	packetsWritten = 0;
@@ -1439,6 +1578,16 @@ bool idUDP::InitForPort( int portNumber )
 		return false;
 	}
 	
+#ifdef ID_NET_UDP_BATCH
+	if( net_udpBatch.GetBool() )
+	{
+		batch = new( TAG_NETWORKING ) udpBatch_t;
+		batch->recvCount = 0;
+		batch->recvRead = 0;
+		batch->sendCount = 0;
+	}
+#endif
+	
 	return true;
 }
 
@@ -1455,6 +1604,11 @@ void idUDP::Close()
 		netSocket = 0;
 		memset( &bound_to, 0, sizeof( bound_to ) );
 	}
+	
+	// anything still queued is dropped, just like the packets in the socket buffers
+	delete batch;
+	batch = NULL;
+	sendBatching = false;
 }
 
 /*
@@ -1464,8 +1618,46 @@ idUDP::GetPacket
 */
 bool idUDP::GetPacket( netadr_t& from, void* data, int& size, int maxSize )
 {
+	if( batch != NULL )
+	{
+		if( !netSocket )
+		{
+			return false;
+		}
+		
+		while( 1 )
+		{
+			if( batch->recvRead >= batch->recvCount )
+			{
+				// one system call for up to UDP_BATCH_PACKETS packets
+				batch->recvRead = 0;
+				batch->recvCount = Net_ReceiveUDPBatch( netSocket, batch );
+				if( batch->recvCount == 0 )
+				{
+					return false;
+				}
+			}
+			
+			const int i = batch->recvRead++;
+			if( batch->recvSize[i] < 0 )
+			{
+				continue;
+			}
+			
+			Net_SockadrToNetadr( &batch->recvFrom[i], &from );
+			if( batch->recvSize[i] > maxSize )
+			{
+				idLib::Printf( "Net_GetUDPPacket: oversize packet from %s\n", Sys_NetAdrToString( from ) );
+				continue;
+			}
+			
+			size = batch->recvSize[i];
+			memcpy( data, batch->recvData[i], size );
+			break;
+		}
+	}
 	// DG: this fake while(1) loop pissed me off so I replaced it.. no functional change.
-	if( ! Net_GetUDPPacket( netSocket, from, ( char* )data, size, maxSize ) )
+	else if( ! Net_GetUDPPacket( netSocket, from, ( char* )data, size, maxSize ) )
 	{
 		return false;
 	}
@@ -1484,7 +1676,12 @@ idUDP::GetPacketBlocking
 */
 bool idUDP::GetPacketBlocking( netadr_t& from, void* data, int& size, int maxSize, int timeout )
 {
-
+	// packets already in the receive ring don't show up in select()
+	if( GetPacket( from, data, size, maxSize ) )
+	{
+		return true;
+	}
+	
 	if( !Net_WaitForData( netSocket, timeout ) )
 	{
 		return false;
@@ -1519,6 +1716,143 @@ void idUDP::SendPacket( const netadr_t to, const void* data, int size )
 		return;
 	}
 	
+	if( batch != NULL && sendBatching && !usingSocks && size <= UDP_BATCH_PACKET_SIZE )
+	{
+		if( batch->sendCount == UDP_BATCH_PACKETS )
+		{
+			Net_SendUDPBatch( netSocket, batch );
+		}
+		
+		const int i = batch->sendCount++;
+		Net_NetadrToSockadr( &to, &batch->sendTo[i] );
+		batch->sendBroadcast[i] = ( to.type == NA_BROADCAST );
+		batch->sendSize[i] = size;
+		memcpy( batch->sendData[i], data, size );
+		return;
+	}
+	
+	// keep the packets in order
+	if( batch != NULL && batch->sendCount > 0 )
+	{
+		Net_SendUDPBatch( netSocket, batch );
+	}
+	
 	Net_SendUDPPacket( netSocket, size, data, to );
 }
 
+/*
+========================
+idUDP::BeginSendBatch
+========================
+*/
+void idUDP::BeginSendBatch()
+{
+	sendBatching = true;
+}
+
+/*
+========================
+idUDP::EndSendBatch
+========================
+*/
+void idUDP::EndSendBatch()
+{
+	sendBatching = false;
+	
+	if( batch != NULL && batch->sendCount > 0 )
+	{
+		Net_SendUDPBatch( netSocket, batch );
+	}
+}
+
+/*
+========================
+net_udpBenchmark
+
+Sends packets from one loopback socket to another in windows of UDP_BATCH_PACKETS, once with
+a system call per packet and once batched. Every packet carries its send time for the latency.
+========================
+*/
+CONSOLE_COMMAND( net_udpBenchmark, "measures loopback UDP packets per second and latency with and without batching, usage: net_udpBenchmark [numPackets] [packetSize]", 0 )
+{
+	const int numPackets = ( args.Argc() > 1 ) ? Max( UDP_BATCH_PACKETS, atoi( args.Argv( 1 ) ) ) : 100000;
+	const int packetSize = ( args.Argc() > 2 ) ? idMath::ClampInt( sizeof( uint64 ), UDP_BATCH_PACKET_SIZE, atoi( args.Argv( 2 ) ) ) : idPacketProcessor::MAX_FINAL_PACKET_SIZE;
+	
+	char packet[ UDP_BATCH_PACKET_SIZE ];
+	memset( packet, 0, sizeof( packet ) );
+	
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		const bool batched = ( pass == 1 );
+		
+		// net_udpBatch is only looked at when the socket is opened
+		const bool oldBatch = net_udpBatch.GetBool();
+		net_udpBatch.SetBool( batched );
+		idUDP sender;
+		idUDP receiver;
+		const bool opened = sender.InitForPort( PORT_ANY ) && receiver.InitForPort( PORT_ANY );
+		net_udpBatch.SetBool( oldBatch );
+		
+		if( !opened )
+		{
+			idLib::Warning( "net_udpBenchmark: couldn't open the loopback sockets" );
+			return;
+		}
+		if( batched && !receiver.IsBatched() )
+		{
+			idLib::Printf( "net_udpBenchmark: batched UDP I/O isn't available on this platform\n" );
+			return;
+		}
+		
+		netadr_t to;
+		memset( &to, 0, sizeof( to ) );
+		to.type = NA_IP;
+		to.ip[0] = 127;
+		to.ip[3] = 1;
+		to.port = receiver.GetPort();
+		
+		uint64 latencyTotal = 0;
+		uint64 latencyMax = 0;
+		int received = 0;
+		
+		const uint64 startTime = Sys_Microseconds();
+		for( int sent = 0; sent < numPackets; )
+		{
+			const int window = Min( UDP_BATCH_PACKETS, numPackets - sent );
+			
+			sender.BeginSendBatch();
+			for( int i = 0; i < window; i++ )
+			{
+				const uint64 sendTime = Sys_Microseconds();
+				memcpy( packet, &sendTime, sizeof( sendTime ) );
+				sender.SendPacket( to, packet, packetSize );
+			}
+			sender.EndSendBatch();
+			sent += window;
+			
+			// drain the window so the socket buffer can't overflow
+			char recvPacket[ UDP_BATCH_PACKET_SIZE ];
+			netadr_t from;
+			int size = 0;
+			for( int i = 0; i < window; i++ )
+			{
+				if( !receiver.GetPacketBlocking( from, recvPacket, size, sizeof( recvPacket ), 100 ) )
+				{
+					break;
+				}
+				uint64 sendTime;
+				memcpy( &sendTime, recvPacket, sizeof( sendTime ) );
+				const uint64 latency = Sys_Microseconds() - sendTime;
+				latencyTotal += latency;
+				latencyMax = Max( latencyMax, latency );
+				received++;
+			}
+		}
+		const uint64 totalTime = Max( Sys_Microseconds() - startTime, ( uint64 )1 );
+		
+		idLib::Printf( "%-9s %d x %d bytes: %.1f msec, %.0f packets/sec, latency avg %.1f usec max %.1f usec, %d lost\n",
+					   batched ? "batched" : "unbatched", numPackets, packetSize, totalTime * 0.001,
+					   received * 1000000.0 / totalTime, received > 0 ? ( double )latencyTotal / received : 0.0, ( double )latencyMax, numPackets - received );
+	}
+}
+
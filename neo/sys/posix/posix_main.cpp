@@ -650,6 +650,72 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return st.st_mtime;
 }
 
+/*
+================
+Sys_MapFileReadOnly
+================
+*/
+const byte* Sys_MapFileReadOnly( const char* osPath, int& length )
+{
+	length = 0;
+	
+	int fd = open( osPath, O_RDONLY );
+	if( fd == -1 )
+	{
+		return NULL;
+	}
+	
+	struct stat st;
+	if( fstat( fd, &st ) == -1 || st.st_size <= 0 || st.st_size > INT_MAX )
+	{
+		close( fd );
+		return NULL;
+	}
+	
+	// the mapping keeps its own reference to the file
+	void* data = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( data == MAP_FAILED )
+	{
+		return NULL;
+	}
+	
+	length = ( int )st.st_size;
+	return ( const byte* )data;
+}
+
+/*
+================
+Sys_UnmapFile
+================
+*/
+void Sys_UnmapFile( const byte* data, int length )
+{
+	if( data != NULL )
+	{
+		munmap( ( void* )data, length );
+	}
+}
+
+/*
+================
+Sys_PrefetchMappedRange
+================
+*/
+void Sys_PrefetchMappedRange( const byte* data, int length )
+{
+	if( data == NULL || length <= 0 )
+	{
+		return;
+	}
+	
+	// madvise wants a page aligned address
+	const uintptr_t pageSize = ( uintptr_t )sysconf( _SC_PAGESIZE );
+	const uintptr_t start = ( uintptr_t )data & ~( pageSize - 1 );
+	const uintptr_t end = ( uintptr_t )data + length;
+	madvise( ( void* )start, end - start, MADV_WILLNEED );
+}
+
 void Sys_Sleep( int msec )
 {
 #if 0 // DG: I don't really care, this spams the console (and on windows this case isn't handled either)
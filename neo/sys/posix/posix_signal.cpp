@@ -119,6 +119,9 @@ static void sig_handler( int signum, siginfo_t* info, void* context )
 	
 	Sys_Printf( "Trying to exit gracefully..\n" );
 	
+	// get the buffered log out in case the shutdown doesn't make it
+	common->FlushLogFile();
+	
 	Posix_SetExit( signum );
 	
 	common->Quit();
@@ -136,6 +136,7 @@ void idLobby::Initialize( lobbyType_t sessionType_, idSessionCallbacks* callback
 		// only needed in multiplayer mode
 		objMemory		= ( uint8* )Mem_Alloc( SNAP_OBJ_JOB_MEMORY, TAG_NETWORKING );
 		lzwData			= ( lzwCompressionData_t* )Mem_Alloc( sizeof( lzwCompressionData_t ), TAG_NETWORKING );
+		byteLZData		= ( byteLZCompressionData_t* )Mem_Alloc( sizeof( byteLZCompressionData_t ), TAG_NETWORKING );
 	}
 }
 
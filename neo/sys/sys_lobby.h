@@ -927,6 +927,7 @@ public:		// Turning this on for now, for the sake of getting this up and running
 	static const int SNAP_OBJ_JOB_MEMORY = 1024 * 128;			// 128k of obj memory
 	
 	lzwCompressionData_t* 				lzwData;				// Shared across all snapshot jobs
+	byteLZCompressionData_t* 			byteLZData;				// Shared across all snapshot jobs
 	uint8* 								objMemory;				// Shared across all snapshot jobs
 	bool								haveSubmittedSnaps;		// True if we previously submitted snaps to jobs
 	idSnapShot* 						localReadSS;
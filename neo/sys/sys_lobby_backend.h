@@ -81,6 +81,9 @@ public:
 	bool ReadRawPacket( lobbyAddress_t& from, void* data, int& size, int maxSize );
 	void SendRawPacket( const lobbyAddress_t& to, const void* data, int size );
 	
+	void BeginSendBatch();
+	void EndSendBatch();
+	
 	bool IsOpen();
 	void Close();
 	
@@ -586,6 +586,12 @@ typedef FILE* idFileHandle;
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// read only memory mapping of a whole file, returns NULL if the file can't be mapped
+const byte* 	Sys_MapFileReadOnly( const char* osPath, int& length );
+void			Sys_UnmapFile( const byte* data, int length );
+// hint to the OS that the mapped range is going to be read soon
+void			Sys_PrefetchMappedRange( const byte* data, int length );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char* 	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char* 	Sys_SecToStr( int sec );
@@ -679,6 +685,11 @@ public:
 								   
 	void		SendPacket( const netadr_t to, const void* data, int size );
 	
+	// packets sent between Begin and EndSendBatch are queued and go out with as few system calls as possible
+	// (sendmmsg on Linux), EndSendBatch sends everything that is still queued
+	void		BeginSendBatch();
+	void		EndSendBatch();
+	
 	void		SetSilent( bool silent )
 	{
 		this->silent = silent;
@@ -698,11 +709,18 @@ public:
 	{
 		return netSocket > 0;
 	}
+	bool		IsBatched() const
+	{
+		return batch != NULL;
+	}
 	
 private:
 	netadr_t	bound_to;		// interface and port
 	int			netSocket;		// OS specific socket
 	bool		silent;			// don't emit anything ( black hole )
+	
+	struct udpBatch_t* batch;	// packet rings for batched I/O, NULL if the platform can't batch
+	bool		sendBatching;	// inside Begin/EndSendBatch
 };
 
 struct msg_t
@@ -89,7 +89,7 @@ struct netVersion_s
 {
 	netVersion_s()
 	{
-		sprintf( string, "%s.%d", ENGINE_VERSION, BUILD_NUMBER );
+		sprintf( string, "%s.%d.%d", ENGINE_VERSION, BUILD_NUMBER, ASYNC_PROTOCOL_VERSION );
 	}
 	char	string[256];
 } netVersion;
@@ -2031,6 +2031,9 @@ void idSessionLocal::Pump()
 	
 	lastPumpTime = time;
 	
+	// everything the lobbies send while pumping goes out in batches
+	GetPort().BeginSendBatch();
+	
 	if( net_migrateHost.GetInteger() >= 0 )
 	{
 		if( net_migrateHost.GetInteger() <= 2 )
@@ -2104,6 +2107,8 @@ void idSessionLocal::Pump()
 	GetGameLobby().PumpPackets();
 	GetGameStateLobby().PumpPackets();
 	
+	GetPort().EndSendBatch();
+	
 	int currentTime = Sys_Milliseconds();
 	
 	const int SHOW_MIGRATING_INFO_IN_SECONDS = 3;	// Show for at least this long once we start showing it
@@ -4508,6 +4513,26 @@ void idNetSessionPort::SendRawPacket( const lobbyAddress_t& to, const void* data
 	UDP.SendPacket( to.netAddr, data, size );
 }
 
+/*
+========================
+idNetSessionPort::BeginSendBatch
+========================
+*/
+void idNetSessionPort::BeginSendBatch()
+{
+	UDP.BeginSendBatch();
+}
+
+/*
+========================
+idNetSessionPort::EndSendBatch
+========================
+*/
+void idNetSessionPort::EndSendBatch()
+{
+	UDP.EndSendBatch();
+}
+
 /*
 ========================
 idNetSessionPort::IsOpen
@@ -475,6 +475,63 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp ) {
 	return itime.QuadPart;
 }
 
+/*
+================
+Sys_MapFileReadOnly
+================
+*/
+const byte* Sys_MapFileReadOnly( const char* osPath, int& length ) {
+	length = 0;
+
+	HANDLE file = CreateFile( osPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( file == INVALID_HANDLE_VALUE ) {
+		return NULL;
+	}
+
+	LARGE_INTEGER size;
+	if ( !GetFileSizeEx( file, &size ) || size.QuadPart <= 0 || size.QuadPart > INT_MAX ) {
+		CloseHandle( file );
+		return NULL;
+	}
+
+	// the view keeps its own reference to the mapping and the file
+	HANDLE mapping = CreateFileMapping( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	CloseHandle( file );
+	if ( mapping == NULL ) {
+		return NULL;
+	}
+	const void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	CloseHandle( mapping );
+	if ( data == NULL ) {
+		return NULL;
+	}
+
+	length = (int)size.QuadPart;
+	return (const byte *)data;
+}
+
+/*
+================
+Sys_UnmapFile
+================
+*/
+void Sys_UnmapFile( const byte* data, int length ) {
+	if ( data != NULL ) {
+		UnmapViewOfFile( data );
+	}
+}
+
+/*
+================
+Sys_PrefetchMappedRange
+
+PrefetchVirtualMemory isn't available on all supported versions of Windows,
+the pages are faulted in on first access instead
+================
+*/
+void Sys_PrefetchMappedRange( const byte* data, int length ) {
+}
+
 /*
 ========================
 Sys_Rmdir
@@ -1471,6 +1528,7 @@ EXCEPTION_DISPOSITION __cdecl _except_handler( struct _EXCEPTION_RECORD *Excepti
 			FPUFlags
 		);
 
+	common->FlushLogFile();
 	EmailCrashReport( msg );
 	common->FatalError( msg );
 
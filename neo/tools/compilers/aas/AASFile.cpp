@@ -638,6 +638,85 @@ bool idAASSettings::WriteToFile( idFile* fp ) const
 	return true;
 }
 
+/*
+============
+idAASSettings::FromBinaryFile
+============
+*/
+bool idAASSettings::FromBinaryFile( idFile* fp )
+{
+	int i;
+	
+	fp->ReadInt( numBoundingBoxes );
+	if( numBoundingBoxes <= 0 || numBoundingBoxes > MAX_AAS_BOUNDING_BOXES )
+	{
+		return false;
+	}
+	for( i = 0; i < numBoundingBoxes; i++ )
+	{
+		fp->ReadVec3( boundingBoxes[i][0] );
+		fp->ReadVec3( boundingBoxes[i][1] );
+	}
+	fp->ReadBool( usePatches );
+	fp->ReadBool( useStaticMeshes );
+	fp->ReadFloat( meshSlopeCos );
+	fp->ReadBool( writeBrushMap );
+	fp->ReadBool( playerFlood );
+	fp->ReadBool( noOptimize );
+	fp->ReadBool( allowSwimReachabilities );
+	fp->ReadBool( allowFlyReachabilities );
+	fp->ReadString( fileExtension );
+	fp->ReadVec3( gravity );
+	gravityDir = gravity;
+	gravityValue = gravityDir.Normalize();
+	invGravityDir = -gravityDir;
+	fp->ReadFloat( maxStepHeight );
+	fp->ReadFloat( maxBarrierHeight );
+	fp->ReadFloat( maxWaterJumpHeight );
+	fp->ReadFloat( maxFallHeight );
+	fp->ReadFloat( minFloorCos );
+	fp->ReadInt( tt_barrierJump );
+	fp->ReadInt( tt_startCrouching );
+	fp->ReadInt( tt_waterJump );
+	return ( fp->ReadInt( tt_startWalkOffLedge ) == sizeof( tt_startWalkOffLedge ) );
+}
+
+/*
+============
+idAASSettings::WriteToBinaryFile
+============
+*/
+void idAASSettings::WriteToBinaryFile( idFile* fp ) const
+{
+	int i;
+	
+	fp->WriteInt( numBoundingBoxes );
+	for( i = 0; i < numBoundingBoxes; i++ )
+	{
+		fp->WriteVec3( boundingBoxes[i][0] );
+		fp->WriteVec3( boundingBoxes[i][1] );
+	}
+	fp->WriteBool( usePatches );
+	fp->WriteBool( useStaticMeshes );
+	fp->WriteFloat( meshSlopeCos );
+	fp->WriteBool( writeBrushMap );
+	fp->WriteBool( playerFlood );
+	fp->WriteBool( noOptimize );
+	fp->WriteBool( allowSwimReachabilities );
+	fp->WriteBool( allowFlyReachabilities );
+	fp->WriteString( fileExtension );
+	fp->WriteVec3( gravity );
+	fp->WriteFloat( maxStepHeight );
+	fp->WriteFloat( maxBarrierHeight );
+	fp->WriteFloat( maxWaterJumpHeight );
+	fp->WriteFloat( maxFallHeight );
+	fp->WriteFloat( minFloorCos );
+	fp->WriteInt( tt_barrierJump );
+	fp->WriteInt( tt_startCrouching );
+	fp->WriteInt( tt_waterJump );
+	fp->WriteInt( tt_startWalkOffLedge );
+}
+
 /*
 ============
 idAASSettings::ValidForBounds
@@ -777,6 +856,7 @@ void idAASFileLocal::Clear()
 	portals.Clear();
 	portalIndex.Clear();
 	clusters.Clear();
+	areaTravelTimes.Clear();
 }
 
 /*
@@ -1315,22 +1395,16 @@ void idAASFileLocal::FinishAreas()
 
 /*
 ================
-idAASFileLocal::Load
+idAASFileLocal::LoadText
 ================
 */
-bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
+bool idAASFileLocal::LoadText( unsigned int mapFileCRC )
 {
 	idLexer src( LEXFL_NOFATALERRORS | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWPATHNAMES );
 	idToken token;
 	int depth;
 	unsigned int c;
 	
-	name = fileName;
-	crc = mapFileCRC;
-	
-	common->Printf( "[Load AAS]\n" );
-	common->Printf( "loading %s\n", name.c_str() );
-	
 	if( !src.LoadFile( name ) )
 	{
 		return false;
@@ -1471,13 +1545,530 @@ bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 	
-	common->UpdateLevelLoadPacifier(true);
+	return true;
+}
+
+/*
+===============================================================================
+
+	Binary AAS file
+	
+	The text AAS file is cached as a binary file in generated/ the first time it is
+	loaded. A header with the map file CRC, the timestamp of the text file and a table
+	of sections is followed by the sections themselves. The fixed size sections are the
+	raw arrays of the lists in memory, aligned to 16 bytes, and are read straight into
+	the list storage. Reachabilities are stored as flat records in list order and the
+	area travel times are stored precomputed, so only the pointers need to be linked.
+
+===============================================================================
+*/
+
+enum
+{
+	AAS_SECTION_SETTINGS,
+	AAS_SECTION_PLANES,
+	AAS_SECTION_VERTICES,
+	AAS_SECTION_EDGES,
+	AAS_SECTION_EDGEINDEX,
+	AAS_SECTION_FACES,
+	AAS_SECTION_FACEINDEX,
+	AAS_SECTION_AREAS,
+	AAS_SECTION_NODES,
+	AAS_SECTION_PORTALS,
+	AAS_SECTION_PORTALINDEX,
+	AAS_SECTION_CLUSTERS,
+	AAS_SECTION_REACHABILITIES,
+	AAS_SECTION_SPECIALS,
+	AAS_SECTION_AREATRAVELTIMES,
+	AAS_NUM_SECTIONS
+};
+
+typedef struct aasBinarySection_s
+{
+	int							num;				// number of elements in the section
+	int							elementSize;		// size of a single element, zero for variable size sections
+	int							offset;				// offset of the section from the start of the file
+} aasBinarySection_t;
+
+typedef struct aasBinaryHeader_s
+{
+	int							magic;				// stored in native byte order so files from other platforms are rejected
+	int							version;
+	unsigned int				mapFileCRC;			// CRC of the map file the AAS file was compiled from
+	int							numSections;
+	int64						sourceTimeStamp;	// timestamp of the text AAS file
+	aasBinarySection_t			sections[AAS_NUM_SECTIONS];
+} aasBinaryHeader_t;
+
+typedef struct aasBinaryReach_s
+{
+	int							travelType;
+	int							toAreaNum;
+	int							fromAreaNum;
+	idVec3						start;
+	idVec3						end;
+	int							edgeNum;
+	int							travelTime;
+} aasBinaryReach_t;
+
+/*
+================
+AAS_BeginBinarySection
+================
+*/
+static void AAS_BeginBinarySection( idFile* fp, aasBinarySection_t& section, int num, int elementSize )
+{
+	static const byte pad[16] = { 0 };
+	
+	int misalign = fp->Tell() & 15;
+	if( misalign != 0 )
+	{
+		fp->Write( pad, 16 - misalign );
+	}
+	section.num = num;
+	section.elementSize = elementSize;
+	section.offset = fp->Tell();
+}
+
+/*
+================
+AAS_WriteBinarySection
+================
+*/
+template< class type >
+static void AAS_WriteBinarySection( idFile* fp, aasBinarySection_t& section, const type* data, int num )
+{
+	AAS_BeginBinarySection( fp, section, num, sizeof( type ) );
+	if( num > 0 )
+	{
+		fp->Write( data, num * sizeof( type ) );
+	}
+}
+
+/*
+================
+AAS_ReadBinarySection
+
+  reads a fixed size section directly into the list storage
+================
+*/
+template< class type, memTag_t _tag_ >
+static bool AAS_ReadBinarySection( idFile* fp, const aasBinarySection_t& section, idList< type, _tag_ >& list )
+{
+	if( section.elementSize != sizeof( type ) || section.num < 0 )
+	{
+		return false;
+	}
+	list.SetNum( section.num );
+	if( section.num == 0 )
+	{
+		return true;
+	}
+	if( fp->Seek( section.offset, FS_SEEK_SET ) != 0 )
+	{
+		return false;
+	}
+	return ( fp->Read( list.Ptr(), section.num * sizeof( type ) ) == section.num * ( int ) sizeof( type ) );
+}
+
+/*
+================
+idAASFileLocal::LoadBinary
+================
+*/
+bool idAASFileLocal::LoadBinary( idFile* file, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp )
+{
+	aasBinaryHeader_t header;
+	idList< aasBinaryReach_t, TAG_AAS > reachRecords;
+	idReachability* reach, **tail;
+	int i, fromAreaNum;
+	
+	if( file->Read( &header, sizeof( header ) ) != sizeof( header ) )
+	{
+		return false;
+	}
+	if( header.magic != AAS_BINARYFILE_MAGIC || header.version != AAS_BINARYFILE_VERSION || header.numSections != AAS_NUM_SECTIONS )
+	{
+		return false;
+	}
+	if( header.mapFileCRC != mapFileCRC )
+	{
+		return false;
+	}
+	if( !fileSystem->InProductionMode() && header.sourceTimeStamp != ( int64 ) sourceTimeStamp && sourceTimeStamp > 0 )
+	{
+		return false;
+	}
+	
+	Clear();
+	
+	const aasBinarySection_t* sections = header.sections;
+	
+	if( file->Seek( sections[AAS_SECTION_SETTINGS].offset, FS_SEEK_SET ) != 0 || !settings.FromBinaryFile( file ) )
+	{
+		return false;
+	}
+	
+	if( !AAS_ReadBinarySection( file, sections[AAS_SECTION_PLANES], planeList ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_VERTICES], vertices ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_EDGES], edges ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_EDGEINDEX], edgeIndex ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_FACES], faces ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_FACEINDEX], faceIndex ) )
+	{
+		return false;
+	}
+	
+	// the reachability pointers are not stored, clear them even when the read
+	// failed half way so the caller can safely delete the reachabilities
+	bool areasRead = AAS_ReadBinarySection( file, sections[AAS_SECTION_AREAS], areas );
+	for( i = 0; i < areas.Num(); i++ )
+	{
+		areas[i].reach = NULL;
+		areas[i].rev_reach = NULL;
+	}
+	
+	if( !areasRead ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_NODES], nodes ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_PORTALS], portals ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_PORTALINDEX], portalIndex ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_CLUSTERS], clusters ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_AREATRAVELTIMES], areaTravelTimes ) ||
+			!AAS_ReadBinarySection( file, sections[AAS_SECTION_REACHABILITIES], reachRecords ) )
+	{
+		return false;
+	}
+	
+	// rebuild the reachability lists in the order they were written, the special
+	// reachabilities read their dictionaries from the specials section in the same order
+	if( file->Seek( sections[AAS_SECTION_SPECIALS].offset, FS_SEEK_SET ) != 0 )
+	{
+		return false;
+	}
+	
+	tail = NULL;
+	fromAreaNum = -1;
+	for( i = 0; i < reachRecords.Num(); i++ )
+	{
+		const aasBinaryReach_t& record = reachRecords[i];
+	
+		if( record.fromAreaNum < fromAreaNum || record.fromAreaNum >= areas.Num() || record.toAreaNum < 0 || record.toAreaNum >= areas.Num() )
+		{
+			return false;
+		}
+		if( record.fromAreaNum != fromAreaNum )
+		{
+			fromAreaNum = record.fromAreaNum;
+			tail = &areas[fromAreaNum].reach;
+		}
+	
+		if( record.travelType == TFL_SPECIAL )
+		{
+			idReachability_Special* special = new( TAG_AAS ) idReachability_Special();
+			special->dict.ReadFromFileHandle( file );
+			reach = special;
+		}
+		else
+		{
+			reach = new( TAG_AAS ) idReachability();
+		}
+		reach->travelType = record.travelType;
+		reach->toAreaNum = record.toAreaNum;
+		reach->fromAreaNum = record.fromAreaNum;
+		reach->start = record.start;
+		reach->end = record.end;
+		reach->edgeNum = record.edgeNum;
+		reach->travelTime = record.travelTime;
+		reach->next = NULL;
+		reach->rev_next = NULL;
+		reach->areaTravelTimes = NULL;
+	
+		*tail = reach;
+		tail = &reach->next;
+	}
+	
+	LinkReversedReachability();
+	
+	// the precomputed travel times have to match the reachabilities exactly
+	if( LinkAreaTravelTimes() != areaTravelTimes.Num() )
+	{
+		return false;
+	}
+	
+	return true;
+}
+
+/*
+================
+idAASFileLocal::WriteBinary
+================
+*/
+void idAASFileLocal::WriteBinary( idFile* file, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp ) const
+{
+	aasBinaryHeader_t header;
+	aasBinaryReach_t record;
+	aasArea_t area;
+	idReachability* reach;
+	int i, numReach, numSpecials;
+	
+	memset( &header, 0, sizeof( header ) );
+	header.magic = AAS_BINARYFILE_MAGIC;
+	header.version = AAS_BINARYFILE_VERSION;
+	header.mapFileCRC = mapFileCRC;
+	header.numSections = AAS_NUM_SECTIONS;
+	header.sourceTimeStamp = sourceTimeStamp;
+	
+	// the section table is written again once all offsets are known
+	file->Write( &header, sizeof( header ) );
+	
+	aasBinarySection_t* sections = header.sections;
+	
+	AAS_BeginBinarySection( file, sections[AAS_SECTION_SETTINGS], 1, 0 );
+	settings.WriteToBinaryFile( file );
+	
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_PLANES], planeList.Ptr(), planeList.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_VERTICES], vertices.Ptr(), vertices.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_EDGES], edges.Ptr(), edges.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_EDGEINDEX], edgeIndex.Ptr(), edgeIndex.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_FACES], faces.Ptr(), faces.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_FACEINDEX], faceIndex.Ptr(), faceIndex.Num() );
+	
+	// areas are written without the reachability pointers
+	AAS_BeginBinarySection( file, sections[AAS_SECTION_AREAS], areas.Num(), sizeof( aasArea_t ) );
+	for( i = 0; i < areas.Num(); i++ )
+	{
+		area = areas[i];
+		area.reach = NULL;
+		area.rev_reach = NULL;
+		file->Write( &area, sizeof( area ) );
+	}
+	
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_NODES], nodes.Ptr(), nodes.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_PORTALS], portals.Ptr(), portals.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_PORTALINDEX], portalIndex.Ptr(), portalIndex.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_CLUSTERS], clusters.Ptr(), clusters.Num() );
+	AAS_WriteBinarySection( file, sections[AAS_SECTION_AREATRAVELTIMES], areaTravelTimes.Ptr(), areaTravelTimes.Num() );
+	
+	numReach = NumReachabilities();
+	AAS_BeginBinarySection( file, sections[AAS_SECTION_REACHABILITIES], numReach, sizeof( aasBinaryReach_t ) );
+	numSpecials = 0;
+	for( i = 0; i < areas.Num(); i++ )
+	{
+		for( reach = areas[i].reach; reach; reach = reach->next )
+		{
+			memset( &record, 0, sizeof( record ) );
+			record.travelType = reach->travelType;
+			record.toAreaNum = reach->toAreaNum;
+			record.fromAreaNum = reach->fromAreaNum;
+			record.start = reach->start;
+			record.end = reach->end;
+			record.edgeNum = reach->edgeNum;
+			record.travelTime = reach->travelTime;
+			file->Write( &record, sizeof( record ) );
+			if( reach->travelType == TFL_SPECIAL )
+			{
+				numSpecials++;
+			}
+		}
+	}
+	
+	AAS_BeginBinarySection( file, sections[AAS_SECTION_SPECIALS], numSpecials, 0 );
+	for( i = 0; i < areas.Num(); i++ )
+	{
+		for( reach = areas[i].reach; reach; reach = reach->next )
+		{
+			if( reach->travelType == TFL_SPECIAL )
+			{
+				static_cast< idReachability_Special* >( reach )->dict.WriteToFileHandle( file );
+			}
+		}
+	}
+	
+	file->Seek( 0, FS_SEEK_SET );
+	file->Write( &header, sizeof( header ) );
+}
+
+/*
+================
+idAASFileLocal::Load
+================
+*/
+bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
+{
+	name = fileName;
+	crc = mapFileCRC;
+	
+	common->Printf( "[Load AAS]\n" );
+	common->Printf( "loading %s\n", name.c_str() );
+	
+	// the binary file can only be validated against a map file CRC, and the
+	// AAS compiler and dmap always work on the text file
+	bool useBinary = ( mapFileCRC != 0 && !( com_editors & ( EDITOR_AAS | EDITOR_DMAP ) ) );
+	
+	// keep the file extension in the name, the aas48 and aas96 files of a map are cached separately
+	idStr extension;
+	name.ExtractFileExtension( extension );
+	idStrStatic< MAX_OSPATH > generatedFileName = name;
+	generatedFileName.StripFileExtension();
+	generatedFileName.Insert( "generated/", 0 );
+	generatedFileName += "_";
+	generatedFileName += extension;
+	generatedFileName.SetFileExtension( AAS_BINARYFILE_EXT );
+	
+	ID_TIME_T sourceTimeStamp = fileSystem->GetTimestamp( name );
+	
+	if( useBinary )
+	{
+		idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+		if( file != NULL )
+		{
+			if( LoadBinary( file, mapFileCRC, sourceTimeStamp ) )
+			{
+				common->UpdateLevelLoadPacifier( true );
+				common->Printf( "done.\n" );
+				return true;
+			}
+			common->Printf( "%s is out of date\n", generatedFileName.c_str() );
+			DeleteReachabilities();
+			Clear();
+		}
+	}
+	
+	if( !LoadText( mapFileCRC ) )
+	{
+		return false;
+	}
+	
+	CalculateAreaTravelTimes();
+	
+	if( useBinary )
+	{
+		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+		if( outputFile != NULL )
+		{
+			WriteBinary( outputFile, mapFileCRC, sourceTimeStamp );
+		}
+	}
+	
+	common->UpdateLevelLoadPacifier( true );
 	
 	common->Printf( "done.\n" );
 	
 	return true;
 }
 
+/*
+================
+idAASFileLocal::LinkAreaTravelTimes
+
+  points each reachability at its slice of the area travel times, returns the number of travel times used
+================
+*/
+int idAASFileLocal::LinkAreaTravelTimes()
+{
+	int n, i, numRevReach, numTravelTimes;
+	idReachability* reach, *rev_reach;
+	
+	numTravelTimes = 0;
+	for( n = 0; n < areas.Num(); n++ )
+	{
+		if( !( areas[n].flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) )
+		{
+			continue;
+		}
+	
+		numRevReach = 0;
+		for( rev_reach = areas[n].rev_reach; rev_reach; rev_reach = rev_reach->rev_next )
+		{
+			numRevReach++;
+		}
+	
+		for( i = 0, reach = areas[n].reach; reach; reach = reach->next, i++ )
+		{
+			if( i >= MAX_REACH_PER_AREA )
+			{
+				common->Error( "idAASFileLocal::LinkAreaTravelTimes: area %d has more than %d reachabilities", n, MAX_REACH_PER_AREA );
+			}
+			if( numTravelTimes + numRevReach > areaTravelTimes.Num() )
+			{
+				return -1;
+			}
+			reach->number = i;
+			reach->disableCount = 0;
+			reach->areaTravelTimes = areaTravelTimes.Ptr() + numTravelTimes;
+			numTravelTimes += numRevReach;
+		}
+	}
+	return numTravelTimes;
+}
+
+/*
+================
+idAASFileLocal::CalculateAreaTravelTimes
+
+  for each reachability that starts in an area calculates the travel time
+  towards all the reachabilities that lead towards the area
+================
+*/
+void idAASFileLocal::CalculateAreaTravelTimes()
+{
+	int n, j, numReach, numRevReach, numTravelTimes, t, maxt;
+	idReachability* reach, *rev_reach;
+	
+	// get total memory for all area travel times
+	numTravelTimes = 0;
+	for( n = 0; n < areas.Num(); n++ )
+	{
+		if( !( areas[n].flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) )
+		{
+			continue;
+		}
+	
+		numReach = 0;
+		for( reach = areas[n].reach; reach; reach = reach->next )
+		{
+			numReach++;
+		}
+	
+		numRevReach = 0;
+		for( rev_reach = areas[n].rev_reach; rev_reach; rev_reach = rev_reach->rev_next )
+		{
+			numRevReach++;
+		}
+		numTravelTimes += numReach * numRevReach;
+	}
+	
+	areaTravelTimes.SetNum( numTravelTimes );
+	LinkAreaTravelTimes();
+	
+	for( n = 0; n < areas.Num(); n++ )
+	{
+		if( !( areas[n].flags & ( AREA_REACHABLE_WALK | AREA_REACHABLE_FLY ) ) )
+		{
+			continue;
+		}
+	
+		for( maxt = 0, reach = areas[n].reach; reach; reach = reach->next )
+		{
+			for( j = 0, rev_reach = areas[n].rev_reach; rev_reach; rev_reach = rev_reach->rev_next, j++ )
+			{
+				t = AreaTravelTime( n, reach->start, rev_reach->end );
+				reach->areaTravelTimes[j] = t;
+				if( t > maxt )
+				{
+					maxt = t;
+				}
+			}
+		}
+	
+		// if this area is a portal set the maximum travel time through this portal
+		if( areas[n].cluster < 0 )
+		{
+			portals[-areas[n].cluster].maxAreaTravelTime = maxt;
+		}
+	}
+}
+
 /*
 ================
 idAASFileLocal::MemorySize
@@ -1498,6 +2089,7 @@ int idAASFileLocal::MemorySize() const
 	size += portals.Size();
 	size += portalIndex.Size();
 	size += clusters.Size();
+	size += areaTravelTimes.Size();
 	size += sizeof( idReachability_Walk ) * NumReachabilities();
 	
 	return size;
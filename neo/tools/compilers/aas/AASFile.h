@@ -41,6 +41,11 @@ If you have questions concerning this license or the applicable additional terms
 #define AAS_FILEID					"DewmAAS"
 #define AAS_FILEVERSION				"1.07"
 
+// binary cache of the text file written to generated/
+#define AAS_BINARYFILE_EXT			"baas"
+#define AAS_BINARYFILE_MAGIC		( ( 'B' << 24 ) | ( 'A' << 16 ) | ( 'A' << 8 ) | 'S' )
+#define AAS_BINARYFILE_VERSION		1
+
 // travel flags
 #define TFL_INVALID					BIT(0)		// not valid
 #define TFL_WALK					BIT(1)		// walking
@@ -285,6 +290,8 @@ public:
 	bool						FromParser( idLexer& src );
 	bool						FromDict( const char* name, const idDict* dict );
 	bool						WriteToFile( idFile* fp ) const;
+	bool						FromBinaryFile( idFile* fp );
+	void						WriteToBinaryFile( idFile* fp ) const;
 	bool						ValidForBounds( const idBounds& bounds ) const;
 	bool						ValidEntity( const char* classname ) const;
 	
@@ -424,11 +431,40 @@ public:
 		return clusters[index];
 	}
 	
+	int							GetNumAreaTravelTimes() const
+	{
+		return areaTravelTimes.Num();
+	}
+	
 	const idAASSettings& 		GetSettings() const
 	{
 		return settings;
 	}
 	
+	// travel time through the area from start to end
+	unsigned short				AreaTravelTime( int areaNum, const idVec3& start, const idVec3& end ) const
+	{
+		float dist = ( end - start ).Length();
+		
+		if( areas[areaNum].travelFlags & TFL_CROUCH )
+		{
+			dist *= 100.0f / 100.0f;
+		}
+		else if( areas[areaNum].travelFlags & TFL_WATER )
+		{
+			dist *= 100.0f / 150.0f;
+		}
+		else
+		{
+			dist *= 100.0f / 300.0f;
+		}
+		if( dist < 1.0f )
+		{
+			return 1;
+		}
+		return ( unsigned short ) idMath::Ftoi( dist );
+	}
+	
 	void						SetPortalMaxTravelTime( int index, int time )
 	{
 		portals[index].maxAreaTravelTime = time;
@@ -472,6 +508,7 @@ protected:
 	idList<aasPortal_t, TAG_AAS>			portals;
 	idList<aasIndex_t, TAG_AAS>			portalIndex;
 	idList<aasCluster_t, TAG_AAS>		clusters;
+	idList<unsigned short, TAG_AAS>		areaTravelTimes;	// travel times through the areas, see idReachability::areaTravelTimes
 	idAASSettings				settings;
 };
 
@@ -72,12 +72,17 @@ public:
 	void						Optimize();
 	void						LinkReversedReachability();
 	void						FinishAreas();
+	void						CalculateAreaTravelTimes();
 	
 	void						Clear();
 	void						DeleteReachabilities();
 	void						DeleteClusters();
 	
 private:
+	bool						LoadText( unsigned int mapFileCRC );
+	bool						LoadBinary( idFile* file, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp );
+	void						WriteBinary( idFile* file, unsigned int mapFileCRC, ID_TIME_T sourceTimeStamp ) const;
+	int							LinkAreaTravelTimes();
 	bool						ParseIndex( idLexer& src, idList<aasIndex_t>& indexes );
 	bool						ParsePlanes( idLexer& src );
 	bool						ParseVertices( idLexer& src );
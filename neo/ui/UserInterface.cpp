@@ -343,6 +343,12 @@ void idUserInterfaceManagerLocal::FreeListGUI( idListGUI* listgui )
 ===============================================================================
 */
 
+// shared by all guis so a key never repeats when a gui is freed and another one takes its place
+static int guiDrawChangeCount = 0;
+
+// windows whose registers read vars that are updated later in the same pass lag a frame behind
+static const int GUI_SETTLED_REDRAWS = 2;
+
 idUserInterfaceLocal::idUserInterfaceLocal()
 {
 	cursorX = cursorY = 0.0;
@@ -355,6 +361,10 @@ idUserInterfaceLocal::idUserInterfaceLocal()
 	//so the reg eval in gui parsing doesn't get bogus values
 	time = 0;
 	refs = 1;
+	drawCacheable = false;
+	drawChangeCount = 0;
+	drawnChangeCount = 0;
+	settledRedraws = 0;
 }
 
 idUserInterfaceLocal::~idUserInterfaceLocal()
@@ -508,6 +518,8 @@ bool idUserInterfaceLocal::InitFromFile( const char* qpath, bool rebuild, bool c
 		}
 	}
 	interactive = desktop->Interactive();
+	drawCacheable = !desktop->DrawsOnItsOwn();
+	DrawChanged();
 	if( uiManagerLocal.guis.Find( this ) == NULL )
 	{
 		uiManagerLocal.guis.Append( this );
@@ -520,6 +532,7 @@ const char* idUserInterfaceLocal::HandleEvent( const sysEvent_t* event, int _tim
 {
 
 	time = _time;
+	DrawChanged();
 	
 	if( bindHandler && event->evType == SE_KEY && event->evValue2 == 1 )
 	{
@@ -553,6 +566,7 @@ const char* idUserInterfaceLocal::HandleEvent( const sysEvent_t* event, int _tim
 
 void idUserInterfaceLocal::HandleNamedEvent( const char* eventName )
 {
+	DrawChanged();
 	desktop->RunNamedEvent( eventName );
 }
 
@@ -565,9 +579,26 @@ void idUserInterfaceLocal::Redraw( int _time, bool hud )
 	if( !loading && desktop )
 	{
 		time = _time;
+		if( drawCacheable )
+		{
+			// only count Redraws that start with nothing changed since the previous one
+			if( drawnChangeCount == drawChangeCount && !desktop->HasPendingTimeEvents() )
+			{
+				settledRedraws++;
+			}
+			else
+			{
+				settledRedraws = 0;
+			}
+			drawnChangeCount = drawChangeCount;
+		}
 		dc->PushClipRect( uiManagerLocal.screenRect );
 		desktop->Redraw( 0, 0, hud );
 		dc->PopClipRect();
+		if( drawCacheable && desktop->HasPendingTimeEvents() )
+		{
+			settledRedraws = 0;
+		}
 	}
 }
 
@@ -590,27 +621,37 @@ const idDict& idUserInterfaceLocal::State() const
 
 void idUserInterfaceLocal::DeleteStateVar( const char* varName )
 {
+	if( state.FindKey( varName ) != NULL )
+	{
+		DrawChanged();
+	}
 	state.Delete( varName );
 }
 
 void idUserInterfaceLocal::SetStateString( const char* varName, const char* value )
 {
+	// the game sets most state vars every frame, only a different value invalidates the cached draw
+	const idKeyValue* kv = state.FindKey( varName );
+	if( kv == NULL || kv->GetValue().Cmp( value ) != 0 )
+	{
+		DrawChanged();
+	}
 	state.Set( varName, value );
 }
 
 void idUserInterfaceLocal::SetStateBool( const char* varName, const bool value )
 {
-	state.SetBool( varName, value );
+	SetStateString( varName, va( "%i", value ) );
 }
 
 void idUserInterfaceLocal::SetStateInt( const char* varName, const int value )
 {
-	state.SetInt( varName, value );
+	SetStateString( varName, va( "%i", value ) );
 }
 
 void idUserInterfaceLocal::SetStateFloat( const char* varName, const float value )
 {
-	state.SetFloat( varName, value );
+	SetStateString( varName, va( "%f", value ) );
 }
 
 const char* idUserInterfaceLocal::GetStateString( const char* varName, const char* defaultString ) const
@@ -636,6 +677,7 @@ float idUserInterfaceLocal::GetStateFloat( const char* varName, const char* defa
 void idUserInterfaceLocal::StateChanged( int _time, bool redraw )
 {
 	time = _time;
+	DrawChanged();
 	if( desktop )
 	{
 		desktop->StateChanged( redraw );
@@ -661,6 +703,7 @@ const char* idUserInterfaceLocal::Activate( bool activate, int _time )
 {
 	time = _time;
 	active = activate;
+	DrawChanged();
 	if( desktop )
 	{
 		activateStr = "";
@@ -673,6 +716,7 @@ const char* idUserInterfaceLocal::Activate( bool activate, int _time )
 void idUserInterfaceLocal::Trigger( int _time )
 {
 	time = _time;
+	DrawChanged();
 	if( desktop )
 	{
 		desktop->Trigger();
@@ -701,6 +745,9 @@ void idUserInterfaceLocal::ReadFromDemoFile( class idDemoFile* f )
 	f->ReadFloat( cursorX );
 	f->ReadFloat( cursorY );
 	
+	drawCacheable = !desktop->DrawsOnItsOwn();
+	DrawChanged();
+	
 	bool add = true;
 	int c = uiManagerLocal.demoGuis.Num();
 	for( int i = 0; i < c; i++ )
@@ -818,6 +865,7 @@ bool idUserInterfaceLocal::ReadFromSaveGame( idFile* savefile )
 	savefile->Read( &cursorY, sizeof( cursorY ) );
 	
 	desktop->ReadFromSaveGame( savefile );
+	DrawChanged();
 	
 	return true;
 }
@@ -874,7 +922,46 @@ idUserInterfaceLocal::SetCursor
 */
 void idUserInterfaceLocal::SetCursor( float x, float y )
 {
+	if( x != cursorX || y != cursorY )
+	{
+		DrawChanged();
+	}
 	cursorX = x;
 	cursorY = y;
 }
 
+/*
+==============
+idUserInterfaceLocal::DrawChanged
+
+Anything that may change what the next Redraw emits gets a new key
+==============
+*/
+void idUserInterfaceLocal::DrawChanged()
+{
+	if( ++guiDrawChangeCount <= 0 )
+	{
+		guiDrawChangeCount = 1;
+	}
+	drawChangeCount = guiDrawChangeCount;
+	settledRedraws = 0;
+}
+
+/*
+==============
+idUserInterfaceLocal::GetDrawCacheKey
+==============
+*/
+int idUserInterfaceLocal::GetDrawCacheKey() const
+{
+	if( !drawCacheable || idWindow::gui_edit.GetBool() || idWindow::gui_debug.GetInteger() != 0 )
+	{
+		return -1;
+	}
+	if( settledRedraws < GUI_SETTLED_REDRAWS )
+	{
+		return 0;
+	}
+	return drawChangeCount;
+}
+
@@ -113,6 +113,11 @@ public:
 	virtual void				SetCursor( float x, float y ) = 0;
 	virtual float				CursorX() = 0;
 	virtual float				CursorY() = 0;
+	
+	// Returns a key that stays the same for as long as Redraw would emit exactly the same
+	// geometry, so the renderer can replay what it recorded instead of redrawing.
+	// -1 means the gui animates on its own and is never cached, 0 that it has not settled yet.
+	virtual int					GetDrawCacheKey() const = 0;
 };
 
 
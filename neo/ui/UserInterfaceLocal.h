@@ -84,6 +84,8 @@ public:
 		return cursorY;
 	}
 	
+	virtual int					GetDrawCacheKey() const;
+	
 	size_t						Size();
 	
 	idDict* 					GetStateDict()
@@ -166,6 +168,13 @@ private:
 	int							time;
 	
 	int							refs;
+	
+	void						DrawChanged();
+	
+	bool						drawCacheable;		// no window animates on its own
+	int							drawChangeCount;	// renewed by everything that can change what Redraw emits
+	int							drawnChangeCount;	// drawChangeCount at the last Redraw
+	int							settledRedraws;		// consecutive Redraws without any change
 };
 
 
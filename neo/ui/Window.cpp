@@ -5573,6 +5573,105 @@ bool idWindow::ContainsStateVars()
 	return false;
 }
 
+/*
+================
+idWindow::DrawsOnItsOwn
+
+Returns true if the window can draw something different without any
+event or state change, because it runs per frame scripts, reads the
+time register or is one of the special window types that animate
+================
+*/
+bool idWindow::DrawsOnItsOwn()
+{
+	if( typeid( *this ) != typeid( idWindow ) )
+	{
+		return true;
+	}
+	if( scripts[ ON_FRAME ] || ( flags & WIN_SHOWTIME ) )
+	{
+		return true;
+	}
+	int c = ops.Num();
+	for( int i = 0; i < c; i++ )
+	{
+		const wexpOp_t& op = ops[i];
+		switch( op.opType )
+		{
+			case WOP_TYPE_VAR:
+			case WOP_TYPE_VARS:
+			case WOP_TYPE_VARF:
+			case WOP_TYPE_VARI:
+			case WOP_TYPE_VARB:
+				// a is a var pointer
+				break;
+			case WOP_TYPE_TABLE:
+				if( op.b == WEXP_REG_TIME )
+				{
+					return true;
+				}
+				break;
+			case WOP_TYPE_COND:
+				if( op.d == WEXP_REG_TIME )
+				{
+					return true;
+				}
+			// fall through
+			default:
+				if( op.a == WEXP_REG_TIME || op.b == WEXP_REG_TIME )
+				{
+					return true;
+				}
+				break;
+		}
+	}
+	c = children.Num();
+	for( int i = 0; i < c; i++ )
+	{
+		if( children[i]->DrawsOnItsOwn() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+================
+idWindow::HasPendingTimeEvents
+
+Returns true while a transition or a timeline event is still going to
+change the window on a later frame
+================
+*/
+bool idWindow::HasPendingTimeEvents()
+{
+	if( flags & WIN_INTRANSITION )
+	{
+		return true;
+	}
+	if( !noTime )
+	{
+		int c = timeLineEvents.Num();
+		for( int i = 0; i < c; i++ )
+		{
+			if( timeLineEvents[i]->pending )
+			{
+				return true;
+			}
+		}
+	}
+	int c = children.Num();
+	for( int i = 0; i < c; i++ )
+	{
+		if( children[i]->HasPendingTimeEvents() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 /*
 ================
 idWindow::Interactive
@@ -344,6 +344,8 @@ public:
 	void AddUpdateVar( idWinVar* var );
 	bool Interactive();
 	bool ContainsStateVars();
+	bool DrawsOnItsOwn();
+	bool HasPendingTimeEvents();
 	void SetChildWinVarVal( const char* name, const char* var, const char* val );
 	idWindow* GetFocusedChild();
 	idWindow* GetCaptureChild();